@@ -43,6 +43,14 @@ namespace QuantLib {
         registerWith(termStructure_);
     }
 
+    TreeCallableFixedRateBondEngine::TreeCallableFixedRateBondEngine(
+        const ext::shared_ptr<ShortRateTreeCache>& treeCache,
+        Handle<YieldTermStructure> termStructure)
+    : LatticeShortRateModelEngine<CallableBond::arguments, CallableBond::results>(treeCache),
+      termStructure_(std::move(termStructure)) {
+        registerWith(termStructure_);
+    }
+
     void TreeCallableFixedRateBondEngine::calculate() const {
         calculateWithSpread(arguments_.spread);
     }
@@ -56,22 +64,18 @@ namespace QuantLib {
             tsmodel != nullptr ? tsmodel->termStructure() : termStructure_;
 
         DiscretizedCallableFixedRateBond callableBond(arguments_, discountCurve);
-        ext::shared_ptr<Lattice> lattice;
-
-        if (lattice_ != nullptr) {
-            lattice = lattice_;
-        } else {
-            std::vector<Time> times = callableBond.mandatoryTimes();
-            TimeGrid timeGrid(times.begin(), times.end(), timeSteps_);
-            lattice = model_->tree(timeGrid);
-        }
+        ext::shared_ptr<Lattice> lattice =
+            latticeFor(callableBond.mandatoryTimes());
 
+        // the tree might be shared with other engines, so the spread
+        // is always set (and reset to zero when none is required)
+        auto* sr = dynamic_cast<OneFactorModel::ShortRateTree*>(&(*lattice));
         if (s != 0.0) {
-            auto* sr = dynamic_cast<OneFactorModel::ShortRateTree*>(&(*lattice));
             QL_REQUIRE(sr,
                        "Spread is not supported for trees other than OneFactorModel");
-            sr->setSpread(s);
         }
+        if (sr != nullptr)
+            sr->setSpread(s);
 
         auto referenceDate = discountCurve->referenceDate();
         auto dayCounter = discountCurve->dayCounter();
@@ -48,6 +48,9 @@ namespace QuantLib {
             const ext::shared_ptr<ShortRateModel>&,
             const TimeGrid& timeGrid,
             Handle<YieldTermStructure> termStructure = Handle<YieldTermStructure>());
+        TreeCallableFixedRateBondEngine(
+            const ext::shared_ptr<ShortRateTreeCache>& treeCache,
+            Handle<YieldTermStructure> termStructure = Handle<YieldTermStructure>());
         //@}
         void calculate() const override;
 
@@ -75,6 +78,12 @@ namespace QuantLib {
                            const Handle<YieldTermStructure>& termStructure =
                                                  Handle<YieldTermStructure>())
         : TreeCallableFixedRateBondEngine(model, timeGrid, termStructure) {}
+
+        TreeCallableZeroCouponBondEngine(
+                           const ext::shared_ptr<ShortRateTreeCache>& treeCache,
+                           const Handle<YieldTermStructure>& termStructure =
+                                                 Handle<YieldTermStructure>())
+        : TreeCallableFixedRateBondEngine(treeCache, termStructure) {}
     };
 
 }
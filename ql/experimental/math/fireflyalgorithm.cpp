@@ -19,6 +19,7 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 
 #include <ql/experimental/math/fireflyalgorithm.hpp>
 #include <ql/math/randomnumbers/sobolrsg.hpp>
+#include <ql/utilities/exceptioncollector.hpp>
 #include <algorithm>
 #include <cmath>
 #include <utility>
@@ -63,15 +64,30 @@ namespace QuantLib {
                 //Assign X=lb+(ub-lb)*random
                 x[j] = lX_[j] + bounds[j] * sample[j];
             }
-            //Evaluate point
-            values_.emplace_back(P.value(x), i);
         }
+        //Evaluate points
+        Array values(M_);
+        evaluate(P, x_, values);
+        for (Size i = 0; i < M_; i++)
+            values_.emplace_back(values[i], i);
 
         //init intensity & randomWalk
         intensity_->init(this);
         randomWalk_->init(this);
     }
 
+    void FireflyAlgorithm::evaluate(Problem& P,
+                                    const std::vector<Array>& points,
+                                    Array& values) const {
+        //The points are evaluated independently of each other
+        ExceptionCollector exceptions(points.size());
+        #pragma omp parallel for schedule(dynamic) if(parallelEvaluation_)
+        for (long i = 0; i < (long)points.size(); i++) {
+            exceptions.run(i, [&]() { values[i] = P.value(points[i]); });
+        }
+        exceptions.rethrow();
+    }
+
     EndCriteria::Type FireflyAlgorithm::minimize(Problem &P, const EndCriteria &endCriteria) {
         QL_REQUIRE(!P.constraint().empty(), "Firefly Algorithm is a constrained optimizer");
         EndCriteria::Type ecType = EndCriteria::None;
@@ -86,6 +102,9 @@ namespace QuantLib {
         bool isFA = Mfa_ > 0;
         //Variables for DE
         Array z(N_, 0.0);
+        //Variables for FA
+        std::vector<Array> zFA(Mfa_, Array(N_, 0.0));
+        Array valuesFA(Mfa_);
         Size indexR1, indexR2;
         decltype(distribution_)::param_type nParam(0, N_ - 1);
 
@@ -175,27 +194,36 @@ namespace QuantLib {
                 //Loop over particles
                 for (Size i = 0; i < Mfa_; i++) {
                     Size index = values_[i].second;
-                    Array& x   = x_[index];
-                    Array& xI  = xI_[index];
-                    Array& xRW = xRW_[index];
+                    const Array& x   = x_[index];
+                    const Array& xI  = xI_[index];
+                    const Array& xRW = xRW_[index];
+                    Array& zi = zFA[i];
 
                     //Loop over dimensions
                     for (Size j = 0; j < N_; j++) {
                         //Update position
-                        z[j] = x[j] + xI[j] + xRW[j];
+                        zi[j] = x[j] + xI[j] + xRW[j];
                         //Enforce bounds on positions
-                        if (z[j] < lX_[j]) {
-                            z[j] = lX_[j];
+                        if (zi[j] < lX_[j]) {
+                            zi[j] = lX_[j];
                         }
-                        else if (z[j] > uX_[j]) {
-                            z[j] = uX_[j];
+                        else if (zi[j] > uX_[j]) {
+                            zi[j] = uX_[j];
                         }
                     }
-                    Real val = P.value(z);
+                }
+
+                //Evaluate new positions
+                evaluate(P, zFA, valuesFA);
+
+                for (Size i = 0; i < Mfa_; i++) {
+                    Size index = values_[i].second;
+                    Array& x = x_[index];
+                    Real val = valuesFA[i];
                     if(!std::isnan(val))
 					{
 						//Accept new point
-                        x = z;
+                        x = zFA[i];
                         values_[index].first = val;
                         //mark best
                         if (val < bestValue) {
@@ -91,7 +91,22 @@ namespace QuantLib {
         void startState(Problem &P, const EndCriteria &endCriteria);
         EndCriteria::Type minimize(Problem& P, const EndCriteria& endCriteria) override;
 
+        /*! When enabled, the initial population and the moved
+            fireflies of each iteration are evaluated concurrently;
+            the cost function must be safe to call from several
+            threads.  Results do not depend on it.  The differential
+            evolution part of the hybrid algorithm remains sequential,
+            since each accepted point enters the following mutations.
+        */
+        void enableParallelEvaluation(bool enable = true) {
+            parallelEvaluation_ = enable;
+        }
+
       protected:
+        void evaluate(Problem& P,
+                      const std::vector<Array>& points,
+                      Array& values) const;
+
         std::vector<Array> x_, xI_, xRW_; 
         std::vector<std::pair<Real, Size> > values_;
         Array lX_, uX_;
@@ -102,6 +117,7 @@ namespace QuantLib {
         std::mt19937 generator_;
         std::uniform_int_distribution<QuantLib::Size> distribution_;
         MersenneTwisterUniformRng rng_;
+        bool parallelEvaluation_ = false;
     };
 
     //! Base intensity class
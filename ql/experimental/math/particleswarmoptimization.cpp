@@ -19,6 +19,7 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 
 #include <ql/experimental/math/particleswarmoptimization.hpp>
 #include <ql/math/randomnumbers/sobolrsg.hpp>
+#include <ql/utilities/exceptioncollector.hpp>
 #include <cmath>
 #include <utility>
 
@@ -82,16 +83,27 @@ namespace QuantLib {
                 //Assign V=(ub-lb)*2*random-(ub-lb) -> between (lb-ub) and (ub-lb)
                 v[j] = bounds[j] * (2.0*sample[2 * j + 1] - 1.0);
             }
-            //Evaluate X and assign as personal best
+            //Assign X as personal best
             pBX_.push_back(X_.back());
-            pBF_[i] = P.value(X_.back());
         }
+        //Evaluate personal bests
+        evaluate(P, pBF_);
 
         //init topology & inertia
         topology_->init(this);
         inertia_->init(this);
     }
 
+    void ParticleSwarmOptimization::evaluate(Problem& P, Array& values) const {
+        //The particles are evaluated independently of each other
+        ExceptionCollector exceptions(M_);
+        #pragma omp parallel for schedule(dynamic) if(parallelEvaluation_)
+        for (long i = 0; i < (long)M_; i++) {
+            exceptions.run(i, [&]() { values[i] = P.value(X_[i]); });
+        }
+        exceptions.rethrow();
+    }
+
     EndCriteria::Type ParticleSwarmOptimization::minimize(Problem &P, const EndCriteria &endCriteria) {
         QL_REQUIRE(!P.constraint().empty(), "PSO is a constrained optimizer");
 
@@ -114,6 +126,7 @@ namespace QuantLib {
         }
 
         //Run optimization
+        Array f(M_);
         do {
             iteration++;
             iterationStat++;
@@ -130,7 +143,7 @@ namespace QuantLib {
             //Loop over particles
             for (Size i = 0; i < M_; i++) {
                 Array& x = X_[i];
-                Array& pB = pBX_[i];
+                const Array& pB = pBX_[i];
                 const Array& gB = gBX_[i];
                 Array& v = V_[i];
 
@@ -150,15 +163,19 @@ namespace QuantLib {
                         v[j] = 0.0;
                     }
                 }
-                //Evaluate x
-                Real f = P.value(x);
-                if (f < pBF_[i]) {
+            }
+
+            //Evaluate particles
+            evaluate(P, f);
+
+            for (Size i = 0; i < M_; i++) {
+                if (f[i] < pBF_[i]) {
                     //Update personal best
-                    pBF_[i] = f;
-                    pB = x;
+                    pBF_[i] = f[i];
+                    pBX_[i] = X_[i];
                     //Check stationary condition
-                    if (f < bestValue) {
-                        bestValue = f;
+                    if (f[i] < bestValue) {
+                        bestValue = f[i];
                         bestPosition = i;
                         iterationStat = 0;
                     }
@@ -109,7 +109,17 @@ namespace QuantLib {
         void startState(Problem &P, const EndCriteria &endCriteria);
         EndCriteria::Type minimize(Problem& P, const EndCriteria& endCriteria) override;
 
+        /*! When enabled, the particles of each iteration are
+            evaluated concurrently; the cost function must be safe to
+            call from several threads.  Results do not depend on it.
+        */
+        void enableParallelEvaluation(bool enable = true) {
+            parallelEvaluation_ = enable;
+        }
+
       protected:
+        void evaluate(Problem& P, Array& values) const;
+
         std::vector<Array> X_, V_, pBX_, gBX_;
         Array pBF_, gBF_;
         Array lX_, uX_;
@@ -118,6 +128,7 @@ namespace QuantLib {
         MersenneTwisterUniformRng rng_;
         ext::shared_ptr<Topology> topology_;
         ext::shared_ptr<Inertia> inertia_;
+        bool parallelEvaluation_ = false;
     };
 
     //! Base inertia class used to alter the PSO state
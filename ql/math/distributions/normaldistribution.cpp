@@ -117,6 +117,44 @@ namespace QuantLib {
         return z;
     }
 
+    void InverseCumulativeNormal::operator()(const Real* begin,
+                                             const Real* end,
+                                             Real* out) const {
+        standard_values(begin, end, out);
+        if (average_ != 0.0 || sigma_ != 1.0) {
+            for (Size i=0, n=end-begin; i<n; ++i)
+                out[i] = average_ + sigma_*out[i];
+        }
+    }
+
+    void InverseCumulativeNormal::standard_values(const Real* begin,
+                                                  const Real* end,
+                                                  Real* out) {
+        const Size n = end - begin;
+
+        // central region for all values, without branches
+        for (Size i=0; i<n; ++i) {
+            const Real z = begin[i] - 0.5;
+            const Real r = z*z;
+            out[i] = (((((a1_*r+a2_)*r+a3_)*r+a4_)*r+a5_)*r+a6_)*z /
+                (((((b1_*r+b2_)*r+b3_)*r+b4_)*r+b5_)*r+1.0);
+        }
+
+        // replace the values in the tails
+        for (Size i=0; i<n; ++i) {
+            if (begin[i] < x_low_ || x_high_ < begin[i])
+                out[i] = tail_value(begin[i]);
+        }
+
+        #ifdef REFINE_TO_FULL_MACHINE_PRECISION_USING_HALLEYS_METHOD
+        for (Size i=0; i<n; ++i) {
+            const Real z = out[i];
+            const Real r = (f_(z) - begin[i]) * M_SQRT2 * M_SQRTPI * exp(0.5 * z*z);
+            out[i] = z - r/(1+0.5*z*r);
+        }
+        #endif
+    }
+
     const Real MoroInverseCumulativeNormal::a0_ =  2.50662823884;
     const Real MoroInverseCumulativeNormal::a1_ =-18.61500062529;
     const Real MoroInverseCumulativeNormal::a2_ = 41.39119773534;
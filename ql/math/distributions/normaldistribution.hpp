@@ -134,6 +134,19 @@ namespace QuantLib {
 
             return z;
         }
+        //! values for a range of \f$ x \f$
+        /*! \pre the output range must not overlap the input range */
+        void operator()(const Real* begin, const Real* end, Real* out) const;
+        //! values for average=0, sigma=1 for a range of \f$ x \f$
+        /*! The central region is evaluated for the whole range in a
+            loop without branches, which compilers can vectorize; the
+            rare values in the tails are replaced afterwards.
+
+            \pre the output range must not overlap the input range
+        */
+        static void standard_values(const Real* begin,
+                                    const Real* end,
+                                    Real* out);
       private:
         /* Handling tails moved into a separate method, which should
            make the inlining of operator() and standard_value method
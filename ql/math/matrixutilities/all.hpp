@@ -4,6 +4,7 @@
 #include <ql/math/matrixutilities/basisincompleteordered.hpp>
 #include <ql/math/matrixutilities/bicgstab.hpp>
 #include <ql/math/matrixutilities/choleskydecomposition.hpp>
+#include <ql/math/matrixutilities/csrmatrix.hpp>
 #include <ql/math/matrixutilities/expm.hpp>
 #include <ql/math/matrixutilities/factorreduction.hpp>
 #include <ql/math/matrixutilities/getcovariance.hpp>
@@ -11,6 +12,7 @@
 #include <ql/math/matrixutilities/householder.hpp>
 #include <ql/math/matrixutilities/pseudosqrt.hpp>
 #include <ql/math/matrixutilities/qrdecomposition.hpp>
+#include <ql/math/matrixutilities/sparseilu0preconditioner.hpp>
 #include <ql/math/matrixutilities/sparseilupreconditioner.hpp>
 #include <ql/math/matrixutilities/sparsematrix.hpp>
 #include <ql/math/matrixutilities/svd.hpp>
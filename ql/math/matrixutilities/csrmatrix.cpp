@@ -0,0 +1,283 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/matrixutilities/csrmatrix.hpp>
+#include <algorithm>
+#include <utility>
+
+namespace QuantLib {
+
+    CsrMatrix::Builder::Builder(Size rows, Size columns, Size expectedNonZeros)
+    : rows_(rows), columns_(columns) {
+        i_.reserve(expectedNonZeros);
+        j_.reserve(expectedNonZeros);
+        values_.reserve(expectedNonZeros);
+    }
+
+    void CsrMatrix::Builder::add(Size i, Size j, Real value) {
+        QL_REQUIRE(i < rows_ && j < columns_,
+                   "element (" << i << ", " << j << ") is outside of a "
+                   << rows_ << "x" << columns_ << " matrix");
+        i_.push_back(i);
+        j_.push_back(j);
+        values_.push_back(value);
+    }
+
+    CsrMatrix CsrMatrix::Builder::build() const {
+        // counting sort of the triplets by row
+        std::vector<Size> rowStart(rows_+1, 0);
+        for (Size i : i_)
+            ++rowStart[i+1];
+        for (Size i=0; i < rows_; ++i)
+            rowStart[i+1] += rowStart[i];
+
+        std::vector<std::pair<Size, Real> > entries(values_.size());
+        std::vector<Size> next(rowStart.begin(), rowStart.end()-1);
+        for (Size k=0; k < values_.size(); ++k)
+            entries[next[i_[k]]++] = std::make_pair(j_[k], values_[k]);
+
+        // sort each row by column and sum up duplicates
+        std::vector<Size> columnIndices;
+        std::vector<Real> values;
+        columnIndices.reserve(entries.size());
+        values.reserve(entries.size());
+
+        Size begin = 0;
+        for (Size i=0; i < rows_; ++i) {
+            const Size end = rowStart[i+1];
+            std::sort(entries.begin() + begin, entries.begin() + end,
+                      [](const std::pair<Size, Real>& a,
+                         const std::pair<Size, Real>& b) {
+                          return a.first < b.first;
+                      });
+
+            const Size rowBegin = values.size();
+            for (Size k=begin; k < end; ++k) {
+                if (values.size() > rowBegin
+                    && columnIndices.back() == entries[k].first) {
+                    values.back() += entries[k].second;
+                } else {
+                    columnIndices.push_back(entries[k].first);
+                    values.push_back(entries[k].second);
+                }
+            }
+            begin = end;
+            rowStart[i+1] = values.size();
+        }
+
+        return {rows_, columns_, std::move(rowStart),
+                std::move(columnIndices), std::move(values)};
+    }
+
+
+    CsrMatrix::CsrMatrix(Size rows, Size columns)
+    : rows_(rows), columns_(columns), rowStart_(rows+1, 0) {}
+
+    CsrMatrix::CsrMatrix(Size rows,
+                         Size columns,
+                         std::vector<Size> rowStart,
+                         std::vector<Size> columnIndices,
+                         std::vector<Real> values)
+    : rows_(rows), columns_(columns), rowStart_(std::move(rowStart)),
+      columnIndices_(std::move(columnIndices)), values_(std::move(values)) {
+        QL_REQUIRE(rowStart_.size() == rows_+1, "wrong number of row offsets");
+        QL_REQUIRE(rowStart_.front() == 0 && rowStart_.back() == values_.size()
+                   && columnIndices_.size() == values_.size(),
+                   "inconsistent compressed row storage");
+
+#ifdef QL_EXTRA_SAFETY_CHECKS
+        for (Size i=0; i < rows_; ++i) {
+            QL_REQUIRE(rowStart_[i] <= rowStart_[i+1],
+                       "decreasing row offsets in row " << i);
+            for (Size k=rowStart_[i]; k < rowStart_[i+1]; ++k)
+                QL_REQUIRE(columnIndices_[k] < columns_
+                           && (k == rowStart_[i]
+                               || columnIndices_[k-1] < columnIndices_[k]),
+                           "unsorted or invalid column index in row " << i);
+        }
+#endif
+    }
+
+    CsrMatrix::CsrMatrix(const SparseMatrix& m)
+    : rows_(m.size1()), columns_(m.size2()), rowStart_(m.size1()+1) {
+        // rows after the last stored element are not part of index1
+        const Size filled = m.filled1();
+        for (Size i=0; i <= rows_; ++i)
+            rowStart_[i] = m.index1_data()[std::min(i, filled-1)];
+
+        const Size nnz = rowStart_[rows_];
+        columnIndices_.assign(m.index2_data().begin(),
+                              m.index2_data().begin() + nnz);
+        values_.assign(m.value_data().begin(), m.value_data().begin() + nnz);
+    }
+
+    CsrMatrix CsrMatrix::identity(Size n) {
+        std::vector<Size> rowStart(n+1), columnIndices(n);
+        for (Size i=0; i < n; ++i) {
+            columnIndices[i] = i;
+            rowStart[i+1] = i+1;
+        }
+
+        return {n, n, std::move(rowStart),
+                std::move(columnIndices), std::vector<Real>(n, 1.0)};
+    }
+
+    Real CsrMatrix::operator()(Size i, Size j) const {
+        QL_REQUIRE(i < rows_ && j < columns_, "index out of range");
+
+        const auto begin = columnIndices_.begin() + rowStart_[i];
+        const auto end = columnIndices_.begin() + rowStart_[i+1];
+        const auto iter = std::lower_bound(begin, end, j);
+
+        return (iter != end && *iter == j)
+            ? values_[iter - columnIndices_.begin()] : 0.0;
+    }
+
+    CsrMatrix& CsrMatrix::operator*=(Real s) {
+        for (Real& v : values_)
+            v *= s;
+        return *this;
+    }
+
+    CsrMatrix& CsrMatrix::addToDiagonal(Real s) {
+        QL_REQUIRE(rows_ == columns_, "square matrix required");
+
+        std::vector<Size> diagonal(rows_);
+        for (Size i=0; i < rows_; ++i) {
+            const auto begin = columnIndices_.begin() + rowStart_[i];
+            const auto end = columnIndices_.begin() + rowStart_[i+1];
+            const auto iter = std::lower_bound(begin, end, i);
+            if (iter == end || *iter != i) {
+                // the diagonal is not part of the sparsity pattern
+                *this = *this + s*identity(rows_);
+                return *this;
+            }
+            diagonal[i] = iter - columnIndices_.begin();
+        }
+
+        for (Size k : diagonal)
+            values_[k] += s;
+        return *this;
+    }
+
+    void CsrMatrix::mult_into(const Array& x, Array& y) const {
+        QL_REQUIRE(x.size() == columns_,
+                   "vectors and sparse matrices with different sizes ("
+                   << x.size() << ", " << rows_ << "x" << columns_ <<
+                   ") cannot be multiplied");
+        y.resize(rows_);
+
+        const Size* const rowStart = rowStart_.data();
+        const Size* const columnIndices = columnIndices_.data();
+        const Real* const values = values_.data();
+        const Real* const xp = x.begin();
+        Real* const yp = y.begin();
+
+        #pragma omp parallel for if(rows_ > 10000)
+        for (Size i=0; i < rows_; ++i) {
+            Real t = 0.0;
+            for (Size k=rowStart[i]; k < rowStart[i+1]; ++k)
+                t += values[k]*xp[columnIndices[k]];
+            yp[i] = t;
+        }
+    }
+
+    CsrMatrix CsrMatrix::transpose() const {
+        std::vector<Size> rowStart(columns_+1, 0);
+        for (Size j : columnIndices_)
+            ++rowStart[j+1];
+        for (Size j=0; j < columns_; ++j)
+            rowStart[j+1] += rowStart[j];
+
+        // rows are visited in order, hence the columns
+        // of the transposed matrix come out sorted
+        std::vector<Size> next(rowStart.begin(), rowStart.end()-1);
+        std::vector<Size> columnIndices(nonZeros());
+        std::vector<Real> values(nonZeros());
+        for (Size i=0; i < rows_; ++i)
+            for (Size k=rowStart_[i]; k < rowStart_[i+1]; ++k) {
+                const Size p = next[columnIndices_[k]]++;
+                columnIndices[p] = i;
+                values[p] = values_[k];
+            }
+
+        return {columns_, rows_, std::move(rowStart),
+                std::move(columnIndices), std::move(values)};
+    }
+
+    SparseMatrix CsrMatrix::toSparseMatrix() const {
+        SparseMatrix retVal(rows_, columns_, nonZeros());
+        for (Size i=0; i < rows_; ++i)
+            for (Size k=rowStart_[i]; k < rowStart_[i+1]; ++k)
+                retVal.push_back(i, columnIndices_[k], values_[k]);
+
+        return retVal;
+    }
+
+
+    CsrMatrix operator+(const CsrMatrix& a, const CsrMatrix& b) {
+        QL_REQUIRE(a.rows() == b.rows() && a.columns() == b.columns(),
+                   "matrices with different sizes ("
+                   << a.rows() << "x" << a.columns() << ", "
+                   << b.rows() << "x" << b.columns() << ") cannot be added");
+
+        const std::vector<Size>& ra = a.rowStart();
+        const std::vector<Size>& rb = b.rowStart();
+        const std::vector<Size>& ca = a.columnIndices();
+        const std::vector<Size>& cb = b.columnIndices();
+        const std::vector<Real>& va = a.values();
+        const std::vector<Real>& vb = b.values();
+
+        std::vector<Size> rowStart(a.rows()+1, 0), columnIndices;
+        std::vector<Real> values;
+        columnIndices.reserve(a.nonZeros() + b.nonZeros());
+        values.reserve(a.nonZeros() + b.nonZeros());
+
+        // merge the sorted column indices row by row
+        for (Size i=0; i < a.rows(); ++i) {
+            Size ka = ra[i], kb = rb[i];
+            while (ka < ra[i+1] || kb < rb[i+1]) {
+                if (kb == rb[i+1] || (ka < ra[i+1] && ca[ka] < cb[kb])) {
+                    columnIndices.push_back(ca[ka]);
+                    values.push_back(va[ka++]);
+                } else if (ka == ra[i+1] || cb[kb] < ca[ka]) {
+                    columnIndices.push_back(cb[kb]);
+                    values.push_back(vb[kb++]);
+                } else {
+                    columnIndices.push_back(ca[ka]);
+                    values.push_back(va[ka++] + vb[kb++]);
+                }
+            }
+            rowStart[i+1] = values.size();
+        }
+
+        return {a.rows(), a.columns(), std::move(rowStart),
+                std::move(columnIndices), std::move(values)};
+    }
+
+    CsrMatrix operator*(Real s, const CsrMatrix& m) {
+        CsrMatrix retVal(m);
+        retVal *= s;
+        return retVal;
+    }
+
+    Array prod(const CsrMatrix& m, const Array& x) {
+        Array retVal(m.rows());
+        m.mult_into(x, retVal);
+        return retVal;
+    }
+}
@@ -0,0 +1,109 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file csrmatrix.hpp
+    \brief compressed-row sparse matrix
+*/
+
+#ifndef quantlib_csr_matrix_hpp
+#define quantlib_csr_matrix_hpp
+
+#include <ql/math/array.hpp>
+#include <ql/math/matrixutilities/sparsematrix.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! compressed-row sparse matrix
+    /*! Lightweight alternative to the ublas SparseMatrix for the
+        assembly and the arithmetic of finite-difference operators.
+        The column indices of each row are sorted and unique;
+        explicitly stored zeros are kept, so that the sparsity
+        pattern of a sum is the union of the patterns of its terms.
+
+        Conversions from and to SparseMatrix are linear in the
+        number of stored elements.
+    */
+    class CsrMatrix {
+      public:
+        //! collects (row, column, value) triplets in any order
+        /*! Duplicate entries are summed up by build(). */
+        class Builder {
+          public:
+            Builder(Size rows, Size columns, Size expectedNonZeros = 0);
+
+            void add(Size i, Size j, Real value);
+            CsrMatrix build() const;
+
+          private:
+            Size rows_, columns_;
+            std::vector<Size> i_, j_;
+            std::vector<Real> values_;
+        };
+
+        CsrMatrix() = default;
+        //! matrix without any stored elements
+        CsrMatrix(Size rows, Size columns);
+        //! rowStart must be non-decreasing with rowStart[rows] == nnz
+        CsrMatrix(Size rows,
+                  Size columns,
+                  std::vector<Size> rowStart,
+                  std::vector<Size> columnIndices,
+                  std::vector<Real> values);
+        explicit CsrMatrix(const SparseMatrix& m);
+
+        static CsrMatrix identity(Size n);
+
+        //! \name inspectors
+        //@{
+        Size rows() const { return rows_; }
+        Size columns() const { return columns_; }
+        Size nonZeros() const { return values_.size(); }
+
+        const std::vector<Size>& rowStart() const { return rowStart_; }
+        const std::vector<Size>& columnIndices() const { return columnIndices_; }
+        const std::vector<Real>& values() const { return values_; }
+
+        //! zero if the element is not stored
+        Real operator()(Size i, Size j) const;
+        //@}
+
+        //! \name algebra
+        //@{
+        CsrMatrix& operator*=(Real s);
+        CsrMatrix& addToDiagonal(Real s);
+
+        void mult_into(const Array& x, Array& y) const;
+        CsrMatrix transpose() const;
+
+        SparseMatrix toSparseMatrix() const;
+        //@}
+
+      private:
+        Size rows_ = 0, columns_ = 0;
+        std::vector<Size> rowStart_ = std::vector<Size>(1, 0);
+        std::vector<Size> columnIndices_;
+        std::vector<Real> values_;
+    };
+
+    CsrMatrix operator+(const CsrMatrix& a, const CsrMatrix& b);
+    CsrMatrix operator*(Real s, const CsrMatrix& m);
+
+    Array prod(const CsrMatrix& m, const Array& x);
+}
+
+#endif
@@ -0,0 +1,94 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/matrixutilities/sparseilu0preconditioner.hpp>
+#include <ql/utilities/null.hpp>
+
+namespace QuantLib {
+
+    SparseILU0Preconditioner::SparseILU0Preconditioner(const SparseMatrix& A)
+    : SparseILU0Preconditioner(CsrMatrix(A)) {}
+
+    SparseILU0Preconditioner::SparseILU0Preconditioner(const CsrMatrix& A)
+    : n_(A.rows()), rowStart_(A.rowStart()), columns_(A.columnIndices()),
+      diagonal_(A.rows()), values_(A.values()) {
+
+        QL_REQUIRE(A.rows() == A.columns(),
+                   "sparse ILU(0) preconditioner works only with square matrices");
+
+        for (Size i=0; i < n_; ++i) {
+            Size k = rowStart_[i];
+            while (k < rowStart_[i+1] && columns_[k] < i)
+                ++k;
+            QL_REQUIRE(k < rowStart_[i+1] && columns_[k] == i,
+                       "diagonal element " << i << " is missing");
+            diagonal_[i] = k;
+        }
+
+        // IKJ variant of the incomplete LU factorization,
+        // position[j] is the storage index of the element (i, j)
+        std::vector<Size> position(n_, Null<Size>());
+        for (Size i=0; i < n_; ++i) {
+            for (Size k=rowStart_[i]; k < rowStart_[i+1]; ++k)
+                position[columns_[k]] = k;
+
+            for (Size k=rowStart_[i]; k < diagonal_[i]; ++k) {
+                const Size col = columns_[k];
+                const Real pivot = values_[diagonal_[col]];
+                QL_REQUIRE(pivot != 0.0, "zero pivot in row " << col);
+
+                const Real l = (values_[k] /= pivot);
+                for (Size j=diagonal_[col]+1; j < rowStart_[col+1]; ++j) {
+                    const Size p = position[columns_[j]];
+                    if (p != Null<Size>())
+                        values_[p] -= l*values_[j];
+                }
+            }
+
+            for (Size k=rowStart_[i]; k < rowStart_[i+1]; ++k)
+                position[columns_[k]] = Null<Size>();
+        }
+    }
+
+    Array SparseILU0Preconditioner::apply(const Array& b) const {
+        Array x(b.size());
+        apply_into(b, x);
+        return x;
+    }
+
+    void SparseILU0Preconditioner::apply_into(const Array& b, Array& x) const {
+        QL_REQUIRE(b.size() == n_, "inconsistent size of rhs");
+        x.resize(n_);
+
+        // forward substitution with the unit lower triangular factor
+        for (Size i=0; i < n_; ++i) {
+            Real s = b[i];
+            for (Size k=rowStart_[i]; k < diagonal_[i]; ++k)
+                s -= values_[k]*x[columns_[k]];
+            x[i] = s;
+        }
+
+        // backward substitution with the upper triangular factor
+        for (Size i=n_; i > 0; --i) {
+            const Size r = i-1;
+            Real s = x[r];
+            for (Size k=diagonal_[r]+1; k < rowStart_[i]; ++k)
+                s -= values_[k]*x[columns_[k]];
+            x[r] = s/values_[diagonal_[r]];
+        }
+    }
+}
@@ -0,0 +1,58 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file sparseilu0preconditioner.hpp
+    \brief zero fill-in incomplete LU preconditioner for sparse matrices
+*/
+
+#ifndef quantlib_sparse_ilu0_preconditioner_hpp
+#define quantlib_sparse_ilu0_preconditioner_hpp
+
+#include <ql/math/array.hpp>
+#include <ql/math/matrixutilities/csrmatrix.hpp>
+#include <ql/math/matrixutilities/sparsematrix.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! zero fill-in incomplete LU preconditioner
+    /*! The factors share the sparsity pattern of the given matrix,
+        hence the factorization costs O(nnz) operations and memory,
+        unlike SparseILUPreconditioner, which works on dense rows.
+        All diagonal elements of the matrix must be part of its
+        sparsity pattern.
+
+        References:
+        Saad, Yousef. 1996, Iterative methods for sparse linear systems,
+        Chapter 10.3.2, http://www-users.cs.umn.edu/~saad/books.html
+    */
+    class SparseILU0Preconditioner {
+      public:
+        explicit SparseILU0Preconditioner(const CsrMatrix& A);
+        explicit SparseILU0Preconditioner(const SparseMatrix& A);
+
+        Array apply(const Array& b) const;
+        void apply_into(const Array& b, Array& x) const;
+
+      private:
+        Size n_;
+        std::vector<Size> rowStart_, columns_, diagonal_;
+        std::vector<Real> values_;
+    };
+}
+
+#endif
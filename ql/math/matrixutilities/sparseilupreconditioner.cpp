@@ -26,6 +26,10 @@ namespace QuantLib {
 
     using namespace boost::numeric::ublas;
 
+    SparseILUPreconditioner::SparseILUPreconditioner(const CsrMatrix& A,
+                                                     Integer lfil)
+    : SparseILUPreconditioner(A.toSparseMatrix(), lfil) {}
+
     SparseILUPreconditioner::SparseILUPreconditioner(const SparseMatrix& A,
                                                      Integer lfil)
     : L_(A.size1(),A.size2()),
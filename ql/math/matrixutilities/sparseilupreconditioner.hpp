@@ -25,6 +25,7 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #define quantlib_sparse_ilu_preconditioner_hpp
 
 #include <ql/math/array.hpp>
+#include <ql/math/matrixutilities/csrmatrix.hpp>
 #include <ql/math/matrixutilities/sparsematrix.hpp>
 
 namespace QuantLib {
@@ -36,6 +37,7 @@ namespace QuantLib {
     class SparseILUPreconditioner  {
       public:
         explicit SparseILUPreconditioner(const SparseMatrix& A, Integer lfil = 1);
+        explicit SparseILUPreconditioner(const CsrMatrix& A, Integer lfil = 1);
 
         const SparseMatrix& L() const;
         const SparseMatrix& U() const;
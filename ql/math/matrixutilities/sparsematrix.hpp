@@ -56,7 +56,9 @@ namespace QuantLib {
 
         Array b(x.size(), 0.0);
 
-        for (Size i=0; i < A.filled1()-1; ++i) {
+        const Size nRows = A.filled1()-1;
+        #pragma omp parallel for if(nRows > 10000)
+        for (Size i=0; i < nRows; ++i) {
             const Size begin = A.index1_data()[i];
             const Size end   = A.index1_data()[i+1];
             Real t=0;
@@ -19,6 +19,7 @@
 */
 
 #include <ql/math/optimization/differentialevolution.hpp>
+#include <ql/utilities/exceptioncollector.hpp>
 #include <algorithm>
 #include <cmath>
 
@@ -293,16 +294,25 @@ namespace QuantLib {
                                - lowerBound_[memIter]);
                 }
             }
-            // evaluate objective function as soon as possible to avoid unnecessary loops
-            try {
-                population[popIter].cost = p.value(population[popIter].values);
-            } catch (Error&) {
-                population[popIter].cost = QL_MAX_REAL;
-            }
-            if (!std::isfinite(population[popIter].cost))
-                population[popIter].cost = QL_MAX_REAL;
+        }
 
+        // evaluate objective function; all random numbers have been
+        // drawn above, so the order of evaluation does not matter
+        ExceptionCollector exceptions(population.size());
+        #pragma omp parallel for schedule(dynamic) if(configuration().parallelEvaluation)
+        for (long popIter = 0; popIter < (long)population.size(); popIter++) {
+            exceptions.run(popIter, [&]() {
+                try {
+                    population[popIter].cost =
+                        p.value(population[popIter].values);
+                } catch (Error&) {
+                    population[popIter].cost = QL_MAX_REAL;
+                }
+                if (!std::isfinite(population[popIter].cost))
+                    population[popIter].cost = QL_MAX_REAL;
+            });
         }
+        exceptions.rethrow();
     }
 
     void DifferentialEvolution::getCrossoverMask(
@@ -388,10 +398,17 @@ namespace QuantLib {
                 Real l = lowerBound_[i], u = upperBound_[i];
                 population[j].values[i] = l + (u-l)*rng_.nextReal();
             }
-            population[j].cost = p.costFunction().value(population[j].values);
-            if (!std::isfinite(population[j].cost))
-                population[j].cost = QL_MAX_REAL;
         }
+        ExceptionCollector exceptions(population.size());
+        #pragma omp parallel for schedule(dynamic) if(configuration().parallelEvaluation)
+        for (long j = 1; j < (long)population.size(); ++j) {
+            exceptions.run(j, [&]() {
+                population[j].cost = p.costFunction().value(population[j].values);
+                if (!std::isfinite(population[j].cost))
+                    population[j].cost = QL_MAX_REAL;
+            });
+        }
+        exceptions.rethrow();
     }
 
 }
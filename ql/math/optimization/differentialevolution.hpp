@@ -87,6 +87,7 @@ namespace QuantLib {
             Real stepsizeWeight = 0.2, crossoverProbability = 0.9;
             unsigned long seed = 0;
             bool applyBounds = true, crossoverIsAdaptive = false;
+            bool parallelEvaluation = false;
             std::vector<Array> initialPopulation;
             Array upperBound, lowerBound;
 
@@ -157,6 +158,16 @@ namespace QuantLib {
                 strategy = s;
                 return *this;
             }
+
+            /*! The cost function is evaluated concurrently for the
+                members of each generation; it must be safe to call
+                from several threads.  Random numbers are drawn before
+                the evaluation, so results do not depend on it.
+            */
+            Configuration& withParallelEvaluation(bool b = true) {
+                parallelEvaluation = b;
+                return *this;
+            }
         };
 
 
@@ -114,11 +114,13 @@ namespace QuantLib {
 
     // inline definitions
     inline Real Problem::value(const Array& x) {
+        #pragma omp atomic
         ++functionEvaluation_;
         return costFunction_.value(x);
     }
 
     inline Array Problem::values(const Array& x) {
+        #pragma omp atomic
         ++functionEvaluation_;
         return costFunction_.values(x);
     }
@@ -150,4 +150,24 @@ namespace QuantLib {
         }
         return sequence_;
     }
+
+    Burley2020SobolReplicatesRsg::Burley2020SobolReplicatesRsg(
+                                Size dimensionality,
+                                Size replicates,
+                                unsigned long scrambleSeed,
+                                SobolRsg::DirectionIntegers directionIntegers) {
+        QL_REQUIRE(replicates > 0, "at least one replicate required");
+        MersenneTwisterUniformRng mt(scrambleSeed);
+        generators_.reserve(replicates);
+        for (Size i = 0; i < replicates; ++i)
+            generators_.emplace_back(dimensionality, 42, directionIntegers,
+                                     mt.nextInt32());
+    }
+
+    const SobolRsg::sample_type& Burley2020SobolReplicatesRsg::nextSequence() const {
+        const SobolRsg::sample_type& s = generators_[nextReplicate_].nextSequence();
+        nextReplicate_ = (nextReplicate_ + 1) % generators_.size();
+        return s;
+    }
+
 }
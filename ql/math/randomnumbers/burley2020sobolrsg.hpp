@@ -26,6 +26,7 @@
 
 #include <ql/math/randomnumbers/sobolrsg.hpp>
 #include <ql/shared_ptr.hpp>
+#include <vector>
 
 namespace QuantLib {
 
@@ -58,6 +59,39 @@ namespace QuantLib {
         mutable std::vector<std::uint32_t> group4Seeds_;
     };
 
+    //! Independently scrambled replicates of a Sobol sequence
+    /*! Successive draws cycle through \f$ K \f$ copies of the Sobol
+        sequence, each scrambled according to Burley, 2020 with its
+        own seed; i.e., the \f$ j \f$-th draw is the
+        \f$ \lfloor j/K \rfloor \f$-th point of replicate
+        \f$ j \bmod K \f$.  Each replicate yields an unbiased
+        randomized quasi-Monte Carlo estimate, and the spread between
+        the replicates can be used to estimate the error.
+    */
+    class Burley2020SobolReplicatesRsg {
+      public:
+        typedef Sample<std::vector<Real>> sample_type;
+        Burley2020SobolReplicatesRsg(
+            Size dimensionality,
+            Size replicates,
+            unsigned long scrambleSeed = 43,
+            SobolRsg::DirectionIntegers directionIntegers = SobolRsg::Jaeckel);
+        const sample_type& nextSequence() const;
+        const sample_type& lastSequence() const {
+            return generators_[lastReplicate()].lastSequence();
+        }
+        Size dimension() const { return generators_.front().dimension(); }
+        Size replicates() const { return generators_.size(); }
+        //! replicate which produced the last sequence
+        Size lastReplicate() const {
+            return (nextReplicate_ + generators_.size() - 1) % generators_.size();
+        }
+
+      private:
+        std::vector<Burley2020SobolRsg> generators_;
+        mutable Size nextReplicate_ = 0;
+    };
+
 }
 
 
@@ -25,12 +25,29 @@
 #ifndef quantlib_inversecumulative_rsg_h
 #define quantlib_inversecumulative_rsg_h
 
+#include <ql/math/distributions/normaldistribution.hpp>
 #include <ql/methods/montecarlo/sample.hpp>
+#include <algorithm>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 namespace QuantLib {
 
+    namespace detail {
+
+        // uniform generators which can fill several sequences at once
+        template <class USG, class = void>
+        struct has_block_sequences : std::false_type {};
+
+        template <class USG>
+        struct has_block_sequences<
+            USG, std::void_t<decltype(std::declval<const USG&>().nextSequences(
+                     Size(), static_cast<Real*>(nullptr)))>>
+        : std::true_type {};
+
+    }
+
     //! Inverse cumulative random sequence generator
     /*! It uses a sequence of uniform deviate in (0, 1) as the
         source of cumulative distribution values.
@@ -52,6 +69,14 @@ namespace QuantLib {
             IC::IC();
             Real IC::operator() const;
         \endcode
+
+        If USG also provides
+        \code
+            void USG::nextSequences(Size points, Real* out) const;
+        \endcode
+        (as SobolRsg does) the uniform sequences are drawn and
+        transformed a block of points at a time and then returned one
+        by one; the returned sequences are the same.
     */
     template <class USG, class IC>
     class InverseCumulativeRsg {
@@ -64,34 +89,73 @@ namespace QuantLib {
         const sample_type& lastSequence() const { return x_; }
         Size dimension() const { return dimension_; }
       private:
+        void transform(const Real* begin, const Real* end, Real* out) const;
+        // number of values drawn at once from block generators
+        static constexpr Size blockSize = 4096;
         USG uniformSequenceGenerator_;
         Size dimension_;
         mutable sample_type x_;
         IC ICD_;
+        // block of points drawn in advance, if USG allows it
+        Size blockPoints_;
+        mutable Size nextPoint_;
+        mutable std::vector<Real> uniforms_, deviates_;
     };
 
     template <class USG, class IC>
     InverseCumulativeRsg<USG, IC>::InverseCumulativeRsg(USG usg)
     : uniformSequenceGenerator_(std::move(usg)), dimension_(uniformSequenceGenerator_.dimension()),
-      x_(std::vector<Real>(dimension_), 1.0) {}
+      x_(std::vector<Real>(dimension_), 1.0),
+      blockPoints_(std::max<Size>(1, blockSize/std::max<Size>(1, dimension_))),
+      nextPoint_(blockPoints_) {}
 
     template <class USG, class IC>
     InverseCumulativeRsg<USG, IC>::InverseCumulativeRsg(USG usg, const IC& inverseCum)
     : uniformSequenceGenerator_(std::move(usg)), dimension_(uniformSequenceGenerator_.dimension()),
-      x_(std::vector<Real>(dimension_), 1.0), ICD_(inverseCum) {}
+      x_(std::vector<Real>(dimension_), 1.0), ICD_(inverseCum),
+      blockPoints_(std::max<Size>(1, blockSize/std::max<Size>(1, dimension_))),
+      nextPoint_(blockPoints_) {}
 
     template <class USG, class IC>
     inline const typename InverseCumulativeRsg<USG, IC>::sample_type&
     InverseCumulativeRsg<USG, IC>::nextSequence() const {
-        typename USG::sample_type sample =
-            uniformSequenceGenerator_.nextSequence();
-        x_.weight = sample.weight;
-        for (Size i = 0; i < dimension_; i++) {
-            x_.value[i] = ICD_(sample.value[i]);
+        if constexpr (detail::has_block_sequences<USG>::value) {
+            if (nextPoint_ == blockPoints_) {
+                uniforms_.resize(blockPoints_*dimension_);
+                deviates_.resize(blockPoints_*dimension_);
+                uniformSequenceGenerator_.nextSequences(blockPoints_,
+                                                        uniforms_.data());
+                transform(uniforms_.data(), uniforms_.data() + uniforms_.size(),
+                          deviates_.data());
+                nextPoint_ = 0;
+            }
+            const Real* d = deviates_.data() + nextPoint_*dimension_;
+            std::copy(d, d + dimension_, x_.value.begin());
+            x_.weight = uniformSequenceGenerator_.lastSequence().weight;
+            ++nextPoint_;
+        } else {
+            const typename USG::sample_type& sample =
+                uniformSequenceGenerator_.nextSequence();
+            x_.weight = sample.weight;
+            const Real* u = sample.value.data();
+            transform(u, u + dimension_, x_.value.data());
         }
         return x_;
     }
 
+    template <class USG, class IC>
+    inline void InverseCumulativeRsg<USG, IC>::transform(const Real* begin,
+                                                         const Real* end,
+                                                         Real* out) const {
+        if constexpr (std::is_same_v<IC, InverseCumulativeNormal>) {
+            // transform the whole range at once
+            ICD_(begin, end, out);
+        } else {
+            for (; begin != end; ++begin, ++out)
+                *out = ICD_(*begin);
+        }
+    }
+
 }
 
 
@@ -31,6 +31,7 @@
 #include <ql/math/randomnumbers/inversecumulativerng.hpp>
 #include <ql/math/randomnumbers/randomsequencegenerator.hpp>
 #include <ql/math/randomnumbers/sobolrsg.hpp>
+#include <ql/math/randomnumbers/burley2020sobolrsg.hpp>
 #include <ql/math/randomnumbers/inversecumulativersg.hpp>
 #include <ql/math/distributions/normaldistribution.hpp>
 #include <ql/math/distributions/poissondistribution.hpp>
@@ -104,6 +105,41 @@ namespace QuantLib {
     typedef GenericLowDiscrepancy<SobolRsg,
                                   InverseCumulativeNormal> LowDiscrepancy;
 
+
+    template <class URSG, class IC, Size K = 16>
+    struct GenericRandomizedLowDiscrepancy {
+        // typedefs
+        typedef URSG ursg_type;
+        typedef InverseCumulativeRsg<ursg_type,IC> rsg_type;
+        // more traits
+        enum { allowsErrorEstimate = 1 };
+        //! number of independent randomizations of the sequence
+        static constexpr Size replicates = K;
+        // factory
+        static rsg_type make_sequence_generator(Size dimension,
+                                                BigNatural seed) {
+            ursg_type g(dimension, replicates, seed);
+            return (icInstance ? rsg_type(g, *icInstance) : rsg_type(g));
+        }
+        // data
+        static ext::shared_ptr<IC> icInstance;
+    };
+
+    // static member initialization
+    template<class URSG, class IC, Size K>
+    ext::shared_ptr<IC> GenericRandomizedLowDiscrepancy<URSG, IC, K>::icInstance;
+
+
+    //! traits for randomized quasi-Monte Carlo
+    /*! Paths are drawn in turn from independently scrambled Sobol
+        sequences; the Monte Carlo model averages each randomization
+        separately, so that the spread between them provides an error
+        estimate and a tolerance can be required.
+    */
+    typedef GenericRandomizedLowDiscrepancy<Burley2020SobolReplicatesRsg,
+                                            InverseCumulativeNormal>
+        RandomizedLowDiscrepancy;
+
 }
 
 
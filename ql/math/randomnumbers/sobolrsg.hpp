@@ -26,7 +26,9 @@
 #ifndef quantlib_sobol_ld_rsg_hpp
 #define quantlib_sobol_ld_rsg_hpp
 
+#include <ql/errors.hpp>
 #include <ql/methods/montecarlo/sample.hpp>
+#include <algorithm>
 #include <cstdint>
 #include <vector>
 
@@ -138,9 +140,25 @@ namespace QuantLib {
                 sequence_.value[k] = v[k] * (0.5 / (1UL << 31));
             return sequence_;
         }
+        /*! fills the next <tt>points</tt> integer sequences, stored
+            point after point; i.e., dimension \f$ d \f$ of the
+            \f$ i \f$-th point is written at offset
+            <tt>i*dimension()+d</tt>.  The result is the same as for
+            <tt>points</tt> calls to nextInt32Sequence(), but the
+            Gray-code updates run over a contiguous table of direction
+            integers so that they can be vectorized across dimensions.
+        */
+        void nextInt32Sequences(Size points, std::uint32_t* out) const;
+        /*! fills the next <tt>points</tt> sequences normalized to
+            (0,1), stored as in nextInt32Sequences(); lastSequence()
+            returns the last of them afterwards.  InverseCumulativeRsg
+            draws its uniform deviates through this method.
+        */
+        void nextSequences(Size points, Real* out) const;
         const sample_type& lastSequence() const { return sequence_; }
         Size dimension() const { return dimensionality_; }
       private:
+        const std::vector<std::uint32_t>& nextBlockInt32Sequence() const;
         Size dimensionality_;
         mutable std::uint32_t sequenceCounter_ = 0;
         mutable bool firstDraw_ = true;
@@ -148,8 +166,64 @@ namespace QuantLib {
         mutable std::vector<std::uint32_t> integerSequence_;
         std::vector<std::vector<std::uint32_t>> directionIntegers_;
         bool useGrayCode_;
+        // direction integers stored bit by bit, built on first use
+        mutable std::vector<std::uint32_t> blockDirectionIntegers_;
     };
 
+
+    // inline definitions
+
+    inline const std::vector<std::uint32_t>&
+    SobolRsg::nextBlockInt32Sequence() const {
+        if (!useGrayCode_ || firstDraw_)
+            return nextInt32Sequence();
+
+        if (blockDirectionIntegers_.empty()) {
+            const Size bits = directionIntegers_.front().size();
+            blockDirectionIntegers_.resize(bits*dimensionality_);
+            for (Size k=0; k<dimensionality_; ++k)
+                for (Size j=0; j<bits; ++j)
+                    blockDirectionIntegers_[j*dimensionality_+k] =
+                        directionIntegers_[k][j];
+        }
+
+        ++sequenceCounter_;
+        QL_REQUIRE(sequenceCounter_ != 0, "period exceeded");
+
+        // rightmost zero bit of the counter
+        std::uint32_t n = sequenceCounter_;
+        Size j = 0;
+        while ((n & 1) != 0) {
+            n >>= 1;
+            ++j;
+        }
+
+        const std::uint32_t* v =
+            blockDirectionIntegers_.data() + j*dimensionality_;
+        std::uint32_t* x = integerSequence_.data();
+        for (Size k=0; k<dimensionality_; ++k)
+            x[k] ^= v[k];
+        return integerSequence_;
+    }
+
+    inline void SobolRsg::nextInt32Sequences(Size points,
+                                             std::uint32_t* out) const {
+        for (Size i=0; i<points; ++i, out+=dimensionality_) {
+            const std::vector<std::uint32_t>& v = nextBlockInt32Sequence();
+            std::copy(v.begin(), v.end(), out);
+        }
+    }
+
+    inline void SobolRsg::nextSequences(Size points, Real* out) const {
+        for (Size i=0; i<points; ++i, out+=dimensionality_) {
+            const std::uint32_t* v = nextBlockInt32Sequence().data();
+            for (Size k=0; k<dimensionality_; ++k)
+                out[k] = v[k] * (0.5 / (1UL << 31));
+        }
+        if (points > 0)
+            std::copy(out-dimensionality_, out, sequence_.value.begin());
+    }
+
 }
 
 #endif
@@ -21,6 +21,7 @@
 
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmmeshercomposite.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -39,48 +40,55 @@ namespace QuantLib {
 
     FdmMesherComposite::FdmMesherComposite(
         const ext::shared_ptr<Fdm1dMesher>& mesher)
-    : FdmMesher(getLayoutFromMeshers({mesher})),
-      mesher_({mesher}) {
-    }
+    : FdmMesherComposite(getLayoutFromMeshers({mesher}), {mesher}) {}
 
 
     FdmMesherComposite::FdmMesherComposite(
         const ext::shared_ptr<Fdm1dMesher>& m1,
         const ext::shared_ptr<Fdm1dMesher>& m2)
-    : FdmMesher(getLayoutFromMeshers({m1, m2})),
-      mesher_({m1, m2}) {
-    }
+    : FdmMesherComposite(getLayoutFromMeshers({m1, m2}), {m1, m2}) {}
 
     FdmMesherComposite::FdmMesherComposite(
         const ext::shared_ptr<Fdm1dMesher>& m1,
         const ext::shared_ptr<Fdm1dMesher>& m2,
         const ext::shared_ptr<Fdm1dMesher>& m3)
-    : FdmMesher(getLayoutFromMeshers({m1, m2, m3})),
-      mesher_({m1, m2, m3}) {
-    }
+    : FdmMesherComposite(getLayoutFromMeshers({m1, m2, m3}), {m1, m2, m3}) {}
 
     FdmMesherComposite::FdmMesherComposite(
         const ext::shared_ptr<Fdm1dMesher>& m1,
         const ext::shared_ptr<Fdm1dMesher>& m2,
         const ext::shared_ptr<Fdm1dMesher>& m3,
         const ext::shared_ptr<Fdm1dMesher>& m4)
-    : FdmMesher(getLayoutFromMeshers({m1, m2, m3, m4})),
-      mesher_({m1, m2, m3, m4}) {
-    }
+    : FdmMesherComposite(getLayoutFromMeshers({m1, m2, m3, m4}), {m1, m2, m3, m4}) {}
 
     FdmMesherComposite::FdmMesherComposite(
         const std::vector<ext::shared_ptr<Fdm1dMesher> > & mesher)
-    : FdmMesher(getLayoutFromMeshers(mesher)), mesher_(mesher) {
-    }
+    : FdmMesherComposite(getLayoutFromMeshers(mesher), mesher) {}
 
     FdmMesherComposite::FdmMesherComposite(
         const ext::shared_ptr<FdmLinearOpLayout>& layout,
         const std::vector<ext::shared_ptr<Fdm1dMesher> > & mesher)
-    : FdmMesher(layout), mesher_(mesher) {
+    : FdmMesher(layout), mesher_(mesher), locations_(mesher.size()) {
         for (Size i=0; i < mesher.size(); ++i) {
             QL_REQUIRE(mesher[i]->size() == layout->dim()[i],
                        "size of 1d mesher " << i << " does not fit to layout");
         }
+
+        // index = block + k*stride + j with j < stride, where block
+        // runs over the multiples of n*stride
+        const Size size = layout->size();
+        for (Size i=0; i < mesher.size(); ++i) {
+            const std::vector<Real>& x = mesher[i]->locations();
+            const Size n = layout->dim()[i];
+            const Size stride = layout->spacing()[i];
+
+            Array& locations = locations_[i];
+            locations.resize(size);
+            for (Size block=0; block < size; block += n*stride)
+                for (Size k=0; k < n; ++k)
+                    std::fill_n(locations.begin() + block + k*stride,
+                                stride, x[k]);
+        }
     }
 
     Real FdmMesherComposite::dplus(const FdmLinearOpIterator& iter,
@@ -99,14 +107,7 @@ namespace QuantLib {
     }
 
     Array FdmMesherComposite::locations(Size direction) const {
-        Array retVal(layout_->size());
-
-        for (const auto& iter : *layout_) {
-            retVal[iter.index()] =
-                mesher_[direction]->locations()[iter.coordinates()[direction]];
-        }
-
-        return retVal;
+        return locations_[direction];
     }
 
     const std::vector<ext::shared_ptr<Fdm1dMesher> >&
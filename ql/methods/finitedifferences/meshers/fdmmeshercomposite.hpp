@@ -64,6 +64,8 @@ namespace QuantLib {
 
       private:
         const std::vector<ext::shared_ptr<Fdm1dMesher> > mesher_;
+        // grid locations of all points, precomputed per direction
+        std::vector<Array> locations_;
     };
 }
 
@@ -70,9 +70,7 @@ namespace QuantLib {
 
         if (localVol1_ != nullptr) {
             Array vol1(mesher_->layout()->size()), vol2(mesher_->layout()->size());
-            for (const auto& iter : *mesher_->layout()) {
-                const Size i = iter.index();
-
+            for (Size i=0; i < vol1.size(); ++i) {
                 if (illegalLocalVolOverwrite_ < 0.0) {
                     vol1[i] = localVol1_->localVol(0.5*(t1+t2), x_[i], true);
                     vol2[i] = localVol2_->localVol(0.5*(t1+t2), y_[i], true);
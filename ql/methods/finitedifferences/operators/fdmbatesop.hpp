@@ -52,6 +52,13 @@ namespace QuantLib {
         Array solve_splitting(Size direction, const Array& r, Real s) const override;
         Array preconditioner(const Array& r, Real s) const override;
 
+        void apply_into(const Array& r, Array& out) const override;
+        void apply_mixed_into(const Array& r, Array& out) const override;
+        void apply_direction_into(Size direction,
+                                  const Array& r, Array& out) const override;
+        void solve_splitting_into(Size direction, const Array& r,
+                                  Real s, Array& out) const override;
+
         std::vector<SparseMatrix> toMatrixDecomp() const override;
 
       private:
@@ -112,6 +119,30 @@ namespace QuantLib {
                                             Real s) const {
         return hestonOp_->preconditioner(r, s);
     }
+
+    inline void FdmBatesOp::apply_into(const Array& r, Array& out) const {
+        hestonOp_->apply_into(r, out);
+        out += integro(r);
+    }
+
+    inline void FdmBatesOp::apply_mixed_into(const Array& r,
+                                             Array& out) const {
+        hestonOp_->apply_mixed_into(r, out);
+        out += integro(r);
+    }
+
+    inline void FdmBatesOp::apply_direction_into(Size direction,
+                                                 const Array& r,
+                                                 Array& out) const {
+        hestonOp_->apply_direction_into(direction, r, out);
+    }
+
+    inline void FdmBatesOp::solve_splitting_into(Size direction,
+                                                 const Array& r,
+                                                 Real s,
+                                                 Array& out) const {
+        hestonOp_->solve_splitting_into(direction, r, s, out);
+    }
     
 }
 
@@ -54,9 +54,7 @@ namespace QuantLib {
 
         if (localVol_ != nullptr) {
             Array v(mesher_->layout()->size());
-            for (const auto& iter : *mesher_->layout()) {
-                const Size i = iter.index();
-
+            for (Size i=0; i < v.size(); ++i) {
                 if (illegalLocalVolOverwrite_ < 0.0) {
                     v[i] = squared(localVol_->localVol(0.5*(t1+t2), x_[i], true));
                 }
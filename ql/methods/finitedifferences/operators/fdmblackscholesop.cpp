@@ -54,9 +54,7 @@ namespace QuantLib {
 
         if (localVol_ != nullptr) {
             Array v(mesher_->layout()->size());
-            for (const auto& iter : *mesher_->layout()) {
-                const Size i = iter.index();
-
+            for (Size i=0; i < v.size(); ++i) {
                 if (illegalLocalVolOverwrite_ < 0.0) {
                     v[i] = squared(localVol_->localVol(0.5*(t1+t2), x_[i], true));
                 }
@@ -130,8 +128,44 @@ namespace QuantLib {
         return solve_splitting(direction_, r, dt);
     }
 
+    void FdmBlackScholesOp::apply_into(const Array& u, Array& out) const {
+        mapT_.apply_into(u, out);
+    }
+
+    void FdmBlackScholesOp::apply_mixed_into(const Array& r,
+                                             Array& out) const {
+        out.resize(r.size());
+        std::fill(out.begin(), out.end(), 0.0);
+    }
+
+    void FdmBlackScholesOp::apply_direction_into(Size direction,
+                                                 const Array& r,
+                                                 Array& out) const {
+        if (direction == direction_) {
+            mapT_.apply_into(r, out);
+        }
+        else {
+            out.resize(r.size());
+            std::fill(out.begin(), out.end(), 0.0);
+        }
+    }
+
+    void FdmBlackScholesOp::solve_splitting_into(Size direction,
+                                                 const Array& r,
+                                                 Real dt,
+                                                 Array& out) const {
+        if (direction == direction_)
+            mapT_.solve_splitting_into(r, dt, 1.0, out);
+        else if (&out != &r)
+            out = r;
+    }
+
     std::vector<SparseMatrix> FdmBlackScholesOp::toMatrixDecomp() const {
         return std::vector<SparseMatrix>(1, mapT_.toMatrix());
     }
 
+    std::vector<CsrMatrix> FdmBlackScholesOp::toCsrMatrixDecomp() const {
+        return std::vector<CsrMatrix>(1, mapT_.toCsrMatrix());
+    }
+
 }
@@ -106,6 +106,44 @@ namespace QuantLib {
         return solve_splitting(direction1_, r, dt);
     }
 
+    void FdmG2Op::apply_into(const Array& r, Array& out) const {
+        corrMap_.apply_into(r, out);
+        mapX_.apply_into(r, out, true);
+        mapY_.apply_into(r, out, true);
+    }
+
+    void FdmG2Op::apply_mixed_into(const Array& r, Array& out) const {
+        corrMap_.apply_into(r, out);
+    }
+
+    void FdmG2Op::apply_direction_into(Size direction,
+                                       const Array& r, Array& out) const {
+        if (direction == direction1_) {
+            mapX_.apply_into(r, out);
+        }
+        else if (direction == direction2_) {
+            mapY_.apply_into(r, out);
+        }
+        else {
+            out.resize(r.size());
+            std::fill(out.begin(), out.end(), 0.0);
+        }
+    }
+
+    void FdmG2Op::solve_splitting_into(Size direction, const Array& r,
+                                       Real a, Array& out) const {
+        if (direction == direction1_) {
+            mapX_.solve_splitting_into(r, a, 1.0, out);
+        }
+        else if (direction == direction2_) {
+            mapY_.solve_splitting_into(r, a, 1.0, out);
+        }
+        else {
+            out.resize(r.size());
+            std::fill(out.begin(), out.end(), 0.0);
+        }
+    }
+
     std::vector<SparseMatrix> FdmG2Op::toMatrixDecomp() const {
         return {
             mapX_.toMatrix(),
@@ -141,6 +141,47 @@ namespace QuantLib {
         return solve_splitting(0, r, dt);
     }
 
+    void FdmHestonHullWhiteOp::apply_into(const Array& u, Array& out) const {
+        hullWhiteOp_.apply_into(u, out);
+        dyMap_.apply_into(u, out, true);
+        dxMap_.getMap().apply_into(u, out, true);
+        hestonCorrMap_.apply_into(u, out, true);
+        equityIrCorrMap_.apply_into(u, out, true);
+    }
+
+    void FdmHestonHullWhiteOp::apply_mixed_into(const Array& r,
+                                                Array& out) const {
+        hestonCorrMap_.apply_into(r, out);
+        equityIrCorrMap_.apply_into(r, out, true);
+    }
+
+    void FdmHestonHullWhiteOp::apply_direction_into(Size direction,
+                                                    const Array& r,
+                                                    Array& out) const {
+        if (direction == 0)
+            dxMap_.getMap().apply_into(r, out);
+        else if (direction == 1)
+            dyMap_.apply_into(r, out);
+        else if (direction == 2)
+            hullWhiteOp_.apply_into(r, out);
+        else
+            QL_FAIL("direction too large");
+    }
+
+    void FdmHestonHullWhiteOp::solve_splitting_into(Size direction,
+                                                    const Array& r,
+                                                    Real a,
+                                                    Array& out) const {
+        if (direction == 0)
+            dxMap_.getMap().solve_splitting_into(r, a, 1.0, out);
+        else if (direction == 1)
+            dyMap_.solve_splitting_into(r, a, 1.0, out);
+        else if (direction == 2)
+            hullWhiteOp_.solve_splitting_into(2, r, a, out);
+        else
+            QL_FAIL("direction too large");
+    }
+
     std::vector<SparseMatrix> FdmHestonHullWhiteOp::toMatrixDecomp() const {
         return {
             dxMap_.getMap().toMatrix(),
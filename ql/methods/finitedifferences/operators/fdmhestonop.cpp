@@ -49,12 +49,26 @@ namespace QuantLib {
             }
         }
         volatilityValues_ = Sqrt(2*varianceValues_);
+        L_ = Array(mesher_->layout()->size(), 1.0);
     }
 
     void FdmHestonEquityPart::setTime(Time t1, Time t2) {
         const Rate r = rTS_->forwardRate(t1, t2, Continuous).rate();
         const Rate q = qTS_->forwardRate(t1, t2, Continuous).rate();
 
+        if (!leverageFct_) {
+            // L_ is identically one, no need to rescale the operators
+            if (quantoHelper_ != nullptr) {
+                mapT_.axpyb(r - q - varianceValues_
+                    - quantoHelper_->quantoAdjustment(volatilityValues_, t1, t2),
+                    dxMap_, dxxMap_, Array(1, -0.5*r));
+            } else {
+                mapT_.axpyb(r - q - varianceValues_, dxMap_, dxxMap_,
+                            Array(1, -0.5*r));
+            }
+            return;
+        }
+
         L_ = getLeverageFctSlice(t1, t2);
         const Array Lsquare = L_*L_;
 
@@ -185,6 +199,39 @@ namespace QuantLib {
         return solve_splitting(1, solve_splitting(0, r, dt), dt) ;
     }
 
+    void FdmHestonOp::apply_into(const Array& u, Array& out) const {
+        correlationMap_.apply_into(u, out);
+        out *= dxMap_.getL();
+        dxMap_.getMap().apply_into(u, out, true);
+        dyMap_.getMap().apply_into(u, out, true);
+    }
+
+    void FdmHestonOp::apply_mixed_into(const Array& r, Array& out) const {
+        correlationMap_.apply_into(r, out);
+        out *= dxMap_.getL();
+    }
+
+    void FdmHestonOp::apply_direction_into(Size direction,
+                                           const Array& r,
+                                           Array& out) const {
+        if (direction == 0)
+            dxMap_.getMap().apply_into(r, out);
+        else if (direction == 1)
+            dyMap_.getMap().apply_into(r, out);
+        else
+            QL_FAIL("direction too large");
+    }
+
+    void FdmHestonOp::solve_splitting_into(Size direction, const Array& r,
+                                           Real a, Array& out) const {
+        if (direction == 0)
+            dxMap_.getMap().solve_splitting_into(r, a, 1.0, out);
+        else if (direction == 1)
+            dyMap_.getMap().solve_splitting_into(r, a, 1.0, out);
+        else
+            QL_FAIL("direction too large");
+    }
+
     std::vector<SparseMatrix> FdmHestonOp::toMatrixDecomp() const {
         return {
             dxMap_.getMap().toMatrix(),
@@ -193,4 +240,12 @@ namespace QuantLib {
         };
     }
 
+    std::vector<CsrMatrix> FdmHestonOp::toCsrMatrixDecomp() const {
+        return {
+            dxMap_.getMap().toCsrMatrix(),
+            dyMap_.getMap().toCsrMatrix(),
+            correlationMap_.toCsrMatrix()
+        };
+    }
+
 }
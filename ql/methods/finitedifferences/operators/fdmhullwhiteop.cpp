@@ -85,6 +85,40 @@ namespace QuantLib {
         return solve_splitting(direction_, r, dt);
     }
 
+    void FdmHullWhiteOp::apply_into(const Array& r, Array& out) const {
+        mapT_.apply_into(r, out);
+    }
+
+    void FdmHullWhiteOp::apply_mixed_into(const Array& r, Array& out) const {
+        out.resize(r.size());
+        std::fill(out.begin(), out.end(), 0.0);
+    }
+
+    void FdmHullWhiteOp::apply_direction_into(Size direction,
+                                              const Array& r,
+                                              Array& out) const {
+        if (direction == direction_) {
+            mapT_.apply_into(r, out);
+        }
+        else {
+            out.resize(r.size());
+            std::fill(out.begin(), out.end(), 0.0);
+        }
+    }
+
+    void FdmHullWhiteOp::solve_splitting_into(Size direction,
+                                              const Array& r,
+                                              Real a,
+                                              Array& out) const {
+        if (direction == direction_) {
+            mapT_.solve_splitting_into(r, a, 1.0, out);
+        }
+        else {
+            out.resize(r.size());
+            std::fill(out.begin(), out.end(), 0.0);
+        }
+    }
+
     std::vector<SparseMatrix> FdmHullWhiteOp::toMatrixDecomp() const {
         return std::vector<SparseMatrix>(1, mapT_.toMatrix());
     }
@@ -27,6 +27,7 @@
 #define quantlib_fdm_linear_op_hpp
 
 #include <ql/math/array.hpp>
+#include <ql/math/matrixutilities/csrmatrix.hpp>
 #include <ql/math/matrixutilities/sparsematrix.hpp>
 
 namespace QuantLib {
@@ -38,6 +39,9 @@ namespace QuantLib {
         virtual array_type apply(const array_type& r) const = 0;
 
         virtual SparseMatrix toMatrix() const = 0;
+
+        //! compressed-row representation, converted from toMatrix() by default
+        virtual CsrMatrix toCsrMatrix() const { return CsrMatrix(toMatrix()); }
     };
 }
 
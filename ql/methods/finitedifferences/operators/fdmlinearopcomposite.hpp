@@ -26,6 +26,7 @@
 #ifndef quantlib_fdm_affine_map_composite_hpp
 #define quantlib_fdm_affine_map_composite_hpp
 
+#include <ql/math/matrixutilities/csrmatrix.hpp>
 #include <ql/math/matrixutilities/sparsematrix.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearop.hpp>
 #include <numeric>
@@ -45,14 +46,47 @@ namespace QuantLib {
         virtual Array solve_splitting(Size direction, const Array& r, Real s) const = 0;
         virtual Array preconditioner(const Array& r, Real s) const = 0;
 
+        /*! \name In-place interface
+            The following methods write their result into a
+            caller-provided array, which is resized if needed and
+            must not be the same as the input.  By keeping the output
+            arrays across time steps, schemes avoid a memory
+            allocation per operation.  The default implementations
+            forward to the methods above.
+        */
+        //@{
+        virtual void apply_into(const Array& r, Array& out) const {
+            out = apply(r);
+        }
+        virtual void apply_mixed_into(const Array& r, Array& out) const {
+            out = apply_mixed(r);
+        }
+        virtual void apply_direction_into(Size direction,
+                                          const Array& r, Array& out) const {
+            out = apply_direction(direction, r);
+        }
+        virtual void solve_splitting_into(Size direction, const Array& r,
+                                          Real s, Array& out) const {
+            out = solve_splitting(direction, r, s);
+        }
+        //@}
+
         virtual std::vector<SparseMatrix> toMatrixDecomp() const {
             QL_FAIL(" ublas representation is not implemented");
         }
 
-        SparseMatrix toMatrix() const override {
+        virtual std::vector<CsrMatrix> toCsrMatrixDecomp() const {
             const std::vector<SparseMatrix> dcmp = toMatrixDecomp();
-            return std::accumulate(dcmp.begin()+1, dcmp.end(),
-                                   SparseMatrix(dcmp.front()));
+            return std::vector<CsrMatrix>(dcmp.begin(), dcmp.end());
+        }
+
+        CsrMatrix toCsrMatrix() const override {
+            const std::vector<CsrMatrix> dcmp = toCsrMatrixDecomp();
+            return std::accumulate(dcmp.begin()+1, dcmp.end(), dcmp.front());
+        }
+
+        SparseMatrix toMatrix() const override {
+            return toCsrMatrix().toSparseMatrix();
         }
 
     };
@@ -65,6 +65,31 @@ namespace QuantLib {
         return myIndex + coorOffset1*spacing_[i1]+coorOffset2*spacing_[i2];
     }
 
+    void FdmLinearOpLayout::neighbourhoods(Size i, Integer offset,
+                                           Size* out) const {
+        const Size n = dim_[i];
+        const Size stride = spacing_[i];
+
+        // index = block + k*stride + j with j < stride, where block
+        // runs over the multiples of n*stride
+        for (Size block=0; block < size_; block += n*stride) {
+            for (Size k=0; k < n; ++k) {
+                Integer coorOffset = Integer(k)+offset;
+                if (coorOffset < 0) {
+                    coorOffset=-coorOffset;
+                }
+                else if (Size(coorOffset) >= n) {
+                    coorOffset = 2*(n-1) - coorOffset;
+                }
+
+                const Size first = block + k*stride;
+                const Size target = block + coorOffset*stride;
+                for (Size j=0; j < stride; ++j)
+                    out[first + j] = target + j;
+            }
+        }
+    }
+
     // smart but sometimes too slow
     FdmLinearOpIterator FdmLinearOpLayout::iter_neighbourhood(
         const FdmLinearOpIterator& iterator, Size i, Integer offset) const {
@@ -75,6 +75,13 @@ namespace QuantLib {
                            Size i1, Integer offset1,
                            Size i2, Integer offset2) const;
 
+        /*! Writes the index of the neighbour at the given offset in
+            direction i of every grid point into out, which must have
+            room for size() elements.  The grid is traversed in blocks
+            of contiguous indices instead of via an iterator.
+        */
+        void neighbourhoods(Size i, Integer offset, Size* out) const;
+
         // smart but sometimes too slow
         FdmLinearOpIterator iter_neighbourhood(
             const FdmLinearOpIterator& iterator, Size i, Integer offset) const;
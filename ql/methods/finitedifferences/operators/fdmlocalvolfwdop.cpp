@@ -43,9 +43,7 @@ namespace QuantLib {
         const Rate q = qTS_->forwardRate(t1, t2, Continuous).rate();
 
         Array v(mesher_->layout()->size());
-        for (const auto& iter : *mesher_->layout()) {
-            const Size i = iter.index();
-
+        for (Size i=0; i < v.size(); ++i) {
             v[i] = squared(localVol_->localVol(0.5*(t1+t2), x_[i], true));
         }
         mapT_.axpyb(Array(1, 1.0), dxMap_.multR(- r + q + 0.5*v),
@@ -0,0 +1,136 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/methods/finitedifferences/operators/fdmmultipayoffop.hpp>
+#include <algorithm>
+#include <utility>
+
+namespace QuantLib {
+
+    FdmMultiPayoffOp::FdmMultiPayoffOp(
+        const ext::shared_ptr<FdmLinearOpComposite>& op, Size nPayoffs)
+    : FdmMultiPayoffOp(
+          std::vector<ext::shared_ptr<FdmLinearOpComposite> >(nPayoffs, op)) {}
+
+    FdmMultiPayoffOp::FdmMultiPayoffOp(
+        std::vector<ext::shared_ptr<FdmLinearOpComposite> > ops)
+    : ops_(std::move(ops)), nPayoffs_(ops_.size()) {
+        QL_REQUIRE(nPayoffs_ > 0, "at least one payoff required");
+        for (const auto& op : ops_) {
+            QL_REQUIRE(op, "null operator given");
+            QL_REQUIRE(op->size() == ops_.front()->size(),
+                       "operators of different dimensions given");
+            if (std::find(distinctOps_.begin(), distinctOps_.end(), op)
+                    == distinctOps_.end())
+                distinctOps_.push_back(op);
+        }
+    }
+
+    Size FdmMultiPayoffOp::size() const {
+        return ops_.front()->size();
+    }
+
+    void FdmMultiPayoffOp::setTime(Time t1, Time t2) {
+        for (const auto& op : distinctOps_)
+            op->setTime(t1, t2);
+    }
+
+    template <class F>
+    void FdmMultiPayoffOp::applyToPayoffs(const Array& r, Array& out,
+                                          const F& f) const {
+        QL_REQUIRE(r.size() % nPayoffs_ == 0,
+                   "array size " << r.size()
+                   << " is not a multiple of the number of payoffs "
+                   << nPayoffs_);
+
+        const Size n = r.size()/nPayoffs_;
+        in_.resize(n);
+        out.resize(r.size());
+
+        for (Size i=0; i < nPayoffs_; ++i) {
+            std::copy(r.begin() + i*n, r.begin() + (i+1)*n, in_.begin());
+            f(*ops_[i], in_, out_);
+            QL_REQUIRE(out_.size() == n, "inconsistent operator result");
+            std::copy(out_.begin(), out_.end(), out.begin() + i*n);
+        }
+    }
+
+    void FdmMultiPayoffOp::apply_into(const Array& r, Array& out) const {
+        applyToPayoffs(r, out, [](const FdmLinearOpComposite& op,
+                                  const Array& x, Array& y) {
+            op.apply_into(x, y);
+        });
+    }
+
+    void FdmMultiPayoffOp::apply_mixed_into(const Array& r, Array& out) const {
+        applyToPayoffs(r, out, [](const FdmLinearOpComposite& op,
+                                  const Array& x, Array& y) {
+            op.apply_mixed_into(x, y);
+        });
+    }
+
+    void FdmMultiPayoffOp::apply_direction_into(
+        Size direction, const Array& r, Array& out) const {
+        applyToPayoffs(r, out, [&](const FdmLinearOpComposite& op,
+                                   const Array& x, Array& y) {
+            op.apply_direction_into(direction, x, y);
+        });
+    }
+
+    void FdmMultiPayoffOp::solve_splitting_into(
+        Size direction, const Array& r, Real s, Array& out) const {
+        applyToPayoffs(r, out, [&](const FdmLinearOpComposite& op,
+                                   const Array& x, Array& y) {
+            op.solve_splitting_into(direction, x, s, y);
+        });
+    }
+
+    Array FdmMultiPayoffOp::apply(const Array& r) const {
+        Array retVal;
+        apply_into(r, retVal);
+        return retVal;
+    }
+
+    Array FdmMultiPayoffOp::apply_mixed(const Array& r) const {
+        Array retVal;
+        apply_mixed_into(r, retVal);
+        return retVal;
+    }
+
+    Array FdmMultiPayoffOp::apply_direction(Size direction,
+                                            const Array& r) const {
+        Array retVal;
+        apply_direction_into(direction, r, retVal);
+        return retVal;
+    }
+
+    Array FdmMultiPayoffOp::solve_splitting(Size direction,
+                                            const Array& r, Real s) const {
+        Array retVal;
+        solve_splitting_into(direction, r, s, retVal);
+        return retVal;
+    }
+
+    Array FdmMultiPayoffOp::preconditioner(const Array& r, Real s) const {
+        Array retVal;
+        applyToPayoffs(r, retVal, [&](const FdmLinearOpComposite& op,
+                                      const Array& x, Array& y) {
+            y = op.preconditioner(x, s);
+        });
+        return retVal;
+    }
+}
@@ -0,0 +1,72 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdmmultipayoffop.hpp
+    \brief linear operator acting on the values of several payoffs
+*/
+
+#ifndef quantlib_fdm_multi_payoff_op_hpp
+#define quantlib_fdm_multi_payoff_op_hpp
+
+#include <ql/methods/finitedifferences/operators/fdmlinearopcomposite.hpp>
+
+namespace QuantLib {
+
+    //! linear operator acting on the values of several payoffs
+    /*! The argument is the concatenation of the value arrays of all
+        payoffs, i.e. an array on a mesher whose last direction
+        enumerates the payoffs.  Each value array is acted upon by the
+        operator of its payoff.  Payoffs sharing an operator instance
+        share its coefficients, which are thus computed only once per
+        time step.
+    */
+    class FdmMultiPayoffOp : public FdmLinearOpComposite {
+      public:
+        FdmMultiPayoffOp(const ext::shared_ptr<FdmLinearOpComposite>& op,
+                         Size nPayoffs);
+        //! one operator per payoff
+        explicit FdmMultiPayoffOp(
+            std::vector<ext::shared_ptr<FdmLinearOpComposite> > ops);
+
+        Size size() const override;
+        void setTime(Time t1, Time t2) override;
+
+        Array apply(const Array& r) const override;
+        Array apply_mixed(const Array& r) const override;
+        Array apply_direction(Size direction, const Array& r) const override;
+        Array solve_splitting(Size direction, const Array& r, Real s) const override;
+        Array preconditioner(const Array& r, Real s) const override;
+
+        void apply_into(const Array& r, Array& out) const override;
+        void apply_mixed_into(const Array& r, Array& out) const override;
+        void apply_direction_into(Size direction,
+                                  const Array& r, Array& out) const override;
+        void solve_splitting_into(Size direction, const Array& r,
+                                  Real s, Array& out) const override;
+
+      private:
+        template <class F>
+        void applyToPayoffs(const Array& r, Array& out, const F& f) const;
+
+        const std::vector<ext::shared_ptr<FdmLinearOpComposite> > ops_;
+        std::vector<ext::shared_ptr<FdmLinearOpComposite> > distinctOps_;
+        const Size nPayoffs_;
+        mutable Array in_, out_;
+    };
+}
+
+#endif
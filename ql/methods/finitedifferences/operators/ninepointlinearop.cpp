@@ -53,22 +53,26 @@ namespace QuantLib {
             && d1_ < mesher->layout()->dim().size(),
             "inconsistent derivative directions");
 
-        for (const auto& iter : *mesher->layout()) {
-            const Size i = iter.index();
-
-            i10_[i] = mesher->layout()->neighbourhood(iter, d1_, -1);
-            i01_[i] = mesher->layout()->neighbourhood(iter, d0_, -1);
-            i21_[i] = mesher->layout()->neighbourhood(iter, d0_,  1);
-            i12_[i] = mesher->layout()->neighbourhood(iter, d1_,  1);
-            i00_[i] = mesher->layout()->neighbourhood(iter, d0_, -1, d1_, -1);
-            i20_[i] = mesher->layout()->neighbourhood(iter, d0_,  1, d1_, -1);
-            i02_[i] = mesher->layout()->neighbourhood(iter, d0_, -1, d1_,  1);
-            i22_[i] = mesher->layout()->neighbourhood(iter, d0_,  1, d1_,  1);
+        const ext::shared_ptr<FdmLinearOpLayout>& layout = mesher->layout();
+        layout->neighbourhoods(d1_, -1, i10_.get());
+        layout->neighbourhoods(d0_, -1, i01_.get());
+        layout->neighbourhoods(d0_,  1, i21_.get());
+        layout->neighbourhoods(d1_,  1, i12_.get());
+
+        // the diagonal neighbours are the neighbours in direction d1
+        // of the neighbours in direction d0
+        const Size size = layout->size();
+        for (Size i=0; i < size; ++i) {
+            i00_[i] = i10_[i01_[i]];
+            i20_[i] = i10_[i21_[i]];
+            i02_[i] = i12_[i01_[i]];
+            i22_[i] = i12_[i21_[i]];
         }
     }
 
     NinePointLinearOp::NinePointLinearOp(const NinePointLinearOp& m)
-    : i00_(new Size[m.mesher_->layout()->size()]),
+    : d0_(m.d0_), d1_(m.d1_),
+      i00_(new Size[m.mesher_->layout()->size()]),
       i10_(new Size[m.mesher_->layout()->size()]),
       i20_(new Size[m.mesher_->layout()->size()]),
       i01_(new Size[m.mesher_->layout()->size()]),
@@ -108,11 +112,24 @@ namespace QuantLib {
     }
 
     Array NinePointLinearOp::apply(const Array& u) const {
+        Array retVal(u.size());
+        apply_into(u, retVal);
+        return retVal;
+    }
+
+    void NinePointLinearOp::apply_into(const Array& u, Array& retVal,
+                                       bool add) const {
 
         QL_REQUIRE(u.size() == mesher_->layout()->size(),"inconsistent length of r "
                     << u.size() << " vs " << mesher_->layout()->size());
+        QL_REQUIRE(&u != &retVal, "input and output must be different arrays");
+
+        if (add)
+            QL_REQUIRE(retVal.size() == u.size(),
+                       "inconsistent length of output");
+        else
+            retVal.resize(u.size());
 
-        Array retVal(u.size());
         // direct access to make the following code faster.
         const Real *a00(a00_.get()), *a01(a01_.get()), *a02(a02_.get());
         const Real *a10(a10_.get()), *a11(a11_.get()), *a12(a12_.get());
@@ -123,7 +140,8 @@ namespace QuantLib {
 
         //#pragma omp parallel for
         for (Size i=0; i < retVal.size(); ++i) {
-            retVal[i] =   a00[i]*u[i00[i]]
+            retVal[i] =   (add ? retVal[i] : 0.0)
+                        + a00[i]*u[i00[i]]
                         + a01[i]*u[i01[i]]
                         + a02[i]*u[i02[i]]
                         + a10[i]*u[i10[i]]
@@ -133,32 +151,35 @@ namespace QuantLib {
                         + a21[i]*u[i21[i]]
                         + a22[i]*u[i22[i]];
         }
-        return retVal;
     }
 
     SparseMatrix NinePointLinearOp::toMatrix() const {
+        return toCsrMatrix().toSparseMatrix();
+    }
+
+    CsrMatrix NinePointLinearOp::toCsrMatrix() const {
         const Size n = mesher_->layout()->size();
 
-        SparseMatrix retVal(n, n, 9*n);
-        for (Size i=0; i < mesher_->layout()->size(); ++i) {
-            retVal(i, i00_[i]) += a00_[i];
-            retVal(i, i01_[i]) += a01_[i];
-            retVal(i, i02_[i]) += a02_[i];
-            retVal(i, i10_[i]) += a10_[i];
-            retVal(i, i      ) += a11_[i];
-            retVal(i, i12_[i]) += a12_[i];
-            retVal(i, i20_[i]) += a20_[i];
-            retVal(i, i21_[i]) += a21_[i];
-            retVal(i, i22_[i]) += a22_[i];
+        CsrMatrix::Builder builder(n, n, 9*n);
+        for (Size i=0; i < n; ++i) {
+            builder.add(i, i00_[i], a00_[i]);
+            builder.add(i, i01_[i], a01_[i]);
+            builder.add(i, i02_[i], a02_[i]);
+            builder.add(i, i10_[i], a10_[i]);
+            builder.add(i, i,       a11_[i]);
+            builder.add(i, i12_[i], a12_[i]);
+            builder.add(i, i20_[i], a20_[i]);
+            builder.add(i, i21_[i], a21_[i]);
+            builder.add(i, i22_[i], a22_[i]);
         }
 
-        return retVal;
+        return builder.build();
     }
 
 
     NinePointLinearOp NinePointLinearOp::mult(const Array & u) const {
 
-        NinePointLinearOp retVal(d0_, d1_, mesher_);
+        NinePointLinearOp retVal(*this);
         const Size size = mesher_->layout()->size();
 
         //#pragma omp parallel for
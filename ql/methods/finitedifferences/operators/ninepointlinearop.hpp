@@ -45,11 +45,16 @@ namespace QuantLib {
         ~NinePointLinearOp() override = default;
 
         Array apply(const Array& r) const override;
+        /*! writes the result into out, which must not be the same
+            array as r; if add is true, the result is added to the
+            previous content of out. */
+        void apply_into(const Array& r, Array& out, bool add = false) const;
         NinePointLinearOp mult(const Array& u) const;
 
         void swap(NinePointLinearOp& m) noexcept;
 
         SparseMatrix toMatrix() const override;
+        CsrMatrix toCsrMatrix() const override;
 
       protected:
         NinePointLinearOp() = default;
@@ -24,6 +24,8 @@
 #include <ql/methods/finitedifferences/tridiagonaloperator.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
 #include <ql/methods/finitedifferences/operators/triplebandlinearop.hpp>
+#include <algorithm>
+#include <vector>
 
 namespace QuantLib {
 
@@ -33,36 +35,18 @@ namespace QuantLib {
     : direction_(direction),
       i0_       (new Size[mesher->layout()->size()]),
       i2_       (new Size[mesher->layout()->size()]),
-      reverseIndex_ (new Size[mesher->layout()->size()]),
       lower_    (new Real[mesher->layout()->size()]),
       diag_     (new Real[mesher->layout()->size()]),
       upper_    (new Real[mesher->layout()->size()]),
       mesher_(mesher) {
-
-        std::vector<Size> newDim(mesher->layout()->dim());
-        std::iter_swap(newDim.begin(), newDim.begin()+direction_);
-        std::vector<Size> newSpacing = FdmLinearOpLayout(newDim).spacing();
-        std::iter_swap(newSpacing.begin(), newSpacing.begin()+direction_);
-
-        for (const auto& iter : *mesher->layout()) {
-            const Size i = iter.index();
-
-            i0_[i] = mesher->layout()->neighbourhood(iter, direction, -1);
-            i2_[i] = mesher->layout()->neighbourhood(iter, direction,  1);
-
-            const std::vector<Size>& coordinates = iter.coordinates();
-            const Size newIndex =
-                  std::inner_product(coordinates.begin(), coordinates.end(),
-                                     newSpacing.begin(), Size(0));
-            reverseIndex_[newIndex] = i;
-        }
+        mesher->layout()->neighbourhoods(direction, -1, i0_.get());
+        mesher->layout()->neighbourhoods(direction,  1, i2_.get());
     }
 
     TripleBandLinearOp::TripleBandLinearOp(const TripleBandLinearOp& m)
     : direction_(m.direction_),
       i0_   (new Size[m.mesher_->layout()->size()]),
       i2_   (new Size[m.mesher_->layout()->size()]),
-      reverseIndex_(new Size[m.mesher_->layout()->size()]),
       lower_(new Real[m.mesher_->layout()->size()]),
       diag_ (new Real[m.mesher_->layout()->size()]),
       upper_(new Real[m.mesher_->layout()->size()]),
@@ -70,8 +54,6 @@ namespace QuantLib {
         const Size len = m.mesher_->layout()->size();
         std::copy(m.i0_.get(), m.i0_.get() + len, i0_.get());
         std::copy(m.i2_.get(), m.i2_.get() + len, i2_.get());
-        std::copy(m.reverseIndex_.get(), m.reverseIndex_.get()+len,
-                  reverseIndex_.get());
         std::copy(m.lower_.get(), m.lower_.get() + len, lower_.get());
         std::copy(m.diag_.get(),  m.diag_.get() + len,  diag_.get());
         std::copy(m.upper_.get(), m.upper_.get() + len, upper_.get());
@@ -82,7 +64,6 @@ namespace QuantLib {
         std::swap(direction_, m.direction_);
 
         i0_.swap(m.i0_); i2_.swap(m.i2_);
-        reverseIndex_.swap(m.reverseIndex_);
         lower_.swap(m.lower_); diag_.swap(m.diag_); upper_.swap(m.upper_);
     }
 
@@ -159,7 +140,7 @@ namespace QuantLib {
 
     TripleBandLinearOp TripleBandLinearOp::add(const TripleBandLinearOp& m) const {
 
-        TripleBandLinearOp retVal(direction_, mesher_);
+        TripleBandLinearOp retVal(*this);
         const Size size = mesher_->layout()->size();
         //#pragma omp parallel for
         for (Size i=0; i < size; ++i) {
@@ -174,7 +155,7 @@ namespace QuantLib {
 
     TripleBandLinearOp TripleBandLinearOp::mult(const Array& u) const {
 
-        TripleBandLinearOp retVal(direction_, mesher_);
+        TripleBandLinearOp retVal(*this);
 
         const Size size = mesher_->layout()->size();
         //#pragma omp parallel for
@@ -191,7 +172,7 @@ namespace QuantLib {
     TripleBandLinearOp TripleBandLinearOp::multR(const Array& u) const {
         const Size size = mesher_->layout()->size();
         QL_REQUIRE(u.size() == size, "inconsistent size of rhs");
-        TripleBandLinearOp retVal(direction_, mesher_);
+        TripleBandLinearOp retVal(*this);
 
         #pragma omp parallel for
         for (long i=0; i < (long)size; ++i) {
@@ -208,7 +189,7 @@ namespace QuantLib {
 
     TripleBandLinearOp TripleBandLinearOp::add(const Array& u) const {
 
-        TripleBandLinearOp retVal(direction_, mesher_);
+        TripleBandLinearOp retVal(*this);
 
         const Size size = mesher_->layout()->size();
         //#pragma omp parallel for
@@ -222,7 +203,16 @@ namespace QuantLib {
     }
 
     Array TripleBandLinearOp::apply(const Array& r) const {
-        QL_REQUIRE(r.size() == mesher_->layout()->size(), "inconsistent length of r");
+        array_type retVal(r.size());
+        apply_into(r, retVal);
+        return retVal;
+    }
+
+    void TripleBandLinearOp::apply_into(const Array& r, Array& out,
+                                        bool add) const {
+        const Size size = mesher_->layout()->size();
+        QL_REQUIRE(r.size() == size, "inconsistent length of r");
+        QL_REQUIRE(&r != &out, "input and output must be different arrays");
 
         const Real* lptr = lower_.get();
         const Real* dptr = diag_.get();
@@ -230,30 +220,48 @@ namespace QuantLib {
         const Size* i0ptr = i0_.get();
         const Size* i2ptr = i2_.get();
 
-        array_type retVal(r.size());
-        //#pragma omp parallel for
-        for (Size i=0; i < mesher_->layout()->size(); ++i) {
-            retVal[i] = r[i0ptr[i]]*lptr[i]+r[i]*dptr[i]+r[i2ptr[i]]*uptr[i];
+        if (add) {
+            QL_REQUIRE(out.size() == size, "inconsistent length of output");
+            //#pragma omp parallel for
+            for (Size i=0; i < size; ++i) {
+                out[i] += r[i0ptr[i]]*lptr[i]+r[i]*dptr[i]+r[i2ptr[i]]*uptr[i];
+            }
+        }
+        else {
+            out.resize(size);
+            //#pragma omp parallel for
+            for (Size i=0; i < size; ++i) {
+                out[i] = r[i0ptr[i]]*lptr[i]+r[i]*dptr[i]+r[i2ptr[i]]*uptr[i];
+            }
         }
-
-        return retVal;
     }
 
     SparseMatrix TripleBandLinearOp::toMatrix() const {
+        return toCsrMatrix().toSparseMatrix();
+    }
+
+    CsrMatrix TripleBandLinearOp::toCsrMatrix() const {
         const Size n = mesher_->layout()->size();
 
-        SparseMatrix retVal(n, n, 3*n);
+        CsrMatrix::Builder builder(n, n, 3*n);
         for (Size i=0; i < n; ++i) {
-            retVal(i, i0_[i]) += lower_[i];
-            retVal(i, i     ) += diag_[i];
-            retVal(i, i2_[i]) += upper_[i];
+            builder.add(i, i0_[i], lower_[i]);
+            builder.add(i, i,      diag_[i]);
+            builder.add(i, i2_[i], upper_[i]);
         }
 
-        return retVal;
+        return builder.build();
     }
 
 
     Array TripleBandLinearOp::solve_splitting(const Array& r, Real a, Real b) const {
+        Array retVal(r.size());
+        solve_splitting_into(r, a, b, retVal);
+        return retVal;
+    }
+
+    void TripleBandLinearOp::solve_splitting_into(const Array& r, Real a, Real b,
+                                                  Array& retVal) const {
         QL_REQUIRE(r.size() == mesher_->layout()->size(), "inconsistent size of rhs");
 
 #ifdef QL_EXTRA_SAFETY_CHECKS
@@ -266,8 +274,55 @@ namespace QuantLib {
         }
 #endif
 
-        Array retVal(r.size()), tmp(r.size());
+        const Size size = mesher_->layout()->size();
+        const Size n = mesher_->layout()->dim()[direction_];
+        const Size stride = mesher_->layout()->spacing()[direction_];
+
+        // each element of r is read before the element of retVal
+        // with the same index is written, so that they can coincide
+        retVal.resize(size);
+
+        // The tridiagonal systems along the lines of the given
+        // direction are independent.  Lines starting at adjacent
+        // indices are swept together, so that each step of the
+        // Thomas algorithm reads and writes contiguous memory even
+        // if the direction itself is strided; the resulting blocks
+        // of lines are distributed over the available threads.
+        const Size nBlocks = (stride + lineBlockSize - 1)/lineBlockSize;
+        const long nChunks = long(size/(n*stride)*nBlocks);
+        const Size maxLines = std::min(lineBlockSize, stride);
+
+        const Real* rptr = r.begin();
+        Real* xptr = retVal.begin();
+
+        // exceptions must not escape the parallel region
+        long failures = 0;
+        #pragma omp parallel reduction(+:failures) if(nChunks > 1)
+        {
+            // the workspace of the Thomas algorithm is local to each
+            // thread, so that the operator itself holds no state
+            std::vector<Real> tmp(n*maxLines);
+
+            #pragma omp for
+            for (long chunk=0; chunk < nChunks; ++chunk) {
+                const Size block = Size(chunk) % nBlocks;
+                const Size first = Size(chunk)/nBlocks*n*stride
+                    + block*lineBlockSize;
+                const Size nLines =
+                    std::min(lineBlockSize, stride - block*lineBlockSize);
+
+                if (!solveLines(rptr, xptr, tmp.data(),
+                                first, nLines, n, stride, a, b))
+                    ++failures;
+            }
+        }
+        QL_ENSURE(failures == 0, "division by zero");
+    }
 
+    bool TripleBandLinearOp::solveLines(const Real* r, Real* x, Real* tmp,
+                                        Size first, Size nLines,
+                                        Size n, Size stride,
+                                        Real a, Real b) const {
         const Real* lptr = lower_.get();
         const Real* dptr = diag_.get();
         const Real* uptr = upper_.get();
@@ -275,27 +330,39 @@ namespace QuantLib {
         // Thomson algorithm to solve a tridiagonal system.
         // Example code taken from Tridiagonalopertor and
         // changed to fit for the triple band operator.
-        Size rim1 = reverseIndex_[0];
-        Real bet=1.0/(a*dptr[rim1]+b);
-        QL_REQUIRE(bet != 0.0, "division by zero");
-        retVal[reverseIndex_[0]] = r[rim1]*bet;
+        Real bet[lineBlockSize];
+        bool nonSingular = true;
+        for (Size l=0; l < nLines; ++l) {
+            const Size i = first + l;
+            const Real pivot = a*dptr[i]+b;
+            nonSingular &= (pivot != 0.0);
+            bet[l] = 1.0/pivot;
+            x[i] = r[i]*bet[l];
+        }
 
-        for (Size j=1; j<=mesher_->layout()->size()-1; j++){
-            const Size ri = reverseIndex_[j];
-            tmp[j] = a*uptr[rim1]*bet;
+        for (Size k=1; k < n; ++k) {
+            const Size row = first + k*stride;
+            for (Size l=0; l < nLines; ++l) {
+                const Size i = row + l;
+                const Size im1 = i - stride;
+                tmp[k*nLines+l] = a*uptr[im1]*bet[l];
 
-            bet=b+a*(dptr[ri]-tmp[j]*lptr[ri]);
-            QL_ENSURE(bet != 0.0, "division by zero");
-            bet=1.0/bet;
+                const Real pivot = b+a*(dptr[i]-tmp[k*nLines+l]*lptr[i]);
+                nonSingular &= (pivot != 0.0);
+                bet[l] = 1.0/pivot;
 
-            retVal[ri] = (r[ri]-a*lptr[ri]*retVal[rim1])*bet;
-            rim1 = ri;
+                x[i] = (r[i]-a*lptr[i]*x[im1])*bet[l];
+            }
         }
-        // cannot be j>=0 with Size j
-        for (Size j=mesher_->layout()->size()-2; j>0; --j)
-            retVal[reverseIndex_[j]] -= tmp[j+1]*retVal[reverseIndex_[j+1]];
-        retVal[reverseIndex_[0]] -= tmp[1]*retVal[reverseIndex_[1]];
 
-        return retVal;
+        for (Size k=n-1; k > 0; --k) {
+            const Size row = first + (k-1)*stride;
+            for (Size l=0; l < nLines; ++l) {
+                const Size i = row + l;
+                x[i] -= tmp[k*nLines+l]*x[i+stride];
+            }
+        }
+
+        return nonSingular;
     }
 }
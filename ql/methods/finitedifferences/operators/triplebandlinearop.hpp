@@ -48,6 +48,16 @@ namespace QuantLib {
         Array apply(const Array& r) const override;
         Array solve_splitting(const Array& r, Real a, Real b = 1.0) const;
 
+        /*! writes the result into out, which must not be the same
+            array as r; if add is true, the result is added to the
+            previous content of out. */
+        void apply_into(const Array& r, Array& out, bool add = false) const;
+        /*! out can be the same array as r.  The independent systems
+            along the lines of the operator's direction are solved in
+            parallel if OpenMP is enabled. */
+        void solve_splitting_into(const Array& r, Real a, Real b,
+                                  Array& out) const;
+
         TripleBandLinearOp mult(const Array& u) const;
         // interpret u as the diagonal of a diagonal matrix, multiplied on LHS
         TripleBandLinearOp multR(const Array& u) const;
@@ -62,16 +72,24 @@ namespace QuantLib {
         void swap(TripleBandLinearOp& m) noexcept;
 
         SparseMatrix toMatrix() const override;
+        CsrMatrix toCsrMatrix() const override;
 
       protected:
         TripleBandLinearOp() = default;
 
         Size direction_;
         std::unique_ptr<Size[]> i0_, i2_;
-        std::unique_ptr<Size[]> reverseIndex_;
         std::unique_ptr<Real[]> lower_, diag_, upper_;
 
         ext::shared_ptr<FdmMesher> mesher_;
+
+      private:
+        // number of lines swept together by the Thomas algorithm
+        static constexpr Size lineBlockSize = 64;
+
+        bool solveLines(const Real* r, Real* x, Real* tmp,
+                        Size first, Size nLines, Size n, Size stride,
+                        Real a, Real b) const;
     };
 
 
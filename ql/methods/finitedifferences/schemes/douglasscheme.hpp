@@ -54,6 +54,10 @@ namespace QuantLib {
         const Real theta_;
         const ext::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
+
+      private:
+        // workspace kept across steps
+        Array y_, rhs_;
     };
 }
 
@@ -60,6 +60,10 @@ namespace QuantLib {
 
         const ext::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
+    
+      private:
+        // workspace kept across steps
+        Array y_, y0_, yt_, rhs_, diff_;
     };
 }
 
@@ -22,6 +22,7 @@
 #include <ql/functional.hpp>
 #include <ql/math/matrixutilities/bicgstab.hpp>
 #include <ql/math/matrixutilities/gmres.hpp>
+#include <ql/math/matrixutilities/sparseilu0preconditioner.hpp>
 #include <ql/methods/finitedifferences/schemes/impliciteulerscheme.hpp>
 #include <utility>
 
@@ -30,9 +31,11 @@ namespace QuantLib {
     ImplicitEulerScheme::ImplicitEulerScheme(ext::shared_ptr<FdmLinearOpComposite> map,
                                              const bc_set& bcSet,
                                              Real relTol,
-                                             SolverType solverType)
+                                             SolverType solverType,
+                                             PreconditionerType preconditionerType)
     : dt_(Null<Real>()), iterations_(ext::make_shared<Size>(0U)), relTol_(relTol),
-      map_(std::move(map)), bcSet_(bcSet), solverType_(solverType) {}
+      map_(std::move(map)), bcSet_(bcSet), solverType_(solverType),
+      preconditionerType_(preconditionerType) {}
 
     Array ImplicitEulerScheme::apply(const Array& r, Real theta) const {
         return r - (theta*dt_)*map_->apply(r);
@@ -53,8 +56,29 @@ namespace QuantLib {
             a = map_->solve_splitting(0, a, -theta*dt_);
         }
         else {
-            auto preconditioner = [&](const Array& _a){ return map_->preconditioner(_a, -theta*dt_); };
-            auto applyF = [&](const Array& _a){ return apply(_a, theta); };
+            // sparse matrix of the implicit step and its ILU(0) factors
+            CsrMatrix m;
+            ext::shared_ptr<SparseILU0Preconditioner> ilu;
+            if (preconditionerType_ == ILU0) {
+                m = map_->toCsrMatrix();
+                m *= -theta*dt_;
+                m.addToDiagonal(1.0);
+                ilu = ext::make_shared<SparseILU0Preconditioner>(m);
+            }
+
+            const std::function<Array(const Array&)> preconditioner =
+                (ilu != nullptr)
+                ? std::function<Array(const Array&)>(
+                      [&](const Array& _a){ return ilu->apply(_a); })
+                : std::function<Array(const Array&)>(
+                      [&](const Array& _a){
+                          return map_->preconditioner(_a, -theta*dt_); });
+            const std::function<Array(const Array&)> applyF =
+                (ilu != nullptr)
+                ? std::function<Array(const Array&)>(
+                      [&](const Array& _a){ return prod(m, _a); })
+                : std::function<Array(const Array&)>(
+                      [&](const Array& _a){ return apply(_a, theta); });
 
             if (solverType_ == BiCGstab) {
                 const BiCGStabResult result =
@@ -35,6 +35,11 @@ namespace QuantLib {
     class ImplicitEulerScheme {
       public:
         enum SolverType { BiCGstab, GMRES };
+        /*! Splitting uses the operator's preconditioner(), ILU0
+            assembles the sparse matrix of the implicit step after
+            each setTime call and uses its ILU(0) factorization.
+        */
+        enum PreconditionerType { Splitting, ILU0 };
 
         // typedefs
         typedef OperatorTraits<FdmLinearOp> traits;
@@ -47,7 +52,9 @@ namespace QuantLib {
         explicit ImplicitEulerScheme(ext::shared_ptr<FdmLinearOpComposite> map,
                                      const bc_set& bcSet = bc_set(),
                                      Real relTol = 1e-8,
-                                     SolverType solverType = BiCGstab);
+                                     SolverType solverType = BiCGstab,
+                                     PreconditionerType preconditionerType
+                                         = Splitting);
 
         void step(array_type& a, Time t);
         void setStep(Time dt);
@@ -66,6 +73,7 @@ namespace QuantLib {
         const ext::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
         const SolverType solverType_;
+        const PreconditionerType preconditionerType_;
     };
 }
 
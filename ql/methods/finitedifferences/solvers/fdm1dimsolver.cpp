@@ -17,6 +17,7 @@
  FOR A PARTICULAR PURPOSE.  See the license for more details.
 */
 
+#include <ql/math/comparison.hpp>
 #include <ql/math/interpolations/cubicinterpolation.hpp>
 #include <ql/methods/finitedifferences/finitedifferencemodel.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmmesher.hpp>
@@ -31,14 +32,19 @@ namespace QuantLib {
 
     Fdm1DimSolver::Fdm1DimSolver(const FdmSolverDesc& solverDesc,
                                  const FdmSchemeDesc& schemeDesc,
-                                 ext::shared_ptr<FdmLinearOpComposite> op)
+                                 ext::shared_ptr<FdmLinearOpComposite> op,
+                                 std::vector<Time> snapshotTimes)
     : solverDesc_(solverDesc), schemeDesc_(schemeDesc), op_(std::move(op)),
+      snapshotTimes_(std::move(snapshotTimes)),
       thetaCondition_(ext::make_shared<FdmSnapshotCondition>(
           0.99 * std::min(1.0 / 365.0,
                           solverDesc.condition->stoppingTimes().empty() ?
                               solverDesc.maturity :
                               solverDesc.condition->stoppingTimes().front()))),
-      conditions_(FdmStepConditionComposite::joinConditions(thetaCondition_, solverDesc.condition)),
+      snapshots_(fdmSnapshotConditions(snapshotTimes_, solverDesc.maturity)),
+      conditions_(FdmStepConditionComposite::joinConditions(
+          thetaCondition_,
+          FdmStepConditionComposite::joinConditions(snapshots_, solverDesc.condition))),
       x_(solverDesc.mesher->layout()->size()), initialValues_(solverDesc.mesher->layout()->size()),
       resultValues_(solverDesc.mesher->layout()->size()) {
 
@@ -62,6 +68,15 @@ namespace QuantLib {
         std::copy(rhs.begin(), rhs.end(), resultValues_.begin());
         interpolation_ = ext::make_shared<MonotonicCubicNaturalSpline>(x_.begin(), x_.end(),
                                         resultValues_.begin());
+
+        snapshotValues_.resize(snapshots_.size());
+        snapshotInterpolations_.resize(snapshots_.size());
+        for (Size i=0; i < snapshots_.size(); ++i) {
+            snapshotValues_[i] = snapshots_[i]->getValues();
+            snapshotInterpolations_[i] =
+                ext::make_shared<MonotonicCubicNaturalSpline>(
+                    x_.begin(), x_.end(), snapshotValues_[i].begin());
+        }
     }
 
     Real Fdm1DimSolver::interpolateAt(Real x) const {
@@ -94,4 +109,33 @@ namespace QuantLib {
         calculate();
         return interpolation_->secondDerivative(x);
     }
+
+    const std::vector<Time>& Fdm1DimSolver::snapshotTimes() const {
+        return snapshotTimes_;
+    }
+
+    Size Fdm1DimSolver::snapshotIndex(Time t) const {
+        for (Size i=0; i < snapshotTimes_.size(); ++i)
+            if (close_enough(snapshotTimes_[i], t))
+                return i;
+        QL_FAIL("no value grid retained at time " << t);
+    }
+
+    Real Fdm1DimSolver::snapshotAt(Time t, Real x) const {
+        const Size i = snapshotIndex(t);
+        calculate();
+        return (*snapshotInterpolations_[i])(x);
+    }
+
+    Real Fdm1DimSolver::snapshotDerivativeX(Time t, Real x) const {
+        const Size i = snapshotIndex(t);
+        calculate();
+        return snapshotInterpolations_[i]->derivative(x);
+    }
+
+    Real Fdm1DimSolver::snapshotDerivativeXX(Time t, Real x) const {
+        const Size i = snapshotIndex(t);
+        calculate();
+        return snapshotInterpolations_[i]->secondDerivative(x);
+    }
 }
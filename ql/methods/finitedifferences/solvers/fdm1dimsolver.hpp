@@ -39,7 +39,8 @@ namespace QuantLib {
       public:
         Fdm1DimSolver(const FdmSolverDesc& solverDesc,
                       const FdmSchemeDesc& schemeDesc,
-                      ext::shared_ptr<FdmLinearOpComposite> op);
+                      ext::shared_ptr<FdmLinearOpComposite> op,
+                      std::vector<Time> snapshotTimes = std::vector<Time>());
 
         Real interpolateAt(Real x) const;
         Real thetaAt(Real x) const;
@@ -47,20 +48,42 @@ namespace QuantLib {
         Real derivativeX(Real x) const;
         Real derivativeXX(Real x) const;
 
+        /*! \name retained value grids
+            The value grids at the snapshot times given to the
+            constructor are kept after the rollback, hence values and
+            derivatives as seen from these times are available without
+            a further backward solve. Times are measured from the
+            evaluation date, i.e. t = 1/365 returns the solution for
+            the next day under an Actual/365 day counter.
+        */
+        //@{
+        const std::vector<Time>& snapshotTimes() const;
+        Real snapshotAt(Time t, Real x) const;
+        Real snapshotDerivativeX(Time t, Real x) const;
+        Real snapshotDerivativeXX(Time t, Real x) const;
+        //@}
+
       protected:
         void performCalculations() const override;
 
       private:
+        Size snapshotIndex(Time t) const;
+
         const FdmSolverDesc solverDesc_;
         const FdmSchemeDesc schemeDesc_;
         const ext::shared_ptr<FdmLinearOpComposite> op_;
 
+        const std::vector<Time> snapshotTimes_;
         const ext::shared_ptr<FdmSnapshotCondition> thetaCondition_;
+        const std::vector<ext::shared_ptr<FdmSnapshotCondition> > snapshots_;
         const ext::shared_ptr<FdmStepConditionComposite> conditions_;
 
         std::vector<Real> x_, initialValues_;
         mutable Array resultValues_;
         mutable ext::shared_ptr<CubicInterpolation> interpolation_;
+        mutable std::vector<Array> snapshotValues_;
+        mutable std::vector<ext::shared_ptr<CubicInterpolation> >
+            snapshotInterpolations_;
     };
 }
 
@@ -17,6 +17,7 @@
  FOR A PARTICULAR PURPOSE.  See the license for more details.
 */
 
+#include <ql/math/comparison.hpp>
 #include <ql/math/interpolations/bicubicsplineinterpolation.hpp>
 #include <ql/methods/finitedifferences/finitedifferencemodel.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmmesher.hpp>
@@ -31,14 +32,19 @@ namespace QuantLib {
 
     Fdm2DimSolver::Fdm2DimSolver(const FdmSolverDesc& solverDesc,
                                  const FdmSchemeDesc& schemeDesc,
-                                 ext::shared_ptr<FdmLinearOpComposite> op)
+                                 ext::shared_ptr<FdmLinearOpComposite> op,
+                                 std::vector<Time> snapshotTimes)
     : solverDesc_(solverDesc), schemeDesc_(schemeDesc), op_(std::move(op)),
+      snapshotTimes_(std::move(snapshotTimes)),
       thetaCondition_(ext::make_shared<FdmSnapshotCondition>(
           0.99 * std::min(1.0 / 365.0,
                           solverDesc.condition->stoppingTimes().empty() ?
                               solverDesc.maturity :
                               solverDesc.condition->stoppingTimes().front()))),
-      conditions_(FdmStepConditionComposite::joinConditions(thetaCondition_, solverDesc.condition)),
+      snapshots_(fdmSnapshotConditions(snapshotTimes_, solverDesc.maturity)),
+      conditions_(FdmStepConditionComposite::joinConditions(
+          thetaCondition_,
+          FdmStepConditionComposite::joinConditions(snapshots_, solverDesc.condition))),
       initialValues_(solverDesc.mesher->layout()->size()),
       resultValues_(solverDesc.mesher->layout()->dim()[1], solverDesc.mesher->layout()->dim()[0]) {
 
@@ -72,6 +78,18 @@ namespace QuantLib {
         interpolation_ = ext::make_shared<BicubicSpline>(x_.begin(), x_.end(),
                               y_.begin(), y_.end(),
                               resultValues_);
+
+        // the splines refer to the matrices, which must not move anymore
+        snapshotValues_.assign(snapshots_.size(),
+                               Matrix(resultValues_.rows(),
+                                      resultValues_.columns()));
+        snapshotSplines_.resize(snapshots_.size());
+        for (Size i=0; i < snapshots_.size(); ++i) {
+            const Array& values = snapshots_[i]->getValues();
+            std::copy(values.begin(), values.end(), snapshotValues_[i].begin());
+            snapshotSplines_[i] = ext::make_shared<BicubicSpline>(
+                x_.begin(), x_.end(), y_.begin(), y_.end(), snapshotValues_[i]);
+        }
     }
 
     Real Fdm2DimSolver::interpolateAt(Real x, Real y) const {
@@ -120,4 +138,33 @@ namespace QuantLib {
         return interpolation_->derivativeXY(x, y);
     }
 
+    const std::vector<Time>& Fdm2DimSolver::snapshotTimes() const {
+        return snapshotTimes_;
+    }
+
+    Size Fdm2DimSolver::snapshotIndex(Time t) const {
+        for (Size i=0; i < snapshotTimes_.size(); ++i)
+            if (close_enough(snapshotTimes_[i], t))
+                return i;
+        QL_FAIL("no value grid retained at time " << t);
+    }
+
+    Real Fdm2DimSolver::snapshotAt(Time t, Real x, Real y) const {
+        const Size i = snapshotIndex(t);
+        calculate();
+        return (*snapshotSplines_[i])(x, y);
+    }
+
+    Real Fdm2DimSolver::snapshotDerivativeX(Time t, Real x, Real y) const {
+        const Size i = snapshotIndex(t);
+        calculate();
+        return snapshotSplines_[i]->derivativeX(x, y);
+    }
+
+    Real Fdm2DimSolver::snapshotDerivativeXX(Time t, Real x, Real y) const {
+        const Size i = snapshotIndex(t);
+        calculate();
+        return snapshotSplines_[i]->secondDerivativeX(x, y);
+    }
+
 }
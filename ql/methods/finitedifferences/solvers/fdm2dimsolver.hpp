@@ -39,7 +39,8 @@ namespace QuantLib {
       public:
         Fdm2DimSolver(const FdmSolverDesc& solverDesc,
                       const FdmSchemeDesc& schemeDesc,
-                      ext::shared_ptr<FdmLinearOpComposite> op);
+                      ext::shared_ptr<FdmLinearOpComposite> op,
+                      std::vector<Time> snapshotTimes = std::vector<Time>());
 
         Real interpolateAt(Real x, Real y) const;
         Real thetaAt(Real x, Real y) const;
@@ -50,20 +51,38 @@ namespace QuantLib {
         Real derivativeYY(Real x, Real y) const;
         Real derivativeXY(Real x, Real y) const;
 
+        /*! \name retained value grids
+            The value grids at the snapshot times given to the
+            constructor are kept after the rollback; times are
+            measured from the evaluation date.
+        */
+        //@{
+        const std::vector<Time>& snapshotTimes() const;
+        Real snapshotAt(Time t, Real x, Real y) const;
+        Real snapshotDerivativeX(Time t, Real x, Real y) const;
+        Real snapshotDerivativeXX(Time t, Real x, Real y) const;
+        //@}
+
       protected:
         void performCalculations() const override;
 
       private:
+        Size snapshotIndex(Time t) const;
+
         const FdmSolverDesc solverDesc_;
         const FdmSchemeDesc schemeDesc_;
         const ext::shared_ptr<FdmLinearOpComposite> op_;
 
+        const std::vector<Time> snapshotTimes_;
         const ext::shared_ptr<FdmSnapshotCondition> thetaCondition_;
+        const std::vector<ext::shared_ptr<FdmSnapshotCondition> > snapshots_;
         const ext::shared_ptr<FdmStepConditionComposite> conditions_;
 
         std::vector<Real> x_, y_, initialValues_;
         mutable Matrix resultValues_;
         mutable ext::shared_ptr<BicubicSpline> interpolation_;
+        mutable std::vector<Matrix> snapshotValues_;
+        mutable std::vector<ext::shared_ptr<BicubicSpline> > snapshotSplines_;
     };
 }
 
@@ -35,6 +35,7 @@
 #include <ql/methods/finitedifferences/solvers/fdmbackwardsolver.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmstepconditioncomposite.hpp>
 #include <ql/mathconstants.hpp>
+#include <algorithm>
 #include <utility>
 
 
@@ -77,6 +78,20 @@ namespace QuantLib {
 
     FdmSchemeDesc FdmSchemeDesc::TrBDF2() { return {FdmSchemeDesc::TrBDF2Type, 2 - M_SQRT2, 1e-8}; }
 
+    FdmSchemeDesc FdmSchemeDesc::AdaptiveTrBDF2(Real tolerance,
+                                                Real maxGrowthFactor) {
+        QL_REQUIRE(tolerance > 0.0, "positive tolerance required");
+        QL_REQUIRE(maxGrowthFactor > 1.0,
+                   "maximum growth factor must be greater than one");
+        return {FdmSchemeDesc::AdaptiveTrBDF2Type, tolerance, maxGrowthFactor};
+    }
+
+    FdmSchemeDesc FdmSchemeDesc::SparseImplicit(Real theta, Real relTol) {
+        QL_REQUIRE(theta >= 0.5 && theta <= 1.0,
+                   "theta must be in [0.5, 1], " << theta << " given");
+        return {FdmSchemeDesc::SparseImplicitType, theta, relTol};
+    }
+
     FdmBackwardSolver::FdmBackwardSolver(
         ext::shared_ptr<FdmLinearOpComposite> map,
         FdmBoundaryConditionSet bcSet,
@@ -98,7 +113,12 @@ namespace QuantLib {
         const Time dampingTo = from - (deltaT*dampingSteps)/allSteps;
 
         if ((dampingSteps != 0U) && schemeDesc_.type != FdmSchemeDesc::ImplicitEulerType) {
-            ImplicitEulerScheme implicitEvolver(map_, bcSet_);    
+            const bool sparse = schemeDesc_.type == FdmSchemeDesc::SparseImplicitType;
+            ImplicitEulerScheme implicitEvolver(
+                map_, bcSet_,
+                sparse ? schemeDesc_.mu : 1e-8,
+                ImplicitEulerScheme::BiCGstab,
+                sparse ? ImplicitEulerScheme::ILU0 : ImplicitEulerScheme::Splitting);
             FiniteDifferenceModel<ImplicitEulerScheme> 
                     dampingModel(implicitEvolver, condition_->stoppingTimes());
             dampingModel.rollback(rhs, from, dampingTo, 
@@ -193,8 +213,98 @@ namespace QuantLib {
                 trBDF2Model.rollback(rhs, dampingTo, to, steps, *condition_);
             }
             break;
+          case FdmSchemeDesc::AdaptiveTrBDF2Type:
+            rollbackAdaptive(rhs, dampingTo, to, steps);
+            break;
+          case FdmSchemeDesc::SparseImplicitType:
+            {
+                CrankNicolsonScheme sparseEvolver(
+                    schemeDesc_.theta, map_, bcSet_, schemeDesc_.mu,
+                    ImplicitEulerScheme::BiCGstab, ImplicitEulerScheme::ILU0);
+                FiniteDifferenceModel<CrankNicolsonScheme>
+                    sparseModel(sparseEvolver, condition_->stoppingTimes());
+                sparseModel.rollback(rhs, dampingTo, to, steps, *condition_);
+            }
+            break;
           default:
             QL_FAIL("Unknown scheme type");
         }
     }
+
+    void FdmBackwardSolver::rollbackAdaptive(array_type& rhs,
+                                             Time from, Time to, Size steps) {
+        QL_REQUIRE(from >= to,
+                   "trying to roll back from " << from << " to " << to);
+        QL_REQUIRE(steps > 0, "at least one step required");
+
+        const Real tol = schemeDesc_.theta;
+        const Real maxGrowthFactor = schemeDesc_.mu;
+        const Time initialStep = (from - to)/steps;
+        const Time minStep = 1e-4*initialStep;
+
+        adaptiveStatistics_ = AdaptiveStatistics();
+
+        // the trapezoidal rule and the TR-BDF2 scheme are both second
+        // order, their difference estimates the local error
+        const FdmSchemeDesc trDesc = FdmSchemeDesc::CraigSneyd();
+        const ext::shared_ptr<CraigSneydScheme> trEvolver(
+            ext::make_shared<CraigSneydScheme>(
+                trDesc.theta, trDesc.mu, map_, bcSet_));
+        TrBDF2Scheme<CraigSneydScheme> trBDF2(
+            FdmSchemeDesc::TrBDF2().theta, map_, trEvolver, bcSet_);
+
+        std::vector<Time> stoppingTimes = condition_->stoppingTimes();
+        std::sort(stoppingTimes.begin(), stoppingTimes.end());
+        stoppingTimes.erase(
+            std::unique(stoppingTimes.begin(), stoppingTimes.end()),
+            stoppingTimes.end());
+
+        if (!stoppingTimes.empty() && stoppingTimes.back() == from)
+            condition_->applyTo(rhs, from);
+
+        array_type trSolution, bdf2Solution;
+        Time t = from, dt = initialStep;
+        while (t > to) {
+            // next stopping time or the end of the rollback
+            auto iter = std::lower_bound(
+                stoppingTimes.begin(), stoppingTimes.end(), t);
+            const Time target = (iter == stoppingTimes.begin())
+                ? to : std::max(to, *(--iter));
+
+            // avoid leaving a tiny remainder in front of the target
+            const bool hit = (1.1*dt >= t - target);
+            const Time h = hit ? t - target : dt;
+
+            trSolution = rhs;
+            trEvolver->setStep(h);
+            trEvolver->step(trSolution, t);
+
+            bdf2Solution = rhs;
+            trBDF2.setStep(h);
+            trBDF2.step(bdf2Solution, t);
+            adaptiveStatistics_.solves += 3;
+
+            Real error = 0.0;
+            for (Size i=0; i < rhs.size(); ++i)
+                error = std::max(error, std::fabs(bdf2Solution[i]-trSolution[i])
+                                        / (1.0 + std::fabs(bdf2Solution[i])));
+
+            if (error <= tol || h <= minStep) {
+                rhs.swap(bdf2Solution);
+                ++adaptiveStatistics_.acceptedSteps;
+                t = hit ? target : t - h;
+                condition_->applyTo(rhs, t);
+
+                dt = (hit && t > to)
+                    ? initialStep
+                    : h*std::min(maxGrowthFactor,
+                                 std::max(1.0, 0.9*std::cbrt(tol/error)));
+            }
+            else {
+                ++adaptiveStatistics_.rejectedSteps;
+                dt = std::max(minStep,
+                              h*std::max(0.2, 0.9*std::cbrt(tol/error)));
+            }
+        }
+    }
 }
@@ -37,7 +37,8 @@ namespace QuantLib {
                              CraigSneydType, ModifiedCraigSneydType, 
                              ImplicitEulerType, ExplicitEulerType,
                              MethodOfLinesType, TrBDF2Type,
-                             CrankNicolsonType };
+                             CrankNicolsonType, AdaptiveTrBDF2Type,
+                             SparseImplicitType };
 
         FdmSchemeDesc(FdmSchemeType type, Real theta, Real mu);
 
@@ -56,27 +57,61 @@ namespace QuantLib {
         static FdmSchemeDesc MethodOfLines(
             Real eps=0.001, Real relInitStepSize=0.01);
         static FdmSchemeDesc TrBDF2();
+        static FdmSchemeDesc AdaptiveTrBDF2(
+            Real tolerance=1e-5, Real maxGrowthFactor=2.0);
+        // theta scheme solved on the assembled sparse matrix using
+        // BiCGstab with ILU(0) preconditioning, no operator splitting
+        static FdmSchemeDesc SparseImplicit(
+            Real theta=1.0, Real relTol=1e-8);
     };
         
     class FdmBackwardSolver {
       public:
         typedef FdmLinearOp::array_type array_type;
 
+        //! work done by the last rollback with an AdaptiveTrBDF2 scheme
+        struct AdaptiveStatistics {
+            Size acceptedSteps = 0, rejectedSteps = 0;
+            /*! implicit stages solved, i.e. three per attempted step
+                (a Craig-Sneyd step and the two stages of a TR-BDF2
+                step); a fixed TR-BDF2 step costs two of them.
+            */
+            Size solves = 0;
+        };
+
         FdmBackwardSolver(ext::shared_ptr<FdmLinearOpComposite> map,
                           FdmBoundaryConditionSet bcSet,
                           const ext::shared_ptr<FdmStepConditionComposite>& condition,
                           const FdmSchemeDesc& schemeDesc);
 
+        /*! For AdaptiveTrBDF2 scheme descriptions, <tt>steps</tt>
+            only defines the initial step size. The step size is then
+            controlled by the difference between a Crank-Nicolson
+            (Craig-Sneyd in higher dimensions) and a TR-BDF2 step,
+            grown in smooth regions and reset to the initial step size
+            after each stopping time.
+        */
         void rollback(array_type& a, 
                       Time from, Time to,
                       Size steps, Size dampingSteps);
 
+        const AdaptiveStatistics& adaptiveStatistics() const;
+
       protected:
+        void rollbackAdaptive(array_type& a,
+                              Time from, Time to, Size steps);
+
         const ext::shared_ptr<FdmLinearOpComposite> map_;
         const FdmBoundaryConditionSet bcSet_;
         const ext::shared_ptr<FdmStepConditionComposite> condition_;
         const FdmSchemeDesc schemeDesc_;
+        AdaptiveStatistics adaptiveStatistics_;
     };
+
+    inline const FdmBackwardSolver::AdaptiveStatistics&
+    FdmBackwardSolver::adaptiveStatistics() const {
+        return adaptiveStatistics_;
+    }
 }
 
 #endif
@@ -33,10 +33,12 @@ namespace QuantLib {
                                                  const FdmSchemeDesc& schemeDesc,
                                                  bool localVol,
                                                  Real illegalLocalVolOverwrite,
-                                                 Handle<FdmQuantoHelper> quantoHelper)
+                                                 Handle<FdmQuantoHelper> quantoHelper,
+                                                 std::vector<Time> snapshotTimes)
     : process_(std::move(process)), strike_(strike), solverDesc_(std::move(solverDesc)),
       schemeDesc_(schemeDesc), localVol_(localVol),
-      illegalLocalVolOverwrite_(illegalLocalVolOverwrite), quantoHelper_(std::move(quantoHelper)) {
+      illegalLocalVolOverwrite_(illegalLocalVolOverwrite), quantoHelper_(std::move(quantoHelper)),
+      snapshotTimes_(std::move(snapshotTimes)) {
 
         registerWith(process_);
         registerWith(quantoHelper_);
@@ -51,7 +53,8 @@ namespace QuantLib {
                     ? ext::shared_ptr<FdmQuantoHelper>()
                     : quantoHelper_.currentLink()));
 
-        solver_ = ext::make_shared<Fdm1DimSolver>(solverDesc_, schemeDesc_, op);
+        solver_ = ext::make_shared<Fdm1DimSolver>(
+            solverDesc_, schemeDesc_, op, snapshotTimes_);
     }
 
     Real FdmBlackScholesSolver::valueAt(Real s) const {
@@ -73,4 +76,25 @@ namespace QuantLib {
     Real FdmBlackScholesSolver::thetaAt(Real s) const {
         return solver_->thetaAt(std::log(s));
     }
+
+    const std::vector<Time>& FdmBlackScholesSolver::snapshotTimes() const {
+        return snapshotTimes_;
+    }
+
+    Real FdmBlackScholesSolver::snapshotValueAt(Time t, Real s) const {
+        calculate();
+        return solver_->snapshotAt(t, std::log(s));
+    }
+
+    Real FdmBlackScholesSolver::snapshotDeltaAt(Time t, Real s) const {
+        calculate();
+        return solver_->snapshotDerivativeX(t, std::log(s))/s;
+    }
+
+    Real FdmBlackScholesSolver::snapshotGammaAt(Time t, Real s) const {
+        calculate();
+        const Real x = std::log(s);
+        return (solver_->snapshotDerivativeXX(t, x)
+                -solver_->snapshotDerivativeX(t, x))/(s*s);
+    }
 }
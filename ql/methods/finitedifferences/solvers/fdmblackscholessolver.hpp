@@ -45,13 +45,22 @@ namespace QuantLib {
                               const FdmSchemeDesc& schemeDesc = FdmSchemeDesc::Douglas(),
                               bool localVol = false,
                               Real illegalLocalVolOverwrite = -Null<Real>(),
-                              Handle<FdmQuantoHelper> quantoHelper = Handle<FdmQuantoHelper>());
+                              Handle<FdmQuantoHelper> quantoHelper = Handle<FdmQuantoHelper>(),
+                              std::vector<Time> snapshotTimes = std::vector<Time>());
 
         Real valueAt(Real s) const;
         Real deltaAt(Real s) const;
         Real gammaAt(Real s) const;
         Real thetaAt(Real s) const;
 
+        //! \name values and greeks from the grids retained at snapshotTimes
+        //@{
+        const std::vector<Time>& snapshotTimes() const;
+        Real snapshotValueAt(Time t, Real s) const;
+        Real snapshotDeltaAt(Time t, Real s) const;
+        Real snapshotGammaAt(Time t, Real s) const;
+        //@}
+
       protected:
         void performCalculations() const override;
 
@@ -63,6 +72,7 @@ namespace QuantLib {
         const bool localVol_;
         const Real illegalLocalVolOverwrite_;
         const Handle<FdmQuantoHelper> quantoHelper_;
+        const std::vector<Time> snapshotTimes_;
 
         mutable ext::shared_ptr<Fdm1DimSolver> solver_;
     };
@@ -33,10 +33,11 @@ namespace QuantLib {
                                      const FdmSchemeDesc& schemeDesc,
                                      Handle<FdmQuantoHelper> quantoHelper,
                                      ext::shared_ptr<LocalVolTermStructure> leverageFct,
-                                     const Real mixingFactor)
+                                     const Real mixingFactor,
+                                     std::vector<Time> snapshotTimes)
     : process_(std::move(process)), solverDesc_(std::move(solverDesc)), schemeDesc_(schemeDesc),
       quantoHelper_(std::move(quantoHelper)), leverageFct_(std::move(leverageFct)),
-      mixingFactor_(mixingFactor) {
+      mixingFactor_(mixingFactor), snapshotTimes_(std::move(snapshotTimes)) {
 
         registerWith(process_);
         registerWith(quantoHelper_);
@@ -50,7 +51,8 @@ namespace QuantLib {
                              : ext::shared_ptr<FdmQuantoHelper>(),
                 leverageFct_, mixingFactor_));
 
-        solver_ = ext::make_shared<Fdm2DimSolver>(solverDesc_, schemeDesc_, op);
+        solver_ = ext::make_shared<Fdm2DimSolver>(
+            solverDesc_, schemeDesc_, op, snapshotTimes_);
     }
 
     Real FdmHestonSolver::valueAt(Real s, Real v) const {
@@ -90,4 +92,25 @@ namespace QuantLib {
         calculate();
         return solver_->thetaAt(std::log(s), v);
     }
+
+    const std::vector<Time>& FdmHestonSolver::snapshotTimes() const {
+        return snapshotTimes_;
+    }
+
+    Real FdmHestonSolver::snapshotValueAt(Time t, Real s, Real v) const {
+        calculate();
+        return solver_->snapshotAt(t, std::log(s), v);
+    }
+
+    Real FdmHestonSolver::snapshotDeltaAt(Time t, Real s, Real v) const {
+        calculate();
+        return solver_->snapshotDerivativeX(t, std::log(s), v)/s;
+    }
+
+    Real FdmHestonSolver::snapshotGammaAt(Time t, Real s, Real v) const {
+        calculate();
+        const Real x = std::log(s);
+        return (solver_->snapshotDerivativeXX(t, x, v)
+                -solver_->snapshotDerivativeX(t, x, v))/(s*s);
+    }
 }
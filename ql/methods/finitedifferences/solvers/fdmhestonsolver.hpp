@@ -47,7 +47,8 @@ namespace QuantLib {
                         Handle<FdmQuantoHelper> quantoHelper = Handle<FdmQuantoHelper>(),
                         ext::shared_ptr<LocalVolTermStructure> leverageFct =
                             ext::shared_ptr<LocalVolTermStructure>(),
-                        Real mixingFactor = 1.0);
+                        Real mixingFactor = 1.0,
+                        std::vector<Time> snapshotTimes = std::vector<Time>());
 
         Real valueAt(Real s, Real v) const;
         Real thetaAt(Real s, Real v) const;
@@ -63,6 +64,14 @@ namespace QuantLib {
         Real meanVarianceDeltaAt(Real s, Real v) const;
         Real meanVarianceGammaAt(Real s, Real v) const;
 
+        //! \name values and greeks from the grids retained at snapshotTimes
+        //@{
+        const std::vector<Time>& snapshotTimes() const;
+        Real snapshotValueAt(Time t, Real s, Real v) const;
+        Real snapshotDeltaAt(Time t, Real s, Real v) const;
+        Real snapshotGammaAt(Time t, Real s, Real v) const;
+        //@}
+
       protected:
         void performCalculations() const override;
 
@@ -73,6 +82,7 @@ namespace QuantLib {
         const Handle<FdmQuantoHelper> quantoHelper_;
         const ext::shared_ptr<LocalVolTermStructure> leverageFct_;
         const Real mixingFactor_;
+        const std::vector<Time> snapshotTimes_;
 
         mutable ext::shared_ptr<Fdm2DimSolver> solver_;
     };
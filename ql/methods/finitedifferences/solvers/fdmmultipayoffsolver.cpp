@@ -0,0 +1,196 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/interpolations/bicubicsplineinterpolation.hpp>
+#include <ql/math/interpolations/cubicinterpolation.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmmesher.hpp>
+#include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
+#include <ql/methods/finitedifferences/operators/fdmmultipayoffop.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmmultipayoffsolver.hpp>
+#include <ql/methods/finitedifferences/stepconditions/fdmsnapshotcondition.hpp>
+#include <ql/methods/finitedifferences/stepconditions/fdmstepconditioncomposite.hpp>
+#include <ql/methods/finitedifferences/utilities/fdminnervaluecalculator.hpp>
+
+namespace QuantLib {
+
+    FdmMultiPayoffSolver::FdmMultiPayoffSolver(
+        const FdmSolverDesc& solverDesc,
+        const FdmSchemeDesc& schemeDesc,
+        const ext::shared_ptr<FdmLinearOpComposite>& op)
+    : FdmMultiPayoffSolver(
+          solverDesc, schemeDesc,
+          std::vector<ext::shared_ptr<FdmLinearOpComposite> >(
+              solverDesc.mesher->layout()->dim().back(), op)) {}
+
+    FdmMultiPayoffSolver::FdmMultiPayoffSolver(
+        const FdmSolverDesc& solverDesc,
+        const FdmSchemeDesc& schemeDesc,
+        const std::vector<ext::shared_ptr<FdmLinearOpComposite> >& ops)
+    : solverDesc_(solverDesc), schemeDesc_(schemeDesc),
+      nPayoffs_(solverDesc.mesher->layout()->dim().back()),
+      op_(ext::make_shared<FdmMultiPayoffOp>(ops)),
+      thetaCondition_(ext::make_shared<FdmSnapshotCondition>(
+          0.99 * std::min(1.0 / 365.0,
+                          solverDesc.condition->stoppingTimes().empty() ?
+                              solverDesc.maturity :
+                              solverDesc.condition->stoppingTimes().front()))),
+      conditions_(FdmStepConditionComposite::joinConditions(
+          thetaCondition_, solverDesc.condition)),
+      initialValues_(solverDesc.mesher->layout()->size()) {
+
+        QL_REQUIRE(ops.size() == nPayoffs_,
+                   "number of operators (" << ops.size() << ") differs "
+                   "from the number of payoffs (" << nPayoffs_ << ")");
+
+        const Size nDim = solverDesc.mesher->layout()->dim().size();
+        QL_REQUIRE(nDim == 2 || nDim == 3,
+                   "one- or two-dimensional operator required");
+
+        for (const auto& iter : *solverDesc.mesher->layout()) {
+            initialValues_[iter.index()]
+                 = solverDesc_.calculator->avgInnerValue(iter,
+                                                         solverDesc.maturity);
+
+            const std::vector<Size>& coordinates = iter.coordinates();
+            if (coordinates.back() == 0U) {
+                if (nDim == 2 || coordinates[1] == 0U)
+                    x_.push_back(solverDesc.mesher->location(iter, 0));
+                if (nDim == 3 && coordinates[0] == 0U)
+                    y_.push_back(solverDesc.mesher->location(iter, 1));
+            }
+        }
+    }
+
+    void FdmMultiPayoffSolver::performCalculations() const {
+        Array rhs(initialValues_);
+
+        FdmBackwardSolver(op_, solverDesc_.bcSet, conditions_, schemeDesc_)
+            .rollback(rhs, solverDesc_.maturity, 0.0,
+                      solverDesc_.timeSteps, solverDesc_.dampingSteps);
+
+        if (y_.empty()) {
+            resultValues_.resize(nPayoffs_);
+            interpolations_.resize(nPayoffs_);
+            for (Size i=0; i < nPayoffs_; ++i) {
+                resultValues_[i] = payoffValues(rhs, i);
+                interpolations_[i] =
+                    ext::make_shared<MonotonicCubicNaturalSpline>(
+                        x_.begin(), x_.end(), resultValues_[i].begin());
+            }
+        }
+        else {
+            resultMatrices_.resize(nPayoffs_);
+            splines_.resize(nPayoffs_);
+            for (Size i=0; i < nPayoffs_; ++i) {
+                resultMatrices_[i] = payoffMatrix(rhs, i);
+                splines_[i] = ext::make_shared<BicubicSpline>(
+                    x_.begin(), x_.end(), y_.begin(), y_.end(),
+                    resultMatrices_[i]);
+            }
+        }
+    }
+
+    Array FdmMultiPayoffSolver::payoffValues(const Array& values,
+                                             Size payoff) const {
+        QL_REQUIRE(payoff < nPayoffs_, "payoff index " << payoff
+                   << " out of range [0, " << nPayoffs_ << ")");
+        const Size n = values.size()/nPayoffs_;
+        Array retVal(n);
+        std::copy(values.begin() + payoff*n, values.begin() + (payoff+1)*n,
+                  retVal.begin());
+        return retVal;
+    }
+
+    Matrix FdmMultiPayoffSolver::payoffMatrix(const Array& values,
+                                              Size payoff) const {
+        const Array v = payoffValues(values, payoff);
+        Matrix retVal(y_.size(), x_.size());
+        std::copy(v.begin(), v.end(), retVal.begin());
+        return retVal;
+    }
+
+    Real FdmMultiPayoffSolver::interpolateAt(Size payoff, Real x) const {
+        QL_REQUIRE(y_.empty(), "one-dimensional operator required");
+        QL_REQUIRE(payoff < nPayoffs_, "payoff index out of range");
+        calculate();
+        return (*interpolations_[payoff])(x);
+    }
+
+    Real FdmMultiPayoffSolver::thetaAt(Size payoff, Real x) const {
+        if (conditions_->stoppingTimes().front() == 0.0)
+            return Null<Real>();
+
+        calculate();
+        const Array thetaValues =
+            payoffValues(thetaCondition_->getValues(), payoff);
+
+        const Real temp = MonotonicCubicNaturalSpline(
+            x_.begin(), x_.end(), thetaValues.begin())(x);
+        return (temp - interpolateAt(payoff, x))/thetaCondition_->getTime();
+    }
+
+    Real FdmMultiPayoffSolver::derivativeX(Size payoff, Real x) const {
+        QL_REQUIRE(y_.empty(), "one-dimensional operator required");
+        QL_REQUIRE(payoff < nPayoffs_, "payoff index out of range");
+        calculate();
+        return interpolations_[payoff]->derivative(x);
+    }
+
+    Real FdmMultiPayoffSolver::derivativeXX(Size payoff, Real x) const {
+        QL_REQUIRE(y_.empty(), "one-dimensional operator required");
+        QL_REQUIRE(payoff < nPayoffs_, "payoff index out of range");
+        calculate();
+        return interpolations_[payoff]->secondDerivative(x);
+    }
+
+    Real FdmMultiPayoffSolver::interpolateAt(Size payoff,
+                                             Real x, Real y) const {
+        QL_REQUIRE(!y_.empty(), "two-dimensional operator required");
+        QL_REQUIRE(payoff < nPayoffs_, "payoff index out of range");
+        calculate();
+        return (*splines_[payoff])(x, y);
+    }
+
+    Real FdmMultiPayoffSolver::thetaAt(Size payoff, Real x, Real y) const {
+        if (conditions_->stoppingTimes().front() == 0.0)
+            return Null<Real>();
+
+        calculate();
+        const Matrix thetaValues =
+            payoffMatrix(thetaCondition_->getValues(), payoff);
+
+        return (BicubicSpline(x_.begin(), x_.end(), y_.begin(), y_.end(),
+                              thetaValues)(x, y) - interpolateAt(payoff, x, y))
+              / thetaCondition_->getTime();
+    }
+
+    Real FdmMultiPayoffSolver::derivativeX(Size payoff,
+                                           Real x, Real y) const {
+        QL_REQUIRE(!y_.empty(), "two-dimensional operator required");
+        QL_REQUIRE(payoff < nPayoffs_, "payoff index out of range");
+        calculate();
+        return splines_[payoff]->derivativeX(x, y);
+    }
+
+    Real FdmMultiPayoffSolver::derivativeXX(Size payoff,
+                                            Real x, Real y) const {
+        QL_REQUIRE(!y_.empty(), "two-dimensional operator required");
+        QL_REQUIRE(payoff < nPayoffs_, "payoff index out of range");
+        calculate();
+        return splines_[payoff]->secondDerivativeX(x, y);
+    }
+}
@@ -0,0 +1,103 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdmmultipayoffsolver.hpp
+    \brief solver rolling back several payoffs in a single pass
+*/
+
+#ifndef quantlib_fdm_multi_payoff_solver_hpp
+#define quantlib_fdm_multi_payoff_solver_hpp
+
+#include <ql/math/matrix.hpp>
+#include <ql/patterns/lazyobject.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmsolverdesc.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmbackwardsolver.hpp>
+
+namespace QuantLib {
+
+    class CubicInterpolation;
+    class BicubicSpline;
+    class FdmSnapshotCondition;
+
+    //! solver rolling back several payoffs in a single pass
+    /*! The mesher of the solver description has one more direction
+        than the mesher of the given one- or two-dimensional operator;
+        its last direction enumerates the payoffs.  The calculator
+        and the step conditions of the solver description act on this
+        extended mesher, e.g., by means of a FdmMultiPayoffInnerValue
+        calculator, so that early exercise is handled for each payoff
+        separately.  If a single operator is given, its coefficients
+        are shared between all payoffs and are thus computed once per
+        time step.  Payoffs whose dynamics differ, e.g., because the
+        volatility is read off a smile at their strike, need one
+        operator each.
+    */
+    class FdmMultiPayoffSolver : public LazyObject {
+      public:
+        FdmMultiPayoffSolver(const FdmSolverDesc& solverDesc,
+                             const FdmSchemeDesc& schemeDesc,
+                             const ext::shared_ptr<FdmLinearOpComposite>& op);
+        //! one operator per payoff
+        FdmMultiPayoffSolver(
+            const FdmSolverDesc& solverDesc,
+            const FdmSchemeDesc& schemeDesc,
+            const std::vector<ext::shared_ptr<FdmLinearOpComposite> >& ops);
+
+        Size numberOfPayoffs() const { return nPayoffs_; }
+
+        //! \name one-dimensional operators
+        //@{
+        Real interpolateAt(Size payoff, Real x) const;
+        Real thetaAt(Size payoff, Real x) const;
+        Real derivativeX(Size payoff, Real x) const;
+        Real derivativeXX(Size payoff, Real x) const;
+        //@}
+
+        //! \name two-dimensional operators
+        //@{
+        Real interpolateAt(Size payoff, Real x, Real y) const;
+        Real thetaAt(Size payoff, Real x, Real y) const;
+        Real derivativeX(Size payoff, Real x, Real y) const;
+        Real derivativeXX(Size payoff, Real x, Real y) const;
+        //@}
+
+      protected:
+        void performCalculations() const override;
+
+      private:
+        Array payoffValues(const Array& values, Size payoff) const;
+        Matrix payoffMatrix(const Array& values, Size payoff) const;
+
+        const FdmSolverDesc solverDesc_;
+        const FdmSchemeDesc schemeDesc_;
+        const Size nPayoffs_;
+        const ext::shared_ptr<FdmLinearOpComposite> op_;
+
+        const ext::shared_ptr<FdmSnapshotCondition> thetaCondition_;
+        const ext::shared_ptr<FdmStepConditionComposite> conditions_;
+
+        std::vector<Real> x_, y_;
+        Array initialValues_;
+        mutable std::vector<Array> resultValues_;
+        mutable std::vector<Matrix> resultMatrices_;
+        mutable std::vector<ext::shared_ptr<CubicInterpolation> >
+            interpolations_;
+        mutable std::vector<ext::shared_ptr<BicubicSpline> > splines_;
+    };
+}
+
+#endif
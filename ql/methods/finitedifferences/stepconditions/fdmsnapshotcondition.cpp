@@ -19,6 +19,7 @@
  FOR A PARTICULAR PURPOSE.  See the license for more details.
 */
 
+#include <ql/errors.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmsnapshotcondition.hpp>
 
 namespace QuantLib {
@@ -43,4 +44,18 @@ namespace QuantLib {
         return values_;
     }
 
+
+    std::vector<ext::shared_ptr<FdmSnapshotCondition> >
+    fdmSnapshotConditions(const std::vector<Time>& times, Time maturity) {
+        std::vector<ext::shared_ptr<FdmSnapshotCondition> > retVal;
+        retVal.reserve(times.size());
+        for (Time t : times) {
+            QL_REQUIRE(t > 0.0 && t <= maturity,
+                       "snapshot time " << t << " is outside of (0, "
+                       << maturity << "]");
+            retVal.push_back(ext::make_shared<FdmSnapshotCondition>(t));
+        }
+        return retVal;
+    }
+
 }
@@ -27,6 +27,8 @@
 #define quantlib_fdm_snapshot_condition_hpp
 
 #include <ql/methods/finitedifferences/stepcondition.hpp>
+#include <ql/shared_ptr.hpp>
+#include <vector>
 
 namespace QuantLib {
 
@@ -42,5 +44,33 @@ namespace QuantLib {
         const Time t_;
         mutable Array values_;
     };
+
+    //! snapshot conditions at the given times within (0, maturity]
+    std::vector<ext::shared_ptr<FdmSnapshotCondition> >
+    fdmSnapshotConditions(const std::vector<Time>& times, Time maturity);
+
+    //! store the snapshot values and greeks of a solver as additional results
+    /*! The solver provides snapshotValueAt, snapshotDeltaAt and
+        snapshotGammaAt for each of the given times, evaluated at the
+        given point of the state space.
+    */
+    template <class Results, class Solver, class... Coordinates>
+    void fdmSnapshotResults(Results& results, const Solver& solver,
+                            const std::vector<Time>& times,
+                            Coordinates... x) {
+        std::vector<Real> values, deltas, gammas;
+        values.reserve(times.size());
+        deltas.reserve(times.size());
+        gammas.reserve(times.size());
+        for (Time t : times) {
+            values.push_back(solver.snapshotValueAt(t, x...));
+            deltas.push_back(solver.snapshotDeltaAt(t, x...));
+            gammas.push_back(solver.snapshotGammaAt(t, x...));
+        }
+        results.additionalResults["snapshotTimes"] = times;
+        results.additionalResults["snapshotValues"] = values;
+        results.additionalResults["snapshotDeltas"] = deltas;
+        results.additionalResults["snapshotGammas"] = gammas;
+    }
 }
 #endif
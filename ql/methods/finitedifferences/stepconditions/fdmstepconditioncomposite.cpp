@@ -77,6 +77,26 @@ namespace QuantLib {
             stoppingTimes, conditions);
     }
 
+    ext::shared_ptr<FdmStepConditionComposite>
+    FdmStepConditionComposite::joinConditions(
+                const std::vector<ext::shared_ptr<FdmSnapshotCondition> >& c1,
+                const ext::shared_ptr<FdmStepConditionComposite>& c2) {
+
+        std::list<std::vector<Time> > stoppingTimes;
+        stoppingTimes.push_back(c2->stoppingTimes());
+
+        FdmStepConditionComposite::Conditions conditions;
+        conditions.push_back(c2);
+
+        for (const auto& snapshot : c1) {
+            stoppingTimes.emplace_back(1, snapshot->getTime());
+            conditions.push_back(snapshot);
+        }
+
+        return ext::make_shared<FdmStepConditionComposite>(
+            stoppingTimes, conditions);
+    }
+
     ext::shared_ptr<FdmStepConditionComposite> 
     FdmStepConditionComposite::vanillaComposite(
                  const DividendSchedule& cashFlow,
@@ -55,6 +55,10 @@ namespace QuantLib {
                     const ext::shared_ptr<FdmSnapshotCondition>& c1,
                     const ext::shared_ptr<FdmStepConditionComposite>& c2);
 
+        static ext::shared_ptr<FdmStepConditionComposite> joinConditions(
+                    const std::vector<ext::shared_ptr<FdmSnapshotCondition> >& c1,
+                    const ext::shared_ptr<FdmStepConditionComposite>& c2);
+
         static ext::shared_ptr<FdmStepConditionComposite> vanillaComposite(
              const DividendSchedule& schedule,
              const ext::shared_ptr<Exercise>& exercise,
@@ -133,4 +133,23 @@ namespace QuantLib {
                                     const FdmLinearOpIterator& iter, Time t) {
         return innerValue(iter, t);
     }
+
+
+    FdmMultiPayoffInnerValue::FdmMultiPayoffInnerValue(
+        std::vector<ext::shared_ptr<FdmInnerValueCalculator> > calculators,
+        Size direction)
+    : calculators_(std::move(calculators)), direction_(direction) {
+        QL_REQUIRE(!calculators_.empty(), "no inner value calculator given");
+    }
+
+    Real FdmMultiPayoffInnerValue::innerValue(
+                                    const FdmLinearOpIterator& iter, Time t) {
+        return calculators_[iter.coordinates()[direction_]]->innerValue(iter, t);
+    }
+
+    Real FdmMultiPayoffInnerValue::avgInnerValue(
+                                    const FdmLinearOpIterator& iter, Time t) {
+        return calculators_[iter.coordinates()[direction_]]
+            ->avgInnerValue(iter, t);
+    }
 }
@@ -90,6 +90,25 @@ namespace QuantLib {
         const ext::shared_ptr<FdmMesher> mesher_;
     };
 
+    //! inner values of several payoffs
+    /*! The given direction of the mesher enumerates the payoffs; the
+        i-th calculator provides the inner values of the i-th payoff.
+    */
+    class FdmMultiPayoffInnerValue : public FdmInnerValueCalculator {
+      public:
+        FdmMultiPayoffInnerValue(
+            std::vector<ext::shared_ptr<FdmInnerValueCalculator> > calculators,
+            Size direction);
+
+        Real innerValue(const FdmLinearOpIterator& iter, Time t) override;
+        Real avgInnerValue(const FdmLinearOpIterator& iter, Time t) override;
+
+      private:
+        const std::vector<ext::shared_ptr<FdmInnerValueCalculator> >
+            calculators_;
+        const Size direction_;
+    };
+
     class FdmZeroInnerValue : public FdmInnerValueCalculator {
       public:
         Real innerValue(const FdmLinearOpIterator&, Time) override { return 0.0; }
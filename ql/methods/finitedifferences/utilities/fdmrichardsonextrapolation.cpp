@@ -0,0 +1,55 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/errors.hpp>
+#include <ql/math/richardsonextrapolation.hpp>
+#include <ql/methods/finitedifferences/utilities/fdmrichardsonextrapolation.hpp>
+#include <cmath>
+
+namespace QuantLib {
+
+    std::pair<Real, Real>
+    fdmRichardsonExtrapolation(const std::vector<Real>& values, Real order) {
+        QL_REQUIRE(values.size() == 2 || values.size() == 3,
+                   "two or three grids required for the extrapolation");
+        QL_REQUIRE(order > 0.0, "positive order required, " << order
+                   << " given");
+
+        for (Real v : values)
+            if (v == Null<Real>())
+                return {Null<Real>(), Null<Real>()};
+
+        // result on the grid with relative step size h = 2^{-i}
+        const auto f = [&values](Real h) {
+            return values[std::lround(-std::log2(h))];
+        };
+        // first level extrapolation from the grids with step sizes h, h/2
+        const auto level1 = [&f, order](Real h) {
+            return RichardsonExtrapolation(f, h, order)(2.0);
+        };
+
+        if (values.size() == 2) {
+            const Real value = level1(1.0);
+            return {value, std::fabs(value - values[1])};
+        }
+
+        // second level, the next error term is two orders higher
+        const Real value =
+            RichardsonExtrapolation(level1, 1.0, order + 2.0)(2.0);
+        return {value, std::fabs(value - level1(0.5))};
+    }
+}
@@ -0,0 +1,87 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdmrichardsonextrapolation.hpp
+    \brief Richardson extrapolation of results on nested finite-difference grids
+*/
+
+#ifndef quantlib_fdm_richardson_extrapolation_hpp
+#define quantlib_fdm_richardson_extrapolation_hpp
+
+#include <ql/types.hpp>
+#include <ql/utilities/null.hpp>
+#include <utility>
+#include <vector>
+
+namespace QuantLib {
+
+    //! Richardson extrapolation of results on nested finite-difference grids
+    /*! values[i] is the result on refinement level i, i.e. on the grid
+        refined by the factor \f$ 2^i \f$ in every direction, in time
+        and in all space dimensions. The leading error term is assumed
+        to be of the given order on the first extrapolation level and
+        of two orders higher on the second one if three values are
+        given, as for the Crank-Nicolson-type schemes.
+
+        The error estimate is the distance between the extrapolated
+        value and the best estimate of the previous level. Null values
+        are returned if any of the given values is null.
+    */
+    std::pair<Real, Real>
+    fdmRichardsonExtrapolation(const std::vector<Real>& values,
+                               Real order = 2.0);
+
+    //! Richardson extrapolation of value and greeks of a set of results
+    /*! The extrapolated error estimate of the value is stored in
+        the errorEstimate field, the ones of the greeks are stored as
+        additional results.
+    */
+    template <class Results>
+    Results fdmRichardsonExtrapolation(const std::vector<Results>& results,
+                                       Real order = 2.0) {
+        std::vector<Real> values(results.size()), deltas(results.size()),
+            gammas(results.size()), thetas(results.size());
+        for (Size i=0; i < results.size(); ++i) {
+            values[i] = results[i].value;
+            deltas[i] = results[i].delta;
+            gammas[i] = results[i].gamma;
+            thetas[i] = results[i].theta;
+        }
+
+        Results retVal = results.back();
+
+        std::pair<Real, Real> e = fdmRichardsonExtrapolation(values, order);
+        retVal.value = e.first;
+        retVal.errorEstimate = e.second;
+
+        e = fdmRichardsonExtrapolation(deltas, order);
+        retVal.delta = e.first;
+        retVal.additionalResults["deltaErrorEstimate"] = e.second;
+
+        e = fdmRichardsonExtrapolation(gammas, order);
+        retVal.gamma = e.first;
+        retVal.additionalResults["gammaErrorEstimate"] = e.second;
+
+        e = fdmRichardsonExtrapolation(thetas, order);
+        retVal.theta = e.first;
+        retVal.additionalResults["thetaErrorEstimate"] = e.second;
+
+        return retVal;
+    }
+}
+
+#endif
@@ -80,6 +80,24 @@ namespace QuantLib {
                       const Array& values,
                       Array& newValues) const;
 
+        //! \name Flat transition tables
+        //@{
+        /*! When enabled, the descendants, probabilities and discount
+            factors of each level are copied into contiguous arrays
+            the first time the level is used; rollback and state-price
+            computation then gather from these arrays instead of
+            calling back into the derived class for each node and
+            branch.  This pays off when the same tree is used for
+            many rollbacks.
+
+            \warning the tables must be reset whenever the values
+                     returned by the derived class change.
+        */
+        void enableTransitionTables(bool enable = true);
+        bool transitionTablesEnabled() const { return useTables_; }
+        void resetTransitionTables() const { tables_.clear(); }
+        //@}
+
       protected:
         void computeStatePrices(Size until) const;
 
@@ -87,17 +105,69 @@ namespace QuantLib {
         mutable std::vector<Array> statePrices_;
 
       private:
+        struct TransitionTable {
+            std::vector<Size> descendants;
+            std::vector<Real> probabilities;
+            Array discounts;
+        };
+        const TransitionTable& transitionTable(Size i) const;
+
         Size n_;
         mutable Size statePricesLimit_;
+        bool useTables_ = false;
+        mutable std::vector<TransitionTable> tables_;
     };
 
 
     // template definitions
 
+    template <class Impl>
+    void TreeLattice<Impl>::enableTransitionTables(bool enable) {
+        useTables_ = enable;
+        tables_.clear();
+    }
+
+    template <class Impl>
+    const typename TreeLattice<Impl>::TransitionTable&
+    TreeLattice<Impl>::transitionTable(Size i) const {
+        if (tables_.size() <= i)
+            tables_.resize(i+1);
+
+        TransitionTable& table = tables_[i];
+        if (table.discounts.empty()) {
+            const Size size = this->impl().size(i);
+            table.descendants.resize(size*n_);
+            table.probabilities.resize(size*n_);
+            table.discounts = Array(size);
+            for (Size j=0; j<size; j++) {
+                for (Size l=0; l<n_; l++) {
+                    table.descendants[j*n_+l] =
+                        this->impl().descendant(i,j,l);
+                    table.probabilities[j*n_+l] =
+                        this->impl().probability(i,j,l);
+                }
+                table.discounts[j] = this->impl().discount(i,j);
+            }
+        }
+        return table;
+    }
+
     template <class Impl>
     void TreeLattice<Impl>::computeStatePrices(Size until) const {
         for (Size i=statePricesLimit_; i<until; i++) {
             statePrices_.push_back(Array(this->impl().size(i+1), 0.0));
+            if (useTables_) {
+                const TransitionTable& table = transitionTable(i);
+                const Array& prices = statePrices_[i];
+                Array& next = statePrices_[i+1];
+                for (Size j=0; j<prices.size(); j++) {
+                    const Real statePrice = prices[j]*table.discounts[j];
+                    for (Size l=0; l<n_; l++)
+                        next[table.descendants[j*n_+l]] +=
+                            statePrice*table.probabilities[j*n_+l];
+                }
+                continue;
+            }
             for (Size j=0; j<this->impl().size(i); j++) {
                 DiscountFactor disc = this->impl().discount(i,j);
                 Real statePrice = statePrices_[i][j];
@@ -166,6 +236,20 @@ namespace QuantLib {
     template <class Impl>
     void TreeLattice<Impl>::stepback(Size i, const Array& values,
                                      Array& newValues) const {
+        if (useTables_) {
+            const TransitionTable& table = transitionTable(i);
+            const Size* descendants = table.descendants.data();
+            const Real* probabilities = table.probabilities.data();
+            #pragma omp parallel for
+            for (long j=0; j<(long)table.discounts.size(); j++) {
+                Real value = 0.0;
+                for (Size l=j*n_; l<(j+1)*n_; l++)
+                    value += probabilities[l]*values[descendants[l]];
+                newValues[j] = value*table.discounts[j];
+            }
+            return;
+        }
+
         #pragma omp parallel for
         for (long j=0; j<(long)this->impl().size(i); j++) {
             Real value = 0.0;
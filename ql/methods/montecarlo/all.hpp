@@ -9,6 +9,8 @@
 #include <ql/methods/montecarlo/lsmbasissystem.hpp>
 #include <ql/methods/montecarlo/mctraits.hpp>
 #include <ql/methods/montecarlo/montecarlomodel.hpp>
+#include <ql/methods/montecarlo/multilevelmontecarlomodel.hpp>
+#include <ql/methods/montecarlo/multilevelpathgenerator.hpp>
 #include <ql/methods/montecarlo/multipath.hpp>
 #include <ql/methods/montecarlo/multipathgenerator.hpp>
 #include <ql/methods/montecarlo/nodedata.hpp>
@@ -25,13 +25,31 @@
 #ifndef quantlib_montecarlo_model_hpp
 #define quantlib_montecarlo_model_hpp
 
+#include <ql/math/array.hpp>
+#include <ql/math/matrix.hpp>
+#include <ql/math/statistics/sequencestatistics.hpp>
 #include <ql/math/statistics/statistics.hpp>
 #include <ql/methods/montecarlo/mctraits.hpp>
 #include <ql/shared_ptr.hpp>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace QuantLib {
 
+    namespace detail {
+
+        // number of independent randomizations drawn in turn by the
+        // generators of the given traits; 1 unless RNG declares it
+        template <class RNG, class = void>
+        struct rng_replicates : std::integral_constant<Size, 1> {};
+
+        template <class RNG>
+        struct rng_replicates<RNG, std::void_t<decltype(RNG::replicates)>>
+        : std::integral_constant<Size, RNG::replicates> {};
+
+    }
+
     //! General-purpose Monte Carlo model for path samples
     /*! The template arguments of this class correspond to available
         policies for the particular model to be instantiated---i.e.,
@@ -46,6 +64,26 @@ namespace QuantLib {
         provide the additional control option, namely the option path
         pricer and the option value.
 
+        A sensitivity path pricer can also be given; it is evaluated
+        on the same paths as the option path pricer, and its results
+        (e.g., pathwise or likelihood-ratio estimates of the Greeks)
+        are collected in a separate accumulator.
+
+        Several control variates can be used together by providing a
+        path pricer returning their values on each path, together with
+        their known expected values.  In this case, the optimal
+        coefficients \f$ \beta \f$ are estimated by regressing the
+        option values on the controls over the first batch of samples
+        (see Glasserman, Monte Carlo Methods in Financial Engineering,
+        section 4.1) and are then kept fixed; each sample is adjusted
+        as \f$ Y - \beta^T (C - E[C]) \f$.
+
+        If the random-number traits declare a number of replicates
+        (as for randomized quasi-Monte Carlo) the samples from each
+        replicate are averaged separately, and the sample accumulator
+        collects the replicate averages; its mean and error estimate
+        are then those of the randomized estimator.
+
         \ingroup mcarlo
     */
     template <template <class> class MC, class RNG, class S = Statistics>
@@ -58,6 +96,10 @@ namespace QuantLib {
         typedef typename path_generator_type::sample_type sample_type;
         typedef typename path_pricer_type::result_type result_type;
         typedef S stats_type;
+        typedef PathPricer<typename MC<RNG>::path_type, Array>
+            sensitivity_pricer_type;
+        typedef PathPricer<typename MC<RNG>::path_type, Array>
+            control_variates_pricer_type;
         // constructor
         MonteCarloModel(
             ext::shared_ptr<path_generator_type> pathGenerator,
@@ -67,16 +109,46 @@ namespace QuantLib {
             ext::shared_ptr<path_pricer_type> cvPathPricer = ext::shared_ptr<path_pricer_type>(),
             result_type cvOptionValue = result_type(),
             ext::shared_ptr<path_generator_type> cvPathGenerator =
-                ext::shared_ptr<path_generator_type>())
+                ext::shared_ptr<path_generator_type>(),
+            ext::shared_ptr<sensitivity_pricer_type> sensitivityPathPricer =
+                ext::shared_ptr<sensitivity_pricer_type>(),
+            ext::shared_ptr<control_variates_pricer_type> cvsPathPricer =
+                ext::shared_ptr<control_variates_pricer_type>(),
+            Array cvsValues = Array())
         : pathGenerator_(std::move(pathGenerator)), pathPricer_(std::move(pathPricer)),
           sampleAccumulator_(std::move(sampleAccumulator)), isAntitheticVariate_(antitheticVariate),
           cvPathPricer_(std::move(cvPathPricer)), cvOptionValue_(cvOptionValue),
-          cvPathGenerator_(std::move(cvPathGenerator)) {
+          cvPathGenerator_(std::move(cvPathGenerator)),
+          sensitivityPathPricer_(std::move(sensitivityPathPricer)),
+          cvsPathPricer_(std::move(cvsPathPricer)),
+          cvsValues_(std::move(cvsValues)) {
             isControlVariate_ = static_cast<bool>(cvPathPricer_);
+            QL_REQUIRE(!cvsPathPricer_ || !cvsValues_.empty(),
+                       "control-variate values not given");
+            if (replicates() > 1)
+                replicateAccumulators_.resize(replicates(),
+                                              sampleAccumulator_);
         }
         void addSamples(Size samples);
         const stats_type& sampleAccumulator() const;
+        //! number of samples simulated so far
+        Size samples() const;
+        //! number of independent randomizations of the samples
+        static constexpr Size replicates() {
+            return detail::rng_replicates<RNG>::value;
+        }
+        //! accumulator of the samples drawn from the given replicate
+        const stats_type& replicateAccumulator(Size i) const;
+        //! accumulator of the results of the sensitivity path pricer
+        const SequenceStatisticsInc& sensitivityAccumulator() const;
+        //! regression coefficients of the control variates
+        /*! This is empty until the first batch of samples is drawn. */
+        const Array& controlVariatesCoefficients() const {
+            return cvsCoefficients_;
+        }
       private:
+        void add(const result_type& price, Real weight);
+        void estimateControlVariatesCoefficients();
         ext::shared_ptr<path_generator_type> pathGenerator_;
         ext::shared_ptr<path_pricer_type> pathPricer_;
         stats_type sampleAccumulator_;
@@ -85,6 +157,16 @@ namespace QuantLib {
         result_type cvOptionValue_;
         bool isControlVariate_;
         ext::shared_ptr<path_generator_type> cvPathGenerator_;
+        std::vector<stats_type> replicateAccumulators_;
+        Size nextReplicate_ = 0;
+        ext::shared_ptr<sensitivity_pricer_type> sensitivityPathPricer_;
+        SequenceStatisticsInc sensitivityAccumulator_;
+        ext::shared_ptr<control_variates_pricer_type> cvsPathPricer_;
+        Array cvsValues_, cvsCoefficients_;
+        // first batch of samples, kept until the coefficients are known
+        std::vector<result_type> pilotPrices_;
+        std::vector<Array> pilotControls_;
+        std::vector<Real> pilotWeights_;
     };
 
     // inline definitions
@@ -94,6 +176,11 @@ namespace QuantLib {
 
             const sample_type& path = pathGenerator_->next();
             result_type price = (*pathPricer_)(path.value);
+            Array sensitivities, controls;
+            if (sensitivityPathPricer_)
+                sensitivities = (*sensitivityPathPricer_)(path.value);
+            if (cvsPathPricer_)
+                controls = (*cvsPathPricer_)(path.value);
 
             if (isControlVariate_) {
                 if (!cvPathGenerator_) {
@@ -117,11 +204,93 @@ namespace QuantLib {
                     }
                 }
 
-                sampleAccumulator_.add((price+price2)/2.0, path.weight);
+                price = (price+price2)/2.0;
+                if (sensitivityPathPricer_) {
+                    sensitivities += (*sensitivityPathPricer_)(atPath.value);
+                    sensitivities /= 2.0;
+                }
+                if (cvsPathPricer_) {
+                    controls += (*cvsPathPricer_)(atPath.value);
+                    controls /= 2.0;
+                }
+            }
+
+            if (!cvsPathPricer_) {
+                add(price, path.weight);
+            } else if (!cvsCoefficients_.empty()) {
+                add(price - DotProduct(cvsCoefficients_, controls - cvsValues_),
+                    path.weight);
             } else {
-                sampleAccumulator_.add(price, path.weight);
+                QL_REQUIRE(controls.size() == cvsValues_.size(),
+                           "wrong number of control variates: "
+                           << controls.size() << " returned, "
+                           << cvsValues_.size() << " expected");
+                pilotPrices_.push_back(price);
+                pilotControls_.push_back(controls);
+                pilotWeights_.push_back(path.weight);
             }
+
+            if (sensitivityPathPricer_)
+                sensitivityAccumulator_.add(sensitivities, path.weight);
+        }
+
+        if (cvsPathPricer_ && cvsCoefficients_.empty())
+            estimateControlVariatesCoefficients();
+
+        if (replicates() > 1) {
+            sampleAccumulator_.reset();
+            for (const auto& accumulator : replicateAccumulators_)
+                if (accumulator.samples() > 0)
+                    sampleAccumulator_.add(accumulator.mean());
+        }
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline void MonteCarloModel<MC,RNG,S>::add(const result_type& price,
+                                               Real weight) {
+        if (replicates() > 1) {
+            // generators draw from their replicates in turn
+            replicateAccumulators_[nextReplicate_].add(price, weight);
+            nextReplicate_ = (nextReplicate_ + 1) % replicates();
+        } else {
+            sampleAccumulator_.add(price, weight);
+        }
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline void
+    MonteCarloModel<MC,RNG,S>::estimateControlVariatesCoefficients() {
+        Size n = cvsValues_.size();
+        QL_REQUIRE(pilotPrices_.size() > n+1,
+                   "at least " << n+2 << " samples required to estimate "
+                   "the control-variate coefficients");
+
+        // joint covariance of the controls and of the option value
+        SequenceStatistics pilot(n+1);
+        std::vector<Real> sample(n+1);
+        for (Size i=0; i<pilotPrices_.size(); ++i) {
+            std::copy(pilotControls_[i].begin(), pilotControls_[i].end(),
+                      sample.begin());
+            sample[n] = pilotPrices_[i];
+            pilot.add(sample, pilotWeights_[i]);
+        }
+        Matrix covariance = pilot.covariance();
+        Matrix controlsCovariance(n, n);
+        Array crossCovariance(n);
+        for (Size i=0; i<n; ++i) {
+            for (Size j=0; j<n; ++j)
+                controlsCovariance[i][j] = covariance[i][j];
+            crossCovariance[i] = covariance[i][n];
         }
+        cvsCoefficients_ = inverse(controlsCovariance) * crossCovariance;
+
+        for (Size i=0; i<pilotPrices_.size(); ++i)
+            add(pilotPrices_[i]
+                - DotProduct(cvsCoefficients_, pilotControls_[i] - cvsValues_),
+                pilotWeights_[i]);
+        pilotPrices_.clear();
+        pilotControls_.clear();
+        pilotWeights_.clear();
     }
 
     template <template <class> class MC, class RNG, class S>
@@ -130,6 +299,31 @@ namespace QuantLib {
         return sampleAccumulator_;
     }
 
+    template <template <class> class MC, class RNG, class S>
+    inline const SequenceStatisticsInc&
+    MonteCarloModel<MC,RNG,S>::sensitivityAccumulator() const {
+        return sensitivityAccumulator_;
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline Size MonteCarloModel<MC,RNG,S>::samples() const {
+        if (replicates() > 1) {
+            Size n = 0;
+            for (const auto& accumulator : replicateAccumulators_)
+                n += accumulator.samples();
+            return n;
+        }
+        return sampleAccumulator_.samples();
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline const typename MonteCarloModel<MC,RNG,S>::stats_type&
+    MonteCarloModel<MC,RNG,S>::replicateAccumulator(Size i) const {
+        QL_REQUIRE(i < replicateAccumulators_.size(),
+                   "replicate " << i << " out of range");
+        return replicateAccumulators_[i];
+    }
+
 }
 
 
@@ -0,0 +1,174 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file multilevelmontecarlomodel.hpp
+    \brief Multi-level Monte Carlo model
+*/
+
+#ifndef quantlib_multilevel_montecarlo_model_hpp
+#define quantlib_multilevel_montecarlo_model_hpp
+
+#include <ql/math/statistics/statistics.hpp>
+#include <ql/methods/montecarlo/mctraits.hpp>
+#include <ql/methods/montecarlo/multilevelpathgenerator.hpp>
+#include <ql/shared_ptr.hpp>
+#include <cmath>
+#include <utility>
+
+namespace QuantLib {
+
+    //! Multi-level Monte Carlo model
+    /*! The model holds a hierarchy of levels of increasing time
+        resolution.  On level \f$ l>0 \f$ it samples the correction
+        \f$ P_l - P_{l-1} \f$ between the payoff on the fine grid and
+        the payoff on the coupled coarse grid; on level 0 it samples
+        the payoff itself. The telescoping sum of the level means is
+        an estimator of the payoff on the finest level.
+
+        See M.B. Giles, <i>Multilevel Monte Carlo path
+        simulation</i>, Operations Research 56(3), 2008, pp. 607-617.
+
+        \ingroup mcarlo
+    */
+    template <template <class> class MC, class RNG, class S = Statistics>
+    class MultiLevelMonteCarloModel {
+      public:
+        typedef MC<RNG> mc_traits;
+        typedef RNG rng_traits;
+        typedef typename MC<RNG>::path_type path_type;
+        typedef MultiLevelPathGenerator<path_type, typename RNG::rsg_type>
+            path_generator_type;
+        typedef typename MC<RNG>::path_pricer_type path_pricer_type;
+        typedef typename path_generator_type::sample_type sample_type;
+        typedef typename path_pricer_type::result_type result_type;
+        typedef S stats_type;
+
+        MultiLevelMonteCarloModel() = default;
+        //! adds the next finer level
+        /*! The coarse pricer is used on the coarse paths and must be
+            null for the first level only.
+        */
+        void addLevel(
+            ext::shared_ptr<path_generator_type> pathGenerator,
+            ext::shared_ptr<path_pricer_type> finePathPricer,
+            ext::shared_ptr<path_pricer_type> coarsePathPricer =
+                ext::shared_ptr<path_pricer_type>());
+        void addSamples(Size level, Size samples);
+        //! \name inspectors
+        //@{
+        Size levels() const { return levels_.size(); }
+        const stats_type& levelAccumulator(Size level) const;
+        //! relative cost of a sample on the given level
+        Real levelCost(Size level) const;
+        //! sum of the level means
+        result_type mean() const;
+        //! standard error of the multi-level estimator
+        result_type errorEstimate() const;
+        //@}
+      private:
+        struct Level {
+            ext::shared_ptr<path_generator_type> pathGenerator;
+            ext::shared_ptr<path_pricer_type> finePathPricer;
+            ext::shared_ptr<path_pricer_type> coarsePathPricer;
+            stats_type sampleAccumulator;
+            Real cost;
+        };
+        std::vector<Level> levels_;
+    };
+
+
+    // inline definitions
+
+    template <template <class> class MC, class RNG, class S>
+    inline void MultiLevelMonteCarloModel<MC,RNG,S>::addLevel(
+                    ext::shared_ptr<path_generator_type> pathGenerator,
+                    ext::shared_ptr<path_pricer_type> finePathPricer,
+                    ext::shared_ptr<path_pricer_type> coarsePathPricer) {
+        QL_REQUIRE(pathGenerator, "null path generator given");
+        QL_REQUIRE(finePathPricer, "null path pricer given");
+        QL_REQUIRE(levels_.empty() == !pathGenerator->hasCoarseLevel(),
+                   "only the first level can lack a coarse time grid");
+        QL_REQUIRE(levels_.empty() == !coarsePathPricer,
+                   "only the first level can lack a coarse path pricer");
+
+        Real cost = static_cast<Real>(pathGenerator->timeGrid().size()-1);
+        if (pathGenerator->hasCoarseLevel())
+            cost += static_cast<Real>(
+                pathGenerator->coarseTimeGrid().size()-1);
+
+        levels_.push_back({std::move(pathGenerator),
+                           std::move(finePathPricer),
+                           std::move(coarsePathPricer),
+                           stats_type(), cost});
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline void MultiLevelMonteCarloModel<MC,RNG,S>::addSamples(
+                                                Size level, Size samples) {
+        QL_REQUIRE(level < levels_.size(),
+                   "level " << level << " not available");
+        Level& l = levels_[level];
+        for (Size j=1; j<=samples; ++j) {
+            const sample_type& path = l.pathGenerator->next();
+            result_type price = (*l.finePathPricer)(path.value);
+            if (l.coarsePathPricer)
+                price -= (*l.coarsePathPricer)(
+                                        l.pathGenerator->coarse().value);
+            l.sampleAccumulator.add(price, path.weight);
+        }
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline const typename MultiLevelMonteCarloModel<MC,RNG,S>::stats_type&
+    MultiLevelMonteCarloModel<MC,RNG,S>::levelAccumulator(Size level) const {
+        QL_REQUIRE(level < levels_.size(),
+                   "level " << level << " not available");
+        return levels_[level].sampleAccumulator;
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline Real
+    MultiLevelMonteCarloModel<MC,RNG,S>::levelCost(Size level) const {
+        QL_REQUIRE(level < levels_.size(),
+                   "level " << level << " not available");
+        return levels_[level].cost;
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline typename MultiLevelMonteCarloModel<MC,RNG,S>::result_type
+    MultiLevelMonteCarloModel<MC,RNG,S>::mean() const {
+        result_type sum = result_type();
+        for (const auto& l : levels_)
+            sum += result_type(l.sampleAccumulator.mean());
+        return sum;
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline typename MultiLevelMonteCarloModel<MC,RNG,S>::result_type
+    MultiLevelMonteCarloModel<MC,RNG,S>::errorEstimate() const {
+        Real variance = 0.0;
+        for (const auto& l : levels_) {
+            Real error = l.sampleAccumulator.errorEstimate();
+            variance += error*error;
+        }
+        return result_type(std::sqrt(variance));
+    }
+
+}
+
+
+#endif
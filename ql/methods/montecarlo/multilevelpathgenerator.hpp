@@ -0,0 +1,216 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file multilevelpathgenerator.hpp
+    \brief Generates coupled fine and coarse paths for multi-level Monte Carlo
+*/
+
+#ifndef quantlib_multilevel_path_generator_hpp
+#define quantlib_multilevel_path_generator_hpp
+
+#include <ql/methods/montecarlo/multipath.hpp>
+#include <ql/methods/montecarlo/sample.hpp>
+#include <ql/stochasticprocess.hpp>
+#include <ql/math/comparison.hpp>
+#include <cmath>
+#include <utility>
+
+namespace QuantLib {
+
+    namespace detail {
+
+        template <class PathType>
+        class MultiLevelPathEvolver;
+
+        template <>
+        class MultiLevelPathEvolver<Path> {
+          public:
+            explicit MultiLevelPathEvolver(
+                                const ext::shared_ptr<StochasticProcess>& p)
+            : process_(ext::dynamic_pointer_cast<StochasticProcess1D>(p)) {
+                QL_REQUIRE(process_, "one-dimensional process required");
+            }
+            Size factors() const { return 1; }
+            Path path(const TimeGrid& grid) const { return Path(grid); }
+            void evolve(Path& path, const std::vector<Real>& dw) const {
+                const TimeGrid& grid = path.timeGrid();
+                path.front() = process_->x0();
+                for (Size i=1; i<path.length(); ++i)
+                    path[i] = process_->evolve(grid[i-1], path[i-1],
+                                               grid.dt(i-1), dw[i-1]);
+            }
+          private:
+            ext::shared_ptr<StochasticProcess1D> process_;
+        };
+
+        template <>
+        class MultiLevelPathEvolver<MultiPath> {
+          public:
+            explicit MultiLevelPathEvolver(
+                                ext::shared_ptr<StochasticProcess> p)
+            : process_(std::move(p)), dw_(process_->factors()) {}
+            Size factors() const { return process_->factors(); }
+            MultiPath path(const TimeGrid& grid) const {
+                return MultiPath(process_->size(), grid);
+            }
+            void evolve(MultiPath& path, const std::vector<Real>& dw) const {
+                const TimeGrid& grid = path[0].timeGrid();
+                const Size m = process_->size(), n = dw_.size();
+
+                Array asset = process_->initialValues();
+                for (Size j=0; j<m; ++j)
+                    path[j].front() = asset[j];
+
+                for (Size i=1; i<path.pathSize(); ++i) {
+                    std::copy(dw.begin()+(i-1)*n, dw.begin()+i*n,
+                              dw_.begin());
+                    asset = process_->evolve(grid[i-1], asset,
+                                             grid.dt(i-1), dw_);
+                    for (Size j=0; j<m; ++j)
+                        path[j][i] = asset[j];
+                }
+            }
+          private:
+            ext::shared_ptr<StochasticProcess> process_;
+            mutable Array dw_;
+        };
+
+    }
+
+    //! Generates coupled fine and coarse paths for multi-level Monte Carlo
+    /*! Each call to next() draws one set of Gaussian increments on the
+        fine time grid and evolves the process on it. The same
+        increments, aggregated over the fine steps spanned by each
+        coarse step, drive the path on the coarse time grid; this
+        gives the strong coupling between consecutive levels that
+        multi-level Monte Carlo relies upon.
+
+        The coarse grid must be a subset of the fine one; an empty
+        coarse grid denotes the coarsest level, for which no coarse
+        path is generated.
+
+        PathType can be either Path (for one-dimensional processes)
+        or MultiPath.  The sequence generator must have dimension
+        equal to the number of factors times the number of fine steps.
+
+        \ingroup mcarlo
+    */
+    template <class PathType, class GSG>
+    class MultiLevelPathGenerator {
+      public:
+        typedef Sample<PathType> sample_type;
+        MultiLevelPathGenerator(const ext::shared_ptr<StochasticProcess>&,
+                                const TimeGrid& fineGrid,
+                                const TimeGrid& coarseGrid,
+                                GSG generator);
+        //! \name inspectors
+        //@{
+        //! draws a new fine path and the coupled coarse path
+        const sample_type& next() const;
+        //! the coarse path coupled to the last fine path
+        const sample_type& coarse() const;
+        bool hasCoarseLevel() const { return !coarseGrid_.empty(); }
+        const TimeGrid& timeGrid() const { return fineGrid_; }
+        const TimeGrid& coarseTimeGrid() const { return coarseGrid_; }
+        Size size() const { return dimension_; }
+        //@}
+      private:
+        detail::MultiLevelPathEvolver<PathType> evolver_;
+        GSG generator_;
+        Size dimension_;
+        TimeGrid fineGrid_, coarseGrid_;
+        // first fine step spanned by each coarse step
+        std::vector<Size> coarseOffsets_;
+        std::vector<Real> sqrtDt_;
+        mutable sample_type next_, coarse_;
+        mutable std::vector<Real> temp_;
+    };
+
+
+    // template definitions
+
+    template <class PathType, class GSG>
+    MultiLevelPathGenerator<PathType, GSG>::MultiLevelPathGenerator(
+                        const ext::shared_ptr<StochasticProcess>& process,
+                        const TimeGrid& fineGrid,
+                        const TimeGrid& coarseGrid,
+                        GSG generator)
+    : evolver_(process), generator_(std::move(generator)),
+      dimension_(generator_.dimension()), fineGrid_(fineGrid),
+      coarseGrid_(coarseGrid), sqrtDt_(fineGrid_.size()-1),
+      next_(evolver_.path(fineGrid_), 1.0),
+      coarse_(evolver_.path(coarseGrid_.empty() ? fineGrid_ : coarseGrid_),
+              1.0),
+      temp_(coarseGrid_.empty() ? 0 :
+                (coarseGrid_.size()-1)*evolver_.factors()) {
+        QL_REQUIRE(dimension_ == evolver_.factors()*(fineGrid_.size()-1),
+                   "sequence generator dimensionality (" << dimension_
+                   << ") != factors times timeSteps ("
+                   << evolver_.factors()*(fineGrid_.size()-1) << ")");
+
+        for (Size i=0; i<sqrtDt_.size(); ++i)
+            sqrtDt_[i] = std::sqrt(fineGrid_.dt(i));
+
+        if (!coarseGrid_.empty()) {
+            QL_REQUIRE(close_enough(coarseGrid_.front(), fineGrid_.front())
+                       && close_enough(coarseGrid_.back(), fineGrid_.back()),
+                       "coarse and fine time grids must span the same "
+                       "interval");
+            coarseOffsets_.resize(coarseGrid_.size());
+            for (Size k=0; k<coarseGrid_.size(); ++k)
+                coarseOffsets_[k] = fineGrid_.index(coarseGrid_[k]);
+        }
+    }
+
+    template <class PathType, class GSG>
+    const typename MultiLevelPathGenerator<PathType, GSG>::sample_type&
+    MultiLevelPathGenerator<PathType, GSG>::next() const {
+
+        typedef typename GSG::sample_type sequence_type;
+        const sequence_type& sequence = generator_.nextSequence();
+
+        next_.weight = coarse_.weight = sequence.weight;
+        evolver_.evolve(next_.value, sequence.value);
+
+        if (!coarseGrid_.empty()) {
+            const Size n = evolver_.factors();
+            for (Size k=0; k+1<coarseOffsets_.size(); ++k) {
+                const Real sqrtDt = std::sqrt(coarseGrid_.dt(k));
+                for (Size j=0; j<n; ++j) {
+                    Real dw = 0.0;
+                    for (Size i=coarseOffsets_[k]; i<coarseOffsets_[k+1]; ++i)
+                        dw += sequence.value[i*n+j]*sqrtDt_[i];
+                    temp_[k*n+j] = dw/sqrtDt;
+                }
+            }
+            evolver_.evolve(coarse_.value, temp_);
+        }
+
+        return next_;
+    }
+
+    template <class PathType, class GSG>
+    const typename MultiLevelPathGenerator<PathType, GSG>::sample_type&
+    MultiLevelPathGenerator<PathType, GSG>::coarse() const {
+        QL_REQUIRE(!coarseGrid_.empty(), "no coarse level available");
+        return coarse_;
+    }
+
+}
+
+
+#endif
@@ -25,9 +25,13 @@
 #ifndef quantlib_montecarlo_path_pricer_hpp
 #define quantlib_montecarlo_path_pricer_hpp
 
+#include <ql/math/array.hpp>
 #include <ql/option.hpp>
+#include <ql/shared_ptr.hpp>
 #include <ql/types.hpp>
 #include <functional>
+#include <utility>
+#include <vector>
 
 namespace QuantLib {
 
@@ -45,6 +49,28 @@ namespace QuantLib {
         virtual ValueType operator()(const PathType& path) const=0;
     };
 
+    //! collects the values of several path pricers on the same path
+    /*! This can be used, e.g., to pass a number of control variates
+        to MonteCarloModel.
+
+        \ingroup mcarlo
+    */
+    template<class PathType>
+    class CompositePathPricer : public PathPricer<PathType, Array> {
+      public:
+        explicit CompositePathPricer(
+            std::vector<ext::shared_ptr<PathPricer<PathType> > > pricers)
+        : pricers_(std::move(pricers)) {}
+        Array operator()(const PathType& path) const override {
+            Array result(pricers_.size());
+            for (Size i=0; i<pricers_.size(); ++i)
+                result[i] = (*pricers_[i])(path);
+            return result;
+        }
+      private:
+        std::vector<ext::shared_ptr<PathPricer<PathType> > > pricers_;
+    };
+
 }
 
 
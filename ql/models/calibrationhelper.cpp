@@ -50,14 +50,41 @@ namespace QuantLib {
     }
 
     Real BlackCalibrationHelper::calibrationError() {
+        return calibrationError(modelValue(), nullptr);
+    }
+
+    Real BlackCalibrationHelper::calibrationErrorAndGradient(Array& gradient) {
+        const Real modelPrice = modelValueAndGradient(gradient);
+        if (gradient.empty())
+            return calibrationError(modelPrice, nullptr);
+
+        Real slope;
+        const Real error = calibrationError(modelPrice, &slope);
+        gradient *= slope;
+        return error;
+    }
+
+    Real BlackCalibrationHelper::blackVega(Volatility volatility) const {
+        const Volatility h = 1e-4*volatility;
+        return (blackPrice(volatility + h) - blackPrice(volatility - h))/(2*h);
+    }
+
+    Real BlackCalibrationHelper::calibrationError(Real modelPrice,
+                                                  Real* slope) const {
+        // slope is the derivative of the error w.r.t. the model price
         Real error;
-        
+
         switch (calibrationErrorType_) {
           case RelativePriceError:
-            error = std::fabs(marketValue() - modelValue())/marketValue();
+            error = std::fabs(marketValue() - modelPrice)/marketValue();
+            if (slope != nullptr)
+                *slope = (modelPrice >= marketValue() ? 1.0 : -1.0)
+                    / marketValue();
             break;
           case PriceError:
-            error = marketValue() - modelValue();
+            error = marketValue() - modelPrice;
+            if (slope != nullptr)
+                *slope = -1.0;
             break;
           case ImpliedVolError: 
             {
@@ -65,7 +92,6 @@ namespace QuantLib {
               Real maxVol = volatilityType_ == ShiftedLognormal ? 10.0 : 0.50;
               const Real lowerPrice = blackPrice(minVol);
               const Real upperPrice = blackPrice(maxVol);
-              const Real modelPrice = modelValue();
 
               Volatility implied;
               if (modelPrice <= lowerPrice)
@@ -76,6 +102,16 @@ namespace QuantLib {
                   implied = this->impliedVolatility(
                                           modelPrice, 1e-12, 5000, minVol, maxVol);
               error = implied - volatility_->value();
+
+              if (slope != nullptr) {
+                  if (modelPrice <= lowerPrice || modelPrice >= upperPrice) {
+                      *slope = 0.0;
+                  } else {
+                      // inverse of the vega at the implied volatility
+                      const Real vega = blackVega(implied);
+                      *slope = (vega > 0.0) ? Real(1.0/vega) : Real(0.0);
+                  }
+              }
             }
             break;
           default:
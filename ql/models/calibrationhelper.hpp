@@ -25,6 +25,7 @@
 #ifndef quantlib_interest_rate_modelling_calibration_helper_h
 #define quantlib_interest_rate_modelling_calibration_helper_h
 
+#include <ql/math/array.hpp>
 #include <ql/patterns/lazyobject.hpp>
 #include <ql/quote.hpp>
 #include <ql/termstructures/volatility/volatilitytype.hpp>
@@ -42,6 +43,17 @@ namespace QuantLib {
         virtual ~CalibrationHelper() = default;
         //! returns the error resulting from the model valuation
         virtual Real calibrationError() = 0;
+        //! returns the error and, if available, its gradient
+        /*! The gradient is taken with respect to the full set of
+            model parameters, see CalibratedModel::params(); it is
+            left empty when it cannot be computed analytically, in
+            which case the calibration falls back to finite
+            differences.
+        */
+        virtual Real calibrationErrorAndGradient(Array& gradient) {
+            gradient = Array();
+            return calibrationError();
+        }
     };
 
     //! liquid Black76 market instrument used during calibration
@@ -75,8 +87,19 @@ namespace QuantLib {
         //! returns the price of the instrument according to the model
         virtual Real modelValue() const = 0;
 
+        //! returns the model price and, if available, its gradient
+        /*! The gradient with respect to the model parameters is
+            left empty unless the pricing engine provides it as the
+            "modelParameterGradient" additional result.
+        */
+        virtual Real modelValueAndGradient(Array& gradient) const {
+            gradient = Array();
+            return modelValue();
+        }
+
         //! returns the error resulting from the model valuation
         Real calibrationError() override;
+        Real calibrationErrorAndGradient(Array& gradient) override;
 
         virtual void addTimesTo(std::list<Time>& times) const = 0;
 
@@ -90,9 +113,19 @@ namespace QuantLib {
         //! Black or Bachelier price given a volatility
         virtual Real blackPrice(Volatility volatility) const = 0;
 
+        //! derivative of the Black or Bachelier price w.r.t. the volatility
+        /*! The default implementation approximates it by central
+            finite differences of blackPrice(); derived classes
+            providing analytic gradients override it in closed form.
+        */
+        virtual Real blackVega(Volatility volatility) const;
+
         void setPricingEngine(const ext::shared_ptr<PricingEngine>& engine) {
             engine_ = engine;
         }
+        const ext::shared_ptr<PricingEngine>& pricingEngine() const {
+            return engine_;
+        }
 
       protected:
         mutable Real marketValue_;
@@ -103,6 +136,7 @@ namespace QuantLib {
 
       private:
         class ImpliedVolatilityHelper;
+        Real calibrationError(Real modelPrice, Real* slope) const;
         const CalibrationErrorType calibrationErrorType_;
     };
 
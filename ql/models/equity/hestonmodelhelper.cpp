@@ -83,6 +83,16 @@ namespace QuantLib {
         return option_->NPV();
     }
 
+    Real HestonModelHelper::modelValueAndGradient(Array& gradient) const {
+        const Real value = modelValue();
+        const std::map<std::string, ext::any>& results =
+            option_->additionalResults();
+        const auto iter = results.find("modelParameterGradient");
+        gradient = (iter != results.end())
+            ? ext::any_cast<Array>(iter->second) : Array();
+        return value;
+    }
+
     Real HestonModelHelper::blackPrice(Real volatility) const {
         calculate();
         const Real stdDev = volatility * std::sqrt(maturity());
@@ -90,5 +100,13 @@ namespace QuantLib {
             type_, strikePrice_ * riskFreeRate_->discount(tau_),
             s0_->value() * dividendYield_->discount(tau_), stdDev);
     }
+
+    Real HestonModelHelper::blackVega(Real volatility) const {
+        calculate();
+        const Real stdDev = volatility * std::sqrt(maturity());
+        return std::sqrt(maturity()) * blackFormulaStdDevDerivative(
+            strikePrice_ * riskFreeRate_->discount(tau_),
+            s0_->value() * dividendYield_->discount(tau_), stdDev);
+    }
 }
 
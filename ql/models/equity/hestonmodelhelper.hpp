@@ -56,7 +56,9 @@ namespace QuantLib {
         void addTimesTo(std::list<Time>&) const override {}
         void performCalculations() const override;
         Real modelValue() const override;
+        Real modelValueAndGradient(Array& gradient) const override;
         Real blackPrice(Real volatility) const override;
+        Real blackVega(Real volatility) const override;
         Time maturity() const  { calculate(); return tau_; }
       private:
         const Period maturity_;
@@ -22,13 +22,69 @@
 #include <ql/math/optimization/projectedconstraint.hpp>
 #include <ql/math/optimization/projection.hpp>
 #include <ql/models/model.hpp>
+#include <ql/utilities/exceptioncollector.hpp>
 #include <ql/utilities/null_deleter.hpp>
+#include <memory>
+#include <set>
 #include <utility>
 
 using std::vector;
 
 namespace QuantLib {
 
+    namespace {
+
+        // helpers sharing a pricing engine would overwrite each
+        // other's arguments and results if evaluated concurrently
+        bool shareEngines(
+                const vector<ext::shared_ptr<CalibrationHelper> >& helpers) {
+            std::set<const PricingEngine*> engines;
+            for (const auto& helper : helpers) {
+                const auto blackHelper =
+                    ext::dynamic_pointer_cast<BlackCalibrationHelper>(helper);
+                if (blackHelper != nullptr
+                    && blackHelper->pricingEngine() != nullptr
+                    && !engines.insert(
+                           blackHelper->pricingEngine().get()).second)
+                    return true;
+            }
+            return false;
+        }
+
+        // gives each helper sharing its pricing engine with a previous
+        // one a separate engine; the original ones are restored on exit
+        class SeparateEngines {
+          public:
+            SeparateEngines(
+                const vector<ext::shared_ptr<CalibrationHelper> >& helpers,
+                const std::function<ext::shared_ptr<PricingEngine>()>& factory) {
+                std::set<const PricingEngine*> engines;
+                for (const auto& helper : helpers) {
+                    const auto blackHelper =
+                        ext::dynamic_pointer_cast<BlackCalibrationHelper>(helper);
+                    if (blackHelper == nullptr
+                        || blackHelper->pricingEngine() == nullptr
+                        || engines.insert(
+                               blackHelper->pricingEngine().get()).second)
+                        continue;
+                    replaced_.emplace_back(blackHelper,
+                                           blackHelper->pricingEngine());
+                    blackHelper->setPricingEngine(factory());
+                }
+            }
+            ~SeparateEngines() {
+                for (const auto& r : replaced_)
+                    r.first->setPricingEngine(r.second);
+            }
+            SeparateEngines(const SeparateEngines&) = delete;
+            SeparateEngines& operator=(const SeparateEngines&) = delete;
+          private:
+            vector<std::pair<ext::shared_ptr<BlackCalibrationHelper>,
+                             ext::shared_ptr<PricingEngine> > > replaced_;
+        };
+
+    }
+
     CalibratedModel::CalibratedModel(Size nArguments)
     : arguments_(nArguments), constraint_(new PrivateConstraint(arguments_)) {}
 
@@ -37,39 +93,151 @@ namespace QuantLib {
         CalibrationFunction(CalibratedModel* model,
                             const vector<ext::shared_ptr<CalibrationHelper> >& h,
                             vector<Real> weights,
-                            const Projection& projection)
+                            const Projection& projection,
+                            bool parallel = false)
         : model_(model, null_deleter()), instruments_(h), weights_(std::move(weights)),
-          projection_(projection) {}
+          projection_(projection), parallel_(parallel && !shareEngines(h)) {}
 
         ~CalibrationFunction() override = default;
 
         Real value(const Array& params) const override {
             model_->setParams(projection_.include(params));
+            const Array errors = calibrationErrors();
             Real value = 0.0;
             for (Size i=0; i<instruments_.size(); i++) {
-                Real diff = instruments_[i]->calibrationError();
-                value += diff*diff*weights_[i];
+                value += errors[i]*errors[i]*weights_[i];
             }
             return std::sqrt(value);
         }
 
         Array values(const Array& params) const override {
             model_->setParams(projection_.include(params));
-            Array values(instruments_.size());
+            Array values = calibrationErrors();
             for (Size i=0; i<instruments_.size(); i++) {
-                values[i] = instruments_[i]->calibrationError()
-                           *std::sqrt(weights_[i]);
+                values[i] *= std::sqrt(weights_[i]);
             }
             return values;
         }
 
+        void gradient(Array& grad, const Array& params) const override {
+            valueAndGradient(grad, params);
+        }
+
+        Real valueAndGradient(Array& grad,
+                              const Array& params) const override {
+            Array errors;
+            Matrix gradients;
+            if (!errorsAndGradients(params, errors, gradients)) {
+                CostFunction::gradient(grad, params);
+                return value(params);
+            }
+
+            Real value = 0.0;
+            for (Size i=0; i<instruments_.size(); i++)
+                value += errors[i]*errors[i]*weights_[i];
+            value = std::sqrt(value);
+
+            std::fill(grad.begin(), grad.end(), 0.0);
+            if (value > 0.0) {
+                for (Size i=0; i<instruments_.size(); i++)
+                    for (Size j=0; j<grad.size(); j++)
+                        grad[j] += weights_[i]*errors[i]*gradients[i][j]/value;
+            }
+            return value;
+        }
+
+        void jacobian(Matrix& jac, const Array& params) const override {
+            valuesAndJacobian(jac, params);
+        }
+
+        Array valuesAndJacobian(Matrix& jac,
+                                const Array& params) const override {
+            Array errors;
+            if (!errorsAndGradients(params, errors, jac)) {
+                CostFunction::jacobian(jac, params);
+                return values(params);
+            }
+
+            for (Size i=0; i<instruments_.size(); i++) {
+                const Real w = std::sqrt(weights_[i]);
+                errors[i] *= w;
+                for (Size j=0; j<jac.columns(); j++)
+                    jac[i][j] *= w;
+            }
+            return errors;
+        }
+
         Real finiteDifferenceEpsilon() const override { return 1e-6; }
 
       private:
+        // errors and their gradients w.r.t. the free parameters;
+        // false if any helper cannot provide its gradient
+        bool errorsAndGradients(const Array& params,
+                                Array& errors, Matrix& gradients) const {
+            model_->setParams(projection_.include(params));
+
+            const Size n = instruments_.size();
+            errors = Array(n);
+            gradients = Matrix(n, params.size());
+            std::vector<Array> g(n);
+            errors[0] = instruments_[0]->calibrationErrorAndGradient(g[0]);
+            if (g[0].empty())
+                return false;
+            evaluate([&](Size i) {
+                errors[i] = instruments_[i]->calibrationErrorAndGradient(g[i]);
+            });
+
+            for (Size i=0; i<n; i++) {
+                if (g[i].empty())
+                    return false;
+                QL_REQUIRE(g[i].size() == model_->params().size(),
+                           "gradient size (" << g[i].size() << ") of "
+                           "calibration helper " << i << " does not match "
+                           "the number of model parameters ("
+                           << model_->params().size() << ")");
+                const Array projected = projection_.project(g[i]);
+                std::copy(projected.begin(), projected.end(),
+                          gradients.row_begin(i));
+            }
+            return true;
+        }
+
+        Array calibrationErrors() const {
+            const Size n = instruments_.size();
+            Array errors(n);
+            errors[0] = instruments_[0]->calibrationError();
+            evaluate([&](Size i) {
+                errors[i] = instruments_[i]->calibrationError();
+            });
+            return errors;
+        }
+
+        // calls f on all helpers but the first, concurrently if
+        // enabled.  The callers evaluate the first helper upfront so
+        // that lazy objects shared by all helpers, e.g. term
+        // structures, are not calculated concurrently.
+        template <class F>
+        void evaluate(const F& f) const {
+            const Size n = instruments_.size();
+            if (!parallel_) {
+                for (Size i=1; i<n; i++)
+                    f(i);
+                return;
+            }
+
+            ExceptionCollector exceptions(n);
+            #pragma omp parallel for schedule(dynamic)
+            for (long i=1; i<(long)n; i++) {
+                exceptions.run(i, [&]() { f(i); });
+            }
+            exceptions.rethrow();
+        }
+
         ext::shared_ptr<CalibratedModel> model_;
         const vector<ext::shared_ptr<CalibrationHelper> >& instruments_;
         vector<Real> weights_;
         const Projection projection_;
+        const bool parallel_;
     };
 
     void CalibratedModel::calibrate(
@@ -102,7 +270,11 @@ namespace QuantLib {
                    fixParameters.size() << ")");
         vector<bool> all(prms.size(), false);
         Projection proj(prms, !fixParameters.empty() ? fixParameters : all);
-        CalibrationFunction f(this,instruments,w,proj);
+        std::unique_ptr<SeparateEngines> separateEngines;
+        if (parallelCalibration_ && parallelEngineFactory_)
+            separateEngines = std::make_unique<SeparateEngines>(
+                instruments, parallelEngineFactory_);
+        CalibrationFunction f(this,instruments,w,proj,parallelCalibration_);
         ProjectedConstraint pc(c,proj);
         Problem prob(f, pc, proj.project(prms));
         shortRateEndCriteria_ = method.minimize(prob, endCriteria);
@@ -31,6 +31,7 @@
 #include <ql/models/calibrationhelper.hpp>
 #include <ql/models/parameter.hpp>
 #include <ql/option.hpp>
+#include <functional>
 #include <utility>
 
 namespace QuantLib {
@@ -121,6 +122,41 @@ namespace QuantLib {
         virtual void setParams(const Array& params);
         Integer functionEvaluation() const { return functionEvaluation_; }
 
+        //! evaluate the calibration helpers concurrently
+        /*! When enabled (and OpenMP is available) the helpers are
+            evaluated in parallel within each cost-function call,
+            including the evaluation of their analytic gradients.  The
+            model parameters are set before each evaluation.  The
+            first helper is evaluated upfront, so that lazy objects
+            shared by all helpers, e.g., term structures or a tree
+            taken from a ShortRateTreeCache, are calculated before the
+            others run concurrently.
+
+            Pricing engines store their arguments and results, so
+            Black calibration helpers must not share an engine while
+            evaluated concurrently.  If an engine factory is given,
+            each helper sharing its engine with a previous one gets a
+            separate engine from the factory for the duration of the
+            calibration; the usual setup of a single engine for all
+            helpers is thus evaluated in parallel.  Without a factory,
+            helpers sharing an engine are evaluated sequentially.
+
+            \warning the engines must not share any other mutable
+                     state, and the model must only be read while
+                     pricing; e.g., lattice engines building their own
+                     tree or using a ShortRateTreeCache are safe.
+        */
+        void enableParallelCalibration(
+                bool enable = true,
+                std::function<ext::shared_ptr<PricingEngine>()>
+                    engineFactory = {}) {
+            parallelCalibration_ = enable;
+            parallelEngineFactory_ = std::move(engineFactory);
+        }
+        bool parallelCalibrationEnabled() const {
+            return parallelCalibration_;
+        }
+
       protected:
         virtual void generateArguments() {}
         std::vector<Parameter> arguments_;
@@ -130,6 +166,8 @@ namespace QuantLib {
         Integer functionEvaluation_;
 
       private:
+        bool parallelCalibration_ = false;
+        std::function<ext::shared_ptr<PricingEngine>()> parallelEngineFactory_;
         //! Constraint imposed on arguments
         class PrivateConstraint;
         //! Calibration cost function class
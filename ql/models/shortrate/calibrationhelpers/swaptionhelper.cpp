@@ -126,27 +126,45 @@ namespace QuantLib {
         return swaption_->NPV();
     }
 
+    Real SwaptionHelper::modelValueAndGradient(Array& gradient) const {
+        const Real value = modelValue();
+        const std::map<std::string, ext::any>& results =
+            swaption_->additionalResults();
+        const auto iter = results.find("modelParameterGradient");
+        gradient = (iter != results.end())
+            ? ext::any_cast<Array>(iter->second) : Array();
+        return value;
+    }
+
     Real SwaptionHelper::blackPrice(Volatility sigma) const {
         calculate();
+        swaption_->setPricingEngine(blackEngine(sigma));
+        Real value = swaption_->NPV();
+        swaption_->setPricingEngine(engine_);
+        return value;
+    }
+
+    Real SwaptionHelper::blackVega(Volatility sigma) const {
+        calculate();
+        swaption_->setPricingEngine(blackEngine(sigma));
+        Real vega = swaption_->result<Real>("vega");
+        swaption_->setPricingEngine(engine_);
+        return vega;
+    }
+
+    ext::shared_ptr<PricingEngine>
+    SwaptionHelper::blackEngine(Volatility sigma) const {
         Handle<Quote> vol(ext::shared_ptr<Quote>(new SimpleQuote(sigma)));
-        ext::shared_ptr<PricingEngine> engine;
         switch(volatilityType_) {
         case ShiftedLognormal:
-            engine = ext::make_shared<BlackSwaptionEngine>(
+            return ext::make_shared<BlackSwaptionEngine>(
                 termStructure_, vol, Actual365Fixed(), shift_);
-            break;
         case Normal:
-            engine = ext::make_shared<BachelierSwaptionEngine>(
+            return ext::make_shared<BachelierSwaptionEngine>(
                 termStructure_, vol, Actual365Fixed());
-            break;
         default:
             QL_FAIL("can not construct engine: " << volatilityType_);
-            break;
         }
-        swaption_->setPricingEngine(engine);
-        Real value = swaption_->NPV();
-        swaption_->setPricingEngine(engine_);
-        return value;
     }
 
     void SwaptionHelper::performCalculations() const {
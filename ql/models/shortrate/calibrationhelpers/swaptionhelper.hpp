@@ -91,7 +91,9 @@ namespace QuantLib {
 
         void addTimesTo(std::list<Time>& times) const override;
         Real modelValue() const override;
+        Real modelValueAndGradient(Array& gradient) const override;
         Real blackPrice(Volatility volatility) const override;
+        Real blackVega(Volatility volatility) const override;
 
         const ext::shared_ptr<FixedVsFloatingSwap>& underlying() const {
             calculate();
@@ -101,6 +103,7 @@ namespace QuantLib {
 
       private:
         void performCalculations() const override;
+        ext::shared_ptr<PricingEngine> blackEngine(Volatility volatility) const;
         ext::shared_ptr<FixedVsFloatingSwap> makeSwap(Schedule fixedSchedule,
                                                       Schedule floatSchedule,
                                                       Rate exerciseRate,
@@ -75,13 +75,16 @@ namespace QuantLib {
             // vMax = value + 1.0;
             theta->change(value);
         }
+        enableTransitionTables();
     }
 
     OneFactorModel::ShortRateTree::ShortRateTree(const ext::shared_ptr<TrinomialTree>& tree,
                                                  ext::shared_ptr<ShortRateDynamics> dynamics,
                                                  const TimeGrid& timeGrid)
     : TreeLattice1D<OneFactorModel::ShortRateTree>(timeGrid, tree->size(1)), tree_(tree),
-      dynamics_(std::move(dynamics)), spread_(0.0) {}
+      dynamics_(std::move(dynamics)), spread_(0.0) {
+        enableTransitionTables();
+    }
 
     OneFactorModel::OneFactorModel(Size nArguments)
     : ShortRateModel(nArguments) {}
@@ -100,5 +103,17 @@ namespace QuantLib {
         return discountBond(0.0, t, r0);
     }
 
+    void OneFactorAffineModel::discountBondCoefficients(
+                                        Time now,
+                                        const std::vector<Time>& maturities,
+                                        Array& a, Array& b) const {
+        a.resize(maturities.size());
+        b.resize(maturities.size());
+        for (Size i=0; i<maturities.size(); ++i) {
+            a[i] = A(now, maturities[i]);
+            b[i] = B(now, maturities[i]);
+        }
+    }
+
 }
 
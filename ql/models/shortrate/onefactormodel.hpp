@@ -72,6 +72,10 @@ namespace QuantLib {
     };
 
     //! Recombining trinomial tree discretizing the state variable
+    /*! Flat transition tables are enabled once the tree is built, so
+        that repeated rollbacks do not recompute short rates and
+        discount factors; they are reset when the spread changes.
+    */
     class OneFactorModel::ShortRateTree
         : public TreeLattice1D<OneFactorModel::ShortRateTree> {
       public:
@@ -104,6 +108,8 @@ namespace QuantLib {
         }
         void setSpread(Spread spread)
         {
+            if (spread != spread_)
+                resetTransitionTables();
             spread_=spread;
         }
       private:
@@ -139,6 +145,17 @@ namespace QuantLib {
 
         DiscountFactor discount(Time t) const override;
 
+        //! coefficients of the discount bonds
+        /*! Returns the coefficients \f$ A_i, B_i \f$ such that
+            \f$ P(t, T_i) = A_i \exp(-B_i r) \f$ for all given
+            maturities.  Derived models can override this to share
+            the calculations that only depend on \f$ t \f$.
+        */
+        virtual void discountBondCoefficients(Time now,
+                                              const std::vector<Time>& maturities,
+                                              Array& a,
+                                              Array& b) const;
+
       protected:
         virtual Real A(Time t, Time T) const = 0;
         virtual Real B(Time t, Time T) const = 0;
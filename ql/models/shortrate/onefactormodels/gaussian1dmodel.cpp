@@ -50,6 +50,50 @@ namespace QuantLib {
                (dcf * zerobond(endDate, referenceDate, y, yts));
 }
 
+Array Gaussian1dModel::forwardRate(const Date& fixing,
+                                   const Date& referenceDate,
+                                   const Array& y,
+                                   const ext::shared_ptr<IborIndex>& iborIdx) const {
+
+    QL_REQUIRE(iborIdx != nullptr, "no ibor index given");
+
+    calculate();
+
+    if (fixing <= (evaluationDate_ + (enforcesTodaysHistoricFixings_ ? 0 : -1)))
+        return Array(y.size(), iborIdx->fixing(fixing));
+
+    Handle<YieldTermStructure> yts = iborIdx->forwardingTermStructure(); // might be empty, then
+                                                                         // use model curve
+
+    Date valueDate = iborIdx->valueDate(fixing);
+    Date endDate = iborIdx->fixingCalendar().advance(
+        valueDate, iborIdx->tenor(), iborIdx->businessDayConvention(), iborIdx->endOfMonth());
+    Real dcf = iborIdx->dayCounter().yearFraction(valueDate, endDate);
+
+    Array start = zerobond(valueDate, referenceDate, y, yts);
+    Array end = zerobond(endDate, referenceDate, y, yts);
+    Array result(y.size());
+    for (Size i = 0; i < y.size(); ++i)
+        result[i] = (start[i] - end[i]) / (dcf * end[i]);
+    return result;
+}
+
+Array Gaussian1dModel::numeraireArrayImpl(const Time t, const Array& y,
+                                          const Handle<YieldTermStructure>& yts) const {
+    Array result(y.size());
+    for (Size i = 0; i < y.size(); ++i)
+        result[i] = numeraireImpl(t, y[i], yts);
+    return result;
+}
+
+Array Gaussian1dModel::zerobondArrayImpl(const Time T, const Time t, const Array& y,
+                                         const Handle<YieldTermStructure>& yts) const {
+    Array result(y.size());
+    for (Size i = 0; i < y.size(); ++i)
+        result[i] = zerobondImpl(T, t, y[i], yts);
+    return result;
+}
+
 Real Gaussian1dModel::swapRate(const Date& fixing,
                                const Period& tenor,
                                const Date& referenceDate,
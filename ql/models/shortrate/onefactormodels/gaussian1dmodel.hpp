@@ -91,6 +91,29 @@ class Gaussian1dModel : public TermStructureConsistentModel, public LazyObject {
                   Real y = 0.0,
                   const Handle<YieldTermStructure>& yts = Handle<YieldTermStructure>()) const;
 
+    /*! Vectorized versions of the methods above for an array of
+        state variable values $y$. The parts which do not depend
+        on the state are computed only once, so that these should
+        be preferred when evaluating on a whole integration grid. */
+    Array numeraire(Time t,
+                    const Array& y,
+                    const Handle<YieldTermStructure>& yts = Handle<YieldTermStructure>()) const;
+
+    Array zerobond(Time T,
+                   Time t,
+                   const Array& y,
+                   const Handle<YieldTermStructure>& yts = Handle<YieldTermStructure>()) const;
+
+    Array zerobond(const Date& maturity,
+                   const Date& referenceDate,
+                   const Array& y,
+                   const Handle<YieldTermStructure>& yts = Handle<YieldTermStructure>()) const;
+
+    Array forwardRate(const Date& fixing,
+                      const Date& referenceDate,
+                      const Array& y,
+                      const ext::shared_ptr<IborIndex>& iborIdx) const;
+
     Real zerobondOption(const Option::Type& type,
                         const Date& expiry,
                         const Date& valueDate,
@@ -188,6 +211,17 @@ class Gaussian1dModel : public TermStructureConsistentModel, public LazyObject {
     virtual Real
     zerobondImpl(Time T, Time t, Real y, const Handle<YieldTermStructure>& yts) const = 0;
 
+    // the default implementations of the vectorized versions loop
+    // over the scalar ones, models may override them to share the
+    // state independent parts of the computation
+    virtual Array
+    numeraireArrayImpl(Time t, const Array& y, const Handle<YieldTermStructure>& yts) const;
+
+    virtual Array zerobondArrayImpl(Time T,
+                                    Time t,
+                                    const Array& y,
+                                    const Handle<YieldTermStructure>& yts) const;
+
     void performCalculations() const override {
         evaluationDate_ = Settings::instance().evaluationDate();
         enforcesTodaysHistoricFixings_ =
@@ -240,6 +274,30 @@ Gaussian1dModel::zerobond(const Time T, const Time t, const Real y,
     return zerobondImpl(T, t, y, yts);
 }
 
+inline Array
+Gaussian1dModel::numeraire(const Time t, const Array &y,
+                           const Handle<YieldTermStructure> &yts) const {
+
+    return numeraireArrayImpl(t, y, yts);
+}
+
+inline Array
+Gaussian1dModel::zerobond(const Time T, const Time t, const Array &y,
+                          const Handle<YieldTermStructure> &yts) const {
+    return zerobondArrayImpl(T, t, y, yts);
+}
+
+inline Array
+Gaussian1dModel::zerobond(const Date &maturity, const Date &referenceDate,
+                          const Array &y, const Handle<YieldTermStructure> &yts) const {
+
+    return zerobond(termStructure()->timeFromReference(maturity),
+                    referenceDate != Date()
+                        ? termStructure()->timeFromReference(referenceDate)
+                        : 0.0,
+                    y, yts);
+}
+
 inline Real
 Gaussian1dModel::numeraire(const Date &referenceDate, const Real y,
                            const Handle<YieldTermStructure> &yts) const {
@@ -201,6 +201,55 @@ Real Gsr::zerobondImpl(const Time T, const Time t, const Real y,
     return d * exp(-x * gtT - 0.5 * p->y(t) * gtT * gtT);
 }
 
+Array Gsr::zerobondArrayImpl(const Time T, const Time t, const Array &y,
+                             const Handle<YieldTermStructure> &yts) const {
+
+    calculate();
+
+    if (t == 0.0)
+        return Array(y.size(), yts.empty()
+                                   ? this->termStructure()->discount(T, true)
+                                   : yts->discount(T, true));
+
+    ext::shared_ptr<GsrProcess> p =
+        ext::dynamic_pointer_cast<GsrProcess>(stateProcess_);
+
+    // everything but x is independent of the state
+    Real stdDev = stateProcess_->stdDeviation(0.0, 0.0, t);
+    Real expectation = stateProcess_->expectation(0.0, 0.0, t);
+    Real gtT = p->G(t, T, 0.0);
+    Real adjustment = 0.5 * p->y(t) * gtT * gtT;
+
+    Real d = yts.empty()
+                 ? termStructure()->discount(T, true) /
+                       termStructure()->discount(t, true)
+                 : yts->discount(T, true) / yts->discount(t, true);
+
+    Array result(y.size());
+    for (Size i = 0; i < y.size(); ++i) {
+        Real x = y[i] * stdDev + expectation;
+        result[i] = d * exp(-x * gtT - adjustment);
+    }
+    return result;
+}
+
+Array Gsr::numeraireArrayImpl(const Time t, const Array &y,
+                              const Handle<YieldTermStructure> &yts) const {
+
+    calculate();
+
+    ext::shared_ptr<GsrProcess> p =
+        ext::dynamic_pointer_cast<GsrProcess>(stateProcess_);
+
+    if (t == 0)
+        return Array(y.size(),
+                     yts.empty()
+                         ? this->termStructure()->discount(p->getForwardMeasureTime(),
+                                                           true)
+                         : yts->discount(p->getForwardMeasureTime()));
+    return zerobond(p->getForwardMeasureTime(), t, y, yts);
+}
+
 Real Gsr::numeraireImpl(const Time t, const Real y,
                         const Handle<YieldTermStructure> &yts) const {
 
@@ -141,6 +141,15 @@ class Gsr : public Gaussian1dModel, public CalibratedModel {
 
     Real zerobondImpl(Time T, Time t, Real y, const Handle<YieldTermStructure>& yts) const override;
 
+    Array numeraireArrayImpl(Time t,
+                             const Array& y,
+                             const Handle<YieldTermStructure>& yts) const override;
+
+    Array zerobondArrayImpl(Time T,
+                            Time t,
+                            const Array& y,
+                            const Handle<YieldTermStructure>& yts) const override;
+
     void generateArguments() override {
         ext::static_pointer_cast<GsrProcess>(stateProcess_)->flushCache();
         notifyObservers();
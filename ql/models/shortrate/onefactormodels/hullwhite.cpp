@@ -82,6 +82,25 @@ namespace QuantLib {
         return std::exp(value)*discount2/discount1;
     }
 
+    void HullWhite::discountBondCoefficients(Time t,
+                                             const std::vector<Time>& maturities,
+                                             Array& a, Array& b) const {
+        a.resize(maturities.size());
+        b.resize(maturities.size());
+        DiscountFactor discount1 = termStructure()->discount(t);
+        Rate forward = termStructure()->forwardRate(t, t,
+                                                    Continuous, NoFrequency);
+        Real s = sigma();
+        Real b2t = B(0.0, 2.0*t);
+        for (Size i=0; i<maturities.size(); ++i) {
+            b[i] = B(t, maturities[i]);
+            Real temp = s*b[i];
+            Real value = b[i]*forward - 0.25*temp*temp*b2t;
+            a[i] = std::exp(value)
+                * termStructure()->discount(maturities[i])/discount1;
+        }
+    }
+
     void HullWhite::generateArguments() {
         phi_ = FittingParameter(termStructure(), a(), sigma());
     }
@@ -66,6 +66,14 @@ namespace QuantLib {
                                 Time bondStart,
                                 Time bondMaturity) const override;
 
+        /*! The term-structure discount and forward rate at the
+            given time are retrieved only once for all maturities.
+        */
+        void discountBondCoefficients(Time now,
+                                      const std::vector<Time>& maturities,
+                                      Array& a,
+                                      Array& b) const override;
+
         /*! Futures convexity bias (i.e., the difference between
             futures implied rate and forward rate) calculated as in
             G. Kirikos, D. Novak, "Convexity Conundrums", Risk
@@ -27,6 +27,8 @@
 #include <ql/termstructures/volatility/sabrinterpolatedsmilesection.hpp>
 #include <ql/termstructures/volatility/smilesection.hpp>
 #include <ql/termstructures/volatility/smilesectionutils.hpp>
+#include <ql/utilities/exceptioncollector.hpp>
+#include <algorithm>
 #include <utility>
 
 namespace QuantLib {
@@ -441,8 +443,28 @@ namespace QuantLib {
         QL_MFMESSAGE(modelOutputs_, "updating numeraire tabulation");
         modelOutputs_.dirty_ = true;
 
-        modelOutputs_.adjustmentFactors_.clear();
-        modelOutputs_.digitalsAdjustmentFactors_.clear();
+        Size nPoints = calibrationPoints_.size();
+        modelOutputs_.adjustmentFactors_.resize(nPoints, 1.0);
+        modelOutputs_.digitalsAdjustmentFactors_.resize(nPoints, 1.0);
+
+        Real numeraire0 = termStructure()->discount(numeraireTime_, true);
+
+        // the tabulation on a calibration time depends on the tabulations
+        // on the later calibration times; once a time had to be updated, all
+        // earlier times are updated as well
+        Array parameters = params();
+        bool changed = tabulationInputs_.size() != times_.size() ||
+                       tabulationTimes_ != times_ ||
+                       tabulationParameters_.size() != parameters.size() ||
+                       !std::equal(parameters.begin(), parameters.end(),
+                                   tabulationParameters_.begin()) ||
+                       tabulationNumeraire_ != numeraire0;
+        if (changed) {
+            tabulationInputs_ = std::vector<TabulationInputs>(times_.size());
+            tabulationTimes_ = times_;
+            tabulationParameters_ = parameters;
+            tabulationNumeraire_ = numeraire0;
+        }
 
         int idx = times_.size() - 2;
 
@@ -456,12 +478,26 @@ namespace QuantLib {
                            "no CustomSmileSection given, this is unexpected...");
             }
 
+            if (!changed &&
+                numeraireTabulationIsCurrent(idx, i->first, i->second))
+                continue;
+            changed = true;
+
+            tabulationInputs_[idx].rates.clear();
+
+            TabulationInputs inputs;
+            inputs.discount = termStructure()->discount(times_[idx], true);
+            inputs.annuity = i->second.annuity_;
+            inputs.atm = i->second.atm_;
+            inputs.minRateDigital = i->second.minRateDigital_;
+            inputs.maxRateDigital = i->second.maxRateDigital_;
+            inputs.rates = std::vector<Real>(y_.size(), Null<Real>());
+            inputs.digitals = std::vector<Real>(y_.size(), Null<Real>());
+
             Array discreteDeflatedAnnuities(y_.size(), 0.0);
             Array deflatedFinalPayments;
 
-            Real numeraire0 = termStructure()->discount(numeraireTime_, true);
-            Real normalization =
-                termStructure()->discount(times_[idx], true) / numeraire0;
+            Real normalization = inputs.discount / numeraire0;
 
             for (unsigned int k = 0; k < i->second.paymentDates_.size(); k++) {
                 deflatedFinalPayments =
@@ -478,130 +514,173 @@ namespace QuantLib {
                 0.0, CubicInterpolation::Lagrange, 0.0);
             deflatedAnnuities.enableExtrapolation();
 
-            Real digitalsCorrectionFactor = 1.0;
-            modelOutputs_.digitalsAdjustmentFactors_.insert(
-                modelOutputs_.digitalsAdjustmentFactors_.begin(),
-                digitalsCorrectionFactor);
-
-            Real digital = 0.0, swapRate, swapRate0;
-
-            for (int c = 0;
-                 c == 0 ||
-                 (c == 1 && ((modelSettings_.adjustments_ & ModelSettings::AdjustDigitals) != 0));
-                 c++) {
-
-                if (c == 1) {
-                    digitalsCorrectionFactor = i->second.annuity_ / digital;
-                    modelOutputs_.digitalsAdjustmentFactors_.front() =
-                        digitalsCorrectionFactor;
-                }
-
-                digital = 0.0;
-                swapRate0 =
-                    modelSettings_.upperRateBound_ / 2.0; // initial guess
-                for (int j = y_.size() - 1; j >= 0; j--) {
+            // the integrals of the deflated annuity over the grid intervals
+            // do not depend on the swap rates, the digital prices are their
+            // partial sums
+            Array integrals(y_.size(), 0.0);
+            for (int j = y_.size() - 1; j >= 0; j--) {
 
-                    Real integral = 0.0;
+                Real integral = 0.0;
 
-                    if (j == (int)(y_.size() - 1)) {
+                if (j == (int)(y_.size() - 1)) {
+                    if ((modelSettings_.adjustments_ &
+                         ModelSettings::NoPayoffExtrapolation) == 0) {
                         if ((modelSettings_.adjustments_ &
-                             ModelSettings::NoPayoffExtrapolation) == 0) {
-                            if ((modelSettings_.adjustments_ &
-                                 ModelSettings::ExtrapolatePayoffFlat) != 0) {
-                                integral = gaussianShiftedPolynomialIntegral(
-                                    0.0, 0.0, 0.0, 0.0,
-                                    discreteDeflatedAnnuities[j - 1], y_[j - 1],
-                                    y_[j], 100.0);
-                            } else {
-                                Real ca =
-                                    deflatedAnnuities.aCoefficients()[j - 1];
-                                Real cb =
-                                    deflatedAnnuities.bCoefficients()[j - 1];
-                                Real cc =
-                                    deflatedAnnuities.cCoefficients()[j - 1];
-                                integral = gaussianShiftedPolynomialIntegral(
-                                    0.0, cc, cb, ca,
-                                    discreteDeflatedAnnuities[j - 1], y_[j - 1],
-                                    y_[j], 100.0);
-                            }
+                             ModelSettings::ExtrapolatePayoffFlat) != 0) {
+                            integral = gaussianShiftedPolynomialIntegral(
+                                0.0, 0.0, 0.0, 0.0,
+                                discreteDeflatedAnnuities[j - 1], y_[j - 1],
+                                y_[j], 100.0);
+                        } else {
+                            Real ca = deflatedAnnuities.aCoefficients()[j - 1];
+                            Real cb = deflatedAnnuities.bCoefficients()[j - 1];
+                            Real cc = deflatedAnnuities.cCoefficients()[j - 1];
+                            integral = gaussianShiftedPolynomialIntegral(
+                                0.0, cc, cb, ca,
+                                discreteDeflatedAnnuities[j - 1], y_[j - 1],
+                                y_[j], 100.0);
                         }
-                    } else {
-                        Real ca = deflatedAnnuities.aCoefficients()[j];
-                        Real cb = deflatedAnnuities.bCoefficients()[j];
-                        Real cc = deflatedAnnuities.cCoefficients()[j];
-                        integral = gaussianShiftedPolynomialIntegral(
-                            0.0, cc, cb, ca, discreteDeflatedAnnuities[j],
-                            y_[j], y_[j], y_[j + 1]);
                     }
+                } else {
+                    Real ca = deflatedAnnuities.aCoefficients()[j];
+                    Real cb = deflatedAnnuities.bCoefficients()[j];
+                    Real cc = deflatedAnnuities.cCoefficients()[j];
+                    integral = gaussianShiftedPolynomialIntegral(
+                        0.0, cc, cb, ca, discreteDeflatedAnnuities[j],
+                        y_[j], y_[j], y_[j + 1]);
+                }
 
-                    if (integral < 0) {
-                        QL_MFMESSAGE(modelOutputs_,
-                                     "WARNING: integral for digitalPrice is "
-                                     "negative for j="
-                                         << j << " (" << integral
-                                         << ") --- reset it to zero.");
-                        integral = 0.0;
-                    }
+                if (integral < 0) {
+                    QL_MFMESSAGE(modelOutputs_,
+                                 "WARNING: integral for digitalPrice is "
+                                 "negative for j="
+                                     << j << " (" << integral
+                                     << ") --- reset it to zero.");
+                    integral = 0.0;
+                }
+
+                integrals[j] = integral;
+            }
+
+            Real digitalsCorrectionFactor = 1.0;
+            if ((modelSettings_.adjustments_ & ModelSettings::AdjustDigitals) != 0) {
+                Real digital = 0.0;
+                for (int j = y_.size() - 1; j >= 0; j--)
+                    digital += integrals[j] * numeraire0;
+                digitalsCorrectionFactor = i->second.annuity_ / digital;
+            }
+            modelOutputs_.digitalsAdjustmentFactors_[idx - 1] =
+                digitalsCorrectionFactor;
+
+            Array digitals(y_.size());
+            Real digital = 0.0;
+            for (int j = y_.size() - 1; j >= 0; j--) {
+                digital += integrals[j] * numeraire0 * digitalsCorrectionFactor;
+                digitals[j] = digital;
+            }
 
-                    digital += integral * numeraire0 * digitalsCorrectionFactor;
-
-                    bool check = true;
-                    if ((modelSettings_.adjustments_ & ModelSettings::CustomSmile) != 0) {
-                        swapRate = mfSec->inverseDigitalCall(
-                            digital, i->second.annuity_);
-                    } else if (digital >= i->second.minRateDigital_) {
-                        swapRate = modelSettings_.lowerRateBound_ -
-                                   i->second.rawSmileSection_->shift();
-                        check = false;
-                    } else if (digital <= i->second.maxRateDigital_) {
-                        swapRate = modelSettings_.upperRateBound_;
-                        check = false;
+            // the market swap rates are implied independently for each state
+            Array swapRates(y_.size());
+
+            // smile sections may be lazy; their calculations are
+            // triggered here since they are not thread-safe
+            i->second.rawSmileSection_->volatility(i->second.atm_);
+            i->second.smileSection_->volatility(i->second.atm_);
+
+            // custom smile sections are not required to be thread-safe
+            const bool parallel = !mfSec;
+
+            ExceptionCollector exceptions(y_.size());
+            #pragma omp parallel for if(parallel)
+            for (long j = 0; j < (long)y_.size(); j++) {
+                exceptions.run(j, [&]() {
+                    if (mfSec) {
+                        swapRates[j] = mfSec->inverseDigitalCall(
+                            digitals[j], i->second.annuity_);
+                        inputs.rates[j] = swapRates[j];
+                        inputs.digitals[j] = marketDigitalPrice(
+                            i->first, i->second, Option::Call, swapRates[j]);
+                    } else if (digitals[j] >= i->second.minRateDigital_) {
+                        swapRates[j] = modelSettings_.lowerRateBound_ -
+                                       i->second.rawSmileSection_->shift();
+                    } else if (digitals[j] <= i->second.maxRateDigital_) {
+                        swapRates[j] = modelSettings_.upperRateBound_;
                     } else {
-                        swapRate = marketSwapRate(
-                            i->first, i->second, digital, swapRate0,
+                        swapRates[j] = marketSwapRate(
+                            i->first, i->second, digitals[j], i->second.atm_,
                             i->second.rawSmileSection_->shift());
+                        inputs.rates[j] = swapRates[j];
+                        inputs.digitals[j] = marketDigitalPrice(
+                            i->first, i->second, Option::Call, swapRates[j]);
                     }
-                    if (check && j < (int)y_.size() - 1 &&
-                        swapRate > swapRate0) {
-                        QL_MFMESSAGE(
-                            modelOutputs_,
-                            "WARNING: swap rate is decreasing in y for "
-                            "t=" << times_[idx]
-                                 << ", j=" << j << " (y, swap rate) is ("
-                                 << y_[j] << "," << swapRate << ") but for j="
-                                 << j + 1 << " it is (" << y_[j + 1] << ","
-                                 << swapRate0 << ") --- reset rate to "
-                                 << swapRate0 << " in node j=" << j);
-                        swapRate = swapRate0;
-                    }
-                    swapRate0 = swapRate;
-                    Real numeraire =
-                        1.0 / std::max(swapRate * discreteDeflatedAnnuities[j] +
-                                       deflatedFinalPayments[j], 1E-6);
-                    (*discreteNumeraire_)[idx][j] = numeraire * normalization;
+                });
+            }
+            exceptions.rethrow();
+
+            Real swapRate0 = modelSettings_.upperRateBound_ / 2.0;
+            for (int j = y_.size() - 1; j >= 0; j--) {
+                Real swapRate = swapRates[j];
+                // rates on the rate bounds are not checked
+                if (inputs.rates[j] != Null<Real>() && j < (int)y_.size() - 1 &&
+                    swapRate > swapRate0) {
+                    QL_MFMESSAGE(
+                        modelOutputs_,
+                        "WARNING: swap rate is decreasing in y for "
+                        "t=" << times_[idx]
+                             << ", j=" << j << " (y, swap rate) is ("
+                             << y_[j] << "," << swapRate << ") but for j="
+                             << j + 1 << " it is (" << y_[j + 1] << ","
+                             << swapRate0 << ") --- reset rate to "
+                             << swapRate0 << " in node j=" << j);
+                    swapRate = swapRate0;
                 }
+                swapRate0 = swapRate;
+                Real numeraire =
+                    1.0 / std::max(swapRate * discreteDeflatedAnnuities[j] +
+                                   deflatedFinalPayments[j], 1E-6);
+                (*discreteNumeraire_)[idx][j] = numeraire * normalization;
             }
 
             if ((modelSettings_.adjustments_ & ModelSettings::AdjustYts) != 0) {
                 numeraire_[idx]->update();
                 Real modelDeflatedZerobond = deflatedZerobond(times_[idx], 0.0);
-                Real marketDeflatedZerobond =
-                    termStructure()->discount(times_[idx], true) /
-                    termStructure()->discount(numeraireTime_, true);
+                Real marketDeflatedZerobond = inputs.discount / numeraire0;
                 for (int j = y_.size() - 1; j >= 0; j--) {
                     (*discreteNumeraire_)[idx][j] *=
                         modelDeflatedZerobond / marketDeflatedZerobond;
                 }
-                modelOutputs_.adjustmentFactors_.insert(
-                    modelOutputs_.adjustmentFactors_.begin(),
-                    modelDeflatedZerobond / marketDeflatedZerobond);
+                modelOutputs_.adjustmentFactors_[idx - 1] =
+                    modelDeflatedZerobond / marketDeflatedZerobond;
             } else {
-                modelOutputs_.adjustmentFactors_.insert(
-                    modelOutputs_.adjustmentFactors_.begin(), 1.0);
+                modelOutputs_.adjustmentFactors_[idx - 1] = 1.0;
             }
 
             numeraire_[idx]->update();
+            tabulationInputs_[idx] = inputs;
+        }
+    }
+
+    bool MarkovFunctional::numeraireTabulationIsCurrent(
+        const Size idx, const Date& expiry, const CalibrationPoint& p) const {
+
+        const TabulationInputs& inputs = tabulationInputs_[idx];
+        if (inputs.rates.size() != y_.size() ||
+            inputs.discount != termStructure()->discount(times_[idx], true) ||
+            inputs.annuity != p.annuity_ || inputs.atm != p.atm_ ||
+            inputs.minRateDigital != p.minRateDigital_ ||
+            inputs.maxRateDigital != p.maxRateDigital_)
+            return false;
+
+        // the implied swap rates are unchanged if the smile still gives
+        // the cached digital prices at these rates; this only takes a
+        // digital price per state, no inversion of the smile
+        for (Size j = 0; j < y_.size(); j++) {
+            if (inputs.rates[j] != Null<Real>() &&
+                marketDigitalPrice(expiry, p, Option::Call, inputs.rates[j]) !=
+                    inputs.digitals[j])
+                return false;
         }
+        return true;
     }
 
     const MarkovFunctional::ModelOutputs &
@@ -802,6 +881,37 @@ namespace QuantLib {
                                      termStructure()->discount(T)));
     }
 
+    Array MarkovFunctional::numeraireArrayImpl(
+        const Time t, const Array &y,
+        const Handle<YieldTermStructure> &yts) const {
+
+        if (t == 0)
+            return Array(y.size(),
+                         yts.empty()
+                             ? this->termStructure()->discount(numeraireTime(), true)
+                             : yts->discount(numeraireTime()));
+
+        return numeraireArray(t, y) *
+               (yts.empty() ? Real(1.0)
+                            : (yts->discount(numeraireTime()) /
+                               yts->discount(t) * termStructure()->discount(t) /
+                               termStructure()->discount(numeraireTime())));
+    }
+
+    Array
+    MarkovFunctional::zerobondArrayImpl(const Time T, const Time t, const Array &y,
+                                        const Handle<YieldTermStructure> &yts) const {
+
+        if (t == 0.0)
+            return Array(y.size(), yts.empty()
+                                       ? this->termStructure()->discount(T, true)
+                                       : yts->discount(T, true));
+        return zerobondArray(T, t, y) *
+               (yts.empty() ? Real(1.0) : (yts->discount(T) / yts->discount(t) *
+                                     termStructure()->discount(t) /
+                                     termStructure()->discount(T)));
+    }
+
     Real MarkovFunctional::deflatedZerobond(Time T, Time t,
                                             Real y) const {
 
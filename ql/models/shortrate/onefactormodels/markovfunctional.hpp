@@ -100,6 +100,9 @@ namespace QuantLib {
 
       public:
 
+        /*! Custom smile sections are always called from a single
+            thread, so they need not be thread-safe.
+        */
         class CustomSmileSection : public SmileSection {
         public:
           virtual Real inverseDigitalCall(Real price, Real discount = 1.0) const = 0;
@@ -377,10 +380,19 @@ namespace QuantLib {
         Real
         zerobondImpl(Time T, Time t, Real y, const Handle<YieldTermStructure>& yts) const override;
 
+        Array numeraireArrayImpl(Time t,
+                                 const Array& y,
+                                 const Handle<YieldTermStructure>& yts) const override;
+
+        Array zerobondArrayImpl(Time T,
+                                Time t,
+                                const Array& y,
+                                const Handle<YieldTermStructure>& yts) const override;
+
         void generateArguments() override {
             // if calculate triggers performCalculations, updateNumeraireTabulations
-            // is called twice. If we can not check the lazy object status this seem
-            // hard to avoid though.
+            // is called twice. The second call only verifies that the tabulation
+            // is up to date though.
             calculate();
             updateNumeraireTabulation();
             notifyObservers();
@@ -408,6 +420,10 @@ namespace QuantLib {
 
         void updateSmiles() const;
         void updateNumeraireTabulation() const;
+        bool numeraireTabulationIsCurrent(
+            Size idx,
+            const Date& expiry,
+            const CalibrationPoint& p) const;
 
         void makeSwaptionCalibrationPoint(const Date &expiry,
                                           const Period &tenor);
@@ -533,6 +549,19 @@ namespace QuantLib {
 
         mutable std::vector<std::pair<Size,Size> > arbitrageIndices_;
         std::vector<std::pair<Size,Size> > forcedArbitrageIndices_;
+
+        // inputs of the numeraire tabulation on each calibration time, the
+        // tabulation is only recomputed from the latest time whose inputs
+        // changed; digitals are the smile's digital prices at the implied
+        // rates
+        struct TabulationInputs {
+            Real discount, annuity, atm, minRateDigital, maxRateDigital;
+            std::vector<Real> rates, digitals;
+        };
+        mutable std::vector<TabulationInputs> tabulationInputs_;
+        mutable std::vector<Real> tabulationTimes_;
+        mutable Array tabulationParameters_;
+        mutable Real tabulationNumeraire_ = Null<Real>();
     };
 
     std::ostream &operator<<(std::ostream &out,
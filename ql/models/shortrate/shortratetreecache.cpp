@@ -0,0 +1,101 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/discretizedasset.hpp>
+#include <ql/math/comparison.hpp>
+#include <ql/models/shortrate/shortratetreecache.hpp>
+#include <algorithm>
+#include <utility>
+
+namespace QuantLib {
+
+    ShortRateTreeCache::ShortRateTreeCache(Handle<ShortRateModel> model,
+                                           Size timeSteps)
+    : model_(std::move(model)), timeSteps_(timeSteps) {
+        QL_REQUIRE(timeSteps > 0,
+                   "timeSteps must be positive, " << timeSteps <<
+                   " not allowed");
+        registerWith(model_);
+    }
+
+    ShortRateTreeCache::ShortRateTreeCache(
+        const ext::shared_ptr<ShortRateModel>& model, Size timeSteps)
+    : ShortRateTreeCache(Handle<ShortRateModel>(model), timeSteps) {}
+
+    void ShortRateTreeCache::addTimes(const std::vector<Time>& times) {
+        const bool rebuild = !std::all_of(
+            times.begin(), times.end(),
+            [this](Time t) { return registered(t); });
+        if (!rebuild)
+            return;
+
+        times_.insert(times_.end(), times.begin(), times.end());
+        std::sort(times_.begin(), times_.end());
+        auto e = std::unique(times_.begin(), times_.end(),
+                             static_cast<bool (*)(Real, Real)>(close_enough));
+        times_.erase(e, times_.end());
+
+        const bool built = lattice_ != nullptr;
+        timeGrid_ = TimeGrid();
+        lattice_.reset();
+        // results obtained on the previous tree are out of date
+        if (built)
+            notifyObservers();
+    }
+
+    ext::shared_ptr<Lattice>
+    ShortRateTreeCache::lattice(const std::vector<Time>& times) {
+        for (Time t : times)
+            QL_REQUIRE(registered(t),
+                       "mandatory time " << t << " not registered with "
+                       "the short-rate tree cache; add the times of all "
+                       "instruments before pricing them");
+        timeGrid();
+        return lattice_;
+    }
+
+    const TimeGrid& ShortRateTreeCache::timeGrid() {
+        if (lattice_ == nullptr) {
+            QL_REQUIRE(!model_.empty(), "no model specified");
+            QL_REQUIRE(!times_.empty(), "no mandatory times given");
+            timeGrid_ = TimeGrid(times_.begin(), times_.end(), timeSteps_);
+            ext::shared_ptr<Lattice> lattice = model_->tree(timeGrid_);
+
+            // computes the lazily built state prices and transition
+            // tables, so that the engines sharing the tree only read it
+            DiscretizedDiscountBond bond;
+            bond.initialize(lattice, timeGrid_.back());
+            bond.presentValue();
+            bond.rollback(0.0);
+
+            lattice_ = lattice;
+        }
+        return timeGrid_;
+    }
+
+    void ShortRateTreeCache::update() {
+        lattice_.reset();
+        notifyObservers();
+    }
+
+    bool ShortRateTreeCache::registered(Time t) const {
+        auto i = std::lower_bound(times_.begin(), times_.end(), t);
+        return (i != times_.end() && close_enough(*i, t))
+            || (i != times_.begin() && close_enough(*(i-1), t));
+    }
+
+}
@@ -0,0 +1,91 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file shortratetreecache.hpp
+    \brief short-rate tree shared between lattice engines
+*/
+
+#ifndef quantlib_short_rate_tree_cache_hpp
+#define quantlib_short_rate_tree_cache_hpp
+
+#include <ql/handle.hpp>
+#include <ql/models/model.hpp>
+#include <ql/numericalmethod.hpp>
+
+namespace QuantLib {
+
+    //! short-rate tree shared between lattice engines
+    /*! The cache builds a single tree on a time grid containing the
+        mandatory times of a whole portfolio, so that the
+        term-structure fitting of the tree is performed once rather
+        than once per instrument.  The mandatory times of all the
+        instruments must be registered by means of addTimes() before
+        they are priced; a lattice requested for times that were not
+        registered raises an error instead of rebuilding the tree
+        under the instruments already priced on it.  Registering new
+        times afterwards rebuilds the tree and notifies the observers
+        of the cache, so that those instruments are recalculated.
+        The tree is also discarded whenever the model notifies a
+        change, e.g., after calibration or when its term structure
+        moves; it is rebuilt on the same grid at the next request.
+
+        After being built, the tree is rolled back once over its
+        whole grid so that its lazily computed state prices and
+        transition tables are available; engines sharing it, e.g.,
+        the helpers of a parallel calibration, then only read from
+        it.  The tree itself is built by the first request after a
+        change, which must not run concurrently with others.
+
+        \warning results can differ slightly from those obtained by an
+                 engine building its own tree, since the merged grid
+                 is usually finer than the grid of each instrument.
+
+        \warning engines setting a non-null spread on the tree, e.g.,
+                 TreeCallableFixedRateBondEngine, modify it and must
+                 not price concurrently with other engines sharing it.
+    */
+    class ShortRateTreeCache : public Observer, public Observable {
+      public:
+        ShortRateTreeCache(Handle<ShortRateModel> model, Size timeSteps);
+        ShortRateTreeCache(const ext::shared_ptr<ShortRateModel>& model,
+                           Size timeSteps);
+
+        const Handle<ShortRateModel>& model() const { return model_; }
+        Size timeSteps() const { return timeSteps_; }
+
+        //! registers mandatory times to be included in the grid
+        void addTimes(const std::vector<Time>& times);
+        //! returns the tree, whose grid contains the given registered times
+        ext::shared_ptr<Lattice> lattice(const std::vector<Time>& times);
+        //! the grid of the current tree, which is built if needed
+        const TimeGrid& timeGrid();
+
+        void update() override;
+
+      private:
+        bool registered(Time t) const;
+
+        Handle<ShortRateModel> model_;
+        Size timeSteps_;
+        std::vector<Time> times_;
+        TimeGrid timeGrid_;
+        ext::shared_ptr<Lattice> lattice_;
+    };
+
+}
+
+#endif
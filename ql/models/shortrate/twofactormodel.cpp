@@ -45,7 +45,9 @@ namespace QuantLib {
                          const ext::shared_ptr<ShortRateDynamics>& dynamics)
     : TreeLattice2D<TwoFactorModel::ShortRateTree,TrinomialTree>(
                                        tree1, tree2, dynamics->correlation()),
-      dynamics_(dynamics) {}
+      dynamics_(dynamics) {
+        enableTransitionTables();
+    }
 
     ext::shared_ptr<StochasticProcess>
     TwoFactorModel::ShortRateDynamics::process() const {
@@ -103,7 +103,11 @@ namespace QuantLib {
         Real correlation_;
     };
 
-    //! Recombining two-dimensional tree discretizing the state variable
+    //! Recombining two-dimensional tree discretizing the state variables
+    /*! Flat transition tables are enabled, so that the nine branches
+        of each node and the short-rate discount factors are computed
+        only once per level and shared by all rollbacks on the tree.
+    */
     class TwoFactorModel::ShortRateTree
         : public TreeLattice2D<TwoFactorModel::ShortRateTree,TrinomialTree> {
       public:
@@ -9,8 +9,11 @@
 #include <ql/pricingengines/genericmodelengine.hpp>
 #include <ql/pricingengines/greeks.hpp>
 #include <ql/pricingengines/latticeshortratemodelengine.hpp>
+#include <ql/pricingengines/mcimportancesampling.hpp>
 #include <ql/pricingengines/mclongstaffschwartzengine.hpp>
+#include <ql/pricingengines/mcpathgreeks.hpp>
 #include <ql/pricingengines/mcsimulation.hpp>
+#include <ql/pricingengines/mlmcsimulation.hpp>
 
 #include <ql/pricingengines/asian/all.hpp>
 #include <ql/pricingengines/barrier/all.hpp>
@@ -13,5 +13,6 @@
 #include <ql/pricingengines/asian/mc_discr_geom_av_price.hpp>
 #include <ql/pricingengines/asian/mc_discr_geom_av_price_heston.hpp>
 #include <ql/pricingengines/asian/mcdiscreteasianenginebase.hpp>
+#include <ql/pricingengines/asian/mlmc_discr_arith_av_price.hpp>
 #include <ql/pricingengines/asian/turnbullwakemanasianengine.hpp>
 
@@ -51,4 +51,64 @@ namespace QuantLib {
         return discount_ * payoff_(averagePrice);
     }
 
+
+
+    ArithmeticAPOPathGreeksPricer::ArithmeticAPOPathGreeksPricer(
+                                         Option::Type type,
+                                         Real strike, DiscountFactor discount,
+                                         BlackScholesPathGreeks greeks,
+                                         Real runningSum, Size pastFixings)
+    : type_(type), strike_(strike), discount_(discount),
+      greeks_(std::move(greeks)), runningSum_(runningSum),
+      pastFixings_(pastFixings) {
+        QL_REQUIRE(strike>=0.0,
+            "strike less than zero not allowed");
+    }
+
+    Array ArithmeticAPOPathGreeksPricer::operator()(const Path& path) const {
+        Size n = path.length();
+        QL_REQUIRE(n>1, "the path cannot be empty");
+
+        Size first, fixings;
+        if (path.timeGrid().mandatoryTimes()[0]==0.0) {
+            // include initial fixing
+            first = 0;
+            fixings = pastFixings_ + n;
+        } else {
+            first = 1;
+            fixings = pastFixings_ + n - 1;
+        }
+
+        // only the simulated fixings depend on the underlying and
+        // on the volatility; the running sum does not
+        Real simulatedSum = 0.0, vegaSum = 0.0;
+        for (Size i=first; i<n; ++i) {
+            simulatedSum += path[i];
+            vegaSum += greeks_.pathwiseVega(path, i);
+        }
+        Real averagePrice = (runningSum_ + simulatedSum)/fixings;
+
+        Real slope;
+        switch (type_) {
+          case Option::Call:
+            slope = averagePrice > strike_ ? 1.0 : 0.0;
+            break;
+          case Option::Put:
+            slope = averagePrice < strike_ ? -1.0 : 0.0;
+            break;
+          default:
+            QL_FAIL("unknown option type");
+        }
+        if (slope == 0.0)
+            return Array(3, 0.0);
+
+        Real x0 = greeks_.x0();
+        Real h = discount_ * slope * simulatedSum/fixings;
+        Array result(3);
+        result[0] = h / x0;
+        result[1] = h * (greeks_.deltaWeight(path)*x0 - 1.0) / (x0*x0);
+        result[2] = discount_ * slope * vegaSum/fixings;
+        return result;
+    }
+
 }
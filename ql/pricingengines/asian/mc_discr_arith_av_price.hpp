@@ -28,6 +28,7 @@
 #include <ql/exercise.hpp>
 #include <ql/pricingengines/asian/analytic_discr_geom_av_price.hpp>
 #include <ql/pricingengines/asian/mc_discr_geom_av_price.hpp>
+#include <ql/pricingengines/mcpathgreeks.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
 #include <utility>
 
@@ -40,6 +41,20 @@ namespace QuantLib {
          AnalyticDiscreteGeometricAveragePriceAsianEngine (analytic discrete
          arithmetic average price engine) for control variation.
 
+         If requested, delta and vega are estimated on the same paths
+         as the option value by pathwise differentiation of the
+         payoff, and gamma by a likelihood-ratio weight applied to the
+         pathwise delta; this requires a constant Black volatility.
+         Gamma is not returned if a fixing falls on the evaluation
+         date, since the average then depends on the spot explicitly
+         and not only through the simulated fixings.  The control
+         variate is not applied to the Greeks.
+
+         Alternatively, the geometric-average option and the average
+         price itself can be used together as control variates, with
+         coefficients estimated by regression on the first batch of
+         samples.
+
          \ingroup asianengines
 
          \test the correctness of the returned value is tested by
@@ -66,10 +81,22 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed);
+             BigNatural seed,
+             bool greeks = false,
+             bool regressionControlVariates = false);
+        void calculate() const override;
       protected:
+        typedef typename MCDiscreteAveragingAsianEngineBase<SingleVariate,RNG,S>::
+            sensitivity_pricer_type sensitivity_pricer_type;
+        typedef typename MCDiscreteAveragingAsianEngineBase<SingleVariate,RNG,S>::
+            control_variates_pricer_type control_variates_pricer_type;
         ext::shared_ptr<path_pricer_type> pathPricer() const override;
+        ext::shared_ptr<sensitivity_pricer_type>
+        sensitivityPathPricer() const override;
         ext::shared_ptr<path_pricer_type> controlPathPricer() const override;
+        ext::shared_ptr<control_variates_pricer_type>
+        controlVariatesPathPricer() const override;
+        Array controlVariatesValues() const override;
         ext::shared_ptr<PricingEngine> controlPricingEngine() const override {
             ext::shared_ptr<GeneralizedBlackScholesProcess> process =
                 ext::dynamic_pointer_cast<GeneralizedBlackScholesProcess>(
@@ -78,6 +105,8 @@ namespace QuantLib {
             return ext::shared_ptr<PricingEngine>(new
                 AnalyticDiscreteGeometricAveragePriceAsianEngine(process));
         }
+      private:
+        bool greeks_, regressionControlVariates_;
     };
 
 
@@ -98,6 +127,27 @@ namespace QuantLib {
     };
 
 
+    //! pathwise delta and vega, and likelihood-ratio gamma
+    class ArithmeticAPOPathGreeksPricer : public PathPricer<Path, Array> {
+      public:
+        ArithmeticAPOPathGreeksPricer(Option::Type type,
+                                      Real strike,
+                                      DiscountFactor discount,
+                                      BlackScholesPathGreeks greeks,
+                                      Real runningSum = 0.0,
+                                      Size pastFixings = 0);
+        Array operator()(const Path& path) const override;
+
+      private:
+        Option::Type type_;
+        Real strike_;
+        DiscountFactor discount_;
+        BlackScholesPathGreeks greeks_;
+        Real runningSum_;
+        Size pastFixings_;
+    };
+
+
     // inline definitions
 
     template <class RNG, class S>
@@ -110,7 +160,9 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed)
+             BigNatural seed,
+             bool greeks,
+             bool regressionControlVariates)
     : MCDiscreteAveragingAsianEngineBase<SingleVariate,RNG,S>(process,
                                                               brownianBridge,
                                                               antitheticVariate,
@@ -118,7 +170,25 @@ namespace QuantLib {
                                                               requiredSamples,
                                                               requiredTolerance,
                                                               maxSamples,
-                                                              seed) {}
+                                                              seed),
+      greeks_(greeks), regressionControlVariates_(regressionControlVariates) {
+        QL_REQUIRE(!(controlVariate && regressionControlVariates),
+                   "the geometric control variate is already included "
+                   "in the regression control variates");
+    }
+
+    template <class RNG, class S>
+    inline void MCDiscreteArithmeticAPEngine<RNG,S>::calculate() const {
+        MCDiscreteAveragingAsianEngineBase<SingleVariate,RNG,S>::calculate();
+        if (greeks_) {
+            std::vector<Real> greeks =
+                this->mcModel_->sensitivityAccumulator().mean();
+            this->results_.delta = greeks[0];
+            if (this->timeGrid().mandatoryTimes()[0] != 0.0)
+                this->results_.gamma = greeks[1];
+            this->results_.vega = greeks[2];
+        }
+    }
 
     template <class RNG, class S>
     inline
@@ -151,6 +221,40 @@ namespace QuantLib {
                     this->arguments_.pastFixings));
     }
 
+    template <class RNG, class S>
+    inline
+    ext::shared_ptr<typename
+        MCDiscreteArithmeticAPEngine<RNG,S>::sensitivity_pricer_type>
+        MCDiscreteArithmeticAPEngine<RNG,S>::sensitivityPathPricer() const {
+
+        if (!greeks_)
+            return ext::shared_ptr<sensitivity_pricer_type>();
+
+        ext::shared_ptr<PlainVanillaPayoff> payoff =
+            ext::dynamic_pointer_cast<PlainVanillaPayoff>(
+                this->arguments_.payoff);
+        QL_REQUIRE(payoff, "non-plain payoff given");
+
+        ext::shared_ptr<EuropeanExercise> exercise =
+            ext::dynamic_pointer_cast<EuropeanExercise>(
+                this->arguments_.exercise);
+        QL_REQUIRE(exercise, "wrong exercise given");
+
+        ext::shared_ptr<GeneralizedBlackScholesProcess> process =
+            ext::dynamic_pointer_cast<GeneralizedBlackScholesProcess>(
+                this->process_);
+        QL_REQUIRE(process, "Black-Scholes process required");
+
+        return ext::shared_ptr<sensitivity_pricer_type>(
+                new ArithmeticAPOPathGreeksPricer(
+                    payoff->optionType(),
+                    payoff->strike(),
+                    process->riskFreeRate()->discount(exercise->lastDate()),
+                    BlackScholesPathGreeks(process, this->timeGrid()),
+                    this->arguments_.runningAccumulator,
+                    this->arguments_.pastFixings));
+    }
+
     template <class RNG, class S>
     inline
     ext::shared_ptr<
@@ -183,6 +287,66 @@ namespace QuantLib {
               process->riskFreeRate()->discount(this->timeGrid().back())));
     }
 
+    template <class RNG, class S>
+    inline
+    ext::shared_ptr<typename
+        MCDiscreteArithmeticAPEngine<RNG,S>::control_variates_pricer_type>
+        MCDiscreteArithmeticAPEngine<RNG,S>::controlVariatesPathPricer() const {
+
+        if (!regressionControlVariates_)
+            return ext::shared_ptr<control_variates_pricer_type>();
+
+        ext::shared_ptr<EuropeanExercise> exercise =
+            ext::dynamic_pointer_cast<EuropeanExercise>(
+                this->arguments_.exercise);
+        QL_REQUIRE(exercise, "wrong exercise given");
+
+        ext::shared_ptr<GeneralizedBlackScholesProcess> process =
+            ext::dynamic_pointer_cast<GeneralizedBlackScholesProcess>(
+                this->process_);
+        QL_REQUIRE(process, "Black-Scholes process required");
+
+        // the discounted average price is obtained as a zero-strike call
+        std::vector<ext::shared_ptr<PathPricer<Path> > > controls = {
+            controlPathPricer(),
+            ext::make_shared<ArithmeticAPOPathPricer>(
+                Option::Call, 0.0,
+                process->riskFreeRate()->discount(exercise->lastDate()),
+                this->arguments_.runningAccumulator,
+                this->arguments_.pastFixings)
+        };
+        return ext::make_shared<CompositePathPricer<Path> >(controls);
+    }
+
+    template <class RNG, class S>
+    inline Array
+    MCDiscreteArithmeticAPEngine<RNG,S>::controlVariatesValues() const {
+
+        if (!regressionControlVariates_)
+            return Array();
+
+        ext::shared_ptr<GeneralizedBlackScholesProcess> process =
+            ext::dynamic_pointer_cast<GeneralizedBlackScholesProcess>(
+                this->process_);
+        QL_REQUIRE(process, "Black-Scholes process required");
+
+        // the fixings are the same as in ArithmeticAPOPathPricer
+        TimeGrid grid = this->timeGrid();
+        Size first = grid.mandatoryTimes()[0] == 0.0 ? 0 : 1;
+        Real sum = this->arguments_.runningAccumulator;
+        for (Size i=first; i<grid.size(); ++i)
+            sum += process->x0()
+                * process->dividendYield()->discount(grid[i])
+                / process->riskFreeRate()->discount(grid[i]);
+        Size fixings = this->arguments_.pastFixings + grid.size() - first;
+
+        Array values(2);
+        values[0] = this->controlVariateValue();
+        values[1] = process->riskFreeRate()->discount(
+                        this->arguments_.exercise->lastDate()) * sum/fixings;
+        return values;
+    }
+
     template <class RNG = PseudoRandom, class S = Statistics>
     class MakeMCDiscreteArithmeticAPEngine {
       public:
@@ -196,11 +360,15 @@ namespace QuantLib {
         MakeMCDiscreteArithmeticAPEngine& withSeed(BigNatural seed);
         MakeMCDiscreteArithmeticAPEngine& withAntitheticVariate(bool b = true);
         MakeMCDiscreteArithmeticAPEngine& withControlVariate(bool b = true);
+        MakeMCDiscreteArithmeticAPEngine& withGreeks(bool b = true);
+        MakeMCDiscreteArithmeticAPEngine& withRegressionControlVariates(
+                                                             bool b = true);
         // conversion to pricing engine
         operator ext::shared_ptr<PricingEngine>() const;
       private:
         ext::shared_ptr<GeneralizedBlackScholesProcess> process_;
-        bool antithetic_ = false, controlVariate_ = false;
+        bool antithetic_ = false, controlVariate_ = false, greeks_ = false;
+        bool regressionControlVariates_ = false;
         Size samples_, maxSamples_;
         Real tolerance_;
         bool brownianBridge_ = true;
@@ -270,6 +438,21 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCDiscreteArithmeticAPEngine<RNG,S>&
+    MakeMCDiscreteArithmeticAPEngine<RNG,S>::withGreeks(bool b) {
+        greeks_ = b;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMCDiscreteArithmeticAPEngine<RNG,S>&
+    MakeMCDiscreteArithmeticAPEngine<RNG,S>::withRegressionControlVariates(
+                                                                   bool b) {
+        regressionControlVariates_ = b;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline
     MakeMCDiscreteArithmeticAPEngine<RNG,S>::operator ext::shared_ptr<PricingEngine>()
@@ -280,7 +463,9 @@ namespace QuantLib {
                                                 antithetic_, controlVariate_,
                                                 samples_, tolerance_,
                                                 maxSamples_,
-                                                seed_));
+                                                seed_,
+                                                greeks_,
+                                                regressionControlVariates_));
     }
 
 
@@ -0,0 +1,48 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/pricingengines/asian/mlmc_discr_arith_av_price.hpp>
+
+namespace QuantLib {
+
+    FixingIndexedArithmeticAPOPathPricer::FixingIndexedArithmeticAPOPathPricer(
+                                            Option::Type type,
+                                            Real strike,
+                                            DiscountFactor discount,
+                                            std::vector<Size> fixingIndices,
+                                            Real runningSum,
+                                            Size pastFixings)
+    : payoff_(type, strike), discount_(discount),
+      fixingIndices_(std::move(fixingIndices)),
+      runningSum_(runningSum), pastFixings_(pastFixings) {
+        QL_REQUIRE(strike>=0.0,
+            "strike less than zero not allowed");
+    }
+
+    Real FixingIndexedArithmeticAPOPathPricer::operator()(
+                                                   const Path& path) const {
+        QL_REQUIRE(path.length()>1, "the path cannot be empty");
+
+        Real sum = runningSum_;
+        for (Size i : fixingIndices_)
+            sum += path[i];
+
+        Real averagePrice = sum/(pastFixings_ + fixingIndices_.size());
+        return discount_ * payoff_(averagePrice);
+    }
+
+}
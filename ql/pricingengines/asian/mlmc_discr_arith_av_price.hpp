@@ -0,0 +1,290 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file mlmc_discr_arith_av_price.hpp
+    \brief Multi-level Monte Carlo engine for discrete arithmetic average price Asian
+*/
+
+#ifndef quantlib_mlmc_discrete_arithmetic_average_price_asian_engine_hpp
+#define quantlib_mlmc_discrete_arithmetic_average_price_asian_engine_hpp
+
+#include <ql/exercise.hpp>
+#include <ql/instruments/asianoption.hpp>
+#include <ql/pricingengines/mlmcsimulation.hpp>
+#include <ql/processes/blackscholesprocess.hpp>
+#include <utility>
+
+namespace QuantLib {
+
+    //! Multi-level Monte Carlo engine for discrete arithmetic average price Asian
+    /*! The coarsest level simulates the underlying on the fixing
+        dates, optionally with additional time steps in between;
+        each further level halves the steps between consecutive
+        grid points.  This removes the discretization bias of
+        processes with time- or state-dependent volatility.
+
+        \ingroup asianengines
+
+        \test the correctness of the returned value is tested by
+              checking it against the Monte Carlo engine.
+    */
+    template <class RNG = PseudoRandom, class S = Statistics>
+    class MLMCDiscreteArithmeticAPEngine
+        : public DiscreteAveragingAsianOption::engine,
+          public MlmcSimulation<SingleVariate,RNG,S> {
+      public:
+        typedef
+        typename MlmcSimulation<SingleVariate,RNG,S>::path_generator_type
+            path_generator_type;
+        typedef typename MlmcSimulation<SingleVariate,RNG,S>::path_pricer_type
+            path_pricer_type;
+        typedef typename MlmcSimulation<SingleVariate,RNG,S>::stats_type
+            stats_type;
+        // constructor
+        MLMCDiscreteArithmeticAPEngine(
+             ext::shared_ptr<GeneralizedBlackScholesProcess> process,
+             Size timeSteps,
+             Size levels,
+             Size requiredSamples,
+             Real requiredTolerance,
+             BigNatural seed);
+        void calculate() const override {
+            QL_REQUIRE(arguments_.averageType == Average::Arithmetic,
+                       "not an arithmetic average option");
+            MlmcSimulation<SingleVariate,RNG,S>::calculate(requiredTolerance_,
+                                                           requiredSamples_,
+                                                           levels_);
+            results_.value = this->mcModel_->mean();
+            if constexpr (RNG::allowsErrorEstimate)
+                results_.errorEstimate = this->mcModel_->errorEstimate();
+            results_.additionalResults["levels"] = this->mcModel_->levels();
+        }
+
+      protected:
+        // MlmcSimulation implementation
+        TimeGrid timeGrid() const override;
+        ext::shared_ptr<path_generator_type>
+        pathGenerator(Size level) const override {
+            TimeGrid fine = this->levelTimeGrid(level);
+            TimeGrid coarse =
+                level > 0 ? this->levelTimeGrid(level-1) : TimeGrid();
+            typename RNG::rsg_type generator =
+                RNG::make_sequence_generator(fine.size()-1,
+                                             seed_ != 0 ? seed_ + level : 0);
+            return ext::make_shared<path_generator_type>(
+                process_, fine, coarse, generator);
+        }
+        ext::shared_ptr<path_pricer_type>
+        pathPricer(const TimeGrid& grid) const override;
+        std::vector<Time> fixingTimes() const;
+        // data members
+        ext::shared_ptr<GeneralizedBlackScholesProcess> process_;
+        Size timeSteps_, levels_;
+        Size requiredSamples_;
+        Real requiredTolerance_;
+        BigNatural seed_;
+    };
+
+
+    //! Multi-level Monte Carlo discrete arithmetic Asian engine factory
+    template <class RNG = PseudoRandom, class S = Statistics>
+    class MakeMLMCDiscreteArithmeticAPEngine {
+      public:
+        explicit MakeMLMCDiscreteArithmeticAPEngine(
+            ext::shared_ptr<GeneralizedBlackScholesProcess> process);
+        // named parameters
+        MakeMLMCDiscreteArithmeticAPEngine& withSteps(Size steps);
+        MakeMLMCDiscreteArithmeticAPEngine& withLevels(Size levels);
+        MakeMLMCDiscreteArithmeticAPEngine& withSamples(Size samples);
+        MakeMLMCDiscreteArithmeticAPEngine& withAbsoluteTolerance(
+                                                              Real tolerance);
+        MakeMLMCDiscreteArithmeticAPEngine& withSeed(BigNatural seed);
+        // conversion to pricing engine
+        operator ext::shared_ptr<PricingEngine>() const;
+      private:
+        ext::shared_ptr<GeneralizedBlackScholesProcess> process_;
+        Size steps_, levels_, samples_;
+        Real tolerance_;
+        BigNatural seed_ = 0;
+    };
+
+
+    //! Arithmetic average price path pricer for given fixing indices
+    /*! The fixings are read at the given indices of the path, so
+        that the pricer can be used on grids containing time steps
+        between fixing dates.
+    */
+    class FixingIndexedArithmeticAPOPathPricer : public PathPricer<Path> {
+      public:
+        FixingIndexedArithmeticAPOPathPricer(Option::Type type,
+                                             Real strike,
+                                             DiscountFactor discount,
+                                             std::vector<Size> fixingIndices,
+                                             Real runningSum = 0.0,
+                                             Size pastFixings = 0);
+        Real operator()(const Path& path) const override;
+
+      private:
+        PlainVanillaPayoff payoff_;
+        DiscountFactor discount_;
+        std::vector<Size> fixingIndices_;
+        Real runningSum_;
+        Size pastFixings_;
+    };
+
+
+    // inline definitions
+
+    template <class RNG, class S>
+    inline
+    MLMCDiscreteArithmeticAPEngine<RNG,S>::MLMCDiscreteArithmeticAPEngine(
+             ext::shared_ptr<GeneralizedBlackScholesProcess> process,
+             Size timeSteps,
+             Size levels,
+             Size requiredSamples,
+             Real requiredTolerance,
+             BigNatural seed)
+    : process_(std::move(process)), timeSteps_(timeSteps), levels_(levels),
+      requiredSamples_(requiredSamples),
+      requiredTolerance_(requiredTolerance), seed_(seed) {
+        registerWith(process_);
+    }
+
+    template <class RNG, class S>
+    inline std::vector<Time>
+    MLMCDiscreteArithmeticAPEngine<RNG,S>::fixingTimes() const {
+        std::vector<Time> fixingTimes;
+        for (const auto& fixingDate : arguments_.fixingDates) {
+            Time t = process_->time(fixingDate);
+            if (t >= 0.0)
+                fixingTimes.push_back(t);
+        }
+        QL_REQUIRE(!fixingTimes.empty() &&
+                   (fixingTimes.size() > 1 || fixingTimes.front() > 0.0),
+                   "all fixings are in the past");
+        return fixingTimes;
+    }
+
+    template <class RNG, class S>
+    inline TimeGrid MLMCDiscreteArithmeticAPEngine<RNG,S>::timeGrid() const {
+        std::vector<Time> fixingTimes = this->fixingTimes();
+        if (timeSteps_ != Null<Size>())
+            return TimeGrid(fixingTimes.begin(), fixingTimes.end(),
+                            timeSteps_);
+        else
+            return TimeGrid(fixingTimes.begin(), fixingTimes.end());
+    }
+
+    template <class RNG, class S>
+    inline
+    ext::shared_ptr<
+        typename MLMCDiscreteArithmeticAPEngine<RNG,S>::path_pricer_type>
+    MLMCDiscreteArithmeticAPEngine<RNG,S>::pathPricer(
+                                                const TimeGrid& grid) const {
+
+        ext::shared_ptr<PlainVanillaPayoff> payoff =
+            ext::dynamic_pointer_cast<PlainVanillaPayoff>(
+                this->arguments_.payoff);
+        QL_REQUIRE(payoff, "non-plain payoff given");
+
+        ext::shared_ptr<EuropeanExercise> exercise =
+            ext::dynamic_pointer_cast<EuropeanExercise>(
+                this->arguments_.exercise);
+        QL_REQUIRE(exercise, "wrong exercise given");
+
+        std::vector<Time> fixingTimes = this->fixingTimes();
+        std::vector<Size> fixingIndices(fixingTimes.size());
+        for (Size i=0; i<fixingTimes.size(); ++i)
+            fixingIndices[i] = grid.index(fixingTimes[i]);
+
+        return ext::make_shared<FixingIndexedArithmeticAPOPathPricer>(
+            payoff->optionType(),
+            payoff->strike(),
+            process_->riskFreeRate()->discount(exercise->lastDate()),
+            fixingIndices,
+            this->arguments_.runningAccumulator,
+            this->arguments_.pastFixings);
+    }
+
+
+    template <class RNG, class S>
+    inline MakeMLMCDiscreteArithmeticAPEngine<RNG, S>::
+    MakeMLMCDiscreteArithmeticAPEngine(
+        ext::shared_ptr<GeneralizedBlackScholesProcess> process)
+    : process_(std::move(process)), steps_(Null<Size>()),
+      levels_(Null<Size>()), samples_(Null<Size>()),
+      tolerance_(Null<Real>()) {}
+
+    template <class RNG, class S>
+    inline MakeMLMCDiscreteArithmeticAPEngine<RNG,S>&
+    MakeMLMCDiscreteArithmeticAPEngine<RNG,S>::withSteps(Size steps) {
+        steps_ = steps;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMLMCDiscreteArithmeticAPEngine<RNG,S>&
+    MakeMLMCDiscreteArithmeticAPEngine<RNG,S>::withLevels(Size levels) {
+        levels_ = levels;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMLMCDiscreteArithmeticAPEngine<RNG,S>&
+    MakeMLMCDiscreteArithmeticAPEngine<RNG,S>::withSamples(Size samples) {
+        QL_REQUIRE(tolerance_ == Null<Real>(),
+                   "tolerance already set");
+        samples_ = samples;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMLMCDiscreteArithmeticAPEngine<RNG,S>&
+    MakeMLMCDiscreteArithmeticAPEngine<RNG,S>::withAbsoluteTolerance(
+                                                             Real tolerance) {
+        QL_REQUIRE(samples_ == Null<Size>(),
+                   "number of samples already set");
+        QL_REQUIRE(RNG::allowsErrorEstimate,
+                   "chosen random generator policy "
+                   "does not allow an error estimate");
+        tolerance_ = tolerance;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMLMCDiscreteArithmeticAPEngine<RNG,S>&
+    MakeMLMCDiscreteArithmeticAPEngine<RNG,S>::withSeed(BigNatural seed) {
+        seed_ = seed;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline
+    MakeMLMCDiscreteArithmeticAPEngine<RNG,S>::
+    operator ext::shared_ptr<PricingEngine>() const {
+        return ext::shared_ptr<PricingEngine>(new
+            MLMCDiscreteArithmeticAPEngine<RNG,S>(process_,
+                                                  steps_,
+                                                  levels_,
+                                                  samples_, tolerance_,
+                                                  seed_));
+    }
+
+}
+
+
+#endif
@@ -28,6 +28,8 @@
 
 #include <ql/exercise.hpp>
 #include <ql/instruments/barrieroption.hpp>
+#include <ql/pricingengines/mcimportancesampling.hpp>
+#include <ql/pricingengines/mcpathgreeks.hpp>
 #include <ql/pricingengines/mcsimulation.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
 #include <utility>
@@ -48,6 +50,19 @@ namespace QuantLib {
         Journal of Derivatives; Winter 1998; 6, 2; pg. 65-83
         </i>
 
+        If requested, delta, gamma and vega are estimated on the same
+        paths as the option value by means of likelihood-ratio
+        weights, which do not require the payoff to be
+        differentiable.  This requires a constant Black volatility
+        and the biased pricer, i.e., a barrier monitored on the
+        simulation grid: the Brownian-bridge correction depends
+        explicitly on the spot and on the volatility, which the
+        weights don't account for.
+
+        When the barrier is rarely hit, paths can be sampled with a
+        drift shifted towards it and weighted by the corresponding
+        likelihood ratio; see BlackScholesDriftShift.
+
         \ingroup barrierengines
 
         \test the correctness of the returned value is tested by
@@ -74,7 +89,9 @@ namespace QuantLib {
                         Real requiredTolerance,
                         Size maxSamples,
                         bool isBiased,
-                        BigNatural seed);
+                        BigNatural seed,
+                        bool greeks = false,
+                        Real driftShift = 0.0);
         void calculate() const override {
             Real spot = process_->x0();
             QL_REQUIRE(spot > 0.0, "negative or null underlying given");
@@ -86,20 +103,39 @@ namespace QuantLib {
             if constexpr (RNG::allowsErrorEstimate)
                 results_.errorEstimate =
                     this->mcModel_->sampleAccumulator().errorEstimate();
+            if (greeks_) {
+                std::vector<Real> greeks =
+                    this->mcModel_->sensitivityAccumulator().mean();
+                results_.delta = greeks[0];
+                results_.gamma = greeks[1];
+                results_.vega = greeks[2];
+            }
         }
 
       protected:
+        typedef
+        typename McSimulation<SingleVariate,RNG,S>::sensitivity_pricer_type
+            sensitivity_pricer_type;
         // McSimulation implementation
         TimeGrid timeGrid() const override;
         ext::shared_ptr<path_generator_type> pathGenerator() const override {
             TimeGrid grid = timeGrid();
             typename RNG::rsg_type gen =
                 RNG::make_sequence_generator(grid.size()-1,seed_);
+            ext::shared_ptr<GeneralizedBlackScholesProcess> process =
+                driftShift_ == 0.0 ? process_
+                                   : driftShift().samplingProcess();
             return ext::shared_ptr<path_generator_type>(
-                         new path_generator_type(process_,
+                         new path_generator_type(process,
                                                  grid, gen, brownianBridge_));
         }
         ext::shared_ptr<path_pricer_type> pathPricer() const override;
+        ext::shared_ptr<sensitivity_pricer_type>
+        sensitivityPathPricer() const override;
+        BlackScholesDriftShift driftShift() const {
+            return BlackScholesDriftShift(process_, driftShift_,
+                                          timeGrid().back());
+        }
         // data members
         ext::shared_ptr<GeneralizedBlackScholesProcess> process_;
         Size timeSteps_, timeStepsPerYear_;
@@ -108,6 +144,8 @@ namespace QuantLib {
         bool isBiased_;
         bool brownianBridge_;
         BigNatural seed_;
+        bool greeks_;
+        Real driftShift_;
     };
 
 
@@ -126,11 +164,15 @@ namespace QuantLib {
         MakeMCBarrierEngine& withMaxSamples(Size samples);
         MakeMCBarrierEngine& withBias(bool b = true);
         MakeMCBarrierEngine& withSeed(BigNatural seed);
+        MakeMCBarrierEngine& withGreeks(bool b = true);
+        MakeMCBarrierEngine& withDriftShift(Real shift);
         // conversion to pricing engine
         operator ext::shared_ptr<PricingEngine>() const;
       private:
         ext::shared_ptr<GeneralizedBlackScholesProcess> process_;
         bool brownianBridge_ = false, antithetic_ = false, biased_ = false;
+        bool greeks_ = false;
+        Real driftShift_ = 0.0;
         Size steps_, stepsPerYear_, samples_, maxSamples_;
         Real tolerance_;
         BigNatural seed_ = 0;
@@ -193,11 +235,14 @@ namespace QuantLib {
         Real requiredTolerance,
         Size maxSamples,
         bool isBiased,
-        BigNatural seed)
+        BigNatural seed,
+        bool greeks,
+        Real driftShift)
     : McSimulation<SingleVariate, RNG, S>(antitheticVariate, false), process_(std::move(process)),
       timeSteps_(timeSteps), timeStepsPerYear_(timeStepsPerYear), requiredSamples_(requiredSamples),
       maxSamples_(maxSamples), requiredTolerance_(requiredTolerance), isBiased_(isBiased),
-      brownianBridge_(brownianBridge), seed_(seed) {
+      brownianBridge_(brownianBridge), seed_(seed), greeks_(greeks),
+      driftShift_(driftShift) {
         QL_REQUIRE(timeSteps != Null<Size>() ||
                    timeStepsPerYear != Null<Size>(),
                    "no time steps provided");
@@ -210,6 +255,10 @@ namespace QuantLib {
         QL_REQUIRE(timeStepsPerYear != 0,
                    "timeStepsPerYear must be positive, " << timeStepsPerYear <<
                    " not allowed");
+        QL_REQUIRE(!(greeks && driftShift != 0.0),
+                   "Greeks not available with importance sampling");
+        QL_REQUIRE(!greeks || isBiased,
+                   "Greeks only available with the biased pricer");
         registerWith(process_);
     }
 
@@ -241,9 +290,11 @@ namespace QuantLib {
         for (Size i=0; i<grid.size(); i++)
             discounts[i] = process_->riskFreeRate()->discount(grid[i]);
 
+        ext::shared_ptr<typename MCBarrierEngine<RNG,S>::path_pricer_type>
+            pricer;
         // do this with template parameters?
         if (isBiased_) {
-            return ext::shared_ptr<
+            pricer = ext::shared_ptr<
                         typename MCBarrierEngine<RNG,S>::path_pricer_type>(
                 new BiasedBarrierPathPricer(
                        arguments_.barrierType,
@@ -255,7 +306,7 @@ namespace QuantLib {
         } else {
             PseudoRandom::ursg_type sequenceGen(grid.size()-1,
                                                 PseudoRandom::urng_type(5));
-            return ext::shared_ptr<
+            pricer = ext::shared_ptr<
                         typename MCBarrierEngine<RNG,S>::path_pricer_type>(
                 new BarrierPathPricer(
                     arguments_.barrierType,
@@ -267,6 +318,27 @@ namespace QuantLib {
                     process_,
                     sequenceGen));
         }
+
+        // the Brownian-bridge correction doesn't depend on the drift
+        if (driftShift_ == 0.0)
+            return pricer;
+        return ext::shared_ptr<
+                        typename MCBarrierEngine<RNG,S>::path_pricer_type>(
+            new DriftShiftedPathPricer(pricer, driftShift()));
+    }
+
+
+    template <class RNG, class S>
+    inline
+    ext::shared_ptr<typename MCBarrierEngine<RNG,S>::sensitivity_pricer_type>
+    MCBarrierEngine<RNG,S>::sensitivityPathPricer() const {
+        if (!greeks_)
+            return ext::shared_ptr<sensitivity_pricer_type>();
+
+        return ext::shared_ptr<sensitivity_pricer_type>(
+            new LikelihoodRatioGreeksPathPricer(
+                pathPricer(),
+                BlackScholesPathGreeks(process_, timeGrid())));
     }
 
 
@@ -346,6 +418,20 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCBarrierEngine<RNG,S>&
+    MakeMCBarrierEngine<RNG,S>::withGreeks(bool b) {
+        greeks_ = b;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMCBarrierEngine<RNG,S>&
+    MakeMCBarrierEngine<RNG,S>::withDriftShift(Real shift) {
+        driftShift_ = shift;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline
     MakeMCBarrierEngine<RNG,S>::operator ext::shared_ptr<PricingEngine>()
@@ -363,7 +449,9 @@ namespace QuantLib {
                                    samples_, tolerance_,
                                    maxSamples_,
                                    biased_,
-                                   seed_));
+                                   seed_,
+                                   greeks_,
+                                   driftShift_));
     }
 
 }
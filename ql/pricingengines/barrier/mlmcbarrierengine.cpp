@@ -0,0 +1,116 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/pricingengines/barrier/mlmcbarrierengine.hpp>
+#include <utility>
+
+namespace QuantLib {
+
+    ConditionalBarrierPathPricer::ConditionalBarrierPathPricer(
+                            Barrier::Type barrierType,
+                            Real barrier,
+                            Real rebate,
+                            Option::Type type,
+                            Real strike,
+                            std::vector<DiscountFactor> discounts,
+                            ext::shared_ptr<StochasticProcess1D> diffProcess,
+                            std::vector<Size> monitoringIndices)
+    : barrierType_(barrierType), barrier_(barrier), rebate_(rebate),
+      diffProcess_(std::move(diffProcess)), payoff_(type, strike),
+      discounts_(std::move(discounts)) {
+        QL_REQUIRE(strike>=0.0,
+                   "strike less than zero not allowed");
+        QL_REQUIRE(barrier>0.0,
+                   "barrier less/equal zero not allowed");
+        if (!monitoringIndices.empty()) {
+            monitored_.resize(discounts_.size(), false);
+            for (Size i : monitoringIndices) {
+                QL_REQUIRE(i > 0 && i < monitored_.size(),
+                           "monitoring index " << i << " out of range");
+                monitored_[i] = true;
+            }
+        }
+    }
+
+
+    Real ConditionalBarrierPathPricer::crossingProbability(
+                                const Path& path, Size i, bool isDown) const {
+        // probability of hitting the barrier in the step ending at i
+        Real x1 = std::log(path[i]/barrier_);
+        if (isDown ? x1 <= 0.0 : x1 >= 0.0)
+            return 1.0;
+        if (!monitored_.empty())
+            return 0.0;
+
+        Real x0 = std::log(path[i-1]/barrier_);
+        if (isDown ? x0 <= 0.0 : x0 >= 0.0)
+            return 1.0;
+        const TimeGrid& timeGrid = path.timeGrid();
+        Volatility vol = diffProcess_->diffusion(timeGrid[i-1], path[i-1]);
+        return std::exp(-2.0*x0*x1/(vol*vol*timeGrid.dt(i-1)));
+    }
+
+
+    Real ConditionalBarrierPathPricer::operator()(const Path& path) const {
+        Size n = path.length();
+        QL_REQUIRE(n>1, "the path cannot be empty");
+
+        bool isDown;
+        switch (barrierType_) {
+          case Barrier::DownIn:
+          case Barrier::DownOut:
+            isDown = true;
+            break;
+          case Barrier::UpIn:
+          case Barrier::UpOut:
+            isDown = false;
+            break;
+          default:
+            QL_FAIL("unknown barrier type");
+        }
+
+        QL_REQUIRE(monitored_.empty() || monitored_.size() == n,
+                   "path length (" << n << ") differs from "
+                   "the monitoring grid (" << monitored_.size() << ")");
+
+        // probability of not having touched the barrier so far
+        Real survival = 1.0;
+        // rebate value for knock-out options
+        Real rebateValue = 0.0;
+
+        for (Size i = 1; i < n && survival > 0.0; i++) {
+            if (!monitored_.empty() && !monitored_[i])
+                continue;
+            Real p = crossingProbability(path, i, isDown);
+            rebateValue += survival*p*rebate_*discounts_[i];
+            survival *= 1.0 - p;
+        }
+
+        Real value = payoff_(path.back()) * discounts_.back();
+        switch (barrierType_) {
+          case Barrier::DownOut:
+          case Barrier::UpOut:
+            return survival*value + rebateValue;
+          case Barrier::DownIn:
+          case Barrier::UpIn:
+            return (1.0-survival)*value + survival*rebate_*discounts_.back();
+          default:
+            QL_FAIL("unknown barrier type");
+        }
+    }
+
+}
@@ -0,0 +1,350 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file mlmcbarrierengine.hpp
+    \brief Multi-level Monte Carlo barrier option engine
+*/
+
+#ifndef quantlib_mlmc_barrier_engine_hpp
+#define quantlib_mlmc_barrier_engine_hpp
+
+#include <ql/exercise.hpp>
+#include <ql/instruments/barrieroption.hpp>
+#include <ql/pricingengines/mlmcsimulation.hpp>
+#include <ql/processes/blackscholesprocess.hpp>
+#include <utility>
+
+namespace QuantLib {
+
+    //! Pricing engine for barrier options using multi-level Monte Carlo
+    /*! If no monitoring dates are given, the barrier is monitored
+        continuously: the probability of crossing it between two grid
+        points is taken into account through its Brownian-bridge
+        conditional expectation (see ConditionalBarrierPathPricer).
+        Unlike the sampled correction used by MCBarrierEngine, this
+        keeps the payoff a smooth function of the path, so that fine
+        and coarse paths stay strongly coupled across levels.
+
+        If monitoring dates are given, the barrier is only checked on
+        those dates, which are added to the simulation grid of every
+        level.  The knock-out indicator is discontinuous in this case,
+        so that the variance of the level corrections decays more
+        slowly than for continuous monitoring.
+
+        \ingroup barrierengines
+
+        \test the correctness of the returned value is tested by
+              checking it against analytic results.
+    */
+    template <class RNG = PseudoRandom, class S = Statistics>
+    class MLMCBarrierEngine : public BarrierOption::engine,
+                              public MlmcSimulation<SingleVariate,RNG,S> {
+      public:
+        typedef
+        typename MlmcSimulation<SingleVariate,RNG,S>::path_generator_type
+            path_generator_type;
+        typedef typename MlmcSimulation<SingleVariate,RNG,S>::path_pricer_type
+            path_pricer_type;
+        typedef typename MlmcSimulation<SingleVariate,RNG,S>::stats_type
+            stats_type;
+        // constructor
+        MLMCBarrierEngine(ext::shared_ptr<GeneralizedBlackScholesProcess> process,
+                          Size timeSteps,
+                          Size timeStepsPerYear,
+                          Size levels,
+                          Size requiredSamples,
+                          Real requiredTolerance,
+                          BigNatural seed,
+                          std::vector<Date> monitoringDates = {});
+        void calculate() const override {
+            Real spot = process_->x0();
+            QL_REQUIRE(spot > 0.0, "negative or null underlying given");
+            QL_REQUIRE(!triggered(spot), "barrier touched");
+            MlmcSimulation<SingleVariate,RNG,S>::calculate(requiredTolerance_,
+                                                           requiredSamples_,
+                                                           levels_);
+            results_.value = this->mcModel_->mean();
+            if constexpr (RNG::allowsErrorEstimate)
+                results_.errorEstimate = this->mcModel_->errorEstimate();
+            results_.additionalResults["levels"] = this->mcModel_->levels();
+        }
+
+      protected:
+        // MlmcSimulation implementation
+        TimeGrid timeGrid() const override;
+        ext::shared_ptr<path_generator_type>
+        pathGenerator(Size level) const override {
+            TimeGrid fine = this->levelTimeGrid(level);
+            TimeGrid coarse =
+                level > 0 ? this->levelTimeGrid(level-1) : TimeGrid();
+            typename RNG::rsg_type generator =
+                RNG::make_sequence_generator(fine.size()-1,
+                                             seed_ != 0 ? seed_ + level : 0);
+            return ext::make_shared<path_generator_type>(
+                process_, fine, coarse, generator);
+        }
+        ext::shared_ptr<path_pricer_type>
+        pathPricer(const TimeGrid& grid) const override;
+        // data members
+        ext::shared_ptr<GeneralizedBlackScholesProcess> process_;
+        Size timeSteps_, timeStepsPerYear_, levels_;
+        Size requiredSamples_;
+        Real requiredTolerance_;
+        BigNatural seed_;
+        std::vector<Date> monitoringDates_;
+        std::vector<Time> monitoringTimes() const;
+    };
+
+
+    //! Multi-level Monte Carlo barrier-option engine factory
+    template <class RNG = PseudoRandom, class S = Statistics>
+    class MakeMLMCBarrierEngine {
+      public:
+        explicit MakeMLMCBarrierEngine(
+                            ext::shared_ptr<GeneralizedBlackScholesProcess>);
+        // named parameters
+        MakeMLMCBarrierEngine& withSteps(Size steps);
+        MakeMLMCBarrierEngine& withStepsPerYear(Size steps);
+        MakeMLMCBarrierEngine& withLevels(Size levels);
+        MakeMLMCBarrierEngine& withSamples(Size samples);
+        MakeMLMCBarrierEngine& withAbsoluteTolerance(Real tolerance);
+        MakeMLMCBarrierEngine& withSeed(BigNatural seed);
+        MakeMLMCBarrierEngine& withMonitoringDates(std::vector<Date> dates);
+        // conversion to pricing engine
+        operator ext::shared_ptr<PricingEngine>() const;
+      private:
+        ext::shared_ptr<GeneralizedBlackScholesProcess> process_;
+        Size steps_, stepsPerYear_, levels_, samples_;
+        Real tolerance_;
+        BigNatural seed_ = 0;
+        std::vector<Date> monitoringDates_;
+    };
+
+
+    //! Barrier path pricer using the conditional crossing probability
+    /*! If no monitoring indices are given, the barrier is monitored
+        continuously: instead of sampling whether the barrier was
+        crossed between two grid points, the pricer weights the payoff
+        with the probability that the Brownian bridge joining them
+        stays on the alive side of the barrier.
+
+        Otherwise, the barrier is only checked at the given indices
+        of the path.
+
+        Rebates of knock-out options are paid at the end of the step
+        in which the barrier is hit; rebates of knock-in options are
+        paid at expiry.
+    */
+    class ConditionalBarrierPathPricer : public PathPricer<Path> {
+      public:
+        ConditionalBarrierPathPricer(
+                            Barrier::Type barrierType,
+                            Real barrier,
+                            Real rebate,
+                            Option::Type type,
+                            Real strike,
+                            std::vector<DiscountFactor> discounts,
+                            ext::shared_ptr<StochasticProcess1D> diffProcess,
+                            std::vector<Size> monitoringIndices = {});
+        Real operator()(const Path& path) const override;
+
+      private:
+        Real crossingProbability(const Path& path, Size i, bool isDown) const;
+
+        Barrier::Type barrierType_;
+        Real barrier_;
+        Real rebate_;
+        ext::shared_ptr<StochasticProcess1D> diffProcess_;
+        PlainVanillaPayoff payoff_;
+        std::vector<DiscountFactor> discounts_;
+        std::vector<bool> monitored_;
+    };
+
+
+    // template definitions
+
+    template <class RNG, class S>
+    inline MLMCBarrierEngine<RNG, S>::MLMCBarrierEngine(
+        ext::shared_ptr<GeneralizedBlackScholesProcess> process,
+        Size timeSteps,
+        Size timeStepsPerYear,
+        Size levels,
+        Size requiredSamples,
+        Real requiredTolerance,
+        BigNatural seed,
+        std::vector<Date> monitoringDates)
+    : process_(std::move(process)), timeSteps_(timeSteps),
+      timeStepsPerYear_(timeStepsPerYear), levels_(levels),
+      requiredSamples_(requiredSamples),
+      requiredTolerance_(requiredTolerance), seed_(seed),
+      monitoringDates_(std::move(monitoringDates)) {
+        QL_REQUIRE(timeSteps != Null<Size>() ||
+                   timeStepsPerYear != Null<Size>(),
+                   "no time steps provided");
+        QL_REQUIRE(timeSteps == Null<Size>() ||
+                   timeStepsPerYear == Null<Size>(),
+                   "both time steps and time steps per year were provided");
+        QL_REQUIRE(timeSteps != 0,
+                   "timeSteps must be positive, " << timeSteps <<
+                   " not allowed");
+        QL_REQUIRE(timeStepsPerYear != 0,
+                   "timeStepsPerYear must be positive, " << timeStepsPerYear <<
+                   " not allowed");
+        registerWith(process_);
+    }
+
+    template <class RNG, class S>
+    inline std::vector<Time>
+    MLMCBarrierEngine<RNG,S>::monitoringTimes() const {
+        Time residualTime = process_->time(arguments_.exercise->lastDate());
+        std::vector<Time> times;
+        for (const auto& d : monitoringDates_) {
+            Time t = process_->time(d);
+            if (t > 0.0 && t <= residualTime)
+                times.push_back(t);
+        }
+        QL_REQUIRE(monitoringDates_.empty() || !times.empty(),
+                   "no monitoring date between today and expiry");
+        return times;
+    }
+
+    template <class RNG, class S>
+    inline TimeGrid MLMCBarrierEngine<RNG,S>::timeGrid() const {
+
+        Time residualTime = process_->time(arguments_.exercise->lastDate());
+        Size steps;
+        if (timeSteps_ != Null<Size>()) {
+            steps = timeSteps_;
+        } else {
+            steps = std::max<Size>(
+                static_cast<Size>(timeStepsPerYear_*residualTime), 1);
+        }
+        if (monitoringDates_.empty())
+            return TimeGrid(residualTime, steps);
+
+        std::vector<Time> times = monitoringTimes();
+        times.push_back(residualTime);
+        return TimeGrid(times.begin(), times.end(), steps);
+    }
+
+    template <class RNG, class S>
+    inline
+    ext::shared_ptr<typename MLMCBarrierEngine<RNG,S>::path_pricer_type>
+    MLMCBarrierEngine<RNG,S>::pathPricer(const TimeGrid& grid) const {
+        ext::shared_ptr<PlainVanillaPayoff> payoff =
+            ext::dynamic_pointer_cast<PlainVanillaPayoff>(arguments_.payoff);
+        QL_REQUIRE(payoff, "non-plain payoff given");
+
+        std::vector<DiscountFactor> discounts(grid.size());
+        for (Size i=0; i<grid.size(); i++)
+            discounts[i] = process_->riskFreeRate()->discount(grid[i]);
+
+        std::vector<Size> monitoringIndices;
+        for (Time t : monitoringTimes())
+            monitoringIndices.push_back(grid.index(t));
+
+        return ext::make_shared<ConditionalBarrierPathPricer>(
+            arguments_.barrierType, arguments_.barrier, arguments_.rebate,
+            payoff->optionType(), payoff->strike(), discounts, process_,
+            monitoringIndices);
+    }
+
+
+    template <class RNG, class S>
+    inline MakeMLMCBarrierEngine<RNG, S>::MakeMLMCBarrierEngine(
+        ext::shared_ptr<GeneralizedBlackScholesProcess> process)
+    : process_(std::move(process)), steps_(Null<Size>()),
+      stepsPerYear_(Null<Size>()), levels_(Null<Size>()),
+      samples_(Null<Size>()), tolerance_(Null<Real>()) {}
+
+    template <class RNG, class S>
+    inline MakeMLMCBarrierEngine<RNG,S>&
+    MakeMLMCBarrierEngine<RNG,S>::withSteps(Size steps) {
+        steps_ = steps;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMLMCBarrierEngine<RNG,S>&
+    MakeMLMCBarrierEngine<RNG,S>::withStepsPerYear(Size steps) {
+        stepsPerYear_ = steps;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMLMCBarrierEngine<RNG,S>&
+    MakeMLMCBarrierEngine<RNG,S>::withLevels(Size levels) {
+        levels_ = levels;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMLMCBarrierEngine<RNG,S>&
+    MakeMLMCBarrierEngine<RNG,S>::withSamples(Size samples) {
+        QL_REQUIRE(tolerance_ == Null<Real>(),
+                   "tolerance already set");
+        samples_ = samples;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMLMCBarrierEngine<RNG,S>&
+    MakeMLMCBarrierEngine<RNG,S>::withAbsoluteTolerance(Real tolerance) {
+        QL_REQUIRE(samples_ == Null<Size>(),
+                   "number of samples already set");
+        QL_REQUIRE(RNG::allowsErrorEstimate,
+                   "chosen random generator policy "
+                   "does not allow an error estimate");
+        tolerance_ = tolerance;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMLMCBarrierEngine<RNG,S>&
+    MakeMLMCBarrierEngine<RNG,S>::withSeed(BigNatural seed) {
+        seed_ = seed;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMLMCBarrierEngine<RNG,S>&
+    MakeMLMCBarrierEngine<RNG,S>::withMonitoringDates(std::vector<Date> dates) {
+        monitoringDates_ = std::move(dates);
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline
+    MakeMLMCBarrierEngine<RNG,S>::operator ext::shared_ptr<PricingEngine>()
+                                                                      const {
+        QL_REQUIRE(steps_ != Null<Size>() || stepsPerYear_ != Null<Size>(),
+                   "number of steps not given");
+        QL_REQUIRE(steps_ == Null<Size>() || stepsPerYear_ == Null<Size>(),
+                   "number of steps overspecified");
+        return ext::shared_ptr<PricingEngine>(new
+            MLMCBarrierEngine<RNG,S>(process_,
+                                     steps_,
+                                     stepsPerYear_,
+                                     levels_,
+                                     samples_, tolerance_,
+                                     seed_, monitoringDates_));
+    }
+
+}
+
+
+#endif
@@ -58,6 +58,27 @@ namespace QuantLib {
 
                 Real strike;
 
+                // the floating leg, the discount factors and the numeraire
+                // are computed on the whole grid at once and shared by
+                // the cap and floor parts of a collar
+                Array floatingLegNpv, zerobonds, numeraires;
+                if (fixingDate > settlement) {
+                    zerobonds = model_->zerobond(paymentDate, fixingDate, z);
+                    if (iborIndex != nullptr)
+                        floatingLegNpv =
+                            arguments_.accrualTimes[i] *
+                            model_->forwardRate(fixingDate, fixingDate, z,
+                                                iborIndex) *
+                            model_->zerobond(paymentDate, fixingDate, z,
+                                             discountCurve_);
+                    else
+                        floatingLegNpv =
+                            model_->zerobond(valueDate, fixingDate, z) -
+                            zerobonds;
+                    numeraires =
+                        model_->numeraire(fixingTime, z, discountCurve_);
+                }
+
                 if (type == CapFloor::Cap || type == CapFloor::Collar) {
                     strike = arguments_.capRates[i];
                     if (fixingDate <= settlement) {
@@ -66,31 +87,13 @@ namespace QuantLib {
                             arguments_.accrualTimes[i];
                     } else {
 
-                        // todo add openmp support later on (as in gaussian1dswaptionengine)
-
                         for (Size j = 0; j < z.size(); j++) {
-                            Real floatingLegNpv;
-                            if (iborIndex != nullptr)
-                                floatingLegNpv =
-                                    arguments_.accrualTimes[i] *
-                                    model_->forwardRate(fixingDate, fixingDate,
-                                                        z[j], iborIndex) *
-                                    model_->zerobond(paymentDate, fixingDate,
-                                                     z[j], discountCurve_);
-                            else
-                                floatingLegNpv =
-                                    (model_->zerobond(valueDate, fixingDate,
-                                                      z[j]) -
-                                     model_->zerobond(paymentDate, fixingDate,
-                                                      z[j]));
-                            Real fixedLegNpv =
-                                arguments_.capRates[i] *
-                                arguments_.accrualTimes[i] *
-                                model_->zerobond(paymentDate, fixingDate, z[j]);
-                            p[j] =
-                                std::max((floatingLegNpv - fixedLegNpv), 0.0) /
-                                model_->numeraire(fixingTime, z[j],
-                                                  discountCurve_);
+                            Real fixedLegNpv = arguments_.capRates[i] *
+                                               arguments_.accrualTimes[i] *
+                                               zerobonds[j];
+                            p[j] = std::max((floatingLegNpv[j] - fixedLegNpv),
+                                            0.0) /
+                                   numeraires[j];
                         }
                         CubicInterpolation payoff(
                             z.begin(), z.end(), p.begin(),
@@ -141,28 +144,12 @@ namespace QuantLib {
                             f * arguments_.accrualTimes[i];
                     } else {
                         for (Size j = 0; j < z.size(); j++) {
-                            Real floatingLegNpv;
-                            if (iborIndex != nullptr)
-                                floatingLegNpv =
-                                    arguments_.accrualTimes[i] *
-                                    model_->forwardRate(fixingDate, fixingDate,
-                                                        z[j], iborIndex) *
-                                    model_->zerobond(paymentDate, fixingDate,
-                                                     z[j], discountCurve_);
-                            else
-                                floatingLegNpv =
-                                    (model_->zerobond(valueDate, fixingDate,
-                                                      z[j]) -
-                                     model_->zerobond(paymentDate, fixingDate,
-                                                      z[j]));
-                            Real fixedLegNpv =
-                                arguments_.floorRates[i] *
-                                arguments_.accrualTimes[i] *
-                                model_->zerobond(paymentDate, fixingDate, z[j]);
-                            p[j] =
-                                std::max(-(floatingLegNpv - fixedLegNpv), 0.0) /
-                                model_->numeraire(fixingTime, z[j],
-                                                  discountCurve_);
+                            Real fixedLegNpv = arguments_.floorRates[i] *
+                                               arguments_.accrualTimes[i] *
+                                               zerobonds[j];
+                            p[j] = std::max(-(floatingLegNpv[j] - fixedLegNpv),
+                                            0.0) /
+                                   numeraires[j];
                         }
                         CubicInterpolation payoff(
                             z.begin(), z.end(), p.begin(),
@@ -40,6 +40,13 @@ namespace QuantLib {
         registerWith(termStructure_);
     }
 
+    TreeCapFloorEngine::TreeCapFloorEngine(const ext::shared_ptr<ShortRateTreeCache>& treeCache,
+                                           Handle<YieldTermStructure> termStructure)
+    : LatticeShortRateModelEngine<CapFloor::arguments, CapFloor::results>(treeCache),
+      termStructure_(std::move(termStructure)) {
+        registerWith(termStructure_);
+    }
+
     void TreeCapFloorEngine::calculate() const {
 
         QL_REQUIRE(!model_.empty(), "no model specified");
@@ -58,15 +65,8 @@ namespace QuantLib {
         }
 
         DiscretizedCapFloor capfloor(arguments_, referenceDate, dayCounter);
-        ext::shared_ptr<Lattice> lattice;
-
-        if (lattice_ != nullptr) {
-            lattice = lattice_;
-        } else {
-            std::vector<Time> times = capfloor.mandatoryTimes();
-            TimeGrid timeGrid(times.begin(), times.end(), timeSteps_);
-            lattice = model_->tree(timeGrid);
-        }
+        ext::shared_ptr<Lattice> lattice =
+            latticeFor(capfloor.mandatoryTimes());
 
         Time firstTime = dayCounter.yearFraction(referenceDate,
                                                  arguments_.startDates.front());
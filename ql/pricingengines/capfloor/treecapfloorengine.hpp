@@ -46,6 +46,8 @@ namespace QuantLib {
         TreeCapFloorEngine(const ext::shared_ptr<ShortRateModel>& model,
                            const TimeGrid& timeGrid,
                            Handle<YieldTermStructure> termStructure = Handle<YieldTermStructure>());
+        TreeCapFloorEngine(const ext::shared_ptr<ShortRateTreeCache>& treeCache,
+                           Handle<YieldTermStructure> termStructure = Handle<YieldTermStructure>());
         //@}
         void calculate() const override;
 
@@ -26,13 +26,19 @@
 #define quantlib_short_rate_model_engine_hpp
 
 #include <ql/models/model.hpp>
+#include <ql/models/shortrate/shortratetreecache.hpp>
 #include <ql/pricingengines/genericmodelengine.hpp>
 
 namespace QuantLib {
 
     //! Engine for a short-rate model specialized on a lattice
     /*! Derived engines only need to implement the <tt>calculate()</tt>
-        method
+        method, in which the lattice should be obtained by means of
+        <tt>latticeFor(mandatoryTimes)</tt>.  When a tree cache is passed,
+        the lattice is taken from the cache and thus shared with any
+        other engine using the same cache; the mandatory times of the
+        instrument must have been registered with the cache, and the
+        engine is notified when the cache rebuilds the lattice.
     */
     template <class Arguments, class Results>
     class LatticeShortRateModelEngine
@@ -47,12 +53,19 @@ namespace QuantLib {
         LatticeShortRateModelEngine(
                                const ext::shared_ptr<ShortRateModel>& model,
                                const TimeGrid& timeGrid);
+        explicit LatticeShortRateModelEngine(
+                           const ext::shared_ptr<ShortRateTreeCache>& cache);
         void update() override;
 
       protected:
+        //! lattice whose grid contains the given mandatory times
+        ext::shared_ptr<Lattice>
+        latticeFor(const std::vector<Time>& mandatoryTimes) const;
+
         TimeGrid timeGrid_;
         Size timeSteps_;
         ext::shared_ptr<Lattice> lattice_;
+        ext::shared_ptr<ShortRateTreeCache> treeCache_;
     };
 
     template <class Arguments, class Results>
@@ -86,6 +99,29 @@ namespace QuantLib {
         lattice_ = this->model_->tree(timeGrid);
     }
 
+    template <class Arguments, class Results>
+    LatticeShortRateModelEngine<Arguments, Results>::LatticeShortRateModelEngine(
+            const ext::shared_ptr<ShortRateTreeCache>& cache)
+    : GenericModelEngine<ShortRateModel, Arguments, Results>(
+          cache->model()),
+      timeSteps_(cache->timeSteps()), treeCache_(cache) {
+        this->registerWith(treeCache_);
+    }
+
+    template <class Arguments, class Results>
+    ext::shared_ptr<Lattice>
+    LatticeShortRateModelEngine<Arguments, Results>::latticeFor(
+            const std::vector<Time>& mandatoryTimes) const {
+        if (lattice_ != nullptr)
+            return lattice_;
+        if (treeCache_ != nullptr)
+            return treeCache_->lattice(mandatoryTimes);
+
+        TimeGrid timeGrid(mandatoryTimes.begin(), mandatoryTimes.end(),
+                          timeSteps_);
+        return this->model_->tree(timeGrid);
+    }
+
     template <class Arguments, class Results>
     void LatticeShortRateModelEngine<Arguments, Results>::update()
     {
@@ -0,0 +1,78 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/pricingengines/mcimportancesampling.hpp>
+#include <ql/math/comparison.hpp>
+#include <ql/quotes/simplequote.hpp>
+#include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
+#include <ql/termstructures/yield/zerospreadedtermstructure.hpp>
+#include <utility>
+
+namespace QuantLib {
+
+    BlackScholesDriftShift::BlackScholesDriftShift(
+            const ext::shared_ptr<GeneralizedBlackScholesProcess>& process,
+            Real shift,
+            Time maturity)
+    : shift_(shift), x0_(process->x0()), maturity_(maturity) {
+        QL_REQUIRE(maturity_ > 0.0, "positive maturity required");
+        QL_REQUIRE(ext::dynamic_pointer_cast<BlackConstantVol>(
+                       process->blackVolatility().currentLink()),
+                   "constant Black volatility required");
+        sigma_ = process->blackVolatility()->blackVol(maturity_, x0_);
+
+        // an additional drift lambda of the Brownian motion is
+        // equivalent to a dividend yield lowered by lambda*sigma
+        Handle<YieldTermStructure> shiftedDividendYield(
+            ext::make_shared<ZeroSpreadedTermStructure>(
+                process->dividendYield(),
+                Handle<Quote>(ext::make_shared<SimpleQuote>(-shift_*sigma_))));
+        samplingProcess_ = ext::make_shared<GeneralizedBlackScholesProcess>(
+            process->stateVariable(), shiftedDividendYield,
+            process->riskFreeRate(), process->blackVolatility());
+
+        logDrift_ = std::log(shiftedDividendYield->discount(maturity_)
+                             / process->riskFreeRate()->discount(maturity_));
+    }
+
+    Real BlackScholesDriftShift::likelihoodRatio(const Path& path) const {
+        QL_REQUIRE(close_enough(path.timeGrid().back(), maturity_),
+                   "path maturity (" << path.timeGrid().back()
+                   << ") different from expected (" << maturity_ << ")");
+        // Brownian motion under the sampling measure
+        Real w = (std::log(path.back()/x0_) - logDrift_
+                  + 0.5*sigma_*sigma_*maturity_) / sigma_;
+        return std::exp(-shift_*w - 0.5*shift_*shift_*maturity_);
+    }
+
+
+    DriftShiftedPathPricer::DriftShiftedPathPricer(
+                                  ext::shared_ptr<PathPricer<Path> > pricer,
+                                  BlackScholesDriftShift driftShift)
+    : pricer_(std::move(pricer)), driftShift_(std::move(driftShift)) {
+        QL_REQUIRE(pricer_, "null path pricer");
+    }
+
+    Real DriftShiftedPathPricer::operator()(const Path& path) const {
+        Real value = (*pricer_)(path);
+        if (value == 0.0)
+            return 0.0;
+        return value * driftShift_.likelihoodRatio(path);
+    }
+
+}
+
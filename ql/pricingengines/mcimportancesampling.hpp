@@ -0,0 +1,87 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file mcimportancesampling.hpp
+    \brief drift-shift importance sampling for Black-Scholes paths
+*/
+
+#ifndef quantlib_mc_importance_sampling_hpp
+#define quantlib_mc_importance_sampling_hpp
+
+#include <ql/methods/montecarlo/path.hpp>
+#include <ql/methods/montecarlo/pathpricer.hpp>
+#include <ql/processes/blackscholesprocess.hpp>
+
+namespace QuantLib {
+
+    //! Drift-shift importance sampling for Black-Scholes paths
+    /*! Paths are sampled from a process whose driving Brownian motion
+        has an additional drift \f$ \lambda \f$ per unit time, i.e.,
+        whose log-price drift is increased by \f$ \lambda \sigma \f$.
+        The value of each path must then be multiplied by the
+        likelihood ratio
+        \f[
+            \frac{dP}{dQ} = \exp\left(-\lambda W^Q_T
+                                      - \frac{1}{2}\lambda^2 T\right)
+        \f]
+        which only depends on the value of the path at \f$ T \f$.
+
+        A positive shift makes high prices more likely, which reduces
+        the variance for deep out-of-the-money calls or up barriers;
+        a negative shift does the same for puts and down barriers.
+
+        Reference: P. Glasserman, Monte Carlo Methods in Financial
+        Engineering, section 4.6.
+
+        \warning the process must have a constant Black volatility.
+    */
+    class BlackScholesDriftShift {
+      public:
+        BlackScholesDriftShift(
+            const ext::shared_ptr<GeneralizedBlackScholesProcess>& process,
+            Real shift,
+            Time maturity);
+        //! process from which the paths must be sampled
+        const ext::shared_ptr<GeneralizedBlackScholesProcess>&
+        samplingProcess() const {
+            return samplingProcess_;
+        }
+        //! likelihood ratio of a path sampled from the shifted process
+        Real likelihoodRatio(const Path& path) const;
+      private:
+        ext::shared_ptr<GeneralizedBlackScholesProcess> samplingProcess_;
+        Real shift_, x0_;
+        Volatility sigma_;
+        Time maturity_;
+        Real logDrift_;
+    };
+
+    //! Path pricer weighting the values of another by the likelihood ratio
+    class DriftShiftedPathPricer : public PathPricer<Path> {
+      public:
+        DriftShiftedPathPricer(ext::shared_ptr<PathPricer<Path> > pricer,
+                               BlackScholesDriftShift driftShift);
+        Real operator()(const Path& path) const override;
+      private:
+        ext::shared_ptr<PathPricer<Path> > pricer_;
+        BlackScholesDriftShift driftShift_;
+    };
+
+}
+
+
+#endif
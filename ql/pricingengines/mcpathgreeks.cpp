@@ -0,0 +1,107 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/pricingengines/mcpathgreeks.hpp>
+#include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
+#include <utility>
+
+namespace QuantLib {
+
+    BlackScholesPathGreeks::BlackScholesPathGreeks(
+            const ext::shared_ptr<GeneralizedBlackScholesProcess>& process,
+            const TimeGrid& grid)
+    : x0_(process->x0()), drifts_(grid.size(), 0.0),
+      cumulativeDrifts_(grid.size(), 0.0), sqrtDt_(grid.size(), 0.0) {
+        QL_REQUIRE(grid.size() > 1, "at least one time step required");
+        QL_REQUIRE(grid.front() == 0.0, "time grid must start at zero");
+        QL_REQUIRE(ext::dynamic_pointer_cast<BlackConstantVol>(
+                       process->blackVolatility().currentLink()),
+                   "constant Black volatility required");
+        sigma_ = process->blackVolatility()->blackVol(grid.back(), x0_);
+        QL_REQUIRE(sigma_ > 0.0, "positive volatility required");
+        QL_REQUIRE(x0_ > 0.0, "positive underlying value required");
+
+        const Handle<YieldTermStructure>& riskFree = process->riskFreeRate();
+        const Handle<YieldTermStructure>& dividend = process->dividendYield();
+        for (Size i=1; i<grid.size(); ++i) {
+            drifts_[i] = std::log(dividend->discount(grid[i])
+                                  / dividend->discount(grid[i-1])
+                                  * riskFree->discount(grid[i-1])
+                                  / riskFree->discount(grid[i]));
+            cumulativeDrifts_[i] = cumulativeDrifts_[i-1] + drifts_[i];
+            sqrtDt_[i] = std::sqrt(grid.dt(i-1));
+        }
+        t1_ = grid[1];
+    }
+
+    Real BlackScholesPathGreeks::normalVariate(const Path& path,
+                                               Size i) const {
+        Real stdDev = sigma_*sqrtDt_[i];
+        return (std::log(path[i]/path[i-1]) - drifts_[i]
+                + 0.5*stdDev*stdDev) / stdDev;
+    }
+
+    Real BlackScholesPathGreeks::pathwiseVega(const Path& path,
+                                              Size i) const {
+        Time t = path.time(i);
+        return path[i] * (std::log(path[i]/x0_) - cumulativeDrifts_[i]
+                          - 0.5*sigma_*sigma_*t) / sigma_;
+    }
+
+    Real BlackScholesPathGreeks::deltaWeight(const Path& path) const {
+        Real z1 = normalVariate(path, 1);
+        return z1 / (x0_*sigma_*std::sqrt(t1_));
+    }
+
+    Real BlackScholesPathGreeks::gammaWeight(const Path& path) const {
+        Real z1 = normalVariate(path, 1);
+        Real sqrtT1 = std::sqrt(t1_);
+        return ((z1*z1 - 1.0)/(sigma_*sigma_*t1_) - z1/(sigma_*sqrtT1))
+            / (x0_*x0_);
+    }
+
+    Real BlackScholesPathGreeks::vegaWeight(const Path& path) const {
+        Real weight = 0.0;
+        for (Size i=1; i<path.length(); ++i) {
+            Real z = normalVariate(path, i);
+            weight += (z*z - 1.0)/sigma_ - z*sqrtDt_[i];
+        }
+        return weight;
+    }
+
+
+    LikelihoodRatioGreeksPathPricer::LikelihoodRatioGreeksPathPricer(
+                                  ext::shared_ptr<PathPricer<Path> > pricer,
+                                  BlackScholesPathGreeks greeks,
+                                  bool vega)
+    : pricer_(std::move(pricer)), greeks_(std::move(greeks)), vega_(vega) {
+        QL_REQUIRE(pricer_, "null path pricer");
+    }
+
+    Array LikelihoodRatioGreeksPathPricer::operator()(
+                                                  const Path& path) const {
+        Real value = (*pricer_)(path);
+        Array result(vega_ ? 3 : 2);
+        result[0] = value * greeks_.deltaWeight(path);
+        result[1] = value * greeks_.gammaWeight(path);
+        if (vega_)
+            result[2] = value * greeks_.vegaWeight(path);
+        return result;
+    }
+
+}
+
@@ -0,0 +1,96 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file mcpathgreeks.hpp
+    \brief pathwise and likelihood-ratio Greeks on Black-Scholes paths
+*/
+
+#ifndef quantlib_mc_path_greeks_hpp
+#define quantlib_mc_path_greeks_hpp
+
+#include <ql/math/array.hpp>
+#include <ql/methods/montecarlo/path.hpp>
+#include <ql/methods/montecarlo/pathpricer.hpp>
+#include <ql/processes/blackscholesprocess.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! Path derivatives for Black-Scholes Monte Carlo Greeks
+    /*! Given a path of the Black-Scholes process with constant
+        volatility \f$ \sigma \f$ on a fixed time grid, this class
+        recovers the normal variates \f$ Z_i \f$ which generated it and
+        provides
+
+        - the pathwise derivatives \f$ \partial S_i / \partial S_0 =
+          S_i / S_0 \f$ and \f$ \partial S_i / \partial \sigma \f$,
+          to be used with payoffs that are almost everywhere
+          differentiable;
+        - the likelihood-ratio weights for delta, gamma and vega,
+          which multiply the discounted payoff and thus apply to any
+          payoff, including discontinuous ones.
+
+        Reference: P. Glasserman, Monte Carlo Methods in Financial
+        Engineering, chapter 7.
+
+        \warning the process must have a constant Black volatility.
+    */
+    class BlackScholesPathGreeks {
+      public:
+        BlackScholesPathGreeks(
+            const ext::shared_ptr<GeneralizedBlackScholesProcess>& process,
+            const TimeGrid& grid);
+        Real x0() const { return x0_; }
+        Volatility volatility() const { return sigma_; }
+        //! derivative of the i-th path value with respect to the volatility
+        Real pathwiseVega(const Path& path, Size i) const;
+        //! \name Likelihood-ratio weights
+        //@{
+        Real deltaWeight(const Path& path) const;
+        Real gammaWeight(const Path& path) const;
+        Real vegaWeight(const Path& path) const;
+        //@}
+      private:
+        Real normalVariate(const Path& path, Size i) const;
+        Real x0_;
+        Volatility sigma_;
+        std::vector<Real> drifts_, cumulativeDrifts_, sqrtDt_;
+        Time t1_;
+    };
+
+    //! Likelihood-ratio Greeks for a generic path pricer
+    /*! The returned array contains delta, gamma and, if requested,
+        vega of the wrapped pricer.  Vega must not be requested if the
+        wrapped pricer depends explicitly on the volatility.
+    */
+    class LikelihoodRatioGreeksPathPricer : public PathPricer<Path, Array> {
+      public:
+        LikelihoodRatioGreeksPathPricer(
+            ext::shared_ptr<PathPricer<Path> > pricer,
+            BlackScholesPathGreeks greeks,
+            bool vega = true);
+        Array operator()(const Path& path) const override;
+      private:
+        ext::shared_ptr<PathPricer<Path> > pricer_;
+        BlackScholesPathGreeks greeks_;
+        bool vega_;
+    };
+
+}
+
+
+#endif
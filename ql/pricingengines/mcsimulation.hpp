@@ -36,6 +36,12 @@ namespace QuantLib {
         class from McSimulation gives an easy way to write a Monte
         Carlo engine.
 
+        With randomized quasi-Monte Carlo traits (see
+        RandomizedLowDiscrepancy) the error estimate is based on the
+        spread between independent randomizations; a required
+        tolerance is then met by doubling the points drawn from each
+        of them.
+
         See McVanillaEngine as an example.
     */
 
@@ -49,6 +55,12 @@ namespace QuantLib {
         typedef typename MonteCarloModel<MC,RNG,S>::stats_type
             stats_type;
         typedef typename MonteCarloModel<MC,RNG,S>::result_type result_type;
+        typedef
+        typename MonteCarloModel<MC,RNG,S>::sensitivity_pricer_type
+            sensitivity_pricer_type;
+        typedef
+        typename MonteCarloModel<MC,RNG,S>::control_variates_pricer_type
+            control_variates_pricer_type;
 
         virtual ~McSimulation() = default;
         //! add samples until the required absolute tolerance is reached
@@ -87,6 +99,25 @@ namespace QuantLib {
         virtual result_type controlVariateValue() const {
             return Null<result_type>();
         }
+        /*! if a pricer is returned, its results are averaged over
+            the simulated paths together with the option value */
+        virtual ext::shared_ptr<sensitivity_pricer_type>
+        sensitivityPathPricer() const {
+            return ext::shared_ptr<sensitivity_pricer_type>();
+        }
+        /*! if a pricer is returned, the controls it evaluates on each
+            path are used together, with regression-estimated
+            coefficients; their expected values must be returned by
+            controlVariatesValues().  This can be combined with the
+            single control variate above.
+        */
+        virtual ext::shared_ptr<control_variates_pricer_type>
+        controlVariatesPathPricer() const {
+            return ext::shared_ptr<control_variates_pricer_type>();
+        }
+        virtual Array controlVariatesValues() const {
+            return Array();
+        }
         template <class Sequence>
         static Real maxError(const Sequence& sequence) {
             return *std::max_element(sequence.begin(), sequence.end());
@@ -106,11 +137,19 @@ namespace QuantLib {
         McSimulation<MC,RNG,S>::value(Real tolerance,
                                               Size maxSamples,
                                               Size minSamples) const {
-        Size sampleNumber =
-            mcModel_->sampleAccumulator().samples();
+        Size replicates = mcModel_->replicates();
+        if (replicates > 1) {
+            // same power-of-two number of points in each randomization
+            Size points = 1;
+            while (points*replicates < minSamples)
+                points *= 2;
+            minSamples = points*replicates;
+        }
+
+        Size sampleNumber = mcModel_->samples();
         if (sampleNumber<minSamples) {
             mcModel_->addSamples(minSamples-sampleNumber);
-            sampleNumber = mcModel_->sampleAccumulator().samples();
+            sampleNumber = mcModel_->samples();
         }
 
         Size nextBatch;
@@ -122,11 +161,18 @@ namespace QuantLib {
                        << ") reached, while error (" << error
                        << ") is still above tolerance (" << tolerance << ")");
 
-            // conservative estimate of how many samples are needed
-            order = maxError(Real(error*error))/tolerance/tolerance;
-            nextBatch =
-                Size(std::max<Real>(static_cast<Real>(sampleNumber)*order*0.8 - static_cast<Real>(sampleNumber),
-                                    static_cast<Real>(minSamples)));
+            if (replicates > 1) {
+                // the error of randomized QMC decreases faster than
+                // the square root of the samples, so that the
+                // estimate below would be too large; double instead
+                nextBatch = sampleNumber;
+            } else {
+                // conservative estimate of how many samples are needed
+                order = maxError(Real(error*error))/tolerance/tolerance;
+                nextBatch =
+                    Size(std::max<Real>(static_cast<Real>(sampleNumber)*order*0.8 - static_cast<Real>(sampleNumber),
+                                        static_cast<Real>(minSamples)));
+            }
 
             // do not exceed maxSamples
             nextBatch = std::min(nextBatch, maxSamples-sampleNumber);
@@ -143,7 +189,7 @@ namespace QuantLib {
     inline typename McSimulation<MC,RNG,S>::result_type
         McSimulation<MC,RNG,S>::valueWithSamples(Size samples) const {
 
-        Size sampleNumber = mcModel_->sampleAccumulator().samples();
+        Size sampleNumber = mcModel_->samples();
 
         QL_REQUIRE(samples>=sampleNumber,
                    "number of already simulated samples (" << sampleNumber
@@ -186,13 +232,22 @@ namespace QuantLib {
                     new MonteCarloModel<MC,RNG,S>(
                            pathGenerator(), this->pathPricer(), stats_type(),
                            this->antitheticVariate_, controlPP,
-                           controlVariateValue, controlPG));
+                           controlVariateValue, controlPG,
+                           this->sensitivityPathPricer(),
+                           this->controlVariatesPathPricer(),
+                           this->controlVariatesValues()));
         } else {
             this->mcModel_ =
                 ext::shared_ptr<MonteCarloModel<MC,RNG,S> >(
                     new MonteCarloModel<MC,RNG,S>(
                            pathGenerator(), this->pathPricer(), S(),
-                           this->antitheticVariate_));
+                           this->antitheticVariate_,
+                           ext::shared_ptr<path_pricer_type>(),
+                           result_type(),
+                           ext::shared_ptr<path_generator_type>(),
+                           this->sensitivityPathPricer(),
+                           this->controlVariatesPathPricer(),
+                           this->controlVariatesValues()));
         }
 
         if (requiredTolerance != Null<Real>()) {
@@ -0,0 +1,287 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file mlmcsimulation.hpp
+    \brief framework for multi-level Monte Carlo engines
+*/
+
+#ifndef quantlib_mlmc_simulation_hpp
+#define quantlib_mlmc_simulation_hpp
+
+#include <ql/methods/montecarlo/multilevelmontecarlomodel.hpp>
+#include <ql/mathconstants.hpp>
+#include <ql/timegrid.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace QuantLib {
+
+    //! base class for multi-level Monte Carlo engines
+    /*! Derived engines provide the time grid of the coarsest level,
+        a path pricer for a given time grid and a coupled path
+        generator for each level.  The time grid on level \f$ l \f$
+        is obtained by splitting every step of the coarsest grid
+        into \f$ M^l \f$ equal sub-steps, \f$ M \f$ being the
+        refinement factor.
+
+        When a tolerance is given, levels are added and samples are
+        allocated across them following Giles' adaptive algorithm so
+        that the root-mean-square error of the estimator, including
+        the estimated discretization bias, falls below the tolerance.
+        The number of samples on each level is chosen to minimise the
+        total cost for the target variance, i.e.,
+        \f$ N_l \propto \sqrt{V_l/C_l} \f$.
+
+        See MLMCEuropeanHestonEngine as an example.
+
+        \ingroup mcarlo
+    */
+    template <template <class> class MC, class RNG, class S = Statistics>
+    class MlmcSimulation {
+      public:
+        typedef typename MultiLevelMonteCarloModel<MC,RNG,S>::path_generator_type
+            path_generator_type;
+        typedef typename MultiLevelMonteCarloModel<MC,RNG,S>::path_pricer_type
+            path_pricer_type;
+        typedef typename MultiLevelMonteCarloModel<MC,RNG,S>::stats_type
+            stats_type;
+        typedef typename MultiLevelMonteCarloModel<MC,RNG,S>::result_type
+            result_type;
+
+        virtual ~MlmcSimulation() = default;
+        //! add levels and samples until the required RMS error is reached
+        result_type value(Real tolerance,
+                          Size maxLevels,
+                          Size minSamples = 1000) const;
+        //! simulate a fixed number of levels
+        /*! The number of samples on level \f$ l \f$ is the given number
+            of samples divided by \f$ M^l \f$.
+        */
+        result_type valueWithSamples(Size samples, Size levels) const;
+        //! error estimated using the samples simulated so far
+        result_type errorEstimate() const;
+        //! access to the underlying multi-level model
+        const MultiLevelMonteCarloModel<MC,RNG,S>& model() const;
+        //! basic calculate method provided to inherited pricing engines
+        void calculate(Real requiredTolerance,
+                       Size requiredSamples,
+                       Size levels) const;
+      protected:
+        explicit MlmcSimulation(Size refinement = 2)
+        : refinement_(refinement) {
+            QL_REQUIRE(refinement_ > 1,
+                       "refinement factor must be greater than one");
+        }
+        virtual ext::shared_ptr<path_pricer_type>
+        pathPricer(const TimeGrid& grid) const = 0;
+        virtual ext::shared_ptr<path_generator_type>
+        pathGenerator(Size level) const = 0;
+        //! time grid on the coarsest level
+        virtual TimeGrid timeGrid() const = 0;
+        //! time grid on the given level
+        TimeGrid levelTimeGrid(Size level) const;
+        void addLevel() const;
+
+        mutable ext::shared_ptr<MultiLevelMonteCarloModel<MC,RNG,S> >
+            mcModel_;
+        Size refinement_;
+    };
+
+
+    // inline definitions
+
+    template <template <class> class MC, class RNG, class S>
+    inline TimeGrid MlmcSimulation<MC,RNG,S>::levelTimeGrid(Size level) const {
+        TimeGrid coarsest = timeGrid();
+        if (level == 0)
+            return coarsest;
+
+        Size substeps = 1;
+        for (Size l=0; l<level; ++l)
+            substeps *= refinement_;
+
+        std::vector<Time> times;
+        times.reserve((coarsest.size()-1)*substeps+1);
+        for (Size i=0; i<coarsest.size()-1; ++i) {
+            const Time dt = coarsest.dt(i)/static_cast<Real>(substeps);
+            for (Size k=0; k<substeps; ++k)
+                times.push_back(coarsest[i] + static_cast<Real>(k)*dt);
+        }
+        times.push_back(coarsest.back());
+
+        return TimeGrid(times.begin(), times.end());
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline void MlmcSimulation<MC,RNG,S>::addLevel() const {
+        const Size level = mcModel_->levels();
+        ext::shared_ptr<path_generator_type> generator = pathGenerator(level);
+        if (level == 0)
+            mcModel_->addLevel(generator, pathPricer(generator->timeGrid()));
+        else
+            mcModel_->addLevel(generator,
+                               pathPricer(generator->timeGrid()),
+                               pathPricer(generator->coarseTimeGrid()));
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline typename MlmcSimulation<MC,RNG,S>::result_type
+    MlmcSimulation<MC,RNG,S>::value(Real tolerance,
+                                    Size maxLevels,
+                                    Size minSamples) const {
+        QL_REQUIRE(tolerance > 0.0, "tolerance must be positive");
+        QL_REQUIRE(maxLevels >= 2,
+                   "at least two levels above the coarsest one required");
+        QL_REQUIRE(minSamples > 1, "at least two samples per level required");
+
+        const Real M = static_cast<Real>(refinement_);
+
+        Size L = 2;
+        while (mcModel_->levels() <= L)
+            addLevel();
+
+        std::vector<Size> extraSamples(L+1);
+        for (Size l=0; l<=L; ++l) {
+            Size n = mcModel_->levelAccumulator(l).samples();
+            extraSamples[l] = n < minSamples ? minSamples - n : 0;
+        }
+
+        for (;;) {
+            for (Size l=0; l<=L; ++l)
+                if (extraSamples[l] > 0)
+                    mcModel_->addSamples(l, extraSamples[l]);
+
+            // optimal allocation for a variance of tolerance^2/2
+            std::vector<Real> variances(L+1);
+            Real sumVC = 0.0;
+            for (Size l=0; l<=L; ++l) {
+                variances[l] = std::max(
+                    mcModel_->levelAccumulator(l).variance(), QL_EPSILON);
+                sumVC += std::sqrt(variances[l]*mcModel_->levelCost(l));
+            }
+
+            bool converged = true;
+            for (Size l=0; l<=L; ++l) {
+                const Real n = static_cast<Real>(
+                    mcModel_->levelAccumulator(l).samples());
+                const Real optimal = std::ceil(
+                    2.0/(tolerance*tolerance)
+                    * std::sqrt(variances[l]/mcModel_->levelCost(l))*sumVC);
+                if (optimal > n) {
+                    extraSamples[l] = static_cast<Size>(optimal - n);
+                    if (optimal - n > 0.01*n)
+                        converged = false;
+                } else {
+                    extraSamples[l] = 0;
+                }
+            }
+            if (!converged)
+                continue;
+
+            // weak order estimated by regression on the level means
+            Real sx = 0.0, sy = 0.0, sxx = 0.0, sxy = 0.0;
+            for (Size l=1; l<=L; ++l) {
+                const Real x = static_cast<Real>(l);
+                const Real y = std::log(std::max(
+                    std::fabs(mcModel_->levelAccumulator(l).mean()),
+                    QL_EPSILON))/std::log(M);
+                sx += x; sy += y; sxx += x*x; sxy += x*y;
+            }
+            const Real nPoints = static_cast<Real>(L);
+            const Real alpha = std::max(
+                0.5, -(nPoints*sxy - sx*sy)/(nPoints*sxx - sx*sx));
+
+            const Real bias = std::max(
+                std::fabs(mcModel_->levelAccumulator(L).mean()),
+                std::fabs(mcModel_->levelAccumulator(L-1).mean())
+                    / std::pow(M, alpha)) / (std::pow(M, alpha) - 1.0);
+
+            if (bias <= tolerance/M_SQRT2)
+                break;
+
+            QL_REQUIRE(L < maxLevels,
+                       "max number of levels (" << maxLevels
+                       << ") reached, while estimated bias (" << bias
+                       << ") is still above tolerance ("
+                       << tolerance/M_SQRT2 << ")");
+
+            ++L;
+            addLevel();
+            extraSamples.push_back(minSamples);
+        }
+
+        return mcModel_->mean();
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline typename MlmcSimulation<MC,RNG,S>::result_type
+    MlmcSimulation<MC,RNG,S>::valueWithSamples(Size samples,
+                                               Size levels) const {
+        while (mcModel_->levels() <= levels)
+            addLevel();
+
+        Size n = samples;
+        for (Size l=0; l<=levels; ++l) {
+            const Size done = mcModel_->levelAccumulator(l).samples();
+            const Size required = std::max<Size>(n, 2);
+            if (required > done)
+                mcModel_->addSamples(l, required-done);
+            n /= refinement_;
+        }
+
+        return mcModel_->mean();
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline void MlmcSimulation<MC,RNG,S>::calculate(Real requiredTolerance,
+                                                    Size requiredSamples,
+                                                    Size levels) const {
+
+        QL_REQUIRE(requiredTolerance != Null<Real>() ||
+                   requiredSamples != Null<Size>(),
+                   "neither tolerance nor number of samples set");
+
+        mcModel_ = ext::make_shared<MultiLevelMonteCarloModel<MC,RNG,S> >();
+
+        if (requiredTolerance != Null<Real>()) {
+            QL_REQUIRE(RNG::allowsErrorEstimate,
+                       "chosen random generator policy "
+                       "does not allow an error estimate");
+            this->value(requiredTolerance,
+                        levels != Null<Size>() ? levels : Size(10));
+        } else {
+            QL_REQUIRE(levels != Null<Size>(), "number of levels not set");
+            this->valueWithSamples(requiredSamples, levels);
+        }
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline typename MlmcSimulation<MC,RNG,S>::result_type
+    MlmcSimulation<MC,RNG,S>::errorEstimate() const {
+        return mcModel_->errorEstimate();
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline const MultiLevelMonteCarloModel<MC,RNG,S>&
+    MlmcSimulation<MC,RNG,S>::model() const {
+        return *mcModel_;
+    }
+
+}
+
+
+#endif
@@ -40,6 +40,13 @@ namespace QuantLib {
         registerWith(termStructure_);
     }
 
+    TreeVanillaSwapEngine::TreeVanillaSwapEngine(const ext::shared_ptr<ShortRateTreeCache>& treeCache,
+                                                 Handle<YieldTermStructure> termStructure)
+    : LatticeShortRateModelEngine<VanillaSwap::arguments, VanillaSwap::results>(treeCache),
+      termStructure_(std::move(termStructure)) {
+        registerWith(termStructure_);
+    }
+
     void TreeVanillaSwapEngine::calculate() const {
 
         QL_REQUIRE(!model_.empty(), "no model specified");
@@ -60,13 +67,7 @@ namespace QuantLib {
         DiscretizedSwap swap(arguments_, referenceDate, dayCounter);
         std::vector<Time> times = swap.mandatoryTimes();
 
-        ext::shared_ptr<Lattice> lattice;
-        if (lattice_ != nullptr) {
-            lattice = lattice_;
-        } else {
-            TimeGrid timeGrid(times.begin(), times.end(), timeSteps_);
-            lattice = model_->tree(timeGrid);
-        }
+        ext::shared_ptr<Lattice> lattice = latticeFor(times);
 
         Time maxTime = *std::max_element(times.begin(), times.end());
         swap.initialize(lattice, maxTime);
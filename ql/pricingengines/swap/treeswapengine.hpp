@@ -50,6 +50,9 @@ namespace QuantLib {
             const ext::shared_ptr<ShortRateModel>&,
             const TimeGrid& timeGrid,
             Handle<YieldTermStructure> termStructure = Handle<YieldTermStructure>());
+        TreeVanillaSwapEngine(
+            const ext::shared_ptr<ShortRateTreeCache>& treeCache,
+            Handle<YieldTermStructure> termStructure = Handle<YieldTermStructure>());
         //@}
         void calculate() const override;
 
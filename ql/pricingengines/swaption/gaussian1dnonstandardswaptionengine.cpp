@@ -198,9 +198,103 @@ namespace QuantLib {
                                  arguments_.floatingResetDates.end(), expiry0 - 1) -
                 arguments_.floatingResetDates.begin();
 
-            // todo add openmp support later on (as in gaussian1dswaptionengine)
+            // the exercise values are computed on the whole grid
+            // before entering the loop over the grid points below,
+            // with the state independent parts of the model quantities
+            // computed only once per coupon
+            Array exerciseValues, numeraires;
+            Real zerobond0 = 0.0;
+            if (expiry0 > settlement) {
+                Array floatingLegNpv(z.size(), 0.0), fixedLegNpv(z.size(), 0.0);
+                for (Size l = k1; l < arguments_.floatingCoupons.size(); l++) {
+                    Real zSpreadDf =
+                        oas_.empty()
+                            ? Real(1.0)
+                            : std::exp(
+                                  -oas_->value() *
+                                  (model_->termStructure()
+                                       ->dayCounter()
+                                       .yearFraction(
+                                            expiry0,
+                                            arguments_.floatingPayDates[l])));
+                    Array amounts;
+                    if (arguments_.floatingIsRedemptionFlow[l])
+                        amounts = Array(z.size(), arguments_.floatingCoupons[l]);
+                    else
+                        amounts = arguments_.floatingNominal[l] *
+                                  arguments_.floatingAccrualTimes[l] *
+                                  (arguments_.floatingGearings[l] *
+                                       model_->forwardRate(
+                                           arguments_.floatingFixingDates[l],
+                                           expiry0, z,
+                                           arguments_.swap->iborIndex()) +
+                                   arguments_.floatingSpreads[l]);
+                    Array zerobonds =
+                        model_->zerobond(arguments_.floatingPayDates[l],
+                                         expiry0, z, discountCurve_);
+                    for (Size k = 0; k < z.size(); k++)
+                        floatingLegNpv[k] += amounts[k] * zerobonds[k] * zSpreadDf;
+                }
+                for (Size l = j1; l < arguments_.fixedCoupons.size(); l++) {
+                    Real zSpreadDf =
+                        oas_.empty()
+                            ? Real(1.0)
+                            : std::exp(
+                                  -oas_->value() *
+                                  (model_->termStructure()
+                                       ->dayCounter()
+                                       .yearFraction(
+                                            expiry0,
+                                            arguments_.fixedPayDates[l])));
+                    Array zerobonds =
+                        model_->zerobond(arguments_.fixedPayDates[l], expiry0,
+                                         z, discountCurve_);
+                    for (Size k = 0; k < z.size(); k++)
+                        fixedLegNpv[k] +=
+                            arguments_.fixedCoupons[l] * zerobonds[k] * zSpreadDf;
+                }
+                Real rebate = 0.0;
+                Real zSpreadDf = 1.0;
+                Date rebateDate = expiry0;
+                if (rebatedExercise != nullptr) {
+                    rebate = rebatedExercise->rebate(idx);
+                    rebateDate = rebatedExercise->rebatePaymentDate(idx);
+                    zSpreadDf =
+                        oas_.empty()
+                            ? Real(1.0)
+                            : std::exp(
+                                  -oas_->value() *
+                                  (model_->termStructure()
+                                       ->dayCounter()
+                                       .yearFraction(expiry0, rebateDate)));
+                }
+                Array rebateZerobonds =
+                    model_->zerobond(rebateDate, expiry0, z, discountCurve_);
+                numeraires = model_->numeraire(expiry0Time, z, discountCurve_);
+                exerciseValues = Array(z.size());
+                for (Size k = 0; k < z.size(); k++)
+                    exerciseValues[k] =
+                        ((type == Option::Call ? 1.0 : -1.0) *
+                             (floatingLegNpv[k] - fixedLegNpv[k]) +
+                         rebate * rebateZerobonds[k] * zSpreadDf) /
+                        numeraires[k];
+                if (probabilities_ != None)
+                    zerobond0 = model_->zerobond(expiry0Time, 0.0, 0.0,
+                                                 discountCurve_);
+            }
 
-            for (Size k = 0; k < (expiry0 > settlement ? npv0.size() : 1);
+            // a lazy object is not thread safe, neither is the caching
+            // in gsrprocess. therefore we trigger computations here such
+            // that neither lazy object recalculation nor write access
+            // during caching occurs in the parallized loop below.
+#ifdef _OPENMP
+            if (expiry1Time != Null<Real>())
+                model_->yGrid(stddevs_, integrationPoints_, expiry1Time,
+                              expiry0Time, 0.0);
+#endif
+
+#pragma omp parallel for default(shared) firstprivate(p) if(expiry0>settlement)
+            for (long k = 0; k < (expiry0 > settlement ? (long)npv0.size() : 1);
                  k++) {
 
                 Real price = 0.0;
@@ -356,78 +450,7 @@ namespace QuantLib {
                 // end probability computation
 
                 if (expiry0 > settlement) {
-                    Real floatingLegNpv = 0.0;
-                    for (Size l = k1; l < arguments_.floatingCoupons.size();
-                         l++) {
-                        Real zSpreadDf =
-                            oas_.empty()
-                                ? Real(1.0)
-                                : std::exp(
-                                      -oas_->value() *
-                                      (model_->termStructure()
-                                           ->dayCounter()
-                                           .yearFraction(
-                                                expiry0,
-                                                arguments_
-                                                    .floatingPayDates[l])));
-                        Real amount;
-                        if (arguments_.floatingIsRedemptionFlow[l])
-                            amount = arguments_.floatingCoupons[l];
-                        else
-                            amount = arguments_.floatingNominal[l] *
-                                     arguments_.floatingAccrualTimes[l] *
-                                     (arguments_.floatingGearings[l] *
-                                          model_->forwardRate(
-                                              arguments_.floatingFixingDates[l],
-                                              expiry0, z[k],
-                                              arguments_.swap->iborIndex()) +
-                                      arguments_.floatingSpreads[l]);
-                        floatingLegNpv +=
-                            amount *
-                            model_->zerobond(arguments_.floatingPayDates[l],
-                                             expiry0, z[k], discountCurve_) *
-                            zSpreadDf;
-                    }
-                    Real fixedLegNpv = 0.0;
-                    for (Size l = j1; l < arguments_.fixedCoupons.size(); l++) {
-                        Real zSpreadDf =
-                            oas_.empty()
-                                ? Real(1.0)
-                                : std::exp(
-                                      -oas_->value() *
-                                      (model_->termStructure()
-                                           ->dayCounter()
-                                           .yearFraction(
-                                                expiry0,
-                                                arguments_.fixedPayDates[l])));
-                        fixedLegNpv +=
-                            arguments_.fixedCoupons[l] *
-                            model_->zerobond(arguments_.fixedPayDates[l],
-                                             expiry0, z[k], discountCurve_) *
-                            zSpreadDf;
-                    }
-                    Real rebate = 0.0;
-                    Real zSpreadDf = 1.0;
-                    Date rebateDate = expiry0;
-                    if (rebatedExercise != nullptr) {
-                        rebate = rebatedExercise->rebate(idx);
-                        rebateDate = rebatedExercise->rebatePaymentDate(idx);
-                        zSpreadDf =
-                            oas_.empty()
-                                ? Real(1.0)
-                                : std::exp(
-                                      -oas_->value() *
-                                      (model_->termStructure()
-                                           ->dayCounter()
-                                           .yearFraction(expiry0, rebateDate)));
-                    }
-                    Real exerciseValue =
-                        ((type == Option::Call ? 1.0 : -1.0) *
-                             (floatingLegNpv - fixedLegNpv) +
-                         rebate * model_->zerobond(rebateDate, expiry0, z[k],
-                                                   discountCurve_) *
-                             zSpreadDf) /
-                        model_->numeraire(expiry0Time, z[k], discountCurve_);
+                    Real exerciseValue = exerciseValues[k];
 
                     // for probability computation
                     if (probabilities_ != None) {
@@ -439,21 +462,12 @@ namespace QuantLib {
                             npvp0.back()[k] =
                                 probabilities_ == Naive
                                     ? Real(1.0)
-                                    : 1.0 / (model_->zerobond(expiry0Time, 0.0,
-                                                              0.0,
-                                                              discountCurve_) *
-                                             model_->numeraire(expiry0, z[k],
-                                                               discountCurve_));
+                                    : 1.0 / (zerobond0 * numeraires[k]);
                         if (exerciseValue >= npv0[k]) {
                             npvp0[idx - minIdxAlive][k] =
                                 probabilities_ == Naive
                                     ? Real(1.0)
-                                    : 1.0 /
-                                          (model_->zerobond(expiry0Time, 0.0,
-                                                            0.0,
-                                                            discountCurve_) *
-                                           model_->numeraire(expiry0Time, z[k],
-                                                             discountCurve_));
+                                    : 1.0 / (zerobond0 * numeraires[k]);
                             for (Size ii = idx - minIdxAlive + 1;
                                  ii < npvp0.size(); ii++)
                                 npvp0[ii][k] = 0.0;
@@ -92,6 +92,44 @@ namespace QuantLib {
                                  floatSchedule.dates().end(), expiry0 - 1) -
                 floatSchedule.dates().begin();
 
+            // the exercise values are computed on the whole grid
+            // before entering the loop over the grid points below,
+            // with the state independent parts of the model quantities
+            // computed only once per coupon
+            Array exerciseValues, numeraires;
+            Real zerobond0 = 0.0;
+            if (expiry0 > settlement) {
+                Array floatingLegNpv(z.size(), 0.0), fixedLegNpv(z.size(), 0.0);
+                for (Size l = k1; l < arguments_.floatingCoupons.size(); l++) {
+                    Array forwards = model_->forwardRate(
+                        arguments_.floatingFixingDates[l], expiry0, z,
+                        arguments_.swap->iborIndex());
+                    Array zerobonds =
+                        model_->zerobond(arguments_.floatingPayDates[l],
+                                         expiry0, z, discountCurve_);
+                    for (Size k = 0; k < z.size(); k++)
+                        floatingLegNpv[k] +=
+                            arguments_.nominal *
+                            arguments_.floatingAccrualTimes[l] *
+                            (arguments_.floatingSpreads[l] + forwards[k]) *
+                            zerobonds[k];
+                }
+                for (Size l = j1; l < arguments_.fixedCoupons.size(); l++) {
+                    Array zerobonds =
+                        model_->zerobond(arguments_.fixedPayDates[l], expiry0,
+                                         z, discountCurve_);
+                    for (Size k = 0; k < z.size(); k++)
+                        fixedLegNpv[k] +=
+                            arguments_.fixedCoupons[l] * zerobonds[k];
+                }
+                numeraires = model_->numeraire(expiry0Time, z, discountCurve_);
+                exerciseValues = (type == Option::Call ? 1.0 : -1.0) *
+                                 (floatingLegNpv - fixedLegNpv) / numeraires;
+                if (probabilities_ != None)
+                    zerobond0 = model_->zerobond(expiry0Time, 0.0, 0.0,
+                                                 discountCurve_);
+            }
+
             // a lazy object is not thread safe, neither is the caching
             // in gsrprocess. therefore we trigger computations here such
             // that neither lazy object recalculation nor write access
@@ -102,20 +140,6 @@ namespace QuantLib {
             if (expiry1Time != Null<Real>())
                 model_->yGrid(stddevs_, integrationPoints_, expiry1Time,
                               expiry0Time, 0.0);
-            if (expiry0 > settlement) {
-                for (Size l = k1; l < arguments_.floatingCoupons.size(); l++) {
-                    model_->forwardRate(arguments_.floatingFixingDates[l],
-                                        expiry0, 0.0,
-                                        arguments_.swap->iborIndex());
-                    model_->zerobond(arguments_.floatingPayDates[l], expiry0,
-                                     0.0, discountCurve_);
-                }
-                for (Size l = j1; l < arguments_.fixedCoupons.size(); l++) {
-                    model_->zerobond(arguments_.fixedPayDates[l], expiry0, 0.0,
-                                     discountCurve_);
-                }
-                model_->numeraire(expiry0Time, 0.0, discountCurve_);
-            }
 #endif
 
 #pragma omp parallel for default(shared) firstprivate(p) if(expiry0>settlement)
@@ -253,30 +277,7 @@ namespace QuantLib {
                 // end probability computation
 
                 if (expiry0 > settlement) {
-                    Real floatingLegNpv = 0.0;
-                    for (Size l = k1; l < arguments_.floatingCoupons.size();
-                         l++) {
-                        floatingLegNpv +=
-                            arguments_.nominal *
-                            arguments_.floatingAccrualTimes[l] *
-                            (arguments_.floatingSpreads[l] +
-                             model_->forwardRate(
-                                 arguments_.floatingFixingDates[l], expiry0,
-                                 z[k], arguments_.swap->iborIndex())) *
-                            model_->zerobond(arguments_.floatingPayDates[l],
-                                             expiry0, z[k], discountCurve_);
-                    }
-                    Real fixedLegNpv = 0.0;
-                    for (Size l = j1; l < arguments_.fixedCoupons.size(); l++) {
-                        fixedLegNpv +=
-                            arguments_.fixedCoupons[l] *
-                            model_->zerobond(arguments_.fixedPayDates[l],
-                                             expiry0, z[k], discountCurve_);
-                    }
-                    Real exerciseValue =
-                        (type == Option::Call ? 1.0 : -1.0) *
-                        (floatingLegNpv - fixedLegNpv) /
-                        model_->numeraire(expiry0Time, z[k], discountCurve_);
+                    Real exerciseValue = exerciseValues[k];
 
                     // for probability computation
                     if (probabilities_ != None) {
@@ -288,21 +289,12 @@ namespace QuantLib {
                             npvp0.back()[k] =
                                 probabilities_ == Naive
                                     ? Real(1.0)
-                                    : 1.0 / (model_->zerobond(expiry0Time, 0.0,
-                                                              0.0,
-                                                              discountCurve_) *
-                                             model_->numeraire(expiry0, z[k],
-                                                               discountCurve_));
+                                    : 1.0 / (zerobond0 * numeraires[k]);
                         if (exerciseValue >= npv0[k]) {
                             npvp0[idx - minIdxAlive][k] =
                                 probabilities_ == Naive
                                     ? Real(1.0)
-                                    : 1.0 /
-                                          (model_->zerobond(expiry0Time, 0.0,
-                                                            0.0,
-                                                            discountCurve_) *
-                                           model_->numeraire(expiry0Time, z[k],
-                                                             discountCurve_));
+                                    : 1.0 / (zerobond0 * numeraires[k]);
                             for (Size ii = idx - minIdxAlive + 1;
                                  ii < npvp0.size(); ii++)
                                 npvp0[ii][k] = 0.0;
@@ -19,39 +19,146 @@
 */
 
 #include <ql/math/solvers1d/brent.hpp>
+#include <ql/models/shortrate/onefactormodels/hullwhite.hpp>
+#include <ql/pricingengines/blackformula.hpp>
 #include <ql/pricingengines/swaption/jamshidianswaptionengine.hpp>
 #include <utility>
 
 namespace QuantLib {
 
+    namespace {
+
+        // gradient of the Jamshidian decomposition w.r.t. (a, sigma)
+        // of the Hull-White model; the strikes of the bond options
+        // depend on the parameters through the discount bond prices
+        // and through r*, which is differentiated implicitly
+        Array hullWhiteGradient(const HullWhite& model,
+                                Option::Type w,
+                                Time maturity,
+                                Time valueTime,
+                                const std::vector<Time>& fixedPayTimes,
+                                const std::vector<Real>& amounts,
+                                const std::vector<Real>& K,
+                                Rate rStar) {
+            const Real a = model.a();
+            const Real sigma = model.sigma();
+            if (a < std::sqrt(QL_EPSILON) || sigma <= 0.0)
+                return {};
+
+            const Handle<YieldTermStructure>& ts = model.termStructure();
+            const Rate forward =
+                ts->forwardRate(maturity, maturity, Continuous, NoFrequency);
+
+            const auto B = [a](Time t, Time T) {
+                return (1.0 - std::exp(-a*(T-t)))/a;
+            };
+            const auto dBda = [a, &B](Time t, Time T) {
+                return ((T-t)*std::exp(-a*(T-t)) - B(t, T))/a;
+            };
+
+            // derivatives of ln A(maturity, T), see HullWhite::A
+            const Real b2t = B(0.0, 2.0*maturity);
+            const Real db2t = dBda(0.0, 2.0*maturity);
+            const auto dLnA = [&](Time T) {
+                const Real b = B(maturity, T), db = dBda(maturity, T);
+                return std::make_pair(
+                    db*forward
+                        - 0.25*sigma*sigma*(2.0*b*db*b2t + b*b*db2t),
+                    -0.5*sigma*b*b*b2t);
+            };
+
+            const Size n = fixedPayTimes.size();
+            const Real Bs = B(maturity, valueTime);
+            const std::pair<Real, Real> dLnAs = dLnA(valueTime);
+
+            // partial derivatives of the strikes K_i
+            std::vector<Real> dLnKda(n), dLnKdsigma(n), dLnKdr(n);
+            Real sumA = 0.0, sumSigma = 0.0, sumR = 0.0;
+            for (Size i=0; i<n; ++i) {
+                const Time T = fixedPayTimes[i];
+                const std::pair<Real, Real> dLnAi = dLnA(T);
+                dLnKda[i] = dLnAi.first - dLnAs.first
+                    - (dBda(maturity, T) - dBda(maturity, valueTime))*rStar;
+                dLnKdsigma[i] = dLnAi.second - dLnAs.second;
+                dLnKdr[i] = -(B(maturity, T) - Bs);
+
+                sumA += amounts[i]*K[i]*dLnKda[i];
+                sumSigma += amounts[i]*K[i]*dLnKdsigma[i];
+                sumR += amounts[i]*K[i]*dLnKdr[i];
+            }
+            if (sumR == 0.0)
+                return {};
+            const Real dRStarda = -sumA/sumR;
+            const Real dRStardsigma = -sumSigma/sumR;
+
+            const Real omega = (w == Option::Call) ? 1.0 : -1.0;
+            const DiscountFactor discountStart = ts->discount(valueTime);
+
+            Array gradient(2, 0.0);
+            for (Size i=0; i<n; ++i) {
+                const Time T = fixedPayTimes[i];
+
+                // bond option volatility, see HullWhite::discountBondOption
+                const Real e1 = std::exp(-2.0*a*(valueTime-maturity));
+                const Real e2 = std::exp(-2.0*a*valueTime);
+                const Real e3 = std::exp(-a*(valueTime+T-2.0*maturity));
+                const Real e4 = std::exp(-a*(valueTime+T));
+                const Real e5 = std::exp(-2.0*a*(T-maturity));
+                const Real e6 = std::exp(-2.0*a*T);
+                const Real c = e1 - e2 - 2.0*(e3 - e4) + e5 - e6;
+                if (c <= 0.0)
+                    return {};
+                const Real dc = -2.0*(valueTime-maturity)*e1
+                    + 2.0*valueTime*e2
+                    + 2.0*(valueTime+T-2.0*maturity)*e3
+                    - 2.0*(valueTime+T)*e4
+                    - 2.0*(T-maturity)*e5
+                    + 2.0*T*e6;
+                const Real v = sigma/(a*std::sqrt(2.0*a))*std::sqrt(c);
+                const Real dvda = v*(-1.5/a + 0.5*dc/c);
+                const Real dvdsigma = v/sigma;
+
+                const Real f = ts->discount(T);
+                const Real k = discountStart*K[i];
+                const Real dPdk = -omega*blackFormulaCashItmProbability(
+                    w, k, f, v);
+                const Real dPdv = blackFormulaStdDevDerivative(k, f, v);
+
+                const Real dLnKda_total = dLnKda[i] + dLnKdr[i]*dRStarda;
+                const Real dLnKdsigma_total =
+                    dLnKdsigma[i] + dLnKdr[i]*dRStardsigma;
+
+                gradient[0] += amounts[i]*(dPdk*k*dLnKda_total + dPdv*dvda);
+                gradient[1] += amounts[i]*(dPdk*k*dLnKdsigma_total
+                                           + dPdv*dvdsigma);
+            }
+            return gradient;
+        }
+
+    }
+
     class JamshidianSwaptionEngine::rStarFinder {
       public:
-        rStarFinder(const ext::shared_ptr<OneFactorAffineModel>& model,
-                    Real nominal,
-                    Time maturity,
-                    Time valueTime,
-                    std::vector<Time> fixedPayTimes,
-                    const std::vector<Real>& amounts)
-        : strike_(nominal), maturity_(maturity), valueTime_(valueTime),
-          times_(std::move(fixedPayTimes)), amounts_(amounts), model_(model) {}
+        // the discount bonds P(maturity, T_i) / P(maturity, valueTime)
+        // are given as ratio_i exp(-b_i r)
+        rStarFinder(Real nominal,
+                    const std::vector<Real>& amounts,
+                    const Array& ratios,
+                    const Array& b)
+        : strike_(nominal), amounts_(amounts), ratios_(ratios), b_(b) {}
 
         Real operator()(Rate x) const {
             Real value = strike_;
-            Real B = model_->discountBond(maturity_, valueTime_, x);
-            Size size = times_.size();
-            for (Size i=0; i<size; i++) {
-                Real dbValue =
-                    model_->discountBond(maturity_, times_[i], x) / B;
-                value -= amounts_[i]*dbValue;
-            }
+            Size size = amounts_.size();
+            for (Size i=0; i<size; i++)
+                value -= amounts_[i]*ratios_[i]*std::exp(-b_[i]*x);
             return value;
         }
       private:
         Real strike_;
-        Time maturity_,valueTime_;
-        std::vector<Time> times_;
         const std::vector<Real>& amounts_;
-        const ext::shared_ptr<OneFactorAffineModel>& model_;
+        const Array& ratios_;
+        const Array& b_;
     };
 
     void JamshidianSwaptionEngine::calculate() const {
@@ -96,8 +203,20 @@ namespace QuantLib {
             fixedPayTimes[i] = dayCounter.yearFraction(referenceDate,
                                                        arguments_.fixedPayDates[i]);
 
-        rStarFinder finder(*model_, arguments_.nominal, maturity, valueTime,
-                           fixedPayTimes, amounts);
+        // the coefficients of the discount bonds at the exercise date
+        // are computed once and shared by all solver iterations
+        Size size = arguments_.fixedCoupons.size();
+        std::vector<Time> bondTimes(fixedPayTimes);
+        bondTimes.push_back(valueTime);
+        Array A, B;
+        (*model_)->discountBondCoefficients(maturity, bondTimes, A, B);
+        Array ratios(size), b(size);
+        for (Size i=0; i<size; i++) {
+            ratios[i] = A[i]/A[size];
+            b[i] = B[i] - B[size];
+        }
+
+        rStarFinder finder(arguments_.nominal, amounts, ratios, b);
         Brent s1d;
         Rate minStrike = -10.0;
         Rate maxStrike = 10.0;
@@ -107,24 +226,31 @@ namespace QuantLib {
         Rate rStar = s1d.solve(finder, 1e-8, 0.05, minStrike, maxStrike);
 
         Option::Type w = arguments_.type==Swap::Payer ? Option::Put : Option::Call;
-        Size size = arguments_.fixedCoupons.size();
 
         Real value = 0.0;
-        Real B = model_->discountBond(maturity, valueTime, rStar);
+        std::vector<Real> strikes(size);
         for (Size i=0; i<size; i++) {
-            Real fixedPayTime =
-                dayCounter.yearFraction(referenceDate,
-                                        arguments_.fixedPayDates[i]);
-            Real strike = model_->discountBond(maturity,
-                                               fixedPayTime,
-                                               rStar) / B;
+            strikes[i] = ratios[i]*std::exp(-b[i]*rStar);
             // Looks like the swaption decomposed into individual options adjusted for maturity. Each individual option is valued by Hull-White (or other one-factor model).
             Real dboValue = model_->discountBondOption(
-                                               w, strike, maturity, valueTime,
-                                               fixedPayTime);
+                                               w, strikes[i], maturity, valueTime,
+                                               fixedPayTimes[i]);
             value += amounts[i]*dboValue;
         }
         results_.value = value;
+
+        if (modelParameterGradient_) {
+            const ext::shared_ptr<HullWhite> hullWhite =
+                ext::dynamic_pointer_cast<HullWhite>(*model_);
+            if (hullWhite != nullptr) {
+                const Array gradient = hullWhiteGradient(
+                    *hullWhite, w, maturity, valueTime, fixedPayTimes,
+                    amounts, strikes, rStar);
+                if (!gradient.empty())
+                    results_.additionalResults["modelParameterGradient"] =
+                        gradient;
+            }
+        }
     }
 
 }
@@ -58,8 +58,20 @@ namespace QuantLib {
         }
         void calculate() const override;
 
+        /*! When enabled, the engine returns the gradient of the
+            swaption value with respect to the model parameters as the
+            "modelParameterGradient" additional result, which is used
+            by calibration helpers.  It is currently available for the
+            Hull-White model.
+        */
+        void enableModelParameterGradient(bool enable = true) {
+            modelParameterGradient_ = enable;
+            update();
+        }
+
       private:
         Handle<YieldTermStructure> termStructure_;
+        bool modelParameterGradient_ = false;
         class rStarFinder;
     };
 
@@ -48,6 +48,13 @@ namespace QuantLib {
         registerWith(termStructure_);
     }
 
+    TreeSwaptionEngine::TreeSwaptionEngine(const ext::shared_ptr<ShortRateTreeCache>& treeCache,
+                                           Handle<YieldTermStructure> termStructure)
+    : LatticeShortRateModelEngine<Swaption::arguments, Swaption::results>(treeCache),
+      termStructure_(std::move(termStructure)) {
+        registerWith(termStructure_);
+    }
+
     void TreeSwaptionEngine::calculate() const {
 
         QL_REQUIRE(arguments_.settlementMethod != Settlement::ParYieldCurve,
@@ -69,15 +76,8 @@ namespace QuantLib {
         }
 
         DiscretizedSwaption swaption(arguments_, referenceDate, dayCounter);
-        ext::shared_ptr<Lattice> lattice;
-
-        if (lattice_ != nullptr) {
-            lattice = lattice_;
-        } else {
-            std::vector<Time> times = swaption.mandatoryTimes();
-            TimeGrid timeGrid(times.begin(), times.end(), timeSteps_);
-            lattice = model_->tree(timeGrid);
-        }
+        ext::shared_ptr<Lattice> lattice =
+            latticeFor(swaption.mandatoryTimes());
 
         std::vector<Time> stoppingTimes(arguments_.exercise->dates().size());
         for (Size i=0; i<stoppingTimes.size(); ++i)
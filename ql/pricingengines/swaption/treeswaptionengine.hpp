@@ -59,6 +59,8 @@ namespace QuantLib {
         TreeSwaptionEngine(const Handle<ShortRateModel>&,
                            Size timeSteps,
                            Handle<YieldTermStructure> termStructure = Handle<YieldTermStructure>());
+        TreeSwaptionEngine(const ext::shared_ptr<ShortRateTreeCache>& treeCache,
+                           Handle<YieldTermStructure> termStructure = Handle<YieldTermStructure>());
         //@}
         void calculate() const override;
 
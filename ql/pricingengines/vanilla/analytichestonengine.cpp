@@ -32,12 +32,14 @@
 #include <ql/math/integrals/simpsonintegral.hpp>
 #include <ql/math/integrals/trapezoidintegral.hpp>
 #include <ql/math/integrals/expsinhintegral.hpp>
+#include <ql/math/integrals/gaussianquadratures.hpp>
 #include <ql/math/solvers1d/brent.hpp>
 #include <ql/math/expm1.hpp>
 #include <ql/math/functional.hpp>
 #include <ql/pricingengines/blackcalculator.hpp>
 #include <ql/pricingengines/vanilla/analytichestonengine.hpp>
 
+#include <boost/functional/hash.hpp>
 #include <boost/math/tools/minima.hpp>
 #include <boost/math/special_functions/sign.hpp>
 
@@ -124,9 +126,119 @@ namespace QuantLib {
             const Real v0T2_, logEpsilon_;
             mutable Size evaluations_ = 0;
         };
+        // Heston characteristic function in the Gatheral form together
+        // with the derivatives of its logarithm w.r.t. the model
+        // parameters (theta, kappa, sigma, rho, v0)
+        std::complex<Real> hestonChFAndLogGradient(
+            const std::complex<Real>& u, Time t,
+            Real kappa, Real theta, Real sigma, Real rho, Real v0,
+            std::complex<Real>* h) {
+
+            typedef std::complex<Real> C;
+            const Real s2 = sigma*sigma;
+            const C iu = C(0.0, 1.0)*u, u2 = u*u + iu;
+            const C xi = kappa - sigma*rho*iu;
+            const C d = std::sqrt(xi*xi + s2*u2);
+            const C e = std::exp(-d*t);
+            const C sh = 0.5*(1.0-e), ch = 0.5*(1.0+e);
+            const C a1 = u2*sh, a2 = (d*ch + xi*sh)/v0;
+            const C a = a1/a2;
+            const C D = std::log(d) - std::log(v0)
+                + 0.5*(kappa-d)*t - std::log(a2);
+
+            const C dd_rho = -xi*sigma*iu/d;
+            const C dd_sigma = (-rho*iu*xi + sigma*u2)/d;
+            const C da2_rho = -sigma*iu*(2.0+xi*t)/(2.0*d*v0)*(xi*ch + d*sh);
+            const C da_rho = (u2*ch*0.5*t*dd_rho - a*da2_rho)/a2;
+            const C da2_sigma =
+                (dd_sigma*(ch*(1.0+0.5*xi*t) + 0.5*d*t*sh) - rho*iu*sh)/v0;
+            const C da_sigma = (u2*ch*0.5*t*dd_sigma - a*da2_sigma)/a2;
+            const C dlnB_rho = dd_rho/d - da2_rho/a2;
+            const C dlnB_kappa = dlnB_rho/(-sigma*iu) + 0.5*t;
+
+            const Real c = 2.0*kappa*theta/s2;
+            h[0] = 2.0*kappa/s2*D - kappa*rho*t*iu/sigma;
+            h[1] = da_rho/(sigma*iu) + 2.0*theta/s2*D + c*dlnB_kappa
+                - theta*rho*t*iu/sigma;
+            h[2] = -da_sigma - 2.0*c/sigma*D
+                + c*(dd_sigma/d - da2_sigma/a2) + kappa*theta*rho*t*iu/s2;
+            h[3] = -da_rho + c*dlnB_rho - kappa*theta*t*iu/sigma;
+            h[4] = -a/v0;
+
+            return std::exp(-kappa*theta*rho*t*iu/sigma - a + c*D);
+        }
+
+        // gradient of the undiscounted option value, computed from
+        //   C = (F - K)/2 + 1/pi int_0^inf
+        //          Re(exp(iuk)(F psi(u-i) - K psi(u))/(iu)) du
+        // with k = ln(F/K), which holds for puts as well
+        Array hestonModelParameterGradient(
+            Time t, Real fwd, Real strike,
+            Real kappa, Real theta, Real sigma, Real rho, Real v0) {
+
+            typedef std::complex<Real> C;
+
+            const Real c_inf = std::sqrt(1.0-rho*rho)*(v0+kappa*theta*t)/sigma;
+            const Real uMax = AnalyticHestonEngine::Integration::
+                andersenPiterbargIntegrationLimit(c_inf, 1e-12, v0, t);
+
+            static const Array x = GaussLegendreIntegration(64).x();
+            static const Array w = GaussLegendreIntegration(64).weights();
+            const Size nPanels = Size(std::ceil(uMax/20.0));
+            const Real halfWidth = 0.5*uMax/nPanels;
+            const Real k = std::log(fwd/strike);
+
+            Array gradient(5, 0.0);
+            C h1[5], h2[5];
+            for (Size p=0; p < nPanels; ++p) {
+                const Real mid = (2*p+1)*halfWidth;
+                for (Size j=0; j < x.size(); ++j) {
+                    const Real u = mid + halfWidth*x[j];
+                    const C psi1 = hestonChFAndLogGradient(
+                        C(u, -1.0), t, kappa, theta, sigma, rho, v0, h1);
+                    const C psi2 = hestonChFAndLogGradient(
+                        C(u, 0.0), t, kappa, theta, sigma, rho, v0, h2);
+                    const C f = halfWidth*w[j]
+                        * std::exp(C(0.0, u*k))/C(0.0, u);
+                    for (Size i=0; i < 5; ++i)
+                        gradient[i] += std::real(
+                            f*(fwd*psi1*h1[i] - strike*psi2*h2[i]));
+                }
+            }
+            return gradient/M_PI;
+        }
     }
 
     // helper class for integration
+    std::size_t AnalyticHestonEngine::ChFCacheKeyHasher::operator()(
+        const ChFCacheKey& x) const {
+        std::size_t seed = 0;
+        boost::hash_combine(seed, x.t);
+        boost::hash_combine(seed, x.j);
+        boost::hash_combine(seed, x.re);
+        boost::hash_combine(seed, x.im);
+        return seed;
+    }
+
+    template <class F>
+    std::complex<Real> AnalyticHestonEngine::cachedValue(
+        Size j, const std::complex<Real>& z, Time t, const F& f) const {
+        // with adaptive integration the nodes depend on the strike
+        if (!useChFCache_ || integration_->isAdaptiveIntegration())
+            return f();
+
+        const ChFCacheKey key = {t, j, z.real(), z.imag()};
+        auto iter = chFCache_.find(key);
+        if (iter == chFCache_.end()) {
+            // nodes may depend on the strike, e.g. through the
+            // Andersen-Piterbarg integration limit; bound the memory
+            if (chFCache_.size() >= maxChFCacheSize)
+                chFCache_.clear();
+            iter = chFCache_.emplace(key, f()).first;
+        }
+        return iter->second;
+    }
+
     class AnalyticHestonEngine::Fj_Helper {
     public:
       Fj_Helper(Real kappa, Real theta, Real sigma, Real v0,
@@ -138,6 +250,9 @@ namespace QuantLib {
       Real operator()(Real phi) const;
 
     private:
+        // strike-independent part of the exponent in the Gatheral form
+        std::complex<Real> lnGatheral(Real phi) const;
+
         const Size j_;
         //     const VanillaOption::arguments& arg_;
         const Real kappa_, theta_, sigma_, v0_;
@@ -180,8 +295,8 @@ namespace QuantLib {
     {
     }
 
-    Real AnalyticHestonEngine::Fj_Helper::operator()(Real phi) const
-    {
+    std::complex<Real>
+    AnalyticHestonEngine::Fj_Helper::lnGatheral(Real phi) const {
         const Real rpsig(rsigma_*phi);
 
         const std::complex<Real> t1 = t0_+std::complex<Real>(0, -rpsig);
@@ -192,33 +307,37 @@ namespace QuantLib {
         const std::complex<Real> addOnTerm =
             engine_ != nullptr ? engine_->addOnTerm(phi, term_, j_) : Real(0.0);
 
+        if (sigma_ > 1e-5) {
+            const std::complex<Real> p = (t1-d)/(t1+d);
+            const std::complex<Real> g = std::log((1.0 - p*ex)/(1.0 - p));
+
+            return v0_*(t1-d)*(1.0-ex)/(sigma2_*(1.0-ex*p))
+                + (kappa_*theta_)/sigma2_*((t1-d)*term_-2.0*g)
+                + addOnTerm;
+        }
+        else {
+            const std::complex<Real> td = phi/(2.0*t1)
+                           *std::complex<Real>(-phi, (j_== 1)? 1 : -1);
+            const std::complex<Real> p = td*sigma2_/(t1+d);
+            const std::complex<Real> g = p*(1.0-ex);
+
+            return v0_*td*(1.0-ex)/(1.0-p*ex)
+                + (kappa_*theta_)*(td*term_-2.0*g/sigma2_)
+                + addOnTerm;
+        }
+    }
+
+    Real AnalyticHestonEngine::Fj_Helper::operator()(Real phi) const
+    {
         if (cpxLog_ == Gatheral) {
             if (phi != 0.0) {
-                if (sigma_ > 1e-5) {
-                    const std::complex<Real> p = (t1-d)/(t1+d);
-                    const std::complex<Real> g
-                                            = std::log((1.0 - p*ex)/(1.0 - p));
-
-                    return
-                        std::exp(v0_*(t1-d)*(1.0-ex)/(sigma2_*(1.0-ex*p))
-                                 + (kappa_*theta_)/sigma2_*((t1-d)*term_-2.0*g)
-                                 + std::complex<Real>(0.0, phi*(dd_-sx_))
-                                 + addOnTerm
-                                 ).imag()/phi;
-                }
-                else {
-                    const std::complex<Real> td = phi/(2.0*t1)
-                                   *std::complex<Real>(-phi, (j_== 1)? 1 : -1);
-                    const std::complex<Real> p = td*sigma2_/(t1+d);
-                    const std::complex<Real> g = p*(1.0-ex);
-
-                    return
-                        std::exp(v0_*td*(1.0-ex)/(1.0-p*ex)
-                                 + (kappa_*theta_)*(td*term_-2.0*g/sigma2_)
-                                 + std::complex<Real>(0.0, phi*(dd_-sx_))
-                                 + addOnTerm
-                                 ).imag()/phi;
-                }
+                const std::complex<Real> lnF = (engine_ != nullptr)
+                    ? engine_->cachedValue(j_, phi, term_,
+                                           [&]() { return lnGatheral(phi); })
+                    : lnGatheral(phi);
+
+                return std::exp(lnF + std::complex<Real>(0.0, phi*(dd_-sx_))
+                                ).imag()/phi;
             }
             else {
                 // use l'Hospital's rule to get lim_{phi->0}
@@ -244,6 +363,16 @@ namespace QuantLib {
             }
         }
         else if (cpxLog_ == BranchCorrection) {
+            const Real rpsig(rsigma_*phi);
+
+            const std::complex<Real> t1 = t0_+std::complex<Real>(0, -rpsig);
+            const std::complex<Real> d =
+                std::sqrt(t1*t1 - sigma2_*phi
+                          *std::complex<Real>(-phi, (j_== 1)? 1 : -1));
+            const std::complex<Real> ex = std::exp(-d*term_);
+            const std::complex<Real> addOnTerm =
+                engine_ != nullptr ? engine_->addOnTerm(phi, term_, j_) : Real(0.0);
+
             const std::complex<Real> p = (t1+d)/(t1-d);
 
             // next term: g = std::log((1.0 - p*std::exp(d*term_))/(1.0 - p))
@@ -541,8 +670,12 @@ namespace QuantLib {
                         std::complex<Real>(-zPrime.imag(), zPrime.real()))
             );
 
+            const std::complex<Real> phiHeston = enginePtr_->cachedValue(
+                0, zPrime, term_,
+                [&]() { return enginePtr_->chF(zPrime, term_); });
+
             return (std::exp(std::complex<Real> (0.0, u*freq_))
-                * (phiBS - enginePtr_->chF(zPrime, term_)) / (z*zPrime)
+                * (phiBS - phiHeston) / (z*zPrime)
                 ).real()*s_alpha_;
         }
         else
@@ -860,6 +993,14 @@ namespace QuantLib {
         return value;
     }
 
+    void AnalyticHestonEngine::update() {
+        chFCache_.clear();
+
+        GenericModelEngine<HestonModel,
+                           VanillaOption::arguments,
+                           VanillaOption::results>::update();
+    }
+
     void AnalyticHestonEngine::calculate() const
     {
         // this is a european option pricer
@@ -874,6 +1015,20 @@ namespace QuantLib {
         const Date exerciseDate = arguments_.exercise->lastDate();
 
         results_.value = priceVanillaPayoff(payoff, exerciseDate);
+
+        if (modelParameterGradient_ && model_->sigma() > QL_EPSILON) {
+            const ext::shared_ptr<HestonProcess>& process = model_->process();
+            const Time t = process->time(exerciseDate);
+            const DiscountFactor dr = process->riskFreeRate()->discount(t);
+            const Real fwd = process->s0()->value()
+                * process->dividendYield()->discount(t) / dr;
+
+            results_.additionalResults["modelParameterGradient"] =
+                Array(dr*hestonModelParameterGradient(
+                    t, fwd, payoff->strike(), model_->kappa(),
+                    model_->theta(), model_->sigma(), model_->rho(),
+                    model_->v0()));
+        }
     }
 
 
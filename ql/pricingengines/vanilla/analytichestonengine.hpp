@@ -33,6 +33,7 @@
 #include <ql/instruments/vanillaoption.hpp>
 #include <ql/functional.hpp>
 #include <complex>
+#include <unordered_map>
 
 namespace QuantLib {
 
@@ -138,6 +139,7 @@ namespace QuantLib {
                              Real alpha = -0.5);
 
         void calculate() const override;
+        void update() override;
 
         // normalized characteristic function
         std::complex<Real> chF(const std::complex<Real>& z, Time t) const;
@@ -173,6 +175,32 @@ namespace QuantLib {
         static ComplexLogFormula optimalControlVariate(
              Time t, Real v0, Real kappa, Real theta, Real sigma, Real rho);
 
+        /*! When enabled, the engine returns the gradient of the option
+            value with respect to the model parameters (theta, kappa,
+            sigma, rho, v0) as the "modelParameterGradient" additional
+            result, which is used by calibration helpers.
+        */
+        void enableModelParameterGradient(bool enable = true) {
+            modelParameterGradient_ = enable;
+            update();
+        }
+
+        /*! When enabled, the strike-independent part of the Fourier
+            integrand is cached on the quadrature nodes for each
+            maturity and reused until the model changes.  Options on
+            a strike chain sharing this engine, e.g., the helpers of
+            a model calibration, then cost about one evaluation of
+            the characteristic function per node and maturity.  The
+            cache is used for the Gatheral and Andersen-Piterbarg
+            formulas together with non-adaptive integration algorithms.
+            It is cleared when the model changes or when it exceeds
+            65536 values.
+        */
+        void enableCharacteristicFunctionCache(bool enable = true) {
+            chFCache_.clear();
+            useChFCache_ = enable;
+        }
+
       protected:
         // call back for extended stochastic volatility
         // plus jump diffusion engines like bates model
@@ -183,15 +211,36 @@ namespace QuantLib {
       private:
         class Fj_Helper;
 
+        struct ChFCacheKey {
+            Time t;
+            Size j;
+            Real re, im;
+            bool operator==(const ChFCacheKey& o) const {
+                return t == o.t && j == o.j && re == o.re && im == o.im;
+            }
+        };
+        struct ChFCacheKeyHasher {
+            std::size_t operator()(const ChFCacheKey& x) const;
+        };
+        static constexpr Size maxChFCacheSize = 65536;
+
         Real priceVanillaPayoff(
            const ext::shared_ptr<PlainVanillaPayoff>& payoff,
            Time maturity, Real fwd) const;
 
+        template <class F>
+        std::complex<Real> cachedValue(
+            Size j, const std::complex<Real>& z, Time t, const F& f) const;
+
 
         mutable Size evaluations_;
         const ComplexLogFormula cpxLog_;
         const ext::shared_ptr<Integration> integration_;
         const Real andersenPiterbargEpsilon_, alpha_;
+        bool modelParameterGradient_ = false;
+        bool useChFCache_ = false;
+        mutable std::unordered_map<ChFCacheKey, std::complex<Real>,
+                                   ChFCacheKeyHasher> chFCache_;
     };
 
 
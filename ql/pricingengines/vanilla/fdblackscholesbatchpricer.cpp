@@ -0,0 +1,318 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/exercise.hpp>
+#include <ql/instruments/barrieroption.hpp>
+#include <ql/instruments/vanillaoption.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmblackscholesmesher.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmmeshercomposite.hpp>
+#include <ql/methods/finitedifferences/meshers/predefined1dmesher.hpp>
+#include <ql/methods/finitedifferences/operators/fdmblackscholesop.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmmultipayoffsolver.hpp>
+#include <ql/methods/finitedifferences/stepconditions/fdmstepconditioncomposite.hpp>
+#include <ql/methods/finitedifferences/utilities/fdmdirichletboundary.hpp>
+#include <ql/methods/finitedifferences/utilities/fdminnervaluecalculator.hpp>
+#include <ql/pricingengines/barrier/fdblackscholesbarrierengine.hpp>
+#include <ql/pricingengines/vanilla/fdblackscholesbatchpricer.hpp>
+#include <ql/processes/blackscholesprocess.hpp>
+#include <ql/utilities/exceptioncollector.hpp>
+#include <map>
+#include <tuple>
+#include <utility>
+
+namespace QuantLib {
+
+    namespace {
+
+        // options sharing mesher, boundary and step conditions
+        struct BatchGroup {
+            bool isBarrier = false;
+            Barrier::Type barrierType = Barrier::DownOut;
+            Real barrier = Null<Real>(), rebate = 0.0;
+            ext::shared_ptr<Exercise> exercise;
+
+            std::vector<Size> options;
+            std::vector<ext::shared_ptr<StrikedTypePayoff> > payoffs;
+            ext::shared_ptr<FdmMultiPayoffSolver> solver;
+        };
+
+        // barrier kind (zero for none), barrier, rebate,
+        // exercise type and exercise dates
+        typedef std::tuple<Integer, Real, Real, Integer, std::vector<Date> >
+            BatchKey;
+    }
+
+    FdBlackScholesBatchPricer::FdBlackScholesBatchPricer(
+        ext::shared_ptr<GeneralizedBlackScholesProcess> process,
+        DividendSchedule dividends,
+        Size tGrid,
+        Size xGrid,
+        Size dampingSteps,
+        const FdmSchemeDesc& schemeDesc,
+        bool localVol,
+        Real illegalLocalVolOverwrite)
+    : process_(std::move(process)), dividends_(std::move(dividends)),
+      tGrid_(tGrid), xGrid_(xGrid), dampingSteps_(dampingSteps),
+      schemeDesc_(schemeDesc), localVol_(localVol),
+      illegalLocalVolOverwrite_(illegalLocalVolOverwrite) {}
+
+    std::vector<OneAssetOption::results> FdBlackScholesBatchPricer::calculate(
+        const std::vector<ext::shared_ptr<OneAssetOption> >& options) const {
+
+        const Real spot = process_->x0();
+        QL_REQUIRE(spot > 0.0, "negative or null underlying given");
+
+        std::vector<OneAssetOption::results> results(options.size());
+        for (auto& r : results)
+            r.reset();
+
+        // 1. Grouping
+        std::map<BatchKey, BatchGroup> groups;
+        for (Size i=0; i < options.size(); ++i) {
+            QL_REQUIRE(options[i] != nullptr, "null option given");
+
+            BatchGroup group;
+            ext::shared_ptr<Payoff> payoff;
+            Integer barrierKind = 0;
+
+            const ext::shared_ptr<BarrierOption> barrierOption =
+                ext::dynamic_pointer_cast<BarrierOption>(options[i]);
+            if (barrierOption != nullptr) {
+                BarrierOption::arguments args;
+                barrierOption->setupArguments(&args);
+                args.validate();
+
+                if (   args.barrierType == Barrier::DownIn
+                    || args.barrierType == Barrier::UpIn) {
+                    results[i] = calculateSingle(*barrierOption);
+                    continue;
+                }
+
+                QL_REQUIRE(args.exercise->type() == Exercise::European,
+                           "only european style barrier options are supported");
+                QL_REQUIRE(args.barrierType == Barrier::DownOut
+                           ? spot > args.barrier : spot < args.barrier,
+                           "barrier touched");
+
+                group.isBarrier = true;
+                group.barrierType = args.barrierType;
+                group.barrier = args.barrier;
+                group.rebate = args.rebate;
+                group.exercise = args.exercise;
+                payoff = args.payoff;
+                barrierKind = 1 + Integer(args.barrierType);
+            }
+            else {
+                const ext::shared_ptr<VanillaOption> vanillaOption =
+                    ext::dynamic_pointer_cast<VanillaOption>(options[i]);
+                QL_REQUIRE(vanillaOption != nullptr,
+                           "only vanilla and barrier options are supported");
+
+                VanillaOption::arguments args;
+                vanillaOption->setupArguments(&args);
+                args.validate();
+
+                group.exercise = args.exercise;
+                payoff = args.payoff;
+            }
+
+            const ext::shared_ptr<StrikedTypePayoff> strikedPayoff =
+                ext::dynamic_pointer_cast<StrikedTypePayoff>(payoff);
+            QL_REQUIRE(strikedPayoff != nullptr, "non-striked payoff given");
+            QL_REQUIRE(strikedPayoff->strike() > 0.0,
+                       "strike must be positive");
+
+            const BatchKey key(barrierKind, group.barrier, group.rebate,
+                               Integer(group.exercise->type()),
+                               group.exercise->dates());
+
+            auto iter = groups.find(key);
+            if (iter == groups.end())
+                iter = groups.insert(std::make_pair(key, group)).first;
+
+            iter->second.options.push_back(i);
+            iter->second.payoffs.push_back(strikedPayoff);
+        }
+
+        // 2. Mesher, calculators, conditions and solver of each group
+        if (localVol_)
+            // the local volatility surface is created on first access
+            process_->localVolatility();
+
+        std::vector<BatchGroup*> batches;
+        for (auto& g : groups) {
+            BatchGroup& group = g.second;
+            batches.push_back(&group);
+
+            const Time maturity =
+                process_->time(group.exercise->lastDate());
+            const Real strike = group.payoffs.front()->strike();
+
+            const bool lowerBarrier =
+                group.isBarrier && group.barrierType == Barrier::DownOut;
+            const bool upperBarrier =
+                group.isBarrier && group.barrierType == Barrier::UpOut;
+            const std::pair<Real, Real> cPoint = group.isBarrier
+                ? std::make_pair(Null<Real>(), Null<Real>())
+                : std::make_pair(strike, 0.1);
+
+            // the grid has to cover the ranges needed for all strikes
+            Real xMin = lowerBarrier ? std::log(group.barrier) : Null<Real>();
+            Real xMax = upperBarrier ? std::log(group.barrier) : Null<Real>();
+            if (group.payoffs.size() > 1) {
+                Real lower = xMin, upper = xMax;
+                for (const auto& p : group.payoffs) {
+                    const FdmBlackScholesMesher helper(
+                        xGrid_, process_, maturity, p->strike(),
+                        xMin, xMax, 0.0001, 1.5,
+                        group.isBarrier
+                            ? cPoint : std::make_pair(p->strike(), 0.1),
+                        dividends_);
+                    if (!lowerBarrier)
+                        lower = (lower == Null<Real>())
+                            ? helper.locations().front()
+                            : std::min(lower, helper.locations().front());
+                    if (!upperBarrier)
+                        upper = (upper == Null<Real>())
+                            ? helper.locations().back()
+                            : std::max(upper, helper.locations().back());
+                }
+                xMin = lower;
+                xMax = upper;
+            }
+
+            const ext::shared_ptr<Fdm1dMesher> equityMesher =
+                ext::make_shared<FdmBlackScholesMesher>(
+                    xGrid_, process_, maturity, strike,
+                    xMin, xMax, 0.0001, 1.5, cPoint, dividends_);
+
+            // the second direction enumerates the payoffs
+            std::vector<Real> payoffIndices(group.payoffs.size());
+            for (Size i=0; i < payoffIndices.size(); ++i)
+                payoffIndices[i] = Real(i);
+
+            const ext::shared_ptr<FdmMesher> mesher =
+                ext::make_shared<FdmMesherComposite>(
+                    equityMesher,
+                    ext::make_shared<Predefined1dMesher>(payoffIndices));
+
+            std::vector<ext::shared_ptr<FdmInnerValueCalculator> > calculators;
+            calculators.reserve(group.payoffs.size());
+            for (const auto& p : group.payoffs)
+                calculators.push_back(
+                    ext::make_shared<FdmLogInnerValue>(p, mesher, 0));
+
+            const ext::shared_ptr<FdmInnerValueCalculator> calculator =
+                ext::make_shared<FdmMultiPayoffInnerValue>(calculators, 1);
+
+            const ext::shared_ptr<FdmStepConditionComposite> conditions =
+                FdmStepConditionComposite::vanillaComposite(
+                    dividends_, group.exercise, mesher, calculator,
+                    process_->riskFreeRate()->referenceDate(),
+                    process_->riskFreeRate()->dayCounter());
+
+            FdmBoundaryConditionSet boundaries;
+            if (lowerBarrier)
+                boundaries.push_back(ext::make_shared<FdmDirichletBoundary>(
+                    mesher, group.rebate, 0, FdmDirichletBoundary::Lower));
+            if (upperBarrier)
+                boundaries.push_back(ext::make_shared<FdmDirichletBoundary>(
+                    mesher, group.rebate, 0, FdmDirichletBoundary::Upper));
+
+            FdmSolverDesc solverDesc = { mesher, boundaries, conditions,
+                                         calculator, maturity,
+                                         tGrid_, dampingSteps_ };
+
+            // the local volatility operator does not depend on the
+            // strike, the Black volatility has to be taken at each strike
+            const ext::shared_ptr<FdmMesher> opMesher =
+                ext::make_shared<FdmMesherComposite>(equityMesher);
+            std::map<Real, ext::shared_ptr<FdmLinearOpComposite> > strikeOps;
+            std::vector<ext::shared_ptr<FdmLinearOpComposite> > ops;
+            for (const auto& p : group.payoffs) {
+                const Real opStrike = localVol_ ? strike : p->strike();
+                auto& op = strikeOps[opStrike];
+                if (op == nullptr)
+                    op = ext::make_shared<FdmBlackScholesOp>(
+                        opMesher, process_, opStrike,
+                        localVol_, illegalLocalVolOverwrite_);
+                ops.push_back(op);
+
+                // lazy term structures, e.g. bootstrapped curves, are
+                // calculated here rather than in the parallel rollback
+                process_->riskFreeRate()->discount(maturity);
+                process_->dividendYield()->discount(maturity);
+                process_->blackVolatility()->blackVariance(
+                    maturity, p->strike());
+            }
+
+            group.solver = ext::make_shared<FdmMultiPayoffSolver>(
+                solverDesc, schemeDesc_, ops);
+        }
+
+        // 3. Rollback of all groups
+        const Real x = std::log(spot);
+        ExceptionCollector exceptions(batches.size());
+
+        #pragma omp parallel for schedule(dynamic)
+        for (Size i=0; i < batches.size(); ++i) {
+            exceptions.run(i, [&]() {
+                const BatchGroup& group = *batches[i];
+                for (Size j=0; j < group.options.size(); ++j) {
+                    OneAssetOption::results& r = results[group.options[j]];
+
+                    const Real dx = group.solver->derivativeX(j, x);
+                    r.value = group.solver->interpolateAt(j, x);
+                    r.delta = dx/spot;
+                    r.gamma = (group.solver->derivativeXX(j, x) - dx)
+                        /(spot*spot);
+                    r.theta = group.solver->thetaAt(j, x);
+                }
+            });
+        }
+
+        exceptions.rethrow();
+
+        return results;
+    }
+
+    OneAssetOption::results FdBlackScholesBatchPricer::calculateSingle(
+        const BarrierOption& option) const {
+
+        BarrierOption::arguments args;
+        option.setupArguments(&args);
+
+        BarrierOption barrierOption(args.barrierType, args.barrier,
+                                    args.rebate,
+                                    ext::dynamic_pointer_cast<StrikedTypePayoff>(
+                                        args.payoff),
+                                    args.exercise);
+        barrierOption.setPricingEngine(
+            ext::make_shared<FdBlackScholesBarrierEngine>(
+                process_, dividends_, tGrid_, xGrid_, dampingSteps_,
+                schemeDesc_, localVol_, illegalLocalVolOverwrite_));
+
+        OneAssetOption::results results;
+        results.reset();
+        results.value = barrierOption.NPV();
+        results.delta = barrierOption.delta();
+        results.gamma = barrierOption.gamma();
+        results.theta = barrierOption.theta();
+
+        return results;
+    }
+}
@@ -0,0 +1,87 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdblackscholesbatchpricer.hpp
+    \brief batched finite-differences pricing of options on one process
+*/
+
+#ifndef quantlib_fd_black_scholes_batch_pricer_hpp
+#define quantlib_fd_black_scholes_batch_pricer_hpp
+
+#include <ql/instruments/dividendschedule.hpp>
+#include <ql/instruments/oneassetoption.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmbackwardsolver.hpp>
+
+namespace QuantLib {
+
+    class BarrierOption;
+    class GeneralizedBlackScholesProcess;
+
+    //! batched finite-differences pricing of options on one process
+    /*! Vanilla and barrier options on the same Black-Scholes process
+        are grouped by exercise and, for barrier options, by barrier
+        type, barrier level and rebate. The payoffs of each group are
+        rolled back together on a common mesher covering all strikes
+        (see FdmMultiPayoffSolver). With local volatility, the operator
+        is therefore set up once per group and time step; otherwise,
+        once per distinct strike, using the Black volatility at that
+        strike. Step conditions such as early exercise, and the barrier
+        boundary conditions, act on each payoff separately.
+
+        The groups are priced in parallel if QuantLib is compiled with
+        OpenMP support. Meshers and solvers are set up sequentially
+        beforehand, and the term structures of the process are queried
+        once at each maturity and strike so that lazy ones are
+        calculated before the parallel rollback. Afterwards they must
+        be safe for concurrent reading, and neither the process nor
+        its term structures may be modified during the calculation.
+
+        Knock-in barrier options are priced one by one by means of
+        FdBlackScholesBarrierEngine.
+
+        \ingroup vanillaengines
+    */
+    class FdBlackScholesBatchPricer {
+      public:
+        explicit FdBlackScholesBatchPricer(
+            ext::shared_ptr<GeneralizedBlackScholesProcess> process,
+            DividendSchedule dividends = DividendSchedule(),
+            Size tGrid = 100,
+            Size xGrid = 100,
+            Size dampingSteps = 0,
+            const FdmSchemeDesc& schemeDesc = FdmSchemeDesc::Douglas(),
+            bool localVol = false,
+            Real illegalLocalVolOverwrite = -Null<Real>());
+
+        //! results of vanilla and barrier options in the given order
+        std::vector<OneAssetOption::results> calculate(
+            const std::vector<ext::shared_ptr<OneAssetOption> >& options) const;
+
+      private:
+        OneAssetOption::results calculateSingle(
+            const BarrierOption& option) const;
+
+        ext::shared_ptr<GeneralizedBlackScholesProcess> process_;
+        DividendSchedule dividends_;
+        Size tGrid_, xGrid_, dampingSteps_;
+        FdmSchemeDesc schemeDesc_;
+        bool localVol_;
+        Real illegalLocalVolOverwrite_;
+    };
+}
+
+#endif
@@ -23,14 +23,20 @@
 #include <ql/methods/finitedifferences/meshers/fdmblackscholesmesher.hpp>
 #include <ql/methods/finitedifferences/utilities/escroweddividendadjustment.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmmeshercomposite.hpp>
+#include <ql/methods/finitedifferences/meshers/predefined1dmesher.hpp>
+#include <ql/methods/finitedifferences/operators/fdmblackscholesop.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmblackscholessolver.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmmultipayoffsolver.hpp>
+#include <ql/methods/finitedifferences/stepconditions/fdmsnapshotcondition.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmstepconditioncomposite.hpp>
 #include <ql/methods/finitedifferences/utilities/fdminnervaluecalculator.hpp>
 #include <ql/methods/finitedifferences/utilities/fdmescrowedloginnervaluecalculator.hpp>
 #include <ql/methods/finitedifferences/utilities/fdmquantohelper.hpp>
+#include <ql/methods/finitedifferences/utilities/fdmrichardsonextrapolation.hpp>
 #include <ql/pricingengines/vanilla/fdblackscholesvanillaengine.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
+#include <map>
 
 namespace QuantLib {
 
@@ -108,6 +114,64 @@ namespace QuantLib {
 
     void FdBlackScholesVanillaEngine::calculate() const {
 
+        // cache lookup for precalculated results
+        for (const auto& cachedArgs2result : cachedArgs2results_) {
+            if (cachedArgs2result.first.exercise->type() == arguments_.exercise->type() &&
+                cachedArgs2result.first.exercise->dates() == arguments_.exercise->dates()) {
+                ext::shared_ptr<PlainVanillaPayoff> p1 =
+                    ext::dynamic_pointer_cast<PlainVanillaPayoff>(
+                                                            arguments_.payoff);
+                ext::shared_ptr<PlainVanillaPayoff> p2 =
+                    ext::dynamic_pointer_cast<PlainVanillaPayoff>(cachedArgs2result.first.payoff);
+
+                if ((p1 != nullptr) && p1->strike() == p2->strike() &&
+                    p1->optionType() == p2->optionType()) {
+                    results_ = cachedArgs2result.second;
+                    return;
+                }
+            }
+        }
+
+        QL_REQUIRE(snapshotTimes_.empty()
+                   || (strikes_.empty() && richardsonGrids_ < 2),
+                   "snapshots cannot be combined with multiple strikes "
+                   "caching or Richardson extrapolation");
+
+        if (richardsonGrids_ < 2) {
+            calculateOnGrid(tGrid_, xGrid_, dampingSteps_);
+            return;
+        }
+
+        // the early-exercise boundary spoils the second order
+        // convergence the extrapolation relies on
+        QL_REQUIRE(arguments_.exercise->type() == Exercise::European,
+                   "Richardson extrapolation requires european exercise");
+
+        // Richardson extrapolation on nested grids with Rannacher start-up
+        const Size dampingSteps = std::max(dampingSteps_, Size(2));
+
+        std::vector<VanillaOption::results> results;
+        std::vector<std::vector<VanillaOption::results> > cachedResults;
+        for (Size i=0, scale=1; i < richardsonGrids_; ++i, scale*=2) {
+            calculateOnGrid(tGrid_*scale, xGrid_*scale, dampingSteps);
+
+            results.push_back(results_);
+            cachedResults.emplace_back();
+            for (const auto& cachedArgs2result : cachedArgs2results_)
+                cachedResults.back().push_back(cachedArgs2result.second);
+        }
+
+        results_ = fdmRichardsonExtrapolation(results);
+        for (Size j=0; j < cachedArgs2results_.size(); ++j) {
+            for (Size i=0; i < richardsonGrids_; ++i)
+                results[i] = cachedResults[i][j];
+            cachedArgs2results_[j].second = fdmRichardsonExtrapolation(results);
+        }
+    }
+
+    void FdBlackScholesVanillaEngine::calculateOnGrid(
+        Size tGrid, Size xGrid, Size dampingSteps) const {
+
         // 0. Cash dividend model
         const Date exerciseDate = arguments_.exercise->lastDate();
         const Time maturity = process_->time(exerciseDate);
@@ -155,32 +219,59 @@ namespace QuantLib {
         const ext::shared_ptr<StrikedTypePayoff> payoff =
             ext::dynamic_pointer_cast<StrikedTypePayoff>(arguments_.payoff);
 
+        // further plain-vanilla payoffs rolled back along with the
+        // option's own one, see enableMultipleStrikesCaching
+        std::vector<ext::shared_ptr<StrikedTypePayoff> > payoffs(1, payoff);
+        const ext::shared_ptr<PlainVanillaPayoff> vanillaPayoff =
+            ext::dynamic_pointer_cast<PlainVanillaPayoff>(payoff);
+        if (vanillaPayoff != nullptr) {
+            for (Real strike : strikes_) {
+                if (strike != payoff->strike())
+                    payoffs.push_back(ext::make_shared<PlainVanillaPayoff>(
+                        vanillaPayoff->optionType(), strike));
+            }
+        }
+
+        // the grid has to cover the ranges needed for all strikes
+        Real xMin = Null<Real>(), xMax = Null<Real>();
+        if (payoffs.size() > 1) {
+            for (const auto& p : payoffs) {
+                const FdmBlackScholesMesher helper(
+                    xGrid, process_, maturity, p->strike(),
+                    Null<Real>(), Null<Real>(), 0.0001, 1.5,
+                    std::pair<Real, Real>(p->strike(), 0.1),
+                    dividendSchedule, quantoHelper_, spotAdjustment);
+                xMin = (xMin == Null<Real>())
+                    ? helper.locations().front()
+                    : std::min(xMin, helper.locations().front());
+                xMax = (xMax == Null<Real>())
+                    ? helper.locations().back()
+                    : std::max(xMax, helper.locations().back());
+            }
+        }
+
         const ext::shared_ptr<Fdm1dMesher> equityMesher =
             ext::make_shared<FdmBlackScholesMesher>(
-                    xGrid_, process_, maturity, payoff->strike(), 
-                    Null<Real>(), Null<Real>(), 0.0001, 1.5, 
+                    xGrid, process_, maturity, payoff->strike(), 
+                    xMin, xMax, 0.0001, 1.5, 
                     std::pair<Real, Real>(payoff->strike(), 0.1),
                     dividendSchedule, quantoHelper_,
                     spotAdjustment);
         
         const ext::shared_ptr<FdmMesher> mesher =
             ext::make_shared<FdmMesherComposite>(equityMesher);
-        
-        // 2. Calculator
-        ext::shared_ptr<FdmInnerValueCalculator> calculator;
-        switch (cashDividendModel_) {
-          case Spot:
-              calculator = ext::make_shared<FdmLogInnerValue>(
-                  payoff, mesher, 0);
-            break;
-          case Escrowed:
-              calculator = ext::make_shared<FdmEscrowedLogInnerValueCalculator>(
-                  escrowedDivAdj, payoff, mesher, 0);
-            break;
-          default:
-              QL_FAIL("unknwon cash dividend model");
+
+        if (payoffs.size() > 1) {
+            calculateMultiplePayoffs(payoffs, equityMesher, dividendSchedule,
+                                     escrowedDivAdj, maturity, spotAdjustment,
+                                     tGrid, dampingSteps);
+            return;
         }
 
+        // 2. Calculator
+        const ext::shared_ptr<FdmInnerValueCalculator> calculator =
+            innerValueCalculator(payoff, mesher, escrowedDivAdj);
+
         // 3. Step conditions
         const ext::shared_ptr<FdmStepConditionComposite> conditions = 
             FdmStepConditionComposite::vanillaComposite(
@@ -193,14 +284,19 @@ namespace QuantLib {
 
         // 5. Solver
         FdmSolverDesc solverDesc = { mesher, boundaries, conditions, calculator,
-                                     maturity, tGrid_, dampingSteps_ };
+                                     maturity, tGrid, dampingSteps };
+
+        std::vector<Time> snapshotTimes;
+        for (Time t : snapshotTimes_)
+            if (t <= maturity)
+                snapshotTimes.push_back(t);
 
         const ext::shared_ptr<FdmBlackScholesSolver> solver(
             ext::make_shared<FdmBlackScholesSolver>(
                 Handle<GeneralizedBlackScholesProcess>(process_),
                 payoff->strike(), solverDesc, schemeDesc_,
                 localVol_, illegalLocalVolOverwrite_,
-                Handle<FdmQuantoHelper>(quantoHelper_)));
+                Handle<FdmQuantoHelper>(quantoHelper_), snapshotTimes));
 
         const Real spot = process_->x0() + spotAdjustment;
 
@@ -208,8 +304,144 @@ namespace QuantLib {
         results_.delta = solver->deltaAt(spot);
         results_.gamma = solver->gammaAt(spot);
         results_.theta = solver->thetaAt(spot);
+
+        if (!snapshotTimes_.empty()) {
+            fdmSnapshotResults(results_, *solver, snapshotTimes, spot);
+            snapshotSolver_ = solver;
+        }
+    }
+
+    ext::shared_ptr<FdmInnerValueCalculator>
+    FdBlackScholesVanillaEngine::innerValueCalculator(
+        const ext::shared_ptr<StrikedTypePayoff>& payoff,
+        const ext::shared_ptr<FdmMesher>& mesher,
+        const ext::shared_ptr<EscrowedDividendAdjustment>& escrowedDivAdj) const {
+        switch (cashDividendModel_) {
+          case Spot:
+            return ext::make_shared<FdmLogInnerValue>(payoff, mesher, 0);
+          case Escrowed:
+            return ext::make_shared<FdmEscrowedLogInnerValueCalculator>(
+                escrowedDivAdj, payoff, mesher, 0);
+          default:
+            QL_FAIL("unknwon cash dividend model");
+        }
+    }
+
+    void FdBlackScholesVanillaEngine::calculateMultiplePayoffs(
+        const std::vector<ext::shared_ptr<StrikedTypePayoff> >& payoffs,
+        const ext::shared_ptr<Fdm1dMesher>& equityMesher,
+        const DividendSchedule& dividendSchedule,
+        const ext::shared_ptr<EscrowedDividendAdjustment>& escrowedDivAdj,
+        Time maturity, Real spotAdjustment,
+        Size tGrid, Size dampingSteps) const {
+
+        // 1. Mesher, the second direction enumerates the payoffs
+        std::vector<Real> payoffIndices(payoffs.size());
+        for (Size i=0; i < payoffs.size(); ++i)
+            payoffIndices[i] = Real(i);
+
+        const ext::shared_ptr<FdmMesher> mesher =
+            ext::make_shared<FdmMesherComposite>(
+                equityMesher,
+                ext::make_shared<Predefined1dMesher>(payoffIndices));
+
+        // 2. Calculator
+        std::vector<ext::shared_ptr<FdmInnerValueCalculator> > calculators;
+        calculators.reserve(payoffs.size());
+        for (const auto& payoff : payoffs)
+            calculators.push_back(
+                innerValueCalculator(payoff, mesher, escrowedDivAdj));
+
+        const ext::shared_ptr<FdmInnerValueCalculator> calculator =
+            ext::make_shared<FdmMultiPayoffInnerValue>(calculators, 1);
+
+        // 3. Step conditions
+        const ext::shared_ptr<FdmStepConditionComposite> conditions =
+            FdmStepConditionComposite::vanillaComposite(
+                dividendSchedule, arguments_.exercise, mesher, calculator,
+                process_->riskFreeRate()->referenceDate(),
+                process_->riskFreeRate()->dayCounter());
+
+        // 4. Boundary conditions
+        const FdmBoundaryConditionSet boundaries;
+
+        // 5. Solver
+        FdmSolverDesc solverDesc = { mesher, boundaries, conditions, calculator,
+                                     maturity, tGrid, dampingSteps };
+
+        // the local volatility operator does not depend on the strike,
+        // the Black volatility has to be taken at each strike
+        const ext::shared_ptr<FdmMesher> opMesher =
+            ext::make_shared<FdmMesherComposite>(equityMesher);
+        std::map<Real, ext::shared_ptr<FdmLinearOpComposite> > strikeOps;
+        std::vector<ext::shared_ptr<FdmLinearOpComposite> > ops;
+        for (const auto& payoff : payoffs) {
+            const Real strike =
+                localVol_ ? payoffs.front()->strike() : payoff->strike();
+            auto& op = strikeOps[strike];
+            if (op == nullptr)
+                op = ext::make_shared<FdmBlackScholesOp>(
+                    opMesher, process_, strike,
+                    localVol_, illegalLocalVolOverwrite_, 0, quantoHelper_);
+            ops.push_back(op);
+        }
+
+        const FdmMultiPayoffSolver solver(solverDesc, schemeDesc_, ops);
+
+        const Real spot = process_->x0() + spotAdjustment;
+        const Real x = std::log(spot);
+
+        std::vector<VanillaOption::results> results(payoffs.size());
+        for (Size i=0; i < payoffs.size(); ++i) {
+            const Real dx = solver.derivativeX(i, x);
+            results[i].value = solver.interpolateAt(i, x);
+            results[i].delta = dx/spot;
+            results[i].gamma = (solver.derivativeXX(i, x) - dx)/(spot*spot);
+            results[i].theta = solver.thetaAt(i, x);
+        }
+        results_ = results.front();
+
+        cachedArgs2results_.resize(payoffs.size()-1);
+        for (Size i=1; i < payoffs.size(); ++i) {
+            cachedArgs2results_[i-1].first.exercise = arguments_.exercise;
+            cachedArgs2results_[i-1].first.payoff = payoffs[i];
+            cachedArgs2results_[i-1].second = results[i];
+        }
+    }
+
+    void FdBlackScholesVanillaEngine::update() {
+        cachedArgs2results_.clear();
+        VanillaOption::engine::update();
+    }
+
+    void FdBlackScholesVanillaEngine::enableMultipleStrikesCaching(
+                                        const std::vector<Real>& strikes) {
+        strikes_ = strikes;
+        cachedArgs2results_.clear();
+    }
+
+    void FdBlackScholesVanillaEngine::enableRichardsonExtrapolation(
+                                                            Size nGrids) {
+        QL_REQUIRE(nGrids == 2 || nGrids == 3,
+                   "two or three grids required for the extrapolation");
+        richardsonGrids_ = nGrids;
+        cachedArgs2results_.clear();
+    }
+
+    void FdBlackScholesVanillaEngine::enableSnapshots(
+                                    const std::vector<Time>& snapshotTimes) {
+        snapshotTimes_ = snapshotTimes;
+        snapshotSolver_.reset();
+    }
+
+    ext::shared_ptr<FdmBlackScholesSolver>
+    FdBlackScholesVanillaEngine::snapshotSolver() const {
+        QL_REQUIRE(snapshotSolver_ != nullptr,
+                   "no snapshots retained by the latest calculation");
+        return snapshotSolver_;
     }
 
+
     MakeFdBlackScholesVanillaEngine::MakeFdBlackScholesVanillaEngine(
         ext::shared_ptr<GeneralizedBlackScholesProcess> process)
     : process_(std::move(process)),
@@ -276,9 +508,23 @@ namespace QuantLib {
         return *this;
     }
 
+    MakeFdBlackScholesVanillaEngine&
+    MakeFdBlackScholesVanillaEngine::withRichardsonExtrapolation(Size nGrids) {
+        richardsonGrids_ = nGrids;
+        return *this;
+    }
+
+    MakeFdBlackScholesVanillaEngine&
+    MakeFdBlackScholesVanillaEngine::withSnapshots(
+        const std::vector<Time>& snapshotTimes) {
+        snapshotTimes_ = snapshotTimes;
+        return *this;
+    }
+
     MakeFdBlackScholesVanillaEngine::operator
     ext::shared_ptr<PricingEngine>() const {
-        return ext::make_shared<FdBlackScholesVanillaEngine>(
+        const ext::shared_ptr<FdBlackScholesVanillaEngine> engine =
+            ext::make_shared<FdBlackScholesVanillaEngine>(
                 process_,
                 dividends_,
                 quantoHelper_,
@@ -287,6 +533,13 @@ namespace QuantLib {
                 localVol_,
                 illegalLocalVolOverwrite_,
                 cashDividendModel_);
+
+        if (richardsonGrids_ > 1)
+            engine->enableRichardsonExtrapolation(richardsonGrids_);
+        if (!snapshotTimes_.empty())
+            engine->enableSnapshots(snapshotTimes_);
+
+        return engine;
     }
 
 }
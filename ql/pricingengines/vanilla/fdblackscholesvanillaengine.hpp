@@ -32,7 +32,12 @@
 
 namespace QuantLib {
 
+    class Fdm1dMesher;
+    class FdmMesher;
     class FdmQuantoHelper;
+    class FdmInnerValueCalculator;
+    class EscrowedDividendAdjustment;
+    class FdmBlackScholesSolver;
     class GeneralizedBlackScholesProcess;
 
     //! Finite-differences Black Scholes vanilla option engine
@@ -92,7 +97,71 @@ namespace QuantLib {
 
         void calculate() const override;
 
+        // multiple strikes caching engine
+        /*! The payoffs of all given strikes are rolled back together
+            with the option's own payoff on a common grid; the results
+            for the other strikes are cached until the engine is
+            notified.  With local volatility, all payoffs share one
+            operator; otherwise each strike is rolled back with the
+            Black volatility at that strike.
+        */
+        void update() override;
+        void enableMultipleStrikesCaching(const std::vector<Real>& strikes);
+
+        //! Richardson-extrapolated pricing
+        /*! The option is priced on nGrids (two or three) nested grids,
+            each one refined by a factor two in time and space, and the
+            results are combined by Richardson extrapolation. At least
+            two implicit Euler damping steps (Rannacher start-up) are
+            used on every grid. The error estimates of the value and of
+            the greeks are returned as errorEstimate and as additional
+            results, respectively.
+
+            Every refinement multiplies the number of time steps times
+            grid points by four, so that two grids cost about five and
+            three grids about 21 times the base grid.
+
+            Only European exercise is supported, since the early
+            exercise boundary breaks the second order convergence
+            assumed by the extrapolation.
+        */
+        void enableRichardsonExtrapolation(Size nGrids = 2);
+
+        //! retained value grids
+        /*! The value grids at the given times, measured from the
+            evaluation date, are kept after the backward solve. The
+            value, delta and gamma at the current spot as seen from
+            these times are returned as the additional results
+            snapshotTimes, snapshotValues, snapshotDeltas and
+            snapshotGammas; e.g., a time of one day gives the price
+            after a one-day roll. The solver of the latest calculation
+            gives access to the grids for any other spot without a
+            further backward solve. Times after the exercise date are
+            ignored.
+
+            Snapshots cannot be combined with multiple strikes caching
+            or with Richardson extrapolation. For the escrowed cash
+            dividend model the solver works on the spot minus the
+            escrowed dividends.
+        */
+        void enableSnapshots(const std::vector<Time>& snapshotTimes);
+        ext::shared_ptr<FdmBlackScholesSolver> snapshotSolver() const;
+
       private:
+        void calculateOnGrid(Size tGrid, Size xGrid, Size dampingSteps) const;
+        ext::shared_ptr<FdmInnerValueCalculator> innerValueCalculator(
+            const ext::shared_ptr<StrikedTypePayoff>& payoff,
+            const ext::shared_ptr<FdmMesher>& mesher,
+            const ext::shared_ptr<EscrowedDividendAdjustment>& escrowedDivAdj)
+            const;
+        void calculateMultiplePayoffs(
+            const std::vector<ext::shared_ptr<StrikedTypePayoff> >& payoffs,
+            const ext::shared_ptr<Fdm1dMesher>& equityMesher,
+            const DividendSchedule& dividendSchedule,
+            const ext::shared_ptr<EscrowedDividendAdjustment>& escrowedDivAdj,
+            Time maturity, Real spotAdjustment,
+            Size tGrid, Size dampingSteps) const;
+
         ext::shared_ptr<GeneralizedBlackScholesProcess> process_;
         DividendSchedule dividends_;
         Size tGrid_, xGrid_, dampingSteps_;
@@ -101,6 +170,14 @@ namespace QuantLib {
         Real illegalLocalVolOverwrite_;
         ext::shared_ptr<FdmQuantoHelper> quantoHelper_;
         CashDividendModel cashDividendModel_;
+
+        std::vector<Real> strikes_;
+        Size richardsonGrids_ = 1;
+        std::vector<Time> snapshotTimes_;
+        mutable std::vector<std::pair<VanillaOption::arguments,
+                                      VanillaOption::results> >
+            cachedArgs2results_;
+        mutable ext::shared_ptr<FdmBlackScholesSolver> snapshotSolver_;
     };
 
 
@@ -131,6 +208,12 @@ namespace QuantLib {
         MakeFdBlackScholesVanillaEngine& withCashDividendModel(
             FdBlackScholesVanillaEngine::CashDividendModel cashDividendModel);
 
+        MakeFdBlackScholesVanillaEngine& withRichardsonExtrapolation(
+            Size nGrids = 2);
+
+        MakeFdBlackScholesVanillaEngine& withSnapshots(
+            const std::vector<Time>& snapshotTimes);
+
         operator ext::shared_ptr<PricingEngine>() const;
       private:
         ext::shared_ptr<GeneralizedBlackScholesProcess> process_;
@@ -141,6 +224,8 @@ namespace QuantLib {
         Real illegalLocalVolOverwrite_;
         ext::shared_ptr<FdmQuantoHelper> quantoHelper_;
         FdBlackScholesVanillaEngine::CashDividendModel cashDividendModel_ = FdBlackScholesVanillaEngine::Spot;
+        Size richardsonGrids_ = 1;
+        std::vector<Time> snapshotTimes_;
     };
 
 }
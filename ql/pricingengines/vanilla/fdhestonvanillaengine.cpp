@@ -20,16 +20,20 @@
  FOR A PARTICULAR PURPOSE.  See the license for more details.
 */
 
+#include <ql/exercise.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmblackscholesmesher.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmblackscholesmultistrikemesher.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmhestonvariancemesher.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmmeshercomposite.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmhestonsolver.hpp>
+#include <ql/methods/finitedifferences/stepconditions/fdmsnapshotcondition.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmstepconditioncomposite.hpp>
 #include <ql/methods/finitedifferences/utilities/fdminnervaluecalculator.hpp>
+#include <ql/methods/finitedifferences/utilities/fdmrichardsonextrapolation.hpp>
 #include <ql/pricingengines/vanilla/fdhestonvanillaengine.hpp>
 #include <ql/processes/batesprocess.hpp>
+#include <algorithm>
 #include <utility>
 
 namespace QuantLib {
@@ -101,6 +105,11 @@ namespace QuantLib {
       quantoHelper_(std::move(quantoHelper)), mixingFactor_(mixingFactor) {}
 
     FdmSolverDesc FdHestonVanillaEngine::getSolverDesc(Real) const {
+        return solverDesc(tGrid_, xGrid_, vGrid_, dampingSteps_);
+    }
+
+    FdmSolverDesc FdHestonVanillaEngine::solverDesc(
+        Size tGrid, Size xGrid, Size vGrid, Size dampingSteps) const {
 
         // 1. Mesher
         const ext::shared_ptr<HestonProcess> process = model_->process();
@@ -108,10 +117,10 @@ namespace QuantLib {
 
         // 1.1 The variance mesher
         const Size tGridMin = 5;
-        const Size tGridAvgSteps = std::max(tGridMin, tGrid_/50);
+        const Size tGridAvgSteps = std::max(tGridMin, tGrid/50);
         const ext::shared_ptr<FdmHestonLocalVolatilityVarianceMesher> vMesher
             = ext::make_shared<FdmHestonLocalVolatilityVarianceMesher>(
-                  vGrid_, process, leverageFct_, maturity, tGridAvgSteps, 0.0001, mixingFactor_);
+                  vGrid, process, leverageFct_, maturity, tGridAvgSteps, 0.0001, mixingFactor_);
 
         const Volatility avgVolaEstimate = vMesher->volaEstimate();
 
@@ -123,7 +132,7 @@ namespace QuantLib {
         if (strikes_.empty()) {
             equityMesher = ext::shared_ptr<Fdm1dMesher>(
                 new FdmBlackScholesMesher(
-                    xGrid_,
+                    xGrid,
                     FdmBlackScholesMesher::processHelper(
                         process->s0(), process->dividendYield(),
                         process->riskFreeRate(), avgVolaEstimate),
@@ -138,7 +147,7 @@ namespace QuantLib {
                        "multiple strikes engine does not work with discrete dividends");
             equityMesher = ext::shared_ptr<Fdm1dMesher>(
                 new FdmBlackScholesMultiStrikeMesher(
-                    xGrid_,
+                    xGrid,
                     FdmBlackScholesMesher::processHelper(
                       process->s0(), process->dividendYield(),
                       process->riskFreeRate(), avgVolaEstimate),
@@ -167,7 +176,7 @@ namespace QuantLib {
         // 5. Solver
         FdmSolverDesc solverDesc = { mesher, boundaries, conditions,
                                      calculator, maturity,
-                                     tGrid_, dampingSteps_ };
+                                     tGrid, dampingSteps };
 
        return solverDesc;
     }
@@ -194,13 +203,59 @@ namespace QuantLib {
             }
         }
 
+        QL_REQUIRE(snapshotTimes_.empty() || richardsonGrids_ < 2,
+                   "snapshots cannot be combined with "
+                   "Richardson extrapolation");
+
+        if (richardsonGrids_ < 2) {
+            calculateOnGrid(tGrid_, xGrid_, vGrid_, dampingSteps_);
+            return;
+        }
+
+        // the early-exercise boundary spoils the second order
+        // convergence the extrapolation relies on
+        QL_REQUIRE(arguments_.exercise->type() == Exercise::European,
+                   "Richardson extrapolation requires european exercise");
+
+        // Richardson extrapolation on nested grids with Rannacher start-up
+        const Size dampingSteps = std::max(dampingSteps_, Size(2));
+
+        std::vector<VanillaOption::results> results;
+        std::vector<std::vector<VanillaOption::results> > cachedResults;
+        for (Size i=0, scale=1; i < richardsonGrids_; ++i, scale*=2) {
+            calculateOnGrid(tGrid_*scale, xGrid_*scale, vGrid_*scale,
+                            dampingSteps);
+
+            results.push_back(results_);
+            cachedResults.emplace_back();
+            for (const auto& cachedArgs2result : cachedArgs2results_)
+                cachedResults.back().push_back(cachedArgs2result.second);
+        }
+
+        results_ = fdmRichardsonExtrapolation(results);
+        for (Size j=0; j < cachedArgs2results_.size(); ++j) {
+            for (Size i=0; i < richardsonGrids_; ++i)
+                results[i] = cachedResults[i][j];
+            cachedArgs2results_[j].second = fdmRichardsonExtrapolation(results);
+        }
+    }
+
+    void FdHestonVanillaEngine::calculateOnGrid(
+        Size tGrid, Size xGrid, Size vGrid, Size dampingSteps) const {
+
         const ext::shared_ptr<HestonProcess> process = model_->process();
 
+        const Time maturity = process->time(arguments_.exercise->lastDate());
+        std::vector<Time> snapshotTimes;
+        for (Time t : snapshotTimes_)
+            if (t <= maturity)
+                snapshotTimes.push_back(t);
+
         ext::shared_ptr<FdmHestonSolver> solver(new FdmHestonSolver(
                     Handle<HestonProcess>(process),
-                    getSolverDesc(1.5), schemeDesc_,
+                    solverDesc(tGrid, xGrid, vGrid, dampingSteps), schemeDesc_,
                     Handle<FdmQuantoHelper>(quantoHelper_), leverageFct_,
-                    mixingFactor_));
+                    mixingFactor_, snapshotTimes));
 
         const Real v0   = process->v0();
         const Real spot = process->s0()->value();
@@ -210,6 +265,11 @@ namespace QuantLib {
         results_.gamma = solver->gammaAt(spot, v0);
         results_.theta = solver->thetaAt(spot, v0);
 
+        if (!snapshotTimes_.empty()) {
+            fdmSnapshotResults(results_, *solver, snapshotTimes, spot, v0);
+            snapshotSolver_ = solver;
+        }
+
         cachedArgs2results_.resize(strikes_.size());
         const ext::shared_ptr<StrikedTypePayoff> payoff =
             ext::dynamic_pointer_cast<StrikedTypePayoff>(arguments_.payoff);
@@ -241,6 +301,26 @@ namespace QuantLib {
         cachedArgs2results_.clear();
     }
 
+    void FdHestonVanillaEngine::enableRichardsonExtrapolation(Size nGrids) {
+        QL_REQUIRE(nGrids == 2 || nGrids == 3,
+                   "two or three grids required for the extrapolation");
+        richardsonGrids_ = nGrids;
+        cachedArgs2results_.clear();
+    }
+
+    void FdHestonVanillaEngine::enableSnapshots(
+                                    const std::vector<Time>& snapshotTimes) {
+        snapshotTimes_ = snapshotTimes;
+        snapshotSolver_.reset();
+    }
+
+    ext::shared_ptr<FdmHestonSolver>
+    FdHestonVanillaEngine::snapshotSolver() const {
+        QL_REQUIRE(snapshotSolver_ != nullptr,
+                   "no snapshots retained by the latest calculation");
+        return snapshotSolver_;
+    }
+
 
     MakeFdHestonVanillaEngine::MakeFdHestonVanillaEngine(ext::shared_ptr<HestonModel> hestonModel)
     : hestonModel_(std::move(hestonModel)),
@@ -298,15 +378,36 @@ namespace QuantLib {
         return *this;
     }
 
+    MakeFdHestonVanillaEngine&
+    MakeFdHestonVanillaEngine::withRichardsonExtrapolation(Size nGrids) {
+        richardsonGrids_ = nGrids;
+        return *this;
+    }
+
+    MakeFdHestonVanillaEngine&
+    MakeFdHestonVanillaEngine::withSnapshots(
+        const std::vector<Time>& snapshotTimes) {
+        snapshotTimes_ = snapshotTimes;
+        return *this;
+    }
+
     MakeFdHestonVanillaEngine::operator
     ext::shared_ptr<PricingEngine>() const {
-        return ext::make_shared<FdHestonVanillaEngine>(
+        const ext::shared_ptr<FdHestonVanillaEngine> engine =
+            ext::make_shared<FdHestonVanillaEngine>(
                 hestonModel_,
                 dividends_,
                 quantoHelper_,
                 tGrid_, xGrid_, vGrid_, dampingSteps_,
                 *schemeDesc_,
                 leverageFct_);
+
+        if (richardsonGrids_ > 1)
+            engine->enableRichardsonExtrapolation(richardsonGrids_);
+        if (!snapshotTimes_.empty())
+            engine->enableSnapshots(snapshotTimes_);
+
+        return engine;
     }
 
 }
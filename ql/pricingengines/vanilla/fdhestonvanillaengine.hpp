@@ -36,6 +36,7 @@
 namespace QuantLib {
 
     class FdmQuantoHelper;
+    class FdmHestonSolver;
 
     //! Finite-differences Heston vanilla option engine
     /*! \ingroup vanillaengines
@@ -96,10 +97,51 @@ namespace QuantLib {
         void update() override;
         void enableMultipleStrikesCaching(const std::vector<Real>& strikes);
 
+        //! Richardson-extrapolated pricing
+        /*! The option is priced on nGrids (two or three) nested grids,
+            each one refined by a factor two in time, in the equity and
+            in the variance direction. At least two implicit Euler
+            damping steps (Rannacher start-up) are used on every grid.
+            Error estimates are returned as errorEstimate (value) and
+            as additional results (greeks). Only European exercise is
+            supported, see FdBlackScholesVanillaEngine.
+
+            Every refinement multiplies the number of time steps times
+            grid points by eight, so that two grids cost about nine and
+            three grids about 73 times the base grid. The base grid
+            should therefore be about four times coarser in every
+            direction than a plain grid of similar cost.
+        */
+        void enableRichardsonExtrapolation(Size nGrids = 2);
+
+        //! retained value grids
+        /*! The value grids at the given times, measured from the
+            evaluation date, are kept after the backward solve. The
+            value, delta and gamma at the current spot as seen from
+            these times are returned as the additional results
+            snapshotTimes, snapshotValues, snapshotDeltas and
+            snapshotGammas; e.g., a time of one day gives the price
+            after a one-day roll. The solver of the latest calculation
+            gives access to the grids for any other spot without a
+            further backward solve. Times after the exercise date are
+            ignored.
+
+            The grids are two-dimensional and the results are taken at
+            the initial variance v0. Snapshots cannot be combined with
+            Richardson extrapolation.
+        */
+        void enableSnapshots(const std::vector<Time>& snapshotTimes);
+        ext::shared_ptr<FdmHestonSolver> snapshotSolver() const;
+
         // helper method for Heston like engines
         FdmSolverDesc getSolverDesc(Real equityScaleFactor) const;
 
       private:
+        FdmSolverDesc solverDesc(Size tGrid, Size xGrid, Size vGrid,
+                                 Size dampingSteps) const;
+        void calculateOnGrid(Size tGrid, Size xGrid, Size vGrid,
+                             Size dampingSteps) const;
+
         DividendSchedule dividends_;
         const Size tGrid_, xGrid_, vGrid_, dampingSteps_;
         const FdmSchemeDesc schemeDesc_;
@@ -108,9 +150,12 @@ namespace QuantLib {
         const Real mixingFactor_;
 
         std::vector<Real> strikes_;
+        Size richardsonGrids_ = 1;
+        std::vector<Time> snapshotTimes_;
         mutable std::vector<std::pair<VanillaOption::arguments,
                                       VanillaOption::results> >
                                                             cachedArgs2results_;
+        mutable ext::shared_ptr<FdmHestonSolver> snapshotSolver_;
     };
 
     class MakeFdHestonVanillaEngine {
@@ -136,6 +181,12 @@ namespace QuantLib {
             const std::vector<Date>& dividendDates,
             const std::vector<Real>& dividendAmounts);
 
+        MakeFdHestonVanillaEngine& withRichardsonExtrapolation(
+            Size nGrids = 2);
+
+        MakeFdHestonVanillaEngine& withSnapshots(
+            const std::vector<Time>& snapshotTimes);
+
         operator ext::shared_ptr<PricingEngine>() const;
 
       private:
@@ -145,6 +196,8 @@ namespace QuantLib {
         ext::shared_ptr<FdmSchemeDesc> schemeDesc_;
         ext::shared_ptr<LocalVolTermStructure> leverageFct_;
         ext::shared_ptr<FdmQuantoHelper> quantoHelper_;
+        Size richardsonGrids_ = 1;
+        std::vector<Time> snapshotTimes_;
     };
 
 }
@@ -26,6 +26,8 @@
 #ifndef quantlib_montecarlo_european_engine_hpp
 #define quantlib_montecarlo_european_engine_hpp
 
+#include <ql/pricingengines/mcimportancesampling.hpp>
+#include <ql/pricingengines/mcpathgreeks.hpp>
 #include <ql/pricingengines/vanilla/mcvanillaengine.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
 #include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
@@ -36,6 +38,16 @@ namespace QuantLib {
     //! European option pricing engine using Monte Carlo simulation
     /*! \ingroup vanillaengines
 
+        If requested, delta, gamma and vega are estimated on the
+        same paths as the option value; delta and vega use pathwise
+        derivatives of the payoff, while gamma applies a
+        likelihood-ratio weight to the pathwise delta.  This requires
+        a constant Black volatility.
+
+        For deep out-of-the-money options, paths can be sampled with
+        a shifted drift and weighted by the corresponding likelihood
+        ratio; see BlackScholesDriftShift.
+
         \test the correctness of the returned value is tested by
               checking it against analytic results.
     */
@@ -60,9 +72,22 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed);
+             BigNatural seed,
+             bool greeks = false,
+             Real driftShift = 0.0);
+        void calculate() const override;
       protected:
+        typedef
+        typename MCVanillaEngine<SingleVariate,RNG,S>::sensitivity_pricer_type
+            sensitivity_pricer_type;
+        ext::shared_ptr<path_generator_type> pathGenerator() const override;
         ext::shared_ptr<path_pricer_type> pathPricer() const override;
+        ext::shared_ptr<sensitivity_pricer_type>
+        sensitivityPathPricer() const override;
+      private:
+        BlackScholesDriftShift driftShift() const;
+        bool greeks_;
+        Real driftShift_;
     };
 
     //! Monte Carlo European engine factory
@@ -79,6 +104,8 @@ namespace QuantLib {
         MakeMCEuropeanEngine& withMaxSamples(Size samples);
         MakeMCEuropeanEngine& withSeed(BigNatural seed);
         MakeMCEuropeanEngine& withAntitheticVariate(bool b = true);
+        MakeMCEuropeanEngine& withGreeks(bool b = true);
+        MakeMCEuropeanEngine& withDriftShift(Real shift);
         // conversion to pricing engine
         operator ext::shared_ptr<PricingEngine>() const;
       private:
@@ -86,7 +113,8 @@ namespace QuantLib {
         bool antithetic_ = false;
         Size steps_, stepsPerYear_, samples_, maxSamples_;
         Real tolerance_;
-        bool brownianBridge_ = false;
+        bool brownianBridge_ = false, greeks_ = false;
+        Real driftShift_ = 0.0;
         BigNatural seed_ = 0;
     };
 
@@ -102,6 +130,22 @@ namespace QuantLib {
         DiscountFactor discount_;
     };
 
+    //! pathwise delta and vega, and likelihood-ratio gamma
+    class EuropeanPathGreeksPricer : public PathPricer<Path, Array> {
+      public:
+        EuropeanPathGreeksPricer(Option::Type type,
+                                 Real strike,
+                                 DiscountFactor discount,
+                                 BlackScholesPathGreeks greeks);
+        Array operator()(const Path& path) const override;
+
+      private:
+        Option::Type type_;
+        Real strike_;
+        DiscountFactor discount_;
+        BlackScholesPathGreeks greeks_;
+    };
+
 
     // inline definitions
 
@@ -116,7 +160,9 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed)
+             BigNatural seed,
+             bool greeks,
+             Real driftShift)
     : MCVanillaEngine<SingleVariate,RNG,S>(process,
                                            timeSteps,
                                            timeStepsPerYear,
@@ -126,7 +172,53 @@ namespace QuantLib {
                                            requiredSamples,
                                            requiredTolerance,
                                            maxSamples,
-                                           seed) {}
+                                           seed),
+      greeks_(greeks), driftShift_(driftShift) {
+        QL_REQUIRE(!(greeks && driftShift != 0.0),
+                   "Greeks not available with importance sampling");
+    }
+
+
+    template <class RNG, class S>
+    inline void MCEuropeanEngine<RNG,S>::calculate() const {
+        MCVanillaEngine<SingleVariate,RNG,S>::calculate();
+        if (greeks_) {
+            std::vector<Real> greeks =
+                this->mcModel_->sensitivityAccumulator().mean();
+            this->results_.delta = greeks[0];
+            this->results_.gamma = greeks[1];
+            this->results_.vega = greeks[2];
+        }
+    }
+
+
+    template <class RNG, class S>
+    inline BlackScholesDriftShift MCEuropeanEngine<RNG,S>::driftShift() const {
+        ext::shared_ptr<GeneralizedBlackScholesProcess> process =
+            ext::dynamic_pointer_cast<GeneralizedBlackScholesProcess>(
+                this->process_);
+        QL_REQUIRE(process, "Black-Scholes process required");
+        return BlackScholesDriftShift(process, driftShift_,
+                                      this->timeGrid().back());
+    }
+
+
+    template <class RNG, class S>
+    inline
+    ext::shared_ptr<typename MCEuropeanEngine<RNG,S>::path_generator_type>
+    MCEuropeanEngine<RNG,S>::pathGenerator() const {
+
+        if (driftShift_ == 0.0)
+            return MCVanillaEngine<SingleVariate,RNG,S>::pathGenerator();
+
+        TimeGrid grid = this->timeGrid();
+        typename RNG::rsg_type generator =
+            RNG::make_sequence_generator(grid.size()-1, this->seed_);
+        return ext::shared_ptr<path_generator_type>(
+                   new path_generator_type(driftShift().samplingProcess(),
+                                           grid, generator,
+                                           this->brownianBridge_));
+    }
 
 
     template <class RNG, class S>
@@ -144,12 +236,46 @@ namespace QuantLib {
                 this->process_);
         QL_REQUIRE(process, "Black-Scholes process required");
 
+        ext::shared_ptr<
+                       typename MCEuropeanEngine<RNG,S>::path_pricer_type>
+        pricer(new EuropeanPathPricer(
+              payoff->optionType(),
+              payoff->strike(),
+              process->riskFreeRate()->discount(this->timeGrid().back())));
+
+        if (driftShift_ == 0.0)
+            return pricer;
         return ext::shared_ptr<
                        typename MCEuropeanEngine<RNG,S>::path_pricer_type>(
-          new EuropeanPathPricer(
+          new DriftShiftedPathPricer(pricer, driftShift()));
+    }
+
+
+    template <class RNG, class S>
+    inline
+    ext::shared_ptr<typename MCEuropeanEngine<RNG,S>::sensitivity_pricer_type>
+    MCEuropeanEngine<RNG,S>::sensitivityPathPricer() const {
+
+        if (!greeks_)
+            return ext::shared_ptr<sensitivity_pricer_type>();
+
+        ext::shared_ptr<PlainVanillaPayoff> payoff =
+            ext::dynamic_pointer_cast<PlainVanillaPayoff>(
+                this->arguments_.payoff);
+        QL_REQUIRE(payoff, "non-plain payoff given");
+
+        ext::shared_ptr<GeneralizedBlackScholesProcess> process =
+            ext::dynamic_pointer_cast<GeneralizedBlackScholesProcess>(
+                this->process_);
+        QL_REQUIRE(process, "Black-Scholes process required");
+
+        TimeGrid grid = this->timeGrid();
+        return ext::shared_ptr<sensitivity_pricer_type>(
+          new EuropeanPathGreeksPricer(
               payoff->optionType(),
               payoff->strike(),
-              process->riskFreeRate()->discount(this->timeGrid().back())));
+              process->riskFreeRate()->discount(grid.back()),
+              BlackScholesPathGreeks(process, grid)));
     }
 
 
@@ -222,6 +348,20 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCEuropeanEngine<RNG,S>&
+    MakeMCEuropeanEngine<RNG,S>::withGreeks(bool b) {
+        greeks_ = b;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMCEuropeanEngine<RNG,S>&
+    MakeMCEuropeanEngine<RNG,S>::withDriftShift(Real shift) {
+        driftShift_ = shift;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline
     MakeMCEuropeanEngine<RNG,S>::operator ext::shared_ptr<PricingEngine>()
@@ -238,7 +378,9 @@ namespace QuantLib {
                                     antithetic_,
                                     samples_, tolerance_,
                                     maxSamples_,
-                                    seed_));
+                                    seed_,
+                                    greeks_,
+                                    driftShift_));
     }
 
 
@@ -256,6 +398,45 @@ namespace QuantLib {
         return payoff_(path.back()) * discount_;
     }
 
+
+    inline EuropeanPathGreeksPricer::EuropeanPathGreeksPricer(
+                                                Option::Type type,
+                                                Real strike,
+                                                DiscountFactor discount,
+                                                BlackScholesPathGreeks greeks)
+    : type_(type), strike_(strike), discount_(discount),
+      greeks_(std::move(greeks)) {
+        QL_REQUIRE(strike>=0.0,
+                   "strike less than zero not allowed");
+    }
+
+    inline Array EuropeanPathGreeksPricer::operator()(const Path& path) const {
+        QL_REQUIRE(!path.empty(), "the path cannot be empty");
+        Real underlying = path.back();
+        Real slope;
+        switch (type_) {
+          case Option::Call:
+            slope = underlying > strike_ ? 1.0 : 0.0;
+            break;
+          case Option::Put:
+            slope = underlying < strike_ ? -1.0 : 0.0;
+            break;
+          default:
+            QL_FAIL("unknown option type");
+        }
+        if (slope == 0.0)
+            return Array(3, 0.0);
+
+        Real x0 = greeks_.x0();
+        Real h = discount_ * slope * underlying;
+        Array result(3);
+        result[0] = h / x0;
+        result[1] = h * (greeks_.deltaWeight(path)*x0 - 1.0) / (x0*x0);
+        result[2] = discount_ * slope
+                  * greeks_.pathwiseVega(path, path.length()-1);
+        return result;
+    }
+
 }
 
 
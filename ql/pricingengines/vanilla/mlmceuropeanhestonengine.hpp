@@ -0,0 +1,253 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file mlmceuropeanhestonengine.hpp
+    \brief Multi-level Monte Carlo Heston-model engine for European options
+*/
+
+#ifndef quantlib_mlmc_european_heston_engine_hpp
+#define quantlib_mlmc_european_heston_engine_hpp
+
+#include <ql/instruments/vanillaoption.hpp>
+#include <ql/pricingengines/mlmcsimulation.hpp>
+#include <ql/pricingengines/vanilla/mceuropeanhestonengine.hpp>
+#include <utility>
+
+namespace QuantLib {
+
+    //! Multi-level Monte Carlo Heston-model engine for European options
+    /*! The discretization bias of the Heston process is removed
+        level by level; the time steps given refer to the coarsest
+        level, and each further level halves them.
+
+        \ingroup vanillaengines
+
+        \test the correctness of the returned value is tested by
+              checking it against analytic results.
+    */
+    template <class RNG = PseudoRandom,
+              class S = Statistics, class P = HestonProcess>
+    class MLMCEuropeanHestonEngine
+        : public VanillaOption::engine,
+          public MlmcSimulation<MultiVariate,RNG,S> {
+      public:
+        typedef typename MlmcSimulation<MultiVariate,RNG,S>::path_generator_type
+            path_generator_type;
+        typedef typename MlmcSimulation<MultiVariate,RNG,S>::path_pricer_type
+            path_pricer_type;
+        typedef typename MlmcSimulation<MultiVariate,RNG,S>::stats_type
+            stats_type;
+        MLMCEuropeanHestonEngine(ext::shared_ptr<P>,
+                                 Size timeSteps,
+                                 Size timeStepsPerYear,
+                                 Size levels,
+                                 Size requiredSamples,
+                                 Real requiredTolerance,
+                                 BigNatural seed);
+        void calculate() const override {
+            MlmcSimulation<MultiVariate,RNG,S>::calculate(requiredTolerance_,
+                                                          requiredSamples_,
+                                                          levels_);
+            results_.value = this->mcModel_->mean();
+            if constexpr (RNG::allowsErrorEstimate)
+                results_.errorEstimate = this->mcModel_->errorEstimate();
+            results_.additionalResults["levels"] = this->mcModel_->levels();
+        }
+
+      protected:
+        // MlmcSimulation implementation
+        TimeGrid timeGrid() const override;
+        ext::shared_ptr<path_generator_type>
+        pathGenerator(Size level) const override {
+            TimeGrid fine = this->levelTimeGrid(level);
+            TimeGrid coarse =
+                level > 0 ? this->levelTimeGrid(level-1) : TimeGrid();
+            typename RNG::rsg_type generator =
+                RNG::make_sequence_generator(
+                    process_->factors()*(fine.size()-1),
+                    seed_ != 0 ? seed_ + level : 0);
+            return ext::make_shared<path_generator_type>(
+                process_, fine, coarse, generator);
+        }
+        ext::shared_ptr<path_pricer_type>
+        pathPricer(const TimeGrid& grid) const override;
+        // data members
+        ext::shared_ptr<P> process_;
+        Size timeSteps_, timeStepsPerYear_, levels_;
+        Size requiredSamples_;
+        Real requiredTolerance_;
+        BigNatural seed_;
+    };
+
+
+    //! Multi-level Monte Carlo Heston European engine factory
+    template <class RNG = PseudoRandom,
+              class S = Statistics, class P = HestonProcess>
+    class MakeMLMCEuropeanHestonEngine {
+      public:
+        explicit MakeMLMCEuropeanHestonEngine(ext::shared_ptr<P>);
+        // named parameters
+        MakeMLMCEuropeanHestonEngine& withSteps(Size steps);
+        MakeMLMCEuropeanHestonEngine& withStepsPerYear(Size steps);
+        MakeMLMCEuropeanHestonEngine& withLevels(Size levels);
+        MakeMLMCEuropeanHestonEngine& withSamples(Size samples);
+        MakeMLMCEuropeanHestonEngine& withAbsoluteTolerance(Real tolerance);
+        MakeMLMCEuropeanHestonEngine& withSeed(BigNatural seed);
+        // conversion to pricing engine
+        operator ext::shared_ptr<PricingEngine>() const;
+      private:
+        ext::shared_ptr<P> process_;
+        Size steps_, stepsPerYear_, levels_, samples_;
+        Real tolerance_;
+        BigNatural seed_ = 0;
+    };
+
+
+    // template definitions
+
+    template <class RNG, class S, class P>
+    inline MLMCEuropeanHestonEngine<RNG, S, P>::MLMCEuropeanHestonEngine(
+                ext::shared_ptr<P> process,
+                Size timeSteps, Size timeStepsPerYear, Size levels,
+                Size requiredSamples, Real requiredTolerance, BigNatural seed)
+    : process_(std::move(process)), timeSteps_(timeSteps),
+      timeStepsPerYear_(timeStepsPerYear), levels_(levels),
+      requiredSamples_(requiredSamples),
+      requiredTolerance_(requiredTolerance), seed_(seed) {
+        QL_REQUIRE(timeSteps != Null<Size>() ||
+                   timeStepsPerYear != Null<Size>(),
+                   "no time steps provided");
+        QL_REQUIRE(timeSteps == Null<Size>() ||
+                   timeStepsPerYear == Null<Size>(),
+                   "both time steps and time steps per year were provided");
+        QL_REQUIRE(timeSteps != 0,
+                   "timeSteps must be positive, " << timeSteps <<
+                   " not allowed");
+        QL_REQUIRE(timeStepsPerYear != 0,
+                   "timeStepsPerYear must be positive, " << timeStepsPerYear <<
+                   " not allowed");
+        this->registerWith(process_);
+    }
+
+    template <class RNG, class S, class P>
+    inline TimeGrid MLMCEuropeanHestonEngine<RNG,S,P>::timeGrid() const {
+        Time t = process_->time(this->arguments_.exercise->lastDate());
+        if (timeSteps_ != Null<Size>()) {
+            return TimeGrid(t, timeSteps_);
+        } else {
+            Size steps = static_cast<Size>(timeStepsPerYear_*t);
+            return TimeGrid(t, std::max<Size>(steps, 1));
+        }
+    }
+
+    template <class RNG, class S, class P>
+    inline ext::shared_ptr<
+        typename MLMCEuropeanHestonEngine<RNG,S,P>::path_pricer_type>
+    MLMCEuropeanHestonEngine<RNG,S,P>::pathPricer(const TimeGrid& grid) const {
+
+        ext::shared_ptr<PlainVanillaPayoff> payoff =
+            ext::dynamic_pointer_cast<PlainVanillaPayoff>(
+                                                    this->arguments_.payoff);
+        QL_REQUIRE(payoff, "non-plain payoff given");
+
+        return ext::make_shared<EuropeanHestonPathPricer>(
+            payoff->optionType(), payoff->strike(),
+            process_->riskFreeRate()->discount(grid.back()));
+    }
+
+
+    template <class RNG, class S, class P>
+    inline
+    MakeMLMCEuropeanHestonEngine<RNG, S, P>::MakeMLMCEuropeanHestonEngine(
+        ext::shared_ptr<P> process)
+    : process_(std::move(process)), steps_(Null<Size>()),
+      stepsPerYear_(Null<Size>()), levels_(Null<Size>()),
+      samples_(Null<Size>()), tolerance_(Null<Real>()) {}
+
+    template <class RNG, class S, class P>
+    inline MakeMLMCEuropeanHestonEngine<RNG,S,P>&
+    MakeMLMCEuropeanHestonEngine<RNG,S,P>::withSteps(Size steps) {
+        QL_REQUIRE(stepsPerYear_ == Null<Size>(),
+                   "number of steps per year already set");
+        steps_ = steps;
+        return *this;
+    }
+
+    template <class RNG, class S, class P>
+    inline MakeMLMCEuropeanHestonEngine<RNG,S,P>&
+    MakeMLMCEuropeanHestonEngine<RNG,S,P>::withStepsPerYear(Size steps) {
+        QL_REQUIRE(steps_ == Null<Size>(),
+                   "number of steps already set");
+        stepsPerYear_ = steps;
+        return *this;
+    }
+
+    template <class RNG, class S, class P>
+    inline MakeMLMCEuropeanHestonEngine<RNG,S,P>&
+    MakeMLMCEuropeanHestonEngine<RNG,S,P>::withLevels(Size levels) {
+        levels_ = levels;
+        return *this;
+    }
+
+    template <class RNG, class S, class P>
+    inline MakeMLMCEuropeanHestonEngine<RNG,S,P>&
+    MakeMLMCEuropeanHestonEngine<RNG,S,P>::withSamples(Size samples) {
+        QL_REQUIRE(tolerance_ == Null<Real>(),
+                   "tolerance already set");
+        samples_ = samples;
+        return *this;
+    }
+
+    template <class RNG, class S, class P>
+    inline MakeMLMCEuropeanHestonEngine<RNG,S,P>&
+    MakeMLMCEuropeanHestonEngine<RNG,S,P>::withAbsoluteTolerance(
+                                                            Real tolerance) {
+        QL_REQUIRE(samples_ == Null<Size>(),
+                   "number of samples already set");
+        QL_REQUIRE(RNG::allowsErrorEstimate,
+                   "chosen random generator policy "
+                   "does not allow an error estimate");
+        tolerance_ = tolerance;
+        return *this;
+    }
+
+    template <class RNG, class S, class P>
+    inline MakeMLMCEuropeanHestonEngine<RNG,S,P>&
+    MakeMLMCEuropeanHestonEngine<RNG,S,P>::withSeed(BigNatural seed) {
+        seed_ = seed;
+        return *this;
+    }
+
+    template <class RNG, class S, class P>
+    inline
+    MakeMLMCEuropeanHestonEngine<RNG,S,P>::
+    operator ext::shared_ptr<PricingEngine>() const {
+        QL_REQUIRE(steps_ != Null<Size>() || stepsPerYear_ != Null<Size>(),
+                   "number of steps not given");
+        return ext::shared_ptr<PricingEngine>(
+               new MLMCEuropeanHestonEngine<RNG,S,P>(process_,
+                                                     steps_,
+                                                     stepsPerYear_,
+                                                     levels_,
+                                                     samples_, tolerance_,
+                                                     seed_));
+    }
+
+}
+
+
+#endif
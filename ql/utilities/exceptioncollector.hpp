@@ -0,0 +1,74 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file exceptioncollector.hpp
+    \brief exceptions thrown by the iterations of a parallel loop
+*/
+
+#ifndef quantlib_exception_collector_hpp
+#define quantlib_exception_collector_hpp
+
+#include <ql/types.hpp>
+#include <exception>
+#include <utility>
+#include <vector>
+
+namespace QuantLib {
+
+    //! exceptions thrown by the iterations of a parallel loop
+    /*! Exceptions must not escape an OpenMP parallel region. Each
+        iteration is therefore run through this class, which stores
+        whatever it throws; after the loop, the exception of the
+        first failed iteration is rethrown with its original type.
+
+        \code
+        ExceptionCollector exceptions(n);
+        #pragma omp parallel for
+        for (long i=0; i < long(n); ++i)
+            exceptions.run(i, [&]() { ... });
+        exceptions.rethrow();
+        \endcode
+    */
+    class ExceptionCollector {
+      public:
+        explicit ExceptionCollector(Size iterations)
+        : exceptions_(iterations) {}
+
+        //! runs the given iteration, storing the exception it throws
+        template <class F>
+        void run(Size i, F&& f) noexcept {
+            try {
+                std::forward<F>(f)();
+            } catch (...) {
+                exceptions_[i] = std::current_exception();
+            }
+        }
+
+        //! rethrows the exception of the first failed iteration, if any
+        void rethrow() const {
+            for (const auto& e : exceptions_)
+                if (e)
+                    std::rethrow_exception(e);
+        }
+
+      private:
+        std::vector<std::exception_ptr> exceptions_;
+    };
+
+}
+
+#endif
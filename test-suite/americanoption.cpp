@@ -23,6 +23,7 @@
 #include "toplevelfixture.hpp"
 #include "utilities.hpp"
 #include <ql/any.hpp>
+#include <ql/instruments/barrieroption.hpp>
 #include <ql/instruments/vanillaoption.hpp>
 #include <ql/math/distributions/normaldistribution.hpp>
 #include <ql/math/functional.hpp>
@@ -30,16 +31,28 @@
 #include <ql/math/integrals/integral.hpp>
 #include <ql/math/randomnumbers/rngtraits.hpp>
 #include <ql/math/statistics/incrementalstatistics.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmblackscholesmesher.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmmeshercomposite.hpp>
+#include <ql/methods/finitedifferences/operators/fdmblackscholesop.hpp>
+#include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmbackwardsolver.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmblackscholessolver.hpp>
+#include <ql/methods/finitedifferences/stepconditions/fdmstepconditioncomposite.hpp>
+#include <ql/methods/finitedifferences/utilities/fdminnervaluecalculator.hpp>
+#include <ql/pricingengines/barrier/fdblackscholesbarrierengine.hpp>
 #include <ql/pricingengines/vanilla/analyticeuropeanengine.hpp>
 #include <ql/pricingengines/vanilla/baroneadesiwhaleyengine.hpp>
 #include <ql/pricingengines/vanilla/bjerksundstenslandengine.hpp>
+#include <ql/pricingengines/vanilla/fdblackscholesbatchpricer.hpp>
 #include <ql/pricingengines/vanilla/fdblackscholesshoutengine.hpp>
 #include <ql/pricingengines/vanilla/fdblackscholesvanillaengine.hpp>
 #include <ql/pricingengines/vanilla/juquadraticengine.hpp>
 #include <ql/pricingengines/vanilla/qdfpamericanengine.hpp>
 #include <ql/pricingengines/vanilla/qdplusamericanengine.hpp>
 #include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
+#include <ql/termstructures/volatility/equityfx/blackvariancesurface.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/time/calendars/nullcalendar.hpp>
 #include <ql/time/daycounters/actual360.hpp>
 #include <ql/time/daycounters/thirty360.hpp>
 #include <ql/utilities/dataformatters.hpp>
@@ -803,6 +816,378 @@ BOOST_AUTO_TEST_CASE(testEscrowedVsSpotAmericanOption) {
    }
 }
 
+// the smile makes the volatility differ for each strike
+ext::shared_ptr<BlackVolTermStructure> smiledVolSurface(
+    const Date& today, const DayCounter& dc) {
+    const std::vector<Date> volDates
+        = { today + Period(6, Months), today + Period(18, Months) };
+    const std::vector<Real> volStrikes = { 80.0, 90.0, 100.0, 110.0, 120.0 };
+    Matrix smile(volStrikes.size(), volDates.size());
+    for (Size i=0; i < volStrikes.size(); ++i)
+        for (Size j=0; j < volDates.size(); ++j)
+            smile[i][j] = 0.2 + 0.002*std::fabs(volStrikes[i] - 100.0)
+                - 0.01*j;
+
+    return ext::make_shared<BlackVarianceSurface>(
+        today, NullCalendar(), volDates, volStrikes, smile, dc);
+}
+
+BOOST_AUTO_TEST_CASE(testFdMultipleStrikesEngine) {
+    BOOST_TEST_MESSAGE("Testing multiple-strikes FD Black-Scholes engine...");
+
+    const DayCounter dc = Actual365Fixed();
+    const Date today = Date(12, March, 2024);
+    Settings::instance().evaluationDate() = today;
+
+    const auto spot = ext::make_shared<SimpleQuote>(100.0);
+
+    const Date maturityDate = today + Period(1, Years);
+    const auto exercise
+        = ext::make_shared<AmericanExercise>(today, maturityDate);
+    const std::vector<Date> dividendDates = { today + Period(6, Months) };
+    const std::vector<Real> dividendAmounts = { 2.0 };
+
+    const std::vector<Real> strikes = { 100.0, 90.0, 95.0, 105.0, 110.0 };
+
+    const std::vector<Handle<BlackVolTermStructure> > volTSs = {
+        Handle<BlackVolTermStructure>(flatVol(today, 0.25, dc)),
+        Handle<BlackVolTermStructure>(smiledVolSurface(today, dc))
+    };
+
+    for (const auto& volTS : volTSs) {
+        const auto process = ext::make_shared<BlackScholesMertonProcess>(
+            Handle<Quote>(spot),
+            Handle<YieldTermStructure>(flatRate(today, 0.02, dc)),
+            Handle<YieldTermStructure>(flatRate(today, 0.05, dc)),
+            volTS
+        );
+
+        const auto multiStrikeEngine =
+            ext::make_shared<FdBlackScholesVanillaEngine>(
+                process, DividendVector(dividendDates, dividendAmounts),
+                100, 400);
+        multiStrikeEngine->enableMultipleStrikesCaching(strikes);
+
+        const Real tol = 1e-3;
+        for (auto type : { Option::Put, Option::Call }) {
+            for (Real strike : strikes) {
+                VanillaOption option(
+                    ext::make_shared<PlainVanillaPayoff>(type, strike), exercise);
+
+                option.setPricingEngine(
+                    MakeFdBlackScholesVanillaEngine(process)
+                    .withTGrid(100)
+                    .withXGrid(400)
+                    .withCashDividends(dividendDates, dividendAmounts));
+
+                const Real expectedNpv = option.NPV();
+                const Real expectedDelta = option.delta();
+                const Real expectedGamma = option.gamma();
+
+                option.setPricingEngine(multiStrikeEngine);
+
+                const Real npv = option.NPV();
+                const Real delta = option.delta();
+                const Real gamma = option.gamma();
+
+                if (std::fabs(npv - expectedNpv) > tol
+                    || std::fabs(delta - expectedDelta) > tol
+                    || std::fabs(gamma - expectedGamma) > tol) {
+                    BOOST_FAIL("failed to reproduce single-strike results"
+                               << "\n    type:            " << type
+                               << "\n    strike:          " << strike
+                               << "\n    npv:             " << npv
+                               << "\n    expected npv:    " << expectedNpv
+                               << "\n    delta:           " << delta
+                               << "\n    expected delta:  " << expectedDelta
+                               << "\n    gamma:           " << gamma
+                               << "\n    expected gamma:  " << expectedGamma
+                               << "\n    tolerance:       " << tol);
+                }
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testFdAdaptiveTimeStepping) {
+    BOOST_TEST_MESSAGE("Testing adaptive time-stepping for American options...");
+
+    const DayCounter dc = Actual365Fixed();
+    const Date today = Date(12, March, 2024);
+    Settings::instance().evaluationDate() = today;
+
+    const auto process = ext::make_shared<BlackScholesMertonProcess>(
+        Handle<Quote>(ext::make_shared<SimpleQuote>(100.0)),
+        Handle<YieldTermStructure>(flatRate(today, 0.02, dc)),
+        Handle<YieldTermStructure>(flatRate(today, 0.05, dc)),
+        Handle<BlackVolTermStructure>(flatVol(today, 0.25, dc))
+    );
+
+    const std::vector<Date> dividendDates
+        = { today + Period(3, Months), today + Period(9, Months) };
+    const std::vector<Real> dividendAmounts = { 2.0, 2.0 };
+
+    VanillaOption option(
+        ext::make_shared<PlainVanillaPayoff>(Option::Put, 100.0),
+        ext::make_shared<AmericanExercise>(today, today + Period(1, Years)));
+
+    option.setPricingEngine(
+        MakeFdBlackScholesVanillaEngine(process)
+        .withTGrid(2000)
+        .withXGrid(200)
+        .withCashDividends(dividendDates, dividendAmounts));
+    const Real expected = option.NPV();
+
+    option.setPricingEngine(
+        MakeFdBlackScholesVanillaEngine(process)
+        .withTGrid(10)
+        .withXGrid(200)
+        .withCashDividends(dividendDates, dividendAmounts)
+        .withFdmSchemeDesc(FdmSchemeDesc::AdaptiveTrBDF2(1e-5)));
+    const Real calculated = option.NPV();
+
+    const Real tol = 1e-3;
+    const Real diff = std::fabs(calculated - expected);
+    if (diff > tol) {
+        BOOST_FAIL("failed to reproduce American option NPV "
+                   "with adaptive time-stepping"
+                   << "\n    calculated: " << calculated
+                   << "\n    expected:   " << expected
+                   << "\n    difference: " << diff
+                   << "\n    tolerance:  " << tol);
+    }
+
+    // on the same spatial grid, the adaptive rollback has to need
+    // fewer implicit solves than a fixed TR-BDF2 grid of the same
+    // accuracy in the region where the option is priced
+    const Time maturity = dc.yearFraction(today, today + Period(1, Years));
+    const DividendSchedule dividends
+        = DividendVector(dividendDates, dividendAmounts);
+    const auto payoff = ext::make_shared<PlainVanillaPayoff>(Option::Put, 100.0);
+
+    const auto mesher = ext::make_shared<FdmMesherComposite>(
+        ext::make_shared<FdmBlackScholesMesher>(
+            200, process, maturity, 100.0, Null<Real>(), Null<Real>(),
+            0.0001, 1.5, std::pair<Real, Real>(100.0, 0.1), dividends));
+    const auto calculator
+        = ext::make_shared<FdmLogInnerValue>(payoff, mesher, 0);
+    const auto conditions = FdmStepConditionComposite::vanillaComposite(
+        dividends, option.exercise(), mesher, calculator, today, dc);
+    const auto op = ext::make_shared<FdmBlackScholesOp>(mesher, process, 100.0);
+
+    Array initialValues(mesher->layout()->size());
+    std::vector<Size> pricingRegion;
+    for (const auto& iter : *mesher->layout()) {
+        initialValues[iter.index()]
+            = calculator->avgInnerValue(iter, maturity);
+        const Real x = mesher->location(iter, 0);
+        if (x > std::log(50.0) && x < std::log(200.0))
+            pricingRegion.push_back(iter.index());
+    }
+
+    const auto rollback = [&](const FdmSchemeDesc& desc, Size steps,
+                              FdmBackwardSolver::AdaptiveStatistics* stats) {
+        Array values = initialValues;
+        FdmBackwardSolver solver(op, FdmBoundaryConditionSet(),
+                                 conditions, desc);
+        solver.rollback(values, maturity, 0.0, steps, 0);
+        if (stats != nullptr)
+            *stats = solver.adaptiveStatistics();
+        return values;
+    };
+
+    const Array reference = rollback(FdmSchemeDesc::TrBDF2(), 4000, nullptr);
+    const auto error = [&](const Array& values) {
+        Real maxError = 0.0;
+        for (Size i : pricingRegion)
+            maxError = std::max(maxError, std::fabs(values[i]-reference[i]));
+        return maxError;
+    };
+
+    FdmBackwardSolver::AdaptiveStatistics stats;
+    const Real adaptiveError = error(
+        rollback(FdmSchemeDesc::AdaptiveTrBDF2(1e-4), 10, &stats));
+
+    if (stats.acceptedSteps == 0
+        || stats.solves != 3*(stats.acceptedSteps + stats.rejectedSteps))
+        BOOST_FAIL("inconsistent adaptive step statistics"
+                   << "\n    accepted steps: " << stats.acceptedSteps
+                   << "\n    rejected steps: " << stats.rejectedSteps
+                   << "\n    solves:         " << stats.solves);
+
+    // smallest fixed grid at least as accurate as the adaptive one
+    Size lower = 5, upper = 10;
+    while (error(rollback(FdmSchemeDesc::TrBDF2(), upper, nullptr))
+           > adaptiveError) {
+        lower = upper;
+        upper *= 2;
+    }
+    while (upper - lower > 1) {
+        const Size steps = (lower + upper)/2;
+        if (error(rollback(FdmSchemeDesc::TrBDF2(), steps, nullptr))
+            > adaptiveError)
+            lower = steps;
+        else
+            upper = steps;
+    }
+
+    // each fixed step costs two solves, without counting the extra
+    // steps taken at the dividend dates
+    const Size fixedSolves = 2*upper;
+    if (stats.solves >= fixedSolves)
+        BOOST_FAIL("adaptive time-stepping needs more solves than "
+                   "a fixed grid of the same accuracy"
+                   << "\n    adaptive steps:  " << stats.acceptedSteps
+                   << " accepted, " << stats.rejectedSteps << " rejected"
+                   << "\n    adaptive solves: " << stats.solves
+                   << "\n    adaptive error:  " << adaptiveError
+                   << "\n    fixed steps:     " << upper
+                   << "\n    fixed solves:    " << fixedSolves);
+}
+
+BOOST_AUTO_TEST_CASE(testFdSnapshots) {
+    BOOST_TEST_MESSAGE("Testing retained FDM value grids for American options...");
+
+    const DayCounter dc = Actual365Fixed();
+    const Date today = Date(12, March, 2024);
+    Settings::instance().evaluationDate() = today;
+
+    const auto spot = ext::make_shared<SimpleQuote>(100.0);
+    const auto process = ext::make_shared<BlackScholesMertonProcess>(
+        Handle<Quote>(spot),
+        Handle<YieldTermStructure>(flatRate(0.02, dc)),
+        Handle<YieldTermStructure>(flatRate(0.05, dc)),
+        Handle<BlackVolTermStructure>(flatVol(0.25, dc))
+    );
+
+    VanillaOption option(
+        ext::make_shared<PlainVanillaPayoff>(Option::Put, 100.0),
+        ext::make_shared<AmericanExercise>(today, today + Period(1, Years)));
+
+    const auto engine =
+        ext::make_shared<FdBlackScholesVanillaEngine>(process, 200, 400);
+    const Time oneDay = dc.yearFraction(today, today + 1);
+    engine->enableSnapshots({ oneDay, 0.5 });
+    option.setPricingEngine(engine);
+
+    const Real npv = option.NPV();
+    const std::vector<Real> values =
+        option.result<std::vector<Real> >("snapshotValues");
+    const std::vector<Real> deltas =
+        option.result<std::vector<Real> >("snapshotDeltas");
+    const ext::shared_ptr<FdmBlackScholesSolver> solver =
+        engine->snapshotSolver();
+
+    const Real tol = 1e-3;
+
+    if (std::fabs(solver->valueAt(spot->value()) - npv) > 1e-12) {
+        BOOST_FAIL("retained solver does not reproduce the option NPV");
+    }
+
+    // repricing for a shifted spot from the retained solution
+    const Real shifted = solver->valueAt(102.0);
+    spot->setValue(102.0);
+    option.setPricingEngine(
+        ext::make_shared<FdBlackScholesVanillaEngine>(process, 200, 400));
+    const Real expectedShifted = option.NPV();
+    spot->setValue(100.0);
+
+    if (std::fabs(shifted - expectedShifted) > tol) {
+        BOOST_FAIL("failed to reprice a shifted spot from retained grid"
+                   << "\n    calculated: " << shifted
+                   << "\n    expected:   " << expectedShifted
+                   << "\n    tolerance:  " << tol);
+    }
+
+    // one-day roll from the retained value grid
+    Settings::instance().evaluationDate() = today + 1;
+    const Real expectedRolled = option.NPV();
+    const Real expectedDelta = option.delta();
+    Settings::instance().evaluationDate() = today;
+
+    if (std::fabs(values.front() - expectedRolled) > tol
+        || std::fabs(deltas.front() - expectedDelta) > tol) {
+        BOOST_FAIL("failed to reproduce one-day roll from retained grid"
+                   << "\n    calculated value: " << values.front()
+                   << "\n    expected value:   " << expectedRolled
+                   << "\n    calculated delta: " << deltas.front()
+                   << "\n    expected delta:   " << expectedDelta
+                   << "\n    tolerance:        " << tol);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testFdBatchPricer) {
+    BOOST_TEST_MESSAGE("Testing batched FDM pricing of vanilla and barrier options...");
+
+    const DayCounter dc = Actual365Fixed();
+    const Date today = Date(12, March, 2024);
+    Settings::instance().evaluationDate() = today;
+
+    const ext::shared_ptr<Exercise> american =
+        ext::make_shared<AmericanExercise>(today, today + Period(1, Years));
+    const ext::shared_ptr<Exercise> european =
+        ext::make_shared<EuropeanExercise>(today + Period(6, Months));
+
+    std::vector<ext::shared_ptr<OneAssetOption> > options;
+    for (Real strike : { 95.0, 100.0, 105.0 })
+        options.push_back(ext::make_shared<VanillaOption>(
+            ext::make_shared<PlainVanillaPayoff>(Option::Put, strike),
+            american));
+    options.push_back(ext::make_shared<VanillaOption>(
+        ext::make_shared<PlainVanillaPayoff>(Option::Call, 100.0), european));
+    for (Real strike : { 100.0, 105.0 })
+        options.push_back(ext::make_shared<BarrierOption>(
+            Barrier::DownOut, 80.0, 1.0,
+            ext::make_shared<PlainVanillaPayoff>(Option::Call, strike),
+            european));
+    options.push_back(ext::make_shared<BarrierOption>(
+        Barrier::DownIn, 80.0, 0.0,
+        ext::make_shared<PlainVanillaPayoff>(Option::Call, 100.0), european));
+
+    const std::vector<Handle<BlackVolTermStructure> > volTSs = {
+        Handle<BlackVolTermStructure>(flatVol(today, 0.25, dc)),
+        Handle<BlackVolTermStructure>(smiledVolSurface(today, dc))
+    };
+
+    for (const auto& volTS : volTSs) {
+        const auto process = ext::make_shared<BlackScholesMertonProcess>(
+            Handle<Quote>(ext::make_shared<SimpleQuote>(100.0)),
+            Handle<YieldTermStructure>(flatRate(today, 0.02, dc)),
+            Handle<YieldTermStructure>(flatRate(today, 0.05, dc)),
+            volTS
+        );
+
+        const std::vector<OneAssetOption::results> results =
+            FdBlackScholesBatchPricer(process, DividendSchedule(), 100, 200)
+            .calculate(options);
+
+        const Real tol = 1e-3;
+        for (Size i=0; i < options.size(); ++i) {
+            if (ext::dynamic_pointer_cast<BarrierOption>(options[i]) != nullptr)
+                options[i]->setPricingEngine(
+                    ext::make_shared<FdBlackScholesBarrierEngine>(
+                        process, 100, 200));
+            else
+                options[i]->setPricingEngine(
+                    ext::make_shared<FdBlackScholesVanillaEngine>(
+                        process, 100, 200));
+
+            const Real npvDiff = std::fabs(results[i].value - options[i]->NPV());
+            const Real deltaDiff =
+                std::fabs(results[i].delta - options[i]->delta());
+            if (npvDiff > tol || deltaDiff > tol) {
+                BOOST_FAIL("failed to reproduce option results with batched "
+                           "pricing for option " << i
+                           << "\n    batched NPV:   " << results[i].value
+                           << "\n    single NPV:    " << options[i]->NPV()
+                           << "\n    batched delta: " << results[i].delta
+                           << "\n    single delta:  " << options[i]->delta()
+                           << "\n    tolerance:     " << tol);
+            }
+        }
+    }
+}
+
 BOOST_AUTO_TEST_CASE(testTodayIsDividendDate) {
     BOOST_TEST_MESSAGE("Testing escrowed vs spot dividend model on dividend dates for American options...");
 
@@ -41,6 +41,7 @@
 #include <ql/pricingengines/asian/mc_discr_arith_av_strike.hpp>
 #include <ql/pricingengines/asian/mc_discr_geom_av_price.hpp>
 #include <ql/pricingengines/asian/mc_discr_geom_av_price_heston.hpp>
+#include <ql/pricingengines/asian/mlmc_discr_arith_av_price.hpp>
 #include <ql/pricingengines/asian/turnbullwakemanasianengine.hpp>
 #include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
 #include <ql/termstructures/volatility/equityfx/blackvariancecurve.hpp>
@@ -2636,6 +2637,201 @@ BOOST_AUTO_TEST_CASE(testChoiAsianEngineSpecialCases) {
             0.075, 0.2, today, 0.5, expected, calculated, tol);
 }
 
+BOOST_AUTO_TEST_CASE(testMultiLevelMCDiscreteArithmeticAveragePrice) {
+    BOOST_TEST_MESSAGE("Testing multi-level Monte Carlo discrete arithmetic "
+                       "average-price Asians...");
+
+    const DayCounter dc = Actual365Fixed();
+    const Date today = Date(5, January, 2025);
+    Settings::instance().evaluationDate() = today;
+    const Date maturity = today + Period(12, Months);
+
+    std::vector<Date> fixingDates(1, today + Period(1, Months));
+    while (fixingDates.back() < maturity)
+        fixingDates.push_back(fixingDates.back() + Period(1, Months));
+
+    const ext::shared_ptr<PlainVanillaPayoff> payoff
+        = ext::make_shared<PlainVanillaPayoff>(Option::Call, 100);
+    const ext::shared_ptr<EuropeanExercise> exercise
+        = ext::make_shared<EuropeanExercise>(maturity);
+
+    DiscreteAveragingAsianOption option(
+        Average::Arithmetic, 0.0, 0, fixingDates, payoff, exercise);
+
+    ext::shared_ptr<BlackScholesMertonProcess> process
+        = ext::make_shared<BlackScholesMertonProcess>(
+            Handle<Quote>(ext::make_shared<SimpleQuote>(100)),
+            Handle<YieldTermStructure>(flatRate(today, 0.02, dc)),
+            Handle<YieldTermStructure>(flatRate(today, 0.05, dc)),
+            Handle<BlackVolTermStructure>(flatVol(today, 0.3, dc))
+    );
+
+    option.setPricingEngine(
+        ext::make_shared<ChoiAsianEngine>(process, 20, 2 << 12));
+    Real expected = option.NPV();
+
+    Real tol = 0.02;
+    option.setPricingEngine(
+        MakeMLMCDiscreteArithmeticAPEngine<PseudoRandom>(process)
+            .withAbsoluteTolerance(tol)
+            .withSeed(42));
+    Real calculated = option.NPV();
+
+    if (std::fabs(calculated-expected) > 3.0*tol)
+        REPORT_FAILURE("value", Average::Arithmetic, 0.0, 0,
+                       fixingDates, payoff, exercise, process->x0(),
+                       0.02, 0.05, today, 0.3, expected, calculated, 3.0*tol);
+}
+
+BOOST_AUTO_TEST_CASE(testMCDiscreteArithmeticAveragePriceRegressionControlVariates) {
+    BOOST_TEST_MESSAGE("Testing Monte Carlo discrete arithmetic average-price "
+                       "Asians with regression control variates...");
+
+    const DayCounter dc = Actual365Fixed();
+    const Date today = Date(5, January, 2025);
+    Settings::instance().evaluationDate() = today;
+    const Date maturity = today + Period(12, Months);
+
+    std::vector<Date> fixingDates(1, today + Period(1, Months));
+    while (fixingDates.back() < maturity)
+        fixingDates.push_back(fixingDates.back() + Period(1, Months));
+
+    const ext::shared_ptr<PlainVanillaPayoff> payoff
+        = ext::make_shared<PlainVanillaPayoff>(Option::Call, 100);
+    const ext::shared_ptr<EuropeanExercise> exercise
+        = ext::make_shared<EuropeanExercise>(maturity);
+
+    DiscreteAveragingAsianOption option(
+        Average::Arithmetic, 0.0, 0, fixingDates, payoff, exercise);
+
+    ext::shared_ptr<BlackScholesMertonProcess> process
+        = ext::make_shared<BlackScholesMertonProcess>(
+            Handle<Quote>(ext::make_shared<SimpleQuote>(100)),
+            Handle<YieldTermStructure>(flatRate(today, 0.02, dc)),
+            Handle<YieldTermStructure>(flatRate(today, 0.05, dc)),
+            Handle<BlackVolTermStructure>(flatVol(today, 0.3, dc))
+    );
+
+    option.setPricingEngine(
+        ext::make_shared<ChoiAsianEngine>(process, 20, 2 << 12));
+    Real expected = option.NPV();
+
+    option.setPricingEngine(
+        MakeMCDiscreteArithmeticAPEngine<PseudoRandom>(process)
+            .withSamples(10000)
+            .withControlVariate()
+            .withSeed(42));
+    Real singleControlError = option.errorEstimate();
+
+    option.setPricingEngine(
+        MakeMCDiscreteArithmeticAPEngine<PseudoRandom>(process)
+            .withSamples(10000)
+            .withRegressionControlVariates()
+            .withSeed(42));
+    Real calculated = option.NPV();
+    Real error = option.errorEstimate();
+
+    if (std::fabs(calculated-expected) > 3.0*error)
+        REPORT_FAILURE("value", Average::Arithmetic, 0.0, 0,
+                       fixingDates, payoff, exercise, process->x0(),
+                       0.02, 0.05, today, 0.3, expected, calculated, 3.0*error);
+
+    if (error > singleControlError)
+        BOOST_ERROR("regression control variates don't reduce the error:"
+                    << "\n    single control variate: " << singleControlError
+                    << "\n    regression:             " << error);
+}
+
+BOOST_AUTO_TEST_CASE(testMCDiscreteArithmeticAveragePriceGreeks) {
+    BOOST_TEST_MESSAGE("Testing pathwise Greeks of Monte Carlo discrete "
+                       "arithmetic average-price Asians...");
+
+    const DayCounter dc = Actual365Fixed();
+    const Date today = Date(5, January, 2025);
+    Settings::instance().evaluationDate() = today;
+    const Date maturity = today + Period(12, Months);
+
+    const Real underlyingPrice = 100.0;
+    const Rate q = 0.02, r = 0.05;
+    const Volatility vol = 0.3;
+
+    const auto underlying = ext::make_shared<SimpleQuote>(underlyingPrice);
+    const auto volatility = ext::make_shared<SimpleQuote>(vol);
+    const auto process = ext::make_shared<BlackScholesMertonProcess>(
+        Handle<Quote>(underlying),
+        Handle<YieldTermStructure>(flatRate(today, q, dc)),
+        Handle<YieldTermStructure>(flatRate(today, r, dc)),
+        Handle<BlackVolTermStructure>(flatVol(today, volatility, dc)));
+
+    const auto exercise = ext::make_shared<EuropeanExercise>(maturity);
+
+    std::map<std::string, Real> tolerance;
+    tolerance["delta"] = 0.002;
+    tolerance["gamma"] = 0.001;
+    tolerance["vega"] = 0.3;
+
+    // with a fixing on the evaluation date, the average depends
+    // explicitly on the spot and gamma is not available
+    for (bool fixingToday : {false, true}) {
+        std::vector<Date> fixingDates(
+            1, fixingToday ? today : today + Period(1, Months));
+        while (fixingDates.back() < maturity)
+            fixingDates.push_back(fixingDates.back() + Period(1, Months));
+
+        for (Option::Type type : {Option::Call, Option::Put}) {
+            const auto payoff = ext::make_shared<PlainVanillaPayoff>(type, 100.0);
+            DiscreteAveragingAsianOption option(
+                Average::Arithmetic, 0.0, 0, fixingDates, payoff, exercise);
+
+            // reference values by bumping and repricing
+            option.setPricingEngine(
+                ext::make_shared<ChoiAsianEngine>(process, 20, 2 << 12));
+            const Real ds = 1.0, dv = 0.001;
+            const Real npv = option.NPV();
+            underlying->setValue(underlyingPrice + ds);
+            const Real npvUp = option.NPV();
+            underlying->setValue(underlyingPrice - ds);
+            const Real npvDown = option.NPV();
+            underlying->setValue(underlyingPrice);
+            volatility->setValue(vol + dv);
+            const Real vegaUp = option.NPV();
+            volatility->setValue(vol - dv);
+            const Real vegaDown = option.NPV();
+            volatility->setValue(vol);
+
+            std::map<std::string, Real> calculated, expected;
+            expected["delta"] = (npvUp - npvDown)/(2*ds);
+            expected["vega"] = (vegaUp - vegaDown)/(2*dv);
+
+            option.setPricingEngine(
+                MakeMCDiscreteArithmeticAPEngine<PseudoRandom>(process)
+                .withSamples(100000)
+                .withAntitheticVariate()
+                .withSeed(42)
+                .withGreeks());
+            calculated["delta"] = option.delta();
+            calculated["vega"] = option.vega();
+            if (fixingToday) {
+                BOOST_CHECK_THROW(option.gamma(), Error);
+            } else {
+                expected["gamma"] = (npvUp - 2*npv + npvDown)/(ds*ds);
+                calculated["gamma"] = option.gamma();
+            }
+
+            for (const auto& it : calculated) {
+                const std::string& greek = it.first;
+                const Real error = std::fabs(it.second - expected[greek]);
+                if (error > tolerance[greek])
+                    REPORT_FAILURE(greek, Average::Arithmetic, 0.0, 0,
+                                   fixingDates, payoff, exercise,
+                                   underlyingPrice, q, r, today, vol,
+                                   expected[greek], it.second,
+                                   tolerance[greek]);
+            }
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -36,6 +36,7 @@
 #include <ql/pricingengines/barrier/fdhestonbarrierengine.hpp>
 #include <ql/pricingengines/barrier/fdblackscholesbarrierengine.hpp>
 #include <ql/pricingengines/barrier/mcbarrierengine.hpp>
+#include <ql/pricingengines/barrier/mlmcbarrierengine.hpp>
 #include <ql/pricingengines/vanilla/analyticeuropeanengine.hpp>
 #include <ql/pricingengines/blackformula.hpp>
 #include <ql/experimental/barrieroption/perturbativebarrieroptionengine.hpp>
@@ -46,6 +47,7 @@
 #include <ql/termstructures/volatility/equityfx/blackvariancecurve.hpp>
 #include <ql/termstructures/volatility/equityfx/blackvariancesurface.hpp>
 #include <ql/utilities/dataformatters.hpp>
+#include <map>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -1592,6 +1594,285 @@ BOOST_AUTO_TEST_CASE(testVannaVolgaSimpleBarrierValues) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testMultiLevelMonteCarloValues) {
+
+    BOOST_TEST_MESSAGE("Testing multi-level Monte Carlo barrier engine...");
+
+    const DayCounter dc = Actual360();
+    const Date today = Date::todaysDate();
+
+    const Real underlyingPrice = 100.0;
+    const Real strike = 100.0;
+    const Real rebate = 3.0;
+    const Handle<Quote> underlying(ext::make_shared<SimpleQuote>(underlyingPrice));
+    const Handle<YieldTermStructure> qTS(flatRate(today, 0.02, dc));
+    const Handle<YieldTermStructure> rTS(flatRate(today, 0.05, dc));
+    const Handle<BlackVolTermStructure> volTS(flatVol(today, 0.25, dc));
+
+    const auto stochProcess = ext::make_shared<BlackScholesMertonProcess>(
+        underlying, qTS, rTS, volTS);
+
+    const auto payoff = ext::make_shared<PlainVanillaPayoff>(Option::Call, strike);
+    const auto exercise = ext::make_shared<EuropeanExercise>(today + 360);
+
+    struct MLMCBarrierData {
+        Barrier::Type type;
+        Real barrier;
+    };
+    const MLMCBarrierData values[] = {
+        { Barrier::DownOut, 90.0 },
+        { Barrier::DownIn,  90.0 },
+        { Barrier::UpOut,  130.0 },
+        { Barrier::UpIn,   130.0 }
+    };
+
+    const auto analyticEngine =
+        ext::make_shared<AnalyticBarrierEngine>(stochProcess);
+
+    const Real tolerance = 0.02;
+    const ext::shared_ptr<PricingEngine> mlmcEngine =
+        MakeMLMCBarrierEngine<PseudoRandom>(stochProcess)
+        .withSteps(4)
+        .withAbsoluteTolerance(tolerance)
+        .withSeed(42);
+
+    for (const auto& value : values) {
+        BarrierOption option(value.type, value.barrier, rebate, payoff, exercise);
+
+        option.setPricingEngine(analyticEngine);
+        const Real expected = option.NPV();
+
+        option.setPricingEngine(mlmcEngine);
+        const Real calculated = option.NPV();
+
+        // the tolerance bounds the root-mean-square error
+        const Real error = std::fabs(calculated-expected);
+        if (error > 3.0*tolerance) {
+            REPORT_FAILURE("value", value.type, value.barrier, rebate, payoff,
+                           exercise, underlyingPrice, 0.02, 0.05, today, 0.25,
+                           expected, calculated, error, 3.0*tolerance);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testMultiLevelMonteCarloDiscreteMonitoring) {
+
+    BOOST_TEST_MESSAGE("Testing multi-level Monte Carlo barrier engine "
+                       "with discrete monitoring...");
+
+    const DayCounter dc = Actual360();
+    const Date today = Date::todaysDate();
+
+    const Real underlyingPrice = 100.0;
+    const Real strike = 100.0;
+    const Real rebate = 0.0;
+    const Volatility vol = 0.25;
+    const Handle<Quote> underlying(ext::make_shared<SimpleQuote>(underlyingPrice));
+    const Handle<YieldTermStructure> qTS(flatRate(today, 0.02, dc));
+    const Handle<YieldTermStructure> rTS(flatRate(today, 0.05, dc));
+    const Handle<BlackVolTermStructure> volTS(flatVol(today, vol, dc));
+
+    const auto stochProcess = ext::make_shared<BlackScholesMertonProcess>(
+        underlying, qTS, rTS, volTS);
+
+    const auto payoff = ext::make_shared<PlainVanillaPayoff>(Option::Call, strike);
+    const auto exercise = ext::make_shared<EuropeanExercise>(today + 360);
+
+    // monthly monitoring
+    const Size nMonitoring = 12;
+    std::vector<Date> monitoringDates;
+    for (Size i=1; i<=nMonitoring; ++i)
+        monitoringDates.push_back(today + Integer(30*i));
+
+    const Real tolerance = 0.02;
+    const ext::shared_ptr<PricingEngine> mlmcEngine =
+        MakeMLMCBarrierEngine<PseudoRandom>(stochProcess)
+        .withSteps(nMonitoring)
+        .withMonitoringDates(monitoringDates)
+        .withAbsoluteTolerance(tolerance)
+        .withSeed(42);
+
+    const auto analyticEngine =
+        ext::make_shared<AnalyticBarrierEngine>(stochProcess);
+
+    const Real barrier = 90.0;
+
+    // Broadie-Glasserman-Kou continuity correction
+    const Real shift = std::exp(-0.5826*vol*std::sqrt(1.0/nMonitoring));
+    BarrierOption shifted(Barrier::DownOut, barrier*shift, rebate,
+                          payoff, exercise);
+    shifted.setPricingEngine(analyticEngine);
+    const Real expected = shifted.NPV();
+
+    BarrierOption continuous(Barrier::DownOut, barrier, rebate,
+                             payoff, exercise);
+    continuous.setPricingEngine(analyticEngine);
+
+    BarrierOption option(Barrier::DownOut, barrier, rebate, payoff, exercise);
+    option.setPricingEngine(mlmcEngine);
+    const Real calculated = option.NPV();
+
+    // the correction is accurate to a few basis points of the spot
+    const Real error = std::fabs(calculated-expected);
+    if (error > 3.0*tolerance + 0.02) {
+        REPORT_FAILURE("value", Barrier::DownOut, barrier, rebate, payoff,
+                       exercise, underlyingPrice, 0.02, 0.05, today, vol,
+                       expected, calculated, error, 3.0*tolerance + 0.02);
+    }
+
+    // discrete monitoring must be noticeably cheaper to knock out
+    if (calculated - continuous.NPV() < 0.1) {
+        BOOST_ERROR("discretely monitored down-and-out value "
+                    << calculated
+                    << " is too close to the continuously monitored one "
+                    << continuous.NPV());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testMcLikelihoodRatioGreeks) {
+    BOOST_TEST_MESSAGE("Testing likelihood-ratio Greeks of the Monte Carlo "
+                       "barrier engine...");
+
+    const DayCounter dc = Actual360();
+    const Date today = Date(5, January, 2025);
+    Settings::instance().evaluationDate() = today;
+
+    const Real underlyingPrice = 100.0, barrier = 90.0, rebate = 0.0;
+    const Rate q = 0.02, r = 0.05;
+    const Volatility vol = 0.25;
+
+    const auto underlying = ext::make_shared<SimpleQuote>(underlyingPrice);
+    const auto volatility = ext::make_shared<SimpleQuote>(vol);
+    const auto process = ext::make_shared<BlackScholesMertonProcess>(
+        Handle<Quote>(underlying),
+        Handle<YieldTermStructure>(flatRate(today, q, dc)),
+        Handle<YieldTermStructure>(flatRate(today, r, dc)),
+        Handle<BlackVolTermStructure>(flatVol(today, volatility, dc)));
+
+    const auto payoff = ext::make_shared<PlainVanillaPayoff>(Option::Call, 100.0);
+    const auto exercise = ext::make_shared<EuropeanExercise>(today + 360);
+
+    BarrierOption option(Barrier::DownOut, barrier, rebate, payoff, exercise);
+
+    // the Brownian-bridge correction depends explicitly on the spot
+    BOOST_CHECK_THROW(
+        ext::shared_ptr<PricingEngine>(
+            MakeMCBarrierEngine<PseudoRandom>(process)
+            .withSteps(10)
+            .withSamples(1000)
+            .withSeed(42)
+            .withGreeks()),
+        Error);
+
+    // the barrier is monitored on the simulation grid; the reference
+    // values are obtained by bumping and repricing with the same
+    // random numbers
+    const auto engine = [&](bool greeks) {
+        return ext::shared_ptr<PricingEngine>(
+            MakeMCBarrierEngine<PseudoRandom>(process)
+            .withSteps(10)
+            .withBias()
+            .withAntitheticVariate()
+            .withSamples(100000)
+            .withSeed(42)
+            .withGreeks(greeks));
+    };
+
+    option.setPricingEngine(engine(false));
+    const Real ds = 4.0, dv = 0.01;
+    const Real npv = option.NPV();
+    underlying->setValue(underlyingPrice + ds);
+    const Real npvUp = option.NPV();
+    underlying->setValue(underlyingPrice - ds);
+    const Real npvDown = option.NPV();
+    underlying->setValue(underlyingPrice);
+    volatility->setValue(vol + dv);
+    const Real vegaUp = option.NPV();
+    volatility->setValue(vol - dv);
+    const Real vegaDown = option.NPV();
+    volatility->setValue(vol);
+
+    std::map<std::string, Real> calculated, expected, tolerance;
+    expected["delta"] = (npvUp - npvDown)/(2*ds);
+    expected["gamma"] = (npvUp - 2*npv + npvDown)/(ds*ds);
+    expected["vega"] = (vegaUp - vegaDown)/(2*dv);
+
+    option.setPricingEngine(engine(true));
+    calculated["delta"] = option.delta();
+    calculated["gamma"] = option.gamma();
+    calculated["vega"] = option.vega();
+
+    // about three standard errors of the estimators
+    tolerance["delta"] = 0.02;
+    tolerance["gamma"] = 0.003;
+    tolerance["vega"] = 3.5;
+
+    for (const auto& it : calculated) {
+        const std::string& greek = it.first;
+        const Real error = std::fabs(it.second - expected[greek]);
+        if (error > tolerance[greek])
+            REPORT_FAILURE(greek, Barrier::DownOut, barrier, rebate, payoff,
+                           exercise, underlyingPrice, q, r, today, vol,
+                           expected[greek], it.second, error,
+                           tolerance[greek]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testMcDriftShift) {
+    BOOST_TEST_MESSAGE("Testing Monte Carlo barrier engine "
+                       "with importance sampling...");
+
+    const DayCounter dc = Actual360();
+    const Date today = Date(5, January, 2025);
+    Settings::instance().evaluationDate() = today;
+
+    const Real underlyingPrice = 100.0, barrier = 65.0, rebate = 0.0;
+    const Rate q = 0.02, r = 0.05;
+    const Volatility vol = 0.2;
+
+    const auto process = ext::make_shared<BlackScholesMertonProcess>(
+        Handle<Quote>(ext::make_shared<SimpleQuote>(underlyingPrice)),
+        Handle<YieldTermStructure>(flatRate(today, q, dc)),
+        Handle<YieldTermStructure>(flatRate(today, r, dc)),
+        Handle<BlackVolTermStructure>(flatVol(today, vol, dc)));
+
+    // the barrier is rarely hit
+    const auto payoff = ext::make_shared<PlainVanillaPayoff>(Option::Put, 70.0);
+    const auto exercise = ext::make_shared<EuropeanExercise>(today + 360);
+
+    BarrierOption option(Barrier::DownIn, barrier, rebate, payoff, exercise);
+    option.setPricingEngine(ext::make_shared<AnalyticBarrierEngine>(process));
+    const Real expected = option.NPV();
+
+    option.setPricingEngine(
+        MakeMCBarrierEngine<PseudoRandom>(process)
+        .withSteps(20)
+        .withSamples(20000)
+        .withSeed(42));
+    const Real plainError = option.errorEstimate();
+
+    // a negative shift drives the paths towards the barrier
+    option.setPricingEngine(
+        MakeMCBarrierEngine<PseudoRandom>(process)
+        .withSteps(20)
+        .withSamples(20000)
+        .withSeed(42)
+        .withDriftShift(-2.0));
+    const Real calculated = option.NPV();
+    const Real error = option.errorEstimate();
+
+    if (std::fabs(calculated - expected) > 3.0*error)
+        REPORT_FAILURE("value", Barrier::DownIn, barrier, rebate, payoff,
+                       exercise, underlyingPrice, q, r, today, vol,
+                       expected, calculated, std::fabs(calculated - expected),
+                       3.0*error);
+
+    if (error > 0.5*plainError)
+        BOOST_ERROR("importance sampling doesn't reduce the error enough:"
+                    << "\n    plain Monte Carlo:   " << plainError
+                    << "\n    importance sampling: " << error);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()
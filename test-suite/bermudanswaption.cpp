@@ -28,9 +28,11 @@
 #include <ql/instruments/makevanillaswap.hpp>
 #include <ql/instruments/swaption.hpp>
 #include <ql/models/shortrate/onefactormodels/hullwhite.hpp>
+#include <ql/models/shortrate/shortratetreecache.hpp>
 #include <ql/models/shortrate/twofactormodels/g2.hpp>
 #include <ql/pricingengines/swap/discountingswapengine.hpp>
 #include <ql/pricingengines/swaption/fdg2swaptionengine.hpp>
+#include <ql/pricingengines/swaption/discretizedswaption.hpp>
 #include <ql/pricingengines/swaption/fdhullwhiteswaptionengine.hpp>
 #include <ql/pricingengines/swaption/treeswaptionengine.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
@@ -309,6 +311,137 @@ BOOST_AUTO_TEST_CASE(testCachedG2Values, *precondition(if_speed(Fast))) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testSharedTreeCache) {
+
+    BOOST_TEST_MESSAGE(
+        "Testing Bermudan swaptions priced on a shared short-rate tree...");
+
+    CommonVars vars;
+
+    vars.today = Date(15, February, 2002);
+
+    Settings::instance().evaluationDate() = vars.today;
+
+    vars.settlement = Date(19, February, 2002);
+    vars.termStructure.linkTo(flatRate(vars.settlement,
+                                          0.04875825,
+                                          Actual365Fixed()));
+
+    const Rate atmRate = vars.makeSwap(0.0)->fairRate();
+
+    const ext::shared_ptr<HullWhite> model =
+        ext::make_shared<HullWhite>(vars.termStructure, 0.048696, 0.0058904);
+
+    const Size timeSteps = 200;
+    const ext::shared_ptr<ShortRateTreeCache> cache =
+        ext::make_shared<ShortRateTreeCache>(model, timeSteps);
+    const ext::shared_ptr<PricingEngine> cachedEngine =
+        ext::make_shared<TreeSwaptionEngine>(cache);
+    const ext::shared_ptr<PricingEngine> treeEngine =
+        ext::make_shared<TreeSwaptionEngine>(model, timeSteps);
+
+    std::vector<Swaption> swaptions;
+    for (Integer shift : { 0, 10 }) {
+        for (Real moneyness : { 0.8, 1.0, 1.2 }) {
+            const ext::shared_ptr<VanillaSwap> swap =
+                vars.makeSwap(moneyness*atmRate);
+            std::vector<Date> exerciseDates;
+            for (const auto& cf : swap->fixedLeg()) {
+                const Date d = ext::dynamic_pointer_cast<Coupon>(cf)
+                    ->accrualStartDate();
+                exerciseDates.push_back(vars.calendar.adjust(d - shift));
+            }
+            swaptions.emplace_back(
+                swap, ext::make_shared<BermudanExercise>(exerciseDates));
+        }
+    }
+
+    // mandatory times of a swaption priced on a tree
+    const auto mandatoryTimes = [&](const Swaption& swaption) {
+        Swaption::arguments arguments;
+        swaption.setupArguments(&arguments);
+        return DiscretizedSwaption(arguments,
+                                   vars.termStructure->referenceDate(),
+                                   vars.termStructure->dayCounter())
+            .mandatoryTimes();
+    };
+
+    // times must be registered before pricing
+    {
+        Swaption& swaption = swaptions.front();
+        swaption.setPricingEngine(cachedEngine);
+        BOOST_CHECK_THROW(swaption.NPV(), Error);
+    }
+
+    for (const auto& swaption : swaptions)
+        cache->addTimes(mandatoryTimes(swaption));
+
+    // the merged grid differs from the grid of each swaption
+    const auto check = [&]() {
+        const Real tolerance = 5.0e-4;
+        for (auto& swaption : swaptions) {
+            swaption.setPricingEngine(treeEngine);
+            const Real expected = swaption.NPV();
+            swaption.setPricingEngine(cachedEngine);
+            const Real calculated = swaption.NPV();
+            if (std::fabs(calculated - expected) > tolerance*expected)
+                BOOST_ERROR("failed to reproduce swaption value "
+                            "on shared tree:"
+                            << "\n  calculated: " << calculated
+                            << "\n  expected:   " << expected);
+        }
+    };
+
+    check();
+
+    // the tree is built once for all the registered times
+    const ext::shared_ptr<Lattice> lattice =
+        cache->lattice(std::vector<Time>());
+    for (auto& swaption : swaptions) {
+        swaption.recalculate();
+        swaption.NPV();
+    }
+    if (cache->lattice(std::vector<Time>()) != lattice)
+        BOOST_ERROR("shared tree rebuilt for registered mandatory times");
+
+    // registering new times rebuilds the tree; swaptions priced on
+    // the previous one must be notified
+    const auto priced = ext::make_shared<Swaption>(
+        swaptions.front().underlying(), swaptions.front().exercise());
+    priced->setPricingEngine(cachedEngine);
+    priced->NPV();
+    Flag flag;
+    flag.registerWith(priced);
+
+    std::vector<Date> exerciseDates;
+    for (const auto& cf : priced->underlying()->fixedLeg())
+        exerciseDates.push_back(vars.calendar.adjust(
+            ext::dynamic_pointer_cast<Coupon>(cf)->accrualStartDate() - 5));
+    Swaption swaption(priced->underlying(),
+                      ext::make_shared<BermudanExercise>(exerciseDates));
+    swaption.setPricingEngine(cachedEngine);
+    BOOST_CHECK_THROW(swaption.NPV(), Error);
+    if (flag.isUp())
+        BOOST_ERROR("unregistered times modified the shared tree");
+
+    cache->addTimes(mandatoryTimes(swaption));
+    if (!flag.isUp())
+        BOOST_ERROR("swaption not notified of shared tree rebuild");
+    swaption.NPV();
+    const ext::shared_ptr<Lattice> rebuilt =
+        cache->lattice(std::vector<Time>());
+    if (rebuilt == lattice)
+        BOOST_ERROR("shared tree not rebuilt for new mandatory times");
+
+    // a curve change must discard the tree
+    vars.termStructure.linkTo(flatRate(vars.settlement,
+                                          0.045,
+                                          Actual365Fixed()));
+    check();
+    if (cache->lattice(std::vector<Time>()) == rebuilt)
+        BOOST_ERROR("shared tree not rebuilt after curve change");
+}
+
 BOOST_AUTO_TEST_CASE(testTreeEngineTimeSnapping) {
     BOOST_TEST_MESSAGE("Testing snap of exercise dates for discretized swaption...");
 
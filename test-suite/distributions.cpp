@@ -309,6 +309,43 @@ BOOST_AUTO_TEST_CASE(testNormal) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testInverseCumulativeNormalOnRange) {
+
+    BOOST_TEST_MESSAGE("Testing inverse cumulative normal on ranges...");
+
+    // include values in both tails and at the region boundaries
+    std::vector<Real> x = { 1.0e-12, 1.0e-6, 0.001, 0.02425, 0.025, 0.1,
+                            0.3, 0.5, 0.7, 0.9, 0.975, 0.97575, 0.999,
+                            1.0 - 1.0e-6 };
+    for (Size i=1; i<1000; ++i)
+        x.push_back(i/1000.0);
+
+    std::vector<Real> z(x.size());
+    InverseCumulativeNormal::standard_values(x.data(), x.data() + x.size(),
+                                             z.data());
+    for (Size i=0; i<x.size(); ++i) {
+        Real expected = InverseCumulativeNormal::standard_value(x[i]);
+        if (z[i] != expected)
+            BOOST_ERROR("standard inverse cumulative normal on range "
+                        "differs from scalar value at " << x[i] << ":"
+                        << std::scientific
+                        << "\n    scalar: " << expected
+                        << "\n    range:  " << z[i]);
+    }
+
+    InverseCumulativeNormal invCum(average, sigma);
+    invCum(x.data(), x.data() + x.size(), z.data());
+    for (Size i=0; i<x.size(); ++i) {
+        Real expected = invCum(x[i]);
+        if (std::fabs(z[i] - expected) > 1.0e-15*std::fabs(expected))
+            BOOST_ERROR("inverse cumulative normal on range "
+                        "differs from scalar value at " << x[i] << ":"
+                        << std::scientific
+                        << "\n    scalar: " << expected
+                        << "\n    range:  " << z[i]);
+    }
+}
+
 BOOST_AUTO_TEST_CASE(testBivariate) {
 
     BOOST_TEST_MESSAGE("Testing bivariate cumulative normal distribution...");
@@ -1292,6 +1292,167 @@ BOOST_AUTO_TEST_CASE(testQmcEngines) {
     testEngineConsistency(engine,steps,samples,relativeTol);
 }
 
+BOOST_AUTO_TEST_CASE(testRandomizedQmcEngineTolerance) {
+
+    BOOST_TEST_MESSAGE("Testing randomized Quasi Monte Carlo European engine "
+                       "with required tolerance...");
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+
+    ext::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    ext::shared_ptr<YieldTermStructure> qTS = flatRate(today, 0.03, dc);
+    ext::shared_ptr<YieldTermStructure> rTS = flatRate(today, 0.06, dc);
+    ext::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, 0.30, dc);
+
+    ext::shared_ptr<Exercise> exercise(new EuropeanExercise(today + 360));
+    ext::shared_ptr<StrikedTypePayoff> payoff(
+                                new PlainVanillaPayoff(Option::Call, 105.0));
+
+    ext::shared_ptr<VanillaOption> refOption =
+        makeOption(payoff, exercise, spot, qTS, rTS, volTS, Analytic,
+                   Null<Size>(), Null<Size>());
+    Real expected = refOption->NPV();
+
+    ext::shared_ptr<GeneralizedBlackScholesProcess> stochProcess =
+        makeProcess(spot, qTS, rTS, volTS);
+
+    Real tolerance = 0.005;
+    EuropeanOption option(payoff, exercise);
+    option.setPricingEngine(
+        MakeMCEuropeanEngine<RandomizedLowDiscrepancy>(stochProcess)
+            .withSteps(1)
+            .withAbsoluteTolerance(tolerance)
+            .withSeed(42));
+
+    Real calculated = option.NPV();
+    Real errorEstimate = option.errorEstimate();
+
+    if (errorEstimate > tolerance)
+        BOOST_ERROR("error estimate above required tolerance:"
+                    << "\n    error estimate: " << errorEstimate
+                    << "\n    tolerance:      " << tolerance);
+
+    if (std::fabs(calculated - expected) > 3.0*tolerance)
+        REPORT_FAILURE("value", payoff, exercise, spot->value(), 0.03, 0.06,
+                       today, 0.30, expected, calculated,
+                       std::fabs(calculated - expected), 3.0*tolerance);
+}
+
+BOOST_AUTO_TEST_CASE(testMcEngineGreeks) {
+
+    BOOST_TEST_MESSAGE("Testing Monte Carlo European engine Greeks...");
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+
+    ext::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    ext::shared_ptr<YieldTermStructure> qTS = flatRate(today, 0.03, dc);
+    ext::shared_ptr<YieldTermStructure> rTS = flatRate(today, 0.06, dc);
+    ext::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, 0.30, dc);
+
+    ext::shared_ptr<GeneralizedBlackScholesProcess> stochProcess =
+        makeProcess(spot, qTS, rTS, volTS);
+
+    ext::shared_ptr<Exercise> exercise(new EuropeanExercise(today + 360));
+
+    std::map<std::string,Real> tolerance;
+    tolerance["delta"] = 0.005;
+    tolerance["gamma"] = 0.0005;
+    tolerance["vega"] = 1.0;
+
+    Option::Type types[] = { Option::Call, Option::Put };
+    for (auto& type : types) {
+        ext::shared_ptr<StrikedTypePayoff> payoff(
+                                      new PlainVanillaPayoff(type, 105.0));
+
+        ext::shared_ptr<VanillaOption> refOption =
+            makeOption(payoff, exercise, spot, qTS, rTS, volTS, Analytic,
+                       Null<Size>(), Null<Size>());
+
+        EuropeanOption option(payoff, exercise);
+        option.setPricingEngine(
+            MakeMCEuropeanEngine<PseudoRandom>(stochProcess)
+                .withSteps(1)
+                .withAntitheticVariate()
+                .withSamples(100000)
+                .withSeed(42)
+                .withGreeks());
+
+        std::map<std::string,Real> calculated, expected;
+        calculated["delta"] = option.delta();
+        calculated["gamma"] = option.gamma();
+        calculated["vega"] = option.vega();
+        expected["delta"] = refOption->delta();
+        expected["gamma"] = refOption->gamma();
+        expected["vega"] = refOption->vega();
+
+        for (auto& it : calculated) {
+            const std::string& greek = it.first;
+            Real error = std::fabs(it.second - expected[greek]);
+            if (error > tolerance[greek])
+                REPORT_FAILURE(greek, payoff, exercise, spot->value(),
+                               0.03, 0.06, today, 0.30,
+                               expected[greek], it.second, error,
+                               tolerance[greek]);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testMcEngineDriftShift) {
+
+    BOOST_TEST_MESSAGE("Testing Monte Carlo European engine "
+                       "with importance sampling...");
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+
+    ext::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    ext::shared_ptr<YieldTermStructure> qTS = flatRate(today, 0.03, dc);
+    ext::shared_ptr<YieldTermStructure> rTS = flatRate(today, 0.06, dc);
+    ext::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, 0.20, dc);
+
+    ext::shared_ptr<GeneralizedBlackScholesProcess> stochProcess =
+        makeProcess(spot, qTS, rTS, volTS);
+
+    // deep out of the money
+    ext::shared_ptr<Exercise> exercise(new EuropeanExercise(today + 360));
+    ext::shared_ptr<StrikedTypePayoff> payoff(
+                                new PlainVanillaPayoff(Option::Call, 180.0));
+
+    ext::shared_ptr<VanillaOption> refOption =
+        makeOption(payoff, exercise, spot, qTS, rTS, volTS, Analytic,
+                   Null<Size>(), Null<Size>());
+    Real expected = refOption->NPV();
+
+    EuropeanOption option(payoff, exercise);
+    option.setPricingEngine(
+        MakeMCEuropeanEngine<PseudoRandom>(stochProcess)
+            .withSteps(1)
+            .withSamples(20000)
+            .withSeed(42));
+    Real plainError = option.errorEstimate();
+
+    option.setPricingEngine(
+        MakeMCEuropeanEngine<PseudoRandom>(stochProcess)
+            .withSteps(1)
+            .withSamples(20000)
+            .withSeed(42)
+            .withDriftShift(3.0));
+    Real calculated = option.NPV();
+    Real error = option.errorEstimate();
+
+    if (std::fabs(calculated - expected) > 3.0*error)
+        REPORT_FAILURE("value", payoff, exercise, spot->value(), 0.03, 0.06,
+                       today, 0.20, expected, calculated,
+                       std::fabs(calculated - expected), 3.0*error);
+
+    if (error > 0.2*plainError)
+        BOOST_ERROR("importance sampling doesn't reduce the error enough:"
+                    << "\n    plain Monte Carlo:   " << plainError
+                    << "\n    importance sampling: " << error);
+}
+
 BOOST_AUTO_TEST_CASE(testLocalVolatility) {
     BOOST_TEST_MESSAGE("Testing finite-differences with local volatility...");
 
@@ -1696,6 +1857,88 @@ BOOST_AUTO_TEST_CASE(testDouglasVsCrankNicolson) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testFdRichardsonExtrapolation) {
+    BOOST_TEST_MESSAGE("Testing Richardson extrapolation "
+                       "for finite-difference European PDE engines...");
+
+    const DayCounter dc = Actual365Fixed();
+    const Date today = Date(12, March, 2024);
+
+    Settings::instance().evaluationDate() = today;
+
+    const ext::shared_ptr<BlackScholesMertonProcess> process =
+        ext::make_shared<BlackScholesMertonProcess>(
+            Handle<Quote>(ext::make_shared<SimpleQuote>(100.0)),
+            Handle<YieldTermStructure>(flatRate(today, 0.02, dc)),
+            Handle<YieldTermStructure>(flatRate(today, 0.05, dc)),
+            Handle<BlackVolTermStructure>(flatVol(today, 0.25, dc)));
+
+    VanillaOption option(
+        ext::make_shared<PlainVanillaPayoff>(Option::Put, 105.0),
+        ext::make_shared<EuropeanExercise>(today + Period(1, Years)));
+
+    option.setPricingEngine(
+        ext::make_shared<AnalyticEuropeanEngine>(process));
+    const Real expected = option.NPV();
+
+    const Size nGrids[] = { 2, 3 };
+    const Real tol[] = { 2e-4, 2e-5 };
+    // plain grids with at least the total number of time steps
+    // times grid points of the nested 50x50, 100x100 (, 200x200) grids
+    const Size plainGrid[] = { 112, 230 };
+
+    for (Size i=0; i < std::size(nGrids); ++i) {
+        option.setPricingEngine(
+            MakeFdBlackScholesVanillaEngine(process)
+            .withTGrid(50)
+            .withXGrid(50)
+            .withRichardsonExtrapolation(nGrids[i]));
+
+        const Real calculated = option.NPV();
+        const Real errorEstimate = option.errorEstimate();
+        const Real diff = std::fabs(calculated - expected);
+
+        if (diff > tol[i] || errorEstimate == Null<Real>()
+            || diff > errorEstimate) {
+            BOOST_FAIL("Failed to reproduce European option value "
+                       "with Richardson extrapolation"
+                       << "\n    grids:          " << nGrids[i]
+                       << "\n    calculated:     " << calculated
+                       << "\n    expected:       " << expected
+                       << "\n    difference:     " << diff
+                       << "\n    error estimate: " << errorEstimate
+                       << "\n    tolerance:      " << tol[i]);
+        }
+
+        option.setPricingEngine(
+            MakeFdBlackScholesVanillaEngine(process)
+            .withTGrid(plainGrid[i])
+            .withXGrid(plainGrid[i])
+            .withDampingSteps(2));
+        const Real plainDiff = std::fabs(option.NPV() - expected);
+
+        if (diff > plainDiff) {
+            BOOST_FAIL("Richardson extrapolation less accurate than "
+                       "a plain grid of the same cost"
+                       << "\n    grids:          " << nGrids[i]
+                       << "\n    plain grid:     " << plainGrid[i]
+                       << "\n    difference:     " << diff
+                       << "\n    plain diff:     " << plainDiff);
+        }
+    }
+
+    // early exercise breaks the assumed order of convergence
+    VanillaOption americanOption(
+        ext::make_shared<PlainVanillaPayoff>(Option::Put, 105.0),
+        ext::make_shared<AmericanExercise>(today, today + Period(1, Years)));
+    americanOption.setPricingEngine(
+        MakeFdBlackScholesVanillaEngine(process)
+        .withTGrid(50)
+        .withXGrid(50)
+        .withRichardsonExtrapolation(2));
+    BOOST_CHECK_THROW(americanOption.NPV(), Error);
+}
+
 BOOST_AUTO_TEST_CASE(testFFTEngines) {
 
     BOOST_TEST_MESSAGE("Testing FFT European engines "
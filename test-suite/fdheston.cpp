@@ -612,6 +612,165 @@ BOOST_AUTO_TEST_CASE(testFdmHestonEuropeanWithDividends) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testFdmHestonRichardsonExtrapolation) {
+
+    BOOST_TEST_MESSAGE("Testing Richardson extrapolation of FDM Heston engine...");
+
+    const DayCounter dc = Actual365Fixed();
+    const Date today = Date(12, March, 2024);
+    Settings::instance().evaluationDate() = today;
+
+    const auto hestonProcess = ext::make_shared<HestonProcess>(
+        Handle<YieldTermStructure>(flatRate(today, 0.05, dc)),
+        Handle<YieldTermStructure>(flatRate(today, 0.02, dc)),
+        Handle<Quote>(ext::make_shared<SimpleQuote>(100.0)),
+        0.04, 1.5, 0.04, 0.5, -0.7);
+    const auto model = ext::make_shared<HestonModel>(hestonProcess);
+
+    VanillaOption option(
+        ext::make_shared<PlainVanillaPayoff>(Option::Put, 105.0),
+        ext::make_shared<EuropeanExercise>(today + Period(1, Years)));
+
+    option.setPricingEngine(ext::make_shared<AnalyticHestonEngine>(model));
+    const Real expected = option.NPV();
+
+    option.setPricingEngine(
+        MakeFdHestonVanillaEngine(model)
+        .withTGrid(20)
+        .withXGrid(40)
+        .withVGrid(20)
+        .withRichardsonExtrapolation(3));
+
+    const Real calculated = option.NPV();
+    const Real errorEstimate = option.errorEstimate();
+
+    const Real tol = 1e-4;
+    const Real diff = std::fabs(calculated - expected);
+    if (diff > tol || errorEstimate == Null<Real>() || errorEstimate > tol) {
+        BOOST_FAIL("Failed to reproduce Heston option value "
+                   "with Richardson extrapolation"
+                   << "\n    calculated:     " << calculated
+                   << "\n    expected:       " << expected
+                   << "\n    difference:     " << diff
+                   << "\n    error estimate: " << errorEstimate
+                   << "\n    tolerance:      " << tol);
+    }
+
+    // plain grid with at least the total number of time steps times
+    // grid points of the three nested grids, 73 times the base grid
+    option.setPricingEngine(
+        MakeFdHestonVanillaEngine(model)
+        .withTGrid(84)
+        .withXGrid(168)
+        .withVGrid(84)
+        .withDampingSteps(2));
+    const Real plainDiff = std::fabs(option.NPV() - expected);
+
+    if (diff > plainDiff) {
+        BOOST_FAIL("Richardson extrapolation less accurate than "
+                   "a plain grid of the same cost"
+                   << "\n    difference:     " << diff
+                   << "\n    plain diff:     " << plainDiff);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testFdmHestonSnapshots) {
+
+    BOOST_TEST_MESSAGE("Testing retained value grids of FDM Heston engine...");
+
+    const DayCounter dc = Actual365Fixed();
+    const Date today = Date(12, March, 2024);
+    Settings::instance().evaluationDate() = today;
+
+    const auto model = ext::make_shared<HestonModel>(
+        ext::make_shared<HestonProcess>(
+            Handle<YieldTermStructure>(flatRate(0.05, dc)),
+            Handle<YieldTermStructure>(flatRate(0.02, dc)),
+            Handle<Quote>(ext::make_shared<SimpleQuote>(100.0)),
+            0.04, 1.5, 0.04, 0.5, -0.7));
+
+    VanillaOption option(
+        ext::make_shared<PlainVanillaPayoff>(Option::Put, 105.0),
+        ext::make_shared<EuropeanExercise>(today + Period(1, Years)));
+
+    const Date rollDate = today + Period(1, Weeks);
+    option.setPricingEngine(
+        MakeFdHestonVanillaEngine(model)
+        .withTGrid(50)
+        .withXGrid(100)
+        .withVGrid(40)
+        .withSnapshots({ dc.yearFraction(today, rollDate) }));
+
+    const Real calculated =
+        option.result<std::vector<Real> >("snapshotValues").front();
+
+    option.setPricingEngine(
+        MakeFdHestonVanillaEngine(model)
+        .withTGrid(50)
+        .withXGrid(100)
+        .withVGrid(40));
+
+    Settings::instance().evaluationDate() = rollDate;
+    const Real expected = option.NPV();
+    Settings::instance().evaluationDate() = today;
+
+    const Real tol = 5e-3;
+    const Real diff = std::fabs(calculated - expected);
+    if (diff > tol) {
+        BOOST_FAIL("Failed to reproduce rolled Heston option value "
+                   "from retained value grid"
+                   << "\n    calculated: " << calculated
+                   << "\n    expected:   " << expected
+                   << "\n    difference: " << diff
+                   << "\n    tolerance:  " << tol);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testFdmHestonSparseImplicitScheme) {
+
+    BOOST_TEST_MESSAGE("Testing sparse implicit scheme with ILU(0) "
+                       "preconditioning for FDM Heston engine...");
+
+    const DayCounter dc = Actual365Fixed();
+    const Date today = Date(12, March, 2024);
+    Settings::instance().evaluationDate() = today;
+
+    const auto model = ext::make_shared<HestonModel>(
+        ext::make_shared<HestonProcess>(
+            Handle<YieldTermStructure>(flatRate(today, 0.05, dc)),
+            Handle<YieldTermStructure>(flatRate(today, 0.02, dc)),
+            Handle<Quote>(ext::make_shared<SimpleQuote>(100.0)),
+            0.04, 1.5, 0.04, 0.5, -0.7));
+
+    VanillaOption option(
+        ext::make_shared<PlainVanillaPayoff>(Option::Put, 105.0),
+        ext::make_shared<EuropeanExercise>(today + Period(1, Years)));
+
+    option.setPricingEngine(ext::make_shared<AnalyticHestonEngine>(model));
+    const Real expected = option.NPV();
+
+    option.setPricingEngine(
+        MakeFdHestonVanillaEngine(model)
+        .withTGrid(25)
+        .withXGrid(60)
+        .withVGrid(30)
+        .withDampingSteps(2)
+        .withFdmSchemeDesc(FdmSchemeDesc::SparseImplicit(0.5)));
+
+    const Real calculated = option.NPV();
+
+    const Real tol = 0.01;
+    const Real diff = std::fabs(calculated - expected);
+    if (diff > tol) {
+        BOOST_FAIL("Failed to reproduce Heston option value "
+                   "with the sparse implicit scheme"
+                   << "\n    calculated: " << calculated
+                   << "\n    expected:   " << expected
+                   << "\n    difference: " << diff
+                   << "\n    tolerance:  " << tol);
+    }
+}
+
 BOOST_AUTO_TEST_CASE(testFdmHestonConvergence, *precondition(if_speed(Fast))) {
 
     /* convergence tests based on 
@@ -27,7 +27,9 @@
 #include <ql/math/interpolations/bilinearinterpolation.hpp>
 #include <ql/math/interpolations/cubicinterpolation.hpp>
 #include <ql/math/matrixutilities/bicgstab.hpp>
+#include <ql/math/matrixutilities/csrmatrix.hpp>
 #include <ql/math/matrixutilities/gmres.hpp>
+#include <ql/math/matrixutilities/sparseilu0preconditioner.hpp>
 #include <ql/math/matrixutilities/sparseilupreconditioner.hpp>
 #include <ql/math/randomnumbers/rngtraits.hpp>
 #include <ql/methods/finitedifferences/finitedifferencemodel.hpp>
@@ -330,6 +332,43 @@ BOOST_AUTO_TEST_CASE(testFdmLinearOpLayout) {
             }
         }
     }
+
+    std::vector<Size> neighbours(layout.size());
+    for (Size i=0; i < dim.size(); ++i) {
+        for (Integer offset : {-2, -1, 1, 3}) {
+            layout.neighbourhoods(i, offset, &neighbours[0]);
+            for (const auto& iter : layout) {
+                const Size expected = layout.neighbourhood(iter, i, offset);
+                if (neighbours[iter.index()] != expected) {
+                    BOOST_FAIL("stride-based neighbourhood index is "
+                               << neighbours[iter.index()]
+                               << " but should be " << expected);
+                }
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testFdmMesherCompositeLocations) {
+
+    BOOST_TEST_MESSAGE("Testing locations of a composite mesher...");
+
+    const FdmMesherComposite mesher(
+        ext::make_shared<Uniform1dMesher>(-1.0, 1.0, 5),
+        ext::make_shared<Concentrating1dMesher>(0.0, 2.0, 7,
+            std::make_pair(0.5, 0.1)),
+        ext::make_shared<Uniform1dMesher>(3.0, 4.0, 4));
+
+    for (Size i=0; i < 3; ++i) {
+        const Array locations = mesher.locations(i);
+        for (const auto& iter : *mesher.layout()) {
+            const Real expected = mesher.location(iter, i);
+            if (locations[iter.index()] != expected) {
+                BOOST_FAIL("location is " << locations[iter.index()]
+                           << " but should be " << expected);
+            }
+        }
+    }
 }
 
 BOOST_AUTO_TEST_CASE(testUniformGridMesher) {
@@ -833,6 +872,106 @@ BOOST_AUTO_TEST_CASE(testTripleBandMapSolve) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testTripleBandMapSolveOnThreeDimensionalGrid) {
+
+    BOOST_TEST_MESSAGE("Testing triple-band map solution on a 3D grid...");
+
+    // the inner dimension exceeds the number of lines swept together
+    const std::vector<Size> dim = {5, 70, 9};
+
+    ext::shared_ptr<FdmLinearOpLayout> layout(new FdmLinearOpLayout(dim));
+
+    std::vector<std::pair<Real, Real> > boundaries = {
+        {0, 1.0}, {0, 2.0}, {-1.0, 1.0}};
+
+    ext::shared_ptr<FdmMesher> mesher(
+        new UniformGridMesher(layout, boundaries));
+
+    Array u(layout->size());
+    for (Size i=0; i < layout->size(); ++i)
+        u[i] = std::sin(0.1*i)+std::cos(0.35*i);
+
+    for (Size direction=0; direction < dim.size(); ++direction) {
+        SecondDerivativeOp op(direction, mesher);
+        op.axpyb(Array(1, 0.5), FirstDerivativeOp(direction, mesher), op,
+                 Array(1, 1.0));
+
+        Array t = op.apply(u);
+        op.solve_splitting_into(t, 1.0, 0.0, t);
+
+        for (Size i=0; i < u.size(); ++i) {
+            if (std::fabs(u[i] - t[i]) > 1e-8) {
+                BOOST_FAIL("solve and apply are not consistent "
+                    << "\n direction     : " << direction
+                    << "\n expected      : " << u[i]
+                    << "\n calculated    : " << t[i]);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testInPlaceOperatorInterface) {
+
+    BOOST_TEST_MESSAGE("Testing in-place operator interface...");
+
+    const std::vector<Size> dim = {50, 20};
+
+    ext::shared_ptr<FdmLinearOpLayout> layout(new FdmLinearOpLayout(dim));
+
+    std::vector<std::pair<Real, Real> > boundaries = {{3.8, 4.9}, {0.0, 1.0}};
+
+    ext::shared_ptr<FdmMesher> mesher(
+        new UniformGridMesher(layout, boundaries));
+
+    Handle<Quote> s0(ext::shared_ptr<Quote>(new SimpleQuote(100.0)));
+    Handle<YieldTermStructure> rTS(flatRate(0.05, Actual365Fixed()));
+    Handle<YieldTermStructure> qTS(flatRate(0.02, Actual365Fixed()));
+
+    FdmHestonOp hestonOp(mesher, ext::make_shared<HestonProcess>(
+        rTS, qTS, s0, 0.04, 2.5, 0.04, 0.66, -0.8));
+    hestonOp.setTime(0.5, 0.6);
+
+    Array u(layout->size());
+    for (Size i=0; i < layout->size(); ++i)
+        u[i] = std::sin(0.1*i)+std::cos(0.35*i);
+
+    const auto check = [&](const Array& expected, const Array& calculated,
+                           const std::string& method) {
+        BOOST_REQUIRE(expected.size() == calculated.size());
+        for (Size i=0; i < expected.size(); ++i) {
+            if (std::fabs(expected[i] - calculated[i])
+                    > 1e-12*std::max(1.0, std::fabs(expected[i]))) {
+                BOOST_FAIL(method << " differs from allocating version"
+                           << "\n index         : " << i
+                           << "\n expected      : " << expected[i]
+                           << "\n calculated    : " << calculated[i]);
+            }
+        }
+    };
+
+    Array out;
+    hestonOp.apply_into(u, out);
+    check(hestonOp.apply(u), out, "apply_into");
+
+    hestonOp.apply_mixed_into(u, out);
+    check(hestonOp.apply_mixed(u), out, "apply_mixed_into");
+
+    for (Size direction=0; direction < dim.size(); ++direction) {
+        hestonOp.apply_direction_into(direction, u, out);
+        check(hestonOp.apply_direction(direction, u), out,
+              "apply_direction_into");
+
+        const Array expected = hestonOp.solve_splitting(direction, u, 0.1);
+        hestonOp.solve_splitting_into(direction, u, 0.1, out);
+        check(expected, out, "solve_splitting_into");
+
+        // the result may overwrite the right-hand side
+        Array v(u);
+        hestonOp.solve_splitting_into(direction, v, 0.1, v);
+        check(expected, v, "aliased solve_splitting_into");
+    }
+}
+
 BOOST_AUTO_TEST_CASE(testFdmHestonBarrier) {
 
     BOOST_TEST_MESSAGE("Testing FDM with barrier option in Heston model...");
@@ -1289,6 +1428,180 @@ BOOST_AUTO_TEST_CASE(testGMRES) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testSparseILU0Preconditioner) {
+    BOOST_TEST_MESSAGE("Testing ILU(0) preconditioner for sparse FDM matrices...");
+
+    Handle<Quote> s0(ext::make_shared<SimpleQuote>(100.0));
+    Handle<YieldTermStructure> rTS(flatRate(0.05, Actual365Fixed()));
+    Handle<YieldTermStructure> qTS(flatRate(0.02, Actual365Fixed()));
+
+    const ext::shared_ptr<HestonProcess> hestonProcess =
+        ext::make_shared<HestonProcess>(rTS, qTS, s0, 0.04, 2.5, 0.04, 0.66, -0.8);
+
+    const std::vector<Size> dim = {60, 30};
+    const std::vector<std::pair<Real, Real> > boundaries
+        = {{3.8, std::log(220.0)}, {0.0, 1.0}};
+    const ext::shared_ptr<FdmMesher> mesher =
+        ext::make_shared<UniformGridMesher>(
+            ext::make_shared<FdmLinearOpLayout>(dim), boundaries);
+
+    const Time dt = 0.05;
+    MersenneTwisterUniformRng rng(1234);
+
+    // one-dimensional operator: ILU(0) is the exact LU decomposition
+    FdmBlackScholesOp bsOp(
+        ext::make_shared<FdmMesherComposite>(
+            ext::make_shared<Uniform1dMesher>(3.8, std::log(220.0), 100)),
+        ext::make_shared<BlackScholesMertonProcess>(
+            s0, qTS, rTS,
+            Handle<BlackVolTermStructure>(flatVol(0.25, Actual365Fixed()))),
+        100.0);
+    bsOp.setTime(0.5, 0.5+dt);
+
+    SparseMatrix a = bsOp.toMatrix();
+    a *= -dt;
+    for (Size i=0; i < a.size1(); ++i)
+        a(i, i) += 1.0;
+
+    Array b(a.size1());
+    for (Real& i : b)
+        i = rng.next().value;
+
+    const Array x = SparseILU0Preconditioner(a).apply(b);
+    const Real exactError = Norm2(prod(a, x) - b)/Norm2(b);
+    if (exactError > 1e-12) {
+        BOOST_FAIL("failed to solve tridiagonal system with ILU(0)"
+                   << "\n    error:     " << exactError
+                   << "\n    tolerance: " << 1e-12);
+    }
+
+    // two-dimensional operator with mixed derivatives
+    FdmHestonOp hestonOp(mesher, hestonProcess);
+    hestonOp.setTime(0.5, 0.5+dt);
+
+    SparseMatrix m = hestonOp.toMatrix();
+    m *= -dt;
+    for (Size i=0; i < m.size1(); ++i)
+        m(i, i) += 1.0;
+
+    Array c(m.size1());
+    for (Real& i : c)
+        i = rng.next().value;
+
+    const SparseILU0Preconditioner ilu(m);
+    const Real tol = 1e-10;
+
+    const BiCGStabResult iluResult = BiCGstab(
+        [&](const Array& _x) { return prod(m, _x); }, m.size1(), tol,
+        [&](const Array& _x) { return ilu.apply(_x); }).solve(c);
+
+    const BiCGStabResult splittingResult = BiCGstab(
+        [&](const Array& _x) { return prod(m, _x); }, m.size1(), tol,
+        [&](const Array& _x) { return hestonOp.preconditioner(_x, -dt); })
+        .solve(c);
+
+    const Real iluError = Norm2(prod(m, iluResult.x) - c)/Norm2(c);
+    if (iluError > tol) {
+        BOOST_FAIL("failed to solve Heston system with ILU(0) preconditioning"
+                   << "\n    error:     " << iluError
+                   << "\n    tolerance: " << tol);
+    }
+    if (iluResult.iterations > splittingResult.iterations) {
+        BOOST_FAIL("ILU(0) preconditioning needs more iterations than "
+                   "operator splitting"
+                   << "\n    ILU(0):    " << iluResult.iterations
+                   << "\n    splitting: " << splittingResult.iterations);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testCsrMatrix) {
+    BOOST_TEST_MESSAGE("Testing compressed-row sparse matrices...");
+
+    // unsorted triplets with duplicates
+    CsrMatrix::Builder builder(3, 3);
+    builder.add(2, 0, 1.0);
+    builder.add(0, 1, 2.0);
+    builder.add(0, 1, 3.0);
+    builder.add(1, 1, 4.0);
+    builder.add(0, 0, 5.0);
+    const CsrMatrix a = builder.build();
+
+    if (a.nonZeros() != 4 || a(0, 0) != 5.0 || a(0, 1) != 5.0
+        || a(1, 1) != 4.0 || a(2, 0) != 1.0 || a(2, 2) != 0.0) {
+        BOOST_FAIL("failed to assemble compressed-row matrix from triplets");
+    }
+
+    // the diagonal of the third row is not part of the pattern
+    CsrMatrix d(a);
+    d.addToDiagonal(1.0);
+    if (d.nonZeros() != 5 || d(0, 0) != 6.0 || d(1, 1) != 5.0
+        || d(2, 2) != 1.0 || d(2, 0) != 1.0) {
+        BOOST_FAIL("failed to add to the diagonal of a compressed-row matrix");
+    }
+
+    Handle<Quote> s0(ext::make_shared<SimpleQuote>(100.0));
+    Handle<YieldTermStructure> rTS(flatRate(0.05, Actual365Fixed()));
+    Handle<YieldTermStructure> qTS(flatRate(0.02, Actual365Fixed()));
+
+    const ext::shared_ptr<FdmMesher> mesher =
+        ext::make_shared<UniformGridMesher>(
+            ext::make_shared<FdmLinearOpLayout>(std::vector<Size>{40, 20}),
+            std::vector<std::pair<Real, Real> >{
+                {3.8, std::log(220.0)}, {0.0, 1.0}});
+
+    FdmHestonOp hestonOp(mesher, ext::make_shared<HestonProcess>(
+        rTS, qTS, s0, 0.04, 2.5, 0.04, 0.66, -0.8));
+    hestonOp.setTime(0.5, 0.6);
+
+    const CsrMatrix m = hestonOp.toCsrMatrix();
+
+    // ublas assembly of the same operator
+    const std::vector<SparseMatrix> dcmp = hestonOp.toMatrixDecomp();
+    SparseMatrix ref(dcmp.front());
+    for (Size i=1; i < dcmp.size(); ++i)
+        ref = ref + dcmp[i];
+
+    MersenneTwisterUniformRng rng(1234);
+    Array x(m.columns()), y(m.rows());
+    for (Real& i : x)
+        i = rng.next().value;
+    for (Real& i : y)
+        i = rng.next().value;
+
+    const Real tol = 1e-10;
+    const Array mx = prod(m, x);
+    const Real scale = Norm2(mx);
+
+    const Real applyError = Norm2(mx - hestonOp.apply(x))/scale;
+    const Real ublasError = Norm2(mx - prod(ref, x))/scale;
+    const Real convError = Norm2(prod(CsrMatrix(ref), x)
+                                 - prod(m.toSparseMatrix(), x))/scale;
+    if (applyError > tol || ublasError > tol || convError > tol) {
+        BOOST_FAIL("compressed-row matrix differs from operator"
+                   << "\n    apply error:      " << applyError
+                   << "\n    ublas error:      " << ublasError
+                   << "\n    conversion error: " << convError
+                   << "\n    tolerance:        " << tol);
+    }
+
+    const Real transposeError =
+        std::fabs(DotProduct(y, mx) - DotProduct(prod(m.transpose(), y), x))
+        / std::fabs(DotProduct(y, mx));
+    if (transposeError > tol) {
+        BOOST_FAIL("failed to transpose compressed-row matrix"
+                   << "\n    error:     " << transposeError
+                   << "\n    tolerance: " << tol);
+    }
+
+    const Array shifted = prod(m + 2.0*CsrMatrix::identity(m.rows()), x);
+    const Real sumError = Norm2(shifted - mx - 2.0*x)/scale;
+    if (sumError > tol) {
+        BOOST_FAIL("failed to add compressed-row matrices"
+                   << "\n    error:     " << sumError
+                   << "\n    tolerance: " << tol);
+    }
+}
+
 BOOST_AUTO_TEST_CASE(testCrankNicolsonWithDamping) {
 
     BOOST_TEST_MESSAGE("Testing Crank-Nicolson with initial implicit damping steps "
@@ -289,6 +289,64 @@ BOOST_AUTO_TEST_CASE(testGsrModel) {
                     << GsrJamNpv << ")");
 }
 
+BOOST_AUTO_TEST_CASE(testGsrModelOnStateArrays) {
+
+    BOOST_TEST_MESSAGE("Testing GSR model functions on arrays of states...");
+
+    Date refDate = Settings::instance().evaluationDate();
+
+    std::vector<Date> stepDates;
+    for (Size i = 1; i < 20; i++)
+        stepDates.push_back(refDate + (i * 6 * Months));
+    std::vector<Real> vols(stepDates.size() + 1), reversions(stepDates.size() + 1);
+    for (Size i = 0; i < vols.size(); i++) {
+        vols[i] = 0.008 + 0.0002 * i;
+        reversions[i] = 0.01 + 0.001 * i;
+    }
+
+    Handle<YieldTermStructure> yts(ext::shared_ptr<YieldTermStructure>(
+        new FlatForward(0, TARGET(), 0.03, Actual365Fixed())));
+    Handle<YieldTermStructure> discountCurve(ext::shared_ptr<YieldTermStructure>(
+        new FlatForward(0, TARGET(), 0.025, Actual365Fixed())));
+    ext::shared_ptr<Gsr> model(
+        new Gsr(yts, stepDates, vols, reversions, 50.0));
+    ext::shared_ptr<IborIndex> iborIndex(new Euribor6M(yts));
+
+    Array y = model->yGrid(7.0, 16);
+    Real tol = 1E-14;
+
+    for (Size i = 0; i < 6; i++) {
+        Date referenceDate = TARGET().advance(refDate, (3 * i) * Years);
+        Time t = yts->timeFromReference(referenceDate);
+        Date fixing = TARGET().advance(refDate, (3 * i + 2) * Years);
+        Date maturity = TARGET().advance(refDate, (3 * i + 5) * Years);
+        Time T = yts->timeFromReference(maturity);
+
+        Array zerobonds = model->zerobond(T, t, y);
+        Array discountedZerobonds = model->zerobond(T, t, y, discountCurve);
+        Array numeraires = model->numeraire(t, y, discountCurve);
+        Array forwards = model->forwardRate(fixing, referenceDate, y, iborIndex);
+
+        for (Size j = 0; j < y.size(); j++) {
+            Real expected[] = {
+                model->zerobond(T, t, y[j]),
+                model->zerobond(T, t, y[j], discountCurve),
+                model->numeraire(t, y[j], discountCurve),
+                model->forwardRate(fixing, referenceDate, y[j], iborIndex)};
+            Real calculated[] = {zerobonds[j], discountedZerobonds[j],
+                                 numeraires[j], forwards[j]};
+            for (Size k = 0; k < 4; k++) {
+                if (fabs(calculated[k] - expected[k]) > tol * fabs(expected[k]))
+                    BOOST_ERROR("model function " << k << " on state array ("
+                                << calculated[k]
+                                << ") differs from scalar value ("
+                                << expected[k] << ") at t=" << t
+                                << ", y=" << y[j]);
+            }
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -47,6 +47,7 @@
 #include <ql/pricingengines/vanilla/fdhestonvanillaengine.hpp>
 #include <ql/pricingengines/vanilla/hestonexpansionengine.hpp>
 #include <ql/pricingengines/vanilla/mceuropeanhestonengine.hpp>
+#include <ql/pricingengines/vanilla/mlmceuropeanhestonengine.hpp>
 #include <ql/processes/hestonprocess.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <ql/termstructures/volatility/equityfx/hestonblackvolsurface.hpp>
@@ -370,6 +371,172 @@ BOOST_AUTO_TEST_CASE(testDAXCalibration) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testDAXCalibrationWithAnalyticGradient) {
+
+    BOOST_TEST_MESSAGE(
+             "Testing Heston model calibration with analytic parameter "
+             "gradients using DAX volatility data...");
+
+    Date settlementDate(5, July, 2002);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    CalibrationMarketData marketData = getDAXCalibrationMarketData();
+
+    const std::vector<ext::shared_ptr<CalibrationHelper> >& options = marketData.options;
+
+    const ext::shared_ptr<HestonModel> model(
+        ext::make_shared<HestonModel>(ext::make_shared<HestonProcess>(
+            marketData.riskFreeTS, marketData.dividendYield, marketData.s0,
+            0.1, 1.0, 0.1, 0.5, -0.5)));
+
+    const ext::shared_ptr<AnalyticHestonEngine> engine(
+        ext::make_shared<AnalyticHestonEngine>(model, 64));
+    engine->enableModelParameterGradient();
+
+    for (const auto& option : options)
+        ext::dynamic_pointer_cast<BlackCalibrationHelper>(option)->setPricingEngine(engine);
+
+    // compare the gradients with finite differences
+    const Real h = 1e-6, tolerance = 1e-4;
+    for (Size i = 0; i < options.size(); i += 13) {
+        const auto helper =
+            ext::dynamic_pointer_cast<BlackCalibrationHelper>(options[i]);
+        Array gradient;
+        helper->modelValueAndGradient(gradient);
+        BOOST_REQUIRE(gradient.size() == 5);
+
+        for (Size j = 0; j < 5; ++j) {
+            Array params = model->params();
+            params[j] += h;
+            model->setParams(params);
+            const Real up = helper->modelValue();
+            params[j] -= 2*h;
+            model->setParams(params);
+            const Real down = helper->modelValue();
+            params[j] += h;
+            model->setParams(params);
+
+            const Real fd = (up - down)/(2*h);
+            if (std::fabs(gradient[j] - fd) > tolerance*std::max(1.0, std::fabs(fd))) {
+                BOOST_ERROR("Failed to reproduce finite-difference gradient"
+                            << "\n    option:     " << i
+                            << "\n    parameter:  " << j
+                            << "\n    calculated: " << gradient[j]
+                            << "\n    expected:   " << fd);
+            }
+        }
+    }
+
+    LevenbergMarquardt om(1e-8, 1e-8, 1e-8, true);
+    model->calibrate(options, om,
+                     EndCriteria(400, 40, 1.0e-8, 1.0e-8, 1.0e-8));
+
+    Real sse = 0;
+    for (Size i = 0; i < 13*8; ++i) {
+        const Real diff = options[i]->calibrationError()*100.0;
+        sse += diff*diff;
+    }
+    Real expected = 177.2; //see article by A. Sepp.
+    if (std::fabs(sse - expected) > 1.0) {
+        BOOST_FAIL("Failed to reproduce calibration error"
+                   << "\n    calculated: " << sse
+                   << "\n    expected:   " << expected);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testCharacteristicFunctionCache) {
+
+    BOOST_TEST_MESSAGE(
+             "Testing cached characteristic function of the analytic "
+             "Heston engine using DAX volatility data...");
+
+    Date settlementDate(5, July, 2002);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    CalibrationMarketData marketData = getDAXCalibrationMarketData();
+
+    const std::vector<ext::shared_ptr<CalibrationHelper> >& options = marketData.options;
+
+    const ext::shared_ptr<HestonModel> model(
+        ext::make_shared<HestonModel>(ext::make_shared<HestonProcess>(
+            marketData.riskFreeTS, marketData.dividendYield, marketData.s0,
+            0.1, 1.0, 0.1, 0.5, -0.5)));
+
+    const auto modelValues = [&](const ext::shared_ptr<PricingEngine>& engine) {
+        std::vector<Real> values;
+        for (const auto& option : options) {
+            const auto helper =
+                ext::dynamic_pointer_cast<BlackCalibrationHelper>(option);
+            helper->setPricingEngine(engine);
+            values.push_back(helper->modelValue());
+        }
+        return values;
+    };
+
+    const auto makeEngines = [&](AnalyticHestonEngine::ComplexLogFormula cpxLog) {
+        std::vector<ext::shared_ptr<AnalyticHestonEngine> > engines;
+        for (Size i = 0; i < 2; ++i)
+            engines.push_back(ext::make_shared<AnalyticHestonEngine>(
+                model, cpxLog,
+                AnalyticHestonEngine::Integration::gaussLaguerre(128)));
+        engines[1]->enableCharacteristicFunctionCache();
+        return engines;
+    };
+
+    const AnalyticHestonEngine::ComplexLogFormula cpxLogs[] = {
+        AnalyticHestonEngine::Gatheral,
+        AnalyticHestonEngine::AndersenPiterbarg
+    };
+
+    for (auto cpxLog : cpxLogs) {
+        const auto engines = makeEngines(cpxLog);
+
+        // the second set of parameters checks that the cache is
+        // invalidated when the model changes
+        for (Real vol : { 0.5, 0.3 }) {
+            model->setParams({0.1, 1.0, vol, -0.5, 0.1});
+
+            const std::vector<Real> expected = modelValues(engines[0]);
+            const std::vector<Real> calculated = modelValues(engines[1]);
+
+            for (Size i = 0; i < options.size(); ++i) {
+                if (std::fabs(calculated[i] - expected[i]) > 1e-12) {
+                    BOOST_ERROR("Failed to reproduce uncached option value"
+                                << "\n    complex log: " << cpxLog
+                                << "\n    option:      " << i
+                                << std::setprecision(16)
+                                << "\n    calculated:  " << calculated[i]
+                                << "\n    expected:    " << expected[i]);
+                }
+            }
+        }
+    }
+
+    model->setParams({0.1, 1.0, 0.5, -0.5, 0.1});
+    const ext::shared_ptr<AnalyticHestonEngine> engine(
+        ext::make_shared<AnalyticHestonEngine>(model, 64));
+    engine->enableCharacteristicFunctionCache();
+
+    for (const auto& option : options)
+        ext::dynamic_pointer_cast<BlackCalibrationHelper>(option)->setPricingEngine(engine);
+
+    LevenbergMarquardt om(1e-8, 1e-8, 1e-8);
+    model->calibrate(options, om,
+                     EndCriteria(400, 40, 1.0e-8, 1.0e-8, 1.0e-8));
+
+    Real sse = 0;
+    for (Size i = 0; i < 13*8; ++i) {
+        const Real diff = options[i]->calibrationError()*100.0;
+        sse += diff*diff;
+    }
+    Real expected = 177.2; //see article by A. Sepp.
+    if (std::fabs(sse - expected) > 1.0) {
+        BOOST_FAIL("Failed to reproduce calibration error"
+                   << "\n    calculated: " << sse
+                   << "\n    expected:   " << expected);
+    }
+}
+
 BOOST_AUTO_TEST_CASE(testAnalyticVsBlack) {
     BOOST_TEST_MESSAGE("Testing analytic Heston engine against Black formula...");
 
@@ -589,6 +756,61 @@ BOOST_AUTO_TEST_CASE(testMcVsCached) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testMultiLevelMcVsAnalytic) {
+    BOOST_TEST_MESSAGE(
+        "Testing multi-level Monte Carlo Heston engine against analytic values...");
+
+    Date settlementDate(27, December, 2004);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    DayCounter dayCounter = Actual365Fixed();
+    Date exerciseDate = settlementDate + Period(1, Years);
+
+    ext::shared_ptr<StrikedTypePayoff> payoff(
+        ext::make_shared<PlainVanillaPayoff>(Option::Call, 100.0));
+    ext::shared_ptr<Exercise> exercise(
+        ext::make_shared<EuropeanExercise>(exerciseDate));
+
+    Handle<YieldTermStructure> riskFreeTS(flatRate(0.03, dayCounter));
+    Handle<YieldTermStructure> dividendTS(flatRate(0.01, dayCounter));
+
+    Handle<Quote> s0(ext::make_shared<SimpleQuote>(100.0));
+
+    // the Euler scheme has a noticeable bias on coarse grids
+    ext::shared_ptr<HestonProcess> process(
+        ext::make_shared<HestonProcess>(
+                   riskFreeTS, dividendTS, s0, 0.04, 1.5, 0.04, 0.5, -0.7,
+                   HestonProcess::FullTruncation));
+
+    VanillaOption option(payoff, exercise);
+
+    option.setPricingEngine(ext::make_shared<AnalyticHestonEngine>(
+        ext::make_shared<HestonModel>(process)));
+    const Real expected = option.NPV();
+
+    const Real tolerance = 0.05;
+    option.setPricingEngine(
+        MakeMLMCEuropeanHestonEngine<PseudoRandom>(process)
+        .withSteps(2)
+        .withAbsoluteTolerance(tolerance)
+        .withSeed(1234));
+
+    const Real calculated = option.NPV();
+    const auto levels = option.result<Size>("levels");
+
+    if (std::fabs(calculated - expected) > 3.0*tolerance) {
+        BOOST_ERROR("Failed to reproduce analytic price"
+                    << "\n    calculated: " << calculated
+                    << "\n    expected:   " << expected
+                    << "\n    tolerance:  " << tolerance);
+    }
+
+    if (levels < 3) {
+        BOOST_ERROR("failed to refine the coarse discretization"
+                    << "\n    levels: " << levels);
+    }
+}
+
 BOOST_AUTO_TEST_CASE(testFdBarrierVsCached, *precondition(if_speed(Fast))) {
     BOOST_TEST_MESSAGE("Testing FD barrier Heston engine against cached values...");
 
@@ -26,6 +26,7 @@
 #include <ql/math/randomnumbers/burley2020sobolrsg.hpp>
 #include <ql/math/randomnumbers/faurersg.hpp>
 #include <ql/math/randomnumbers/haltonrsg.hpp>
+#include <ql/math/randomnumbers/inversecumulativersg.hpp>
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
 #include <ql/math/randomnumbers/seedgenerator.hpp>
 #include <ql/math/randomnumbers/primitivepolynomials.hpp>
@@ -1068,6 +1069,76 @@ BOOST_AUTO_TEST_CASE(testSobolSkipping) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testSobolBlockGeneration) {
+
+    BOOST_TEST_MESSAGE("Testing Sobol sequence generation in blocks...");
+
+    Size dimensionality[] = { 1, 10, 100, 1000 };
+    Size blocks[] = { 1, 7, 64 };
+
+    for (Size d : dimensionality) {
+        SobolRsg rsg1(d, 42, SobolRsg::JoeKuoD7);
+        SobolRsg rsg2(d, 42, SobolRsg::JoeKuoD7);
+        SobolRsg rsg3(d, 42, SobolRsg::JoeKuoD7);
+        SobolRsg rsg4(d, 42, SobolRsg::JoeKuoD7);
+
+        for (Size k : blocks) {
+            std::vector<std::uint32_t> ints(k*d);
+            std::vector<Real> points(k*d);
+            rsg2.nextInt32Sequences(k, ints.data());
+            rsg3.nextSequences(k, points.data());
+
+            for (Size i = 0; i < k; ++i) {
+                const std::vector<std::uint32_t>& s = rsg1.nextInt32Sequence();
+                const std::vector<Real>& p = rsg4.nextSequence().value;
+                for (Size n = 0; n < d; n++) {
+                    if (s[n] != ints[i*d+n] || p[n] != points[i*d+n])
+                        BOOST_FAIL("Mismatch in block generation:"
+                                   << "\n  size:     " << d
+                                   << "\n  block:    " << k
+                                   << "\n  point:    " << i
+                                   << "\n  at index: " << n);
+                }
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testSobolBlockInverseCumulative) {
+
+    BOOST_TEST_MESSAGE("Testing inverse-cumulative Sobol sequences "
+                       "drawn in blocks...");
+
+    // the generator draws a block of points at a time; the returned
+    // sequences must be the same as if drawn one by one, also across
+    // block boundaries
+    Size dimensionality[] = { 1, 10, 1000, 5000 };
+    const Size points = 300;
+    InverseCumulativeNormal icn;
+
+    for (Size d : dimensionality) {
+        SobolRsg rsg(d, 42, SobolRsg::JoeKuoD7);
+        InverseCumulativeRsg<SobolRsg, InverseCumulativeNormal> gaussian(
+            SobolRsg(d, 42, SobolRsg::JoeKuoD7));
+
+        for (Size i = 0; i < points; ++i) {
+            const SobolRsg::sample_type& u = rsg.nextSequence();
+            const InverseCumulativeRsg<SobolRsg, InverseCumulativeNormal>
+                ::sample_type& x = gaussian.nextSequence();
+            if (x.weight != u.weight)
+                BOOST_FAIL("Mismatch in sample weight at point " << i);
+            for (Size n = 0; n < d; n++) {
+                if (x.value[n] != icn(u.value[n]))
+                    BOOST_FAIL("Mismatch in block inverse-cumulative "
+                               "generation:"
+                               << "\n  size:     " << d
+                               << "\n  point:    " << i
+                               << "\n  at index: " << n);
+            }
+        }
+    }
+}
+
 BOOST_AUTO_TEST_CASE(testHighDimensionalIntegrals, *precondition(if_speed(Slow))) {
     BOOST_TEST_MESSAGE("Testing high-dimensional integrals...");
 
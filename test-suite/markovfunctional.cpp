@@ -1670,6 +1670,87 @@ BOOST_AUTO_TEST_CASE(testBermudanSwaption) {
                     << ")");
 }
 
+BOOST_AUTO_TEST_CASE(testIncrementalNumeraireTabulation) {
+
+    BOOST_TEST_MESSAGE("Testing Markov functional numeraire update "
+                       "after a local volatility change...");
+
+    Date referenceDate(14, November, 2012);
+    Settings::instance().evaluationDate() = referenceDate;
+
+    Handle<YieldTermStructure> flatYts_ = flatYts();
+
+    std::vector<Period> optionTenors = {1 * Years, 2 * Years, 3 * Years,
+                                        5 * Years, 10 * Years, 15 * Years};
+    std::vector<Period> swapTenors = {1 * Years, 5 * Years, 10 * Years};
+    std::vector<std::vector<ext::shared_ptr<SimpleQuote> > > quotes(
+        optionTenors.size());
+    std::vector<std::vector<Handle<Quote> > > vols(optionTenors.size());
+    for (Size i = 0; i < optionTenors.size(); i++) {
+        for (Size j = 0; j < swapTenors.size(); j++) {
+            quotes[i].push_back(
+                ext::make_shared<SimpleQuote>(0.20 - 0.005 * i + 0.01 * j));
+            vols[i].emplace_back(quotes[i].back());
+        }
+    }
+    Handle<SwaptionVolatilityStructure> swaptionVts(
+        ext::make_shared<SwaptionVolatilityMatrix>(
+            TARGET(), Following, optionTenors, swapTenors, vols,
+            Actual365Fixed(), true));
+
+    ext::shared_ptr<SwapIndex> swapIndexBase(
+        new EuriborSwapIsdaFixA(1 * Years));
+    std::vector<Date> volStepDates;
+    std::vector<Real> modelVols = {1.0};
+    MarkovFunctional::ModelSettings settings =
+        MarkovFunctional::ModelSettings()
+            .withYGridPoints(32)
+            .withGaussHermitePoints(16)
+            .addAdjustment(MarkovFunctional::ModelSettings::AdjustDigitals);
+
+    ext::shared_ptr<MarkovFunctional> mf(new MarkovFunctional(
+        flatYts_, 0.01, volStepDates, modelVols, swaptionVts,
+        expiriesCalBasket1(), tenorsCalBasket1(), swapIndexBase, settings));
+
+    std::vector<Time> times = {0.5, 1.5, 2.5, 3.5, 4.5, 6.0, 9.0, 12.0};
+    std::vector<Real> before;
+    for (Real t : times)
+        before.push_back(mf->zerobond(t + 1.0, t, 1.0));
+
+    // bump the volatilities on the third option tenor only, so that just
+    // the tabulation before the fifth year has to be updated
+    for (const auto& q : quotes[2])
+        q->setValue(q->value() + 0.02);
+
+    ext::shared_ptr<MarkovFunctional> reference(new MarkovFunctional(
+        flatYts_, 0.01, volStepDates, modelVols, swaptionVts,
+        expiriesCalBasket1(), tenorsCalBasket1(), swapIndexBase, settings));
+
+    const Real tol = 1E-14;
+
+    for (Size i = 0; i < times.size(); i++) {
+        Time t = times[i];
+        for (Real y = -3.0; y <= 3.0; y += 1.0) {
+            Real updated = mf->zerobond(t + 1.0, t, y);
+            Real expected = reference->zerobond(t + 1.0, t, y);
+            if (std::fabs(updated - expected) > tol)
+                BOOST_ERROR("zerobond of updated model ("
+                            << updated << ") differs from newly built model ("
+                            << expected << ") at t=" << t << ", y=" << y);
+            updated = mf->numeraire(t, y);
+            expected = reference->numeraire(t, y);
+            if (std::fabs(updated - expected) > tol * expected)
+                BOOST_ERROR("numeraire of updated model ("
+                            << updated << ") differs from newly built model ("
+                            << expected << ") at t=" << t << ", y=" << y);
+        }
+        Real after = mf->zerobond(t + 1.0, t, 1.0);
+        if (t < 2.0 && std::fabs(after - before[i]) < 1E-8)
+            BOOST_ERROR("volatility change is not reflected in zerobond "
+                        "at t=" << t << " (" << after << ")");
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -24,6 +24,8 @@
 #include "preconditions.hpp"
 #include "toplevelfixture.hpp"
 #include "utilities.hpp"
+#include <ql/experimental/math/fireflyalgorithm.hpp>
+#include <ql/experimental/math/particleswarmoptimization.hpp>
 #include <ql/math/optimization/bfgs.hpp>
 #include <ql/math/optimization/conjugategradient.hpp>
 #include <ql/math/optimization/constraint.hpp>
@@ -540,6 +542,102 @@ BOOST_AUTO_TEST_CASE(testDifferentialEvolution) {
     }
 }
 
+// random numbers are drawn outside the parallel evaluation, so the
+// results must not depend on the number of threads
+void checkParallelEvaluation(const Problem& sequential,
+                             const Problem& parallel) {
+    if (parallel.functionValue() != sequential.functionValue()
+        || parallel.functionEvaluation() != sequential.functionEvaluation()) {
+        BOOST_ERROR("parallel evaluation changed the result"
+                    << "\n    sequential value:       "
+                    << sequential.functionValue()
+                    << "\n    parallel value:         "
+                    << parallel.functionValue()
+                    << "\n    sequential evaluations: "
+                    << sequential.functionEvaluation()
+                    << "\n    parallel evaluations:   "
+                    << parallel.functionEvaluation());
+    }
+    for (Size i=0; i<sequential.currentValue().size(); ++i) {
+        if (parallel.currentValue()[i] != sequential.currentValue()[i])
+            BOOST_ERROR("parallel evaluation changed the minimum at " << i
+                        << "\n    sequential: " << sequential.currentValue()[i]
+                        << "\n    parallel:   " << parallel.currentValue()[i]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testDifferentialEvolutionParallelEvaluation) {
+    BOOST_TEST_MESSAGE("Testing differential evolution "
+                       "with parallel evaluation of the population...");
+
+    DifferentialEvolution::Configuration conf =
+        DifferentialEvolution::Configuration()
+        .withStepsizeWeight(0.4)
+        .withBounds()
+        .withCrossoverProbability(0.35)
+        .withPopulationMembers(200)
+        .withStrategy(DifferentialEvolution::BestMemberWithJitter)
+        .withCrossoverType(DifferentialEvolution::Normal)
+        .withAdaptiveCrossover()
+        .withSeed(3242);
+
+    Griewangk costFunction;
+    BoundaryConstraint constraint(-600.0, 600.0);
+    EndCriteria endCriteria(200, 100, 1e-12, 1e-10, Null<Real>());
+
+    Problem sequential(costFunction, constraint, Array(5, 100.0));
+    DifferentialEvolution(conf).minimize(sequential, endCriteria);
+
+    Problem parallel(costFunction, constraint, Array(5, 100.0));
+    DifferentialEvolution(conf.withParallelEvaluation())
+        .minimize(parallel, endCriteria);
+
+    checkParallelEvaluation(sequential, parallel);
+}
+
+BOOST_AUTO_TEST_CASE(testParticleSwarmParallelEvaluation) {
+    BOOST_TEST_MESSAGE("Testing particle swarm optimization "
+                       "with parallel evaluation of the particles...");
+
+    Griewangk costFunction;
+    BoundaryConstraint constraint(-600.0, 600.0);
+    EndCriteria endCriteria(200, 100, 1e-12, 1e-10, Null<Real>());
+
+    const auto minimize = [&](bool parallel) {
+        Problem problem(costFunction, constraint, Array(5, 100.0));
+        ParticleSwarmOptimization pso(
+            50, ext::make_shared<GlobalTopology>(),
+            ext::make_shared<TrivialInertia>(), 2.05, 2.05, 3242UL);
+        pso.enableParallelEvaluation(parallel);
+        pso.minimize(problem, endCriteria);
+        return problem;
+    };
+
+    checkParallelEvaluation(minimize(false), minimize(true));
+}
+
+BOOST_AUTO_TEST_CASE(testFireflyParallelEvaluation) {
+    BOOST_TEST_MESSAGE("Testing firefly algorithm "
+                       "with parallel evaluation of the fireflies...");
+
+    Griewangk costFunction;
+    BoundaryConstraint constraint(-600.0, 600.0);
+    EndCriteria endCriteria(200, 100, 1e-12, 1e-10, Null<Real>());
+
+    const auto minimize = [&](bool parallel) {
+        Problem problem(costFunction, constraint, Array(5, 100.0));
+        FireflyAlgorithm firefly(
+            50, ext::make_shared<ExponentialIntensity>(10.0, 1e-8, 1.0),
+            ext::make_shared<GaussianWalk>(2.5, 0.9, 3242UL),
+            20, 1.0, 0.5, 3242UL);
+        firefly.enableParallelEvaluation(parallel);
+        firefly.minimize(problem, endCriteria);
+        return problem;
+    };
+
+    checkParallelEvaluation(minimize(false), minimize(true));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -26,8 +26,12 @@
 #include <ql/cashflows/iborcoupon.hpp>
 #include <ql/models/shortrate/onefactormodels/hullwhite.hpp>
 #include <ql/models/shortrate/onefactormodels/extendedcoxingersollross.hpp>
+#include <ql/models/shortrate/twofactormodels/g2.hpp>
 #include <ql/models/shortrate/calibrationhelpers/swaptionhelper.hpp>
+#include <ql/models/shortrate/shortratetreecache.hpp>
+#include <ql/pricingengines/swaption/discretizedswaption.hpp>
 #include <ql/pricingengines/swaption/jamshidianswaptionengine.hpp>
+#include <ql/pricingengines/swaption/treeswaptionengine.hpp>
 #include <ql/pricingengines/swap/treeswapengine.hpp>
 #include <ql/pricingengines/swap/discountingswapengine.hpp>
 #include <ql/indexes/ibor/euribor.hpp>
@@ -127,6 +131,304 @@ BOOST_AUTO_TEST_CASE(testCachedHullWhite) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testParallelCalibration) {
+    BOOST_TEST_MESSAGE("Testing Hull-White calibration with helpers evaluated in parallel...");
+
+    Date today(15, February, 2002);
+    Date settlement(19, February, 2002);
+    Settings::instance().evaluationDate() = today;
+    Handle<YieldTermStructure> termStructure(flatRate(settlement,0.04875825,
+                                                      Actual365Fixed()));
+    ext::shared_ptr<IborIndex> index(new Euribor6M(termStructure));
+    CalibrationData data[] = {{ 1, 5, 0.1148 },
+                              { 2, 4, 0.1108 },
+                              { 3, 3, 0.1070 },
+                              { 4, 2, 0.1021 },
+                              { 5, 1, 0.1000 }};
+
+    const auto calibratedParams = [&](bool parallel, bool sharedEngine,
+                                      bool analytic) {
+        ext::shared_ptr<HullWhite> model(new HullWhite(termStructure));
+        model->enableParallelCalibration(parallel);
+
+        const auto makeEngine = [&]() {
+            auto engine = ext::make_shared<JamshidianSwaptionEngine>(model);
+            engine->enableModelParameterGradient(analytic);
+            return engine;
+        };
+        // helpers sharing an engine must be evaluated sequentially
+        const ext::shared_ptr<PricingEngine> engine = makeEngine();
+
+        std::vector<ext::shared_ptr<CalibrationHelper> > swaptions;
+        for (auto& i : data) {
+            ext::shared_ptr<Quote> vol(new SimpleQuote(i.volatility));
+            ext::shared_ptr<BlackCalibrationHelper> helper(
+                new SwaptionHelper(Period(i.start, Years), Period(i.length, Years), Handle<Quote>(vol),
+                                   index, Period(1, Years), Thirty360(Thirty360::BondBasis), Actual360(), termStructure));
+            helper->setPricingEngine(sharedEngine ? engine : makeEngine());
+            swaptions.push_back(helper);
+        }
+
+        LevenbergMarquardt optimizationMethod(1.0e-8,1.0e-8,1.0e-8,analytic);
+        EndCriteria endCriteria(10000, 100, 1e-6, 1e-8, 1e-8);
+        model->calibrate(swaptions, optimizationMethod, endCriteria);
+
+        return model->params();
+    };
+
+    const Real tolerance = 1e-12;
+    for (bool analytic : { false, true }) {
+        const Array sequential = calibratedParams(false, false, analytic);
+        for (bool sharedEngine : { false, true }) {
+            const Array parallel =
+                calibratedParams(true, sharedEngine, analytic);
+            for (Size i=0; i < sequential.size(); ++i) {
+                if (std::fabs(sequential[i] - parallel[i]) > tolerance) {
+                    BOOST_ERROR("parallel calibration does not reproduce "
+                                "sequential results:"
+                                << std::setprecision(12)
+                                << "\n  analytic gradient: " << analytic
+                                << "\n  shared engine:     " << sharedEngine
+                                << "\n  parameter:         " << i
+                                << "\n  sequential:        " << sequential[i]
+                                << "\n  parallel:          " << parallel[i]);
+                }
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testParallelCalibrationOnSharedTree) {
+    BOOST_TEST_MESSAGE("Testing parallel Hull-White calibration on a shared tree...");
+
+    Date today(15, February, 2002);
+    Date settlement(19, February, 2002);
+    Settings::instance().evaluationDate() = today;
+    Handle<YieldTermStructure> termStructure(flatRate(settlement,0.04875825,
+                                                      Actual365Fixed()));
+    ext::shared_ptr<IborIndex> index(new Euribor6M(termStructure));
+    CalibrationData data[] = {{ 1, 5, 0.1148 },
+                              { 2, 4, 0.1108 },
+                              { 3, 3, 0.1070 },
+                              { 4, 2, 0.1021 },
+                              { 5, 1, 0.1000 }};
+
+    const auto calibratedParams = [&](bool parallel) {
+        ext::shared_ptr<HullWhite> model(new HullWhite(termStructure));
+        model->enableParallelCalibration(parallel);
+        const auto cache = ext::make_shared<ShortRateTreeCache>(model, 50);
+
+        std::vector<ext::shared_ptr<CalibrationHelper> > swaptions;
+        for (auto& i : data) {
+            ext::shared_ptr<Quote> vol(new SimpleQuote(i.volatility));
+            ext::shared_ptr<SwaptionHelper> helper(
+                new SwaptionHelper(Period(i.start, Years), Period(i.length, Years), Handle<Quote>(vol),
+                                   index, Period(1, Years), Thirty360(Thirty360::BondBasis), Actual360(), termStructure));
+            // distinct engines sharing one tree
+            helper->setPricingEngine(
+                ext::make_shared<TreeSwaptionEngine>(cache));
+            swaptions.push_back(helper);
+
+            Swaption::arguments arguments;
+            helper->swaption()->setupArguments(&arguments);
+            cache->addTimes(
+                DiscretizedSwaption(arguments,
+                                    termStructure->referenceDate(),
+                                    termStructure->dayCounter())
+                .mandatoryTimes());
+        }
+
+        LevenbergMarquardt optimizationMethod(1.0e-8,1.0e-8,1.0e-8);
+        EndCriteria endCriteria(10000, 100, 1e-6, 1e-8, 1e-8);
+        model->calibrate(swaptions, optimizationMethod, endCriteria);
+
+        return model->params();
+    };
+
+    const Array sequential = calibratedParams(false);
+    const Array parallel = calibratedParams(true);
+
+    const Real tolerance = 1e-12;
+    for (Size i=0; i < sequential.size(); ++i) {
+        if (std::fabs(sequential[i] - parallel[i]) > tolerance) {
+            BOOST_ERROR("parallel calibration on shared tree does not "
+                        "reproduce sequential results:"
+                        << std::setprecision(12)
+                        << "\n  parameter:  " << i
+                        << "\n  sequential: " << sequential[i]
+                        << "\n  parallel:   " << parallel[i]);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testParallelTreeCalibration) {
+    BOOST_TEST_MESSAGE("Testing parallel Hull-White calibration with a shared tree engine...");
+
+    Date today(15, February, 2002);
+    Date settlement(19, February, 2002);
+    Settings::instance().evaluationDate() = today;
+    Handle<YieldTermStructure> termStructure(flatRate(settlement,0.04875825,
+                                                      Actual365Fixed()));
+    ext::shared_ptr<IborIndex> index(new Euribor6M(termStructure));
+    CalibrationData data[] = {{ 1, 5, 0.1148 },
+                              { 2, 4, 0.1108 },
+                              { 3, 3, 0.1070 },
+                              { 4, 2, 0.1021 },
+                              { 5, 1, 0.1000 }};
+
+    const auto calibratedParams = [&](bool parallel) {
+        ext::shared_ptr<HullWhite> model(new HullWhite(termStructure));
+        const auto makeEngine = [model]() {
+            return ext::make_shared<TreeSwaptionEngine>(model, 40);
+        };
+        // the helpers sharing the engine get their own ones
+        model->enableParallelCalibration(parallel, makeEngine);
+
+        const ext::shared_ptr<PricingEngine> engine = makeEngine();
+        std::vector<ext::shared_ptr<CalibrationHelper> > swaptions;
+        for (auto& i : data) {
+            ext::shared_ptr<Quote> vol(new SimpleQuote(i.volatility));
+            ext::shared_ptr<BlackCalibrationHelper> helper(
+                new SwaptionHelper(Period(i.start, Years), Period(i.length, Years), Handle<Quote>(vol),
+                                   index, Period(1, Years), Thirty360(Thirty360::BondBasis), Actual360(), termStructure));
+            helper->setPricingEngine(engine);
+            swaptions.push_back(helper);
+        }
+
+        LevenbergMarquardt optimizationMethod(1.0e-8,1.0e-8,1.0e-8);
+        EndCriteria endCriteria(10000, 100, 1e-6, 1e-8, 1e-8);
+        model->calibrate(swaptions, optimizationMethod, endCriteria);
+
+        for (const auto& swaption : swaptions) {
+            if (ext::dynamic_pointer_cast<BlackCalibrationHelper>(swaption)
+                    ->pricingEngine() != engine)
+                BOOST_ERROR("pricing engine of calibration helper "
+                            "not restored after calibration");
+        }
+
+        return model->params();
+    };
+
+    const Array sequential = calibratedParams(false);
+    const Array parallel = calibratedParams(true);
+
+    const Real tolerance = 1e-12;
+    for (Size i=0; i < sequential.size(); ++i) {
+        if (std::fabs(sequential[i] - parallel[i]) > tolerance) {
+            BOOST_ERROR("parallel tree calibration does not reproduce "
+                        "sequential results:"
+                        << std::setprecision(12)
+                        << "\n  parameter:  " << i
+                        << "\n  sequential: " << sequential[i]
+                        << "\n  parallel:   " << parallel[i]);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testAnalyticCalibrationGradient) {
+    BOOST_TEST_MESSAGE("Testing Hull-White calibration with analytic parameter gradients...");
+
+    Date today(15, February, 2002);
+    Date settlement(19, February, 2002);
+    Settings::instance().evaluationDate() = today;
+    Handle<YieldTermStructure> termStructure(flatRate(settlement,0.04875825,
+                                                      Actual365Fixed()));
+    ext::shared_ptr<IborIndex> index(new Euribor6M(termStructure));
+    CalibrationData data[] = {{ 1, 5, 0.1148 },
+                              { 2, 4, 0.1108 },
+                              { 3, 3, 0.1070 },
+                              { 4, 2, 0.1021 },
+                              { 5, 1, 0.1000 }};
+
+    const auto calibratedParams = [&](bool analytic) {
+        ext::shared_ptr<HullWhite> model(new HullWhite(termStructure));
+        ext::shared_ptr<JamshidianSwaptionEngine> engine(
+                                        new JamshidianSwaptionEngine(model));
+        engine->enableModelParameterGradient(analytic);
+
+        std::vector<ext::shared_ptr<CalibrationHelper> > swaptions;
+        for (auto& i : data) {
+            ext::shared_ptr<Quote> vol(new SimpleQuote(i.volatility));
+            ext::shared_ptr<BlackCalibrationHelper> helper(
+                new SwaptionHelper(Period(i.start, Years), Period(i.length, Years), Handle<Quote>(vol),
+                                   index, Period(1, Years), Thirty360(Thirty360::BondBasis), Actual360(), termStructure));
+            helper->setPricingEngine(engine);
+            swaptions.push_back(helper);
+        }
+
+        if (analytic) {
+            // compare the gradients with finite differences
+            model->setParams({0.05, 0.01});
+            const Real h = 1e-5, tolerance = 1e-5;
+            for (auto& swaption : swaptions) {
+                auto helper =
+                    ext::dynamic_pointer_cast<BlackCalibrationHelper>(swaption);
+                Array gradient;
+                helper->modelValueAndGradient(gradient);
+                BOOST_REQUIRE(gradient.size() == 2);
+                for (Size j=0; j < 2; ++j) {
+                    Array params = model->params();
+                    params[j] += h;
+                    model->setParams(params);
+                    const Real up = helper->modelValue();
+                    params[j] -= 2*h;
+                    model->setParams(params);
+                    const Real down = helper->modelValue();
+                    params[j] += h;
+                    model->setParams(params);
+
+                    const Real fd = (up - down)/(2*h);
+                    if (std::fabs(gradient[j] - fd)
+                        > tolerance*std::max(1.0, std::fabs(fd))) {
+                        BOOST_ERROR("failed to reproduce finite-difference "
+                                    "parameter gradient:"
+                                    << std::setprecision(10)
+                                    << "\n  parameter:         " << j
+                                    << "\n  analytic:          " << gradient[j]
+                                    << "\n  finite difference: " << fd);
+                    }
+                }
+
+                // the implied-vol error slope uses the closed-form vega
+                const Volatility vol = 0.1, dv = 1e-6;
+                const Real vega = helper->blackVega(vol);
+                const Real fdVega = (helper->blackPrice(vol + dv)
+                                     - helper->blackPrice(vol - dv))/(2*dv);
+                if (std::fabs(vega - fdVega) > tolerance*fdVega) {
+                    BOOST_ERROR("failed to reproduce finite-difference "
+                                "Black vega:"
+                                << std::setprecision(10)
+                                << "\n  closed form:       " << vega
+                                << "\n  finite difference: " << fdVega);
+                }
+            }
+            model->setParams({0.1, 0.01});
+        }
+
+        LevenbergMarquardt optimizationMethod(1.0e-8,1.0e-8,1.0e-8,analytic);
+        EndCriteria endCriteria(10000, 100, 1e-6, 1e-8, 1e-8);
+        model->calibrate(swaptions, optimizationMethod, endCriteria);
+
+        return model->params();
+    };
+
+    const Array numerical = calibratedParams(false);
+    const Array analytic = calibratedParams(true);
+
+    // the objective function is flat near its minimum
+    const Real tolerance = 1.2e-5;
+    for (Size i=0; i < numerical.size(); ++i) {
+        if (std::fabs(numerical[i] - analytic[i]) > tolerance) {
+            BOOST_ERROR("calibration with analytic gradients does not "
+                        "reproduce numerical results:"
+                        << std::setprecision(12)
+                        << "\n  parameter: " << i
+                        << "\n  numerical: " << numerical[i]
+                        << "\n  analytic:  " << analytic[i]);
+        }
+    }
+}
+
 BOOST_AUTO_TEST_CASE(testCachedHullWhiteFixedReversion) {
     BOOST_TEST_MESSAGE("Testing Hull-White calibration with fixed reversion against cached values...");
 
@@ -440,6 +742,148 @@ BOOST_AUTO_TEST_CASE(testExtendedCoxIngersollRossDiscountFactor) {
                     << "\n  tolerance : " << tol);
     }
 }
+
+BOOST_AUTO_TEST_CASE(testDiscountBondCoefficients) {
+    BOOST_TEST_MESSAGE("Testing discount bond coefficients of affine models...");
+
+    const Date today = Settings::instance().evaluationDate();
+    const Handle<YieldTermStructure> rTS(
+        flatRate(today, 0.04, Actual365Fixed()));
+
+    const std::vector<ext::shared_ptr<OneFactorAffineModel> > models = {
+        ext::make_shared<HullWhite>(rTS, 0.05, 0.01),
+        ext::make_shared<ExtendedCoxIngersollRoss>(rTS, 0.04, 0.5, 0.05, 0.04)
+    };
+
+    const Time now = 2.0;
+    const std::vector<Time> maturities = {2.0, 2.5, 3.0, 5.0, 10.0, 30.0};
+    const Real tol = 1e-14;
+
+    for (const auto& model : models) {
+        Array a, b;
+        model->discountBondCoefficients(now, maturities, a, b);
+        for (Size i=0; i<maturities.size(); ++i) {
+            for (Rate r : {-0.01, 0.03, 0.08}) {
+                const Real expected =
+                    model->discountBond(now, maturities[i], r);
+                const Real calculated = a[i]*std::exp(-b[i]*r);
+                if (std::fabs(calculated-expected) > tol*expected)
+                    BOOST_ERROR("Failed to reproduce discount bond price "
+                                "from its coefficients:"
+                                << "\n  maturity  : " << maturities[i]
+                                << "\n  rate      : " << r
+                                << "\n  calculated: " << calculated
+                                << "\n  expected  : " << expected);
+            }
+        }
+    }
+}
+
+// discount bond value at t=0 and present value at t=2
+std::pair<Real, Real> rollbackDiscountBond(
+                             const ext::shared_ptr<Lattice>& lattice,
+                             Time maturity) {
+    DiscretizedDiscountBond bond;
+    bond.initialize(lattice, maturity);
+    bond.rollback(2.0);
+    const Real presentValue = bond.presentValue();
+    bond.rollback(0.0);
+    return std::make_pair(bond.values()[0], presentValue);
+}
+
+// checks that a tree with flat transition tables reproduces the
+// rollback on a tree without them; returns the former
+template <class Tree, class Model>
+ext::shared_ptr<Tree> checkTransitionTables(const Model& model,
+                                            const TimeGrid& grid) {
+    const ext::shared_ptr<Tree> tree =
+        ext::dynamic_pointer_cast<Tree>(model.tree(grid));
+    const ext::shared_ptr<Tree> directTree =
+        ext::dynamic_pointer_cast<Tree>(model.tree(grid));
+    BOOST_REQUIRE(tree && directTree);
+    BOOST_CHECK(tree->transitionTablesEnabled());
+    directTree->enableTransitionTables(false);
+
+    const Time maturity = grid.back();
+    const std::pair<Real, Real> flat = rollbackDiscountBond(tree, maturity);
+    const std::pair<Real, Real> direct =
+        rollbackDiscountBond(directTree, maturity);
+
+    const Real tol = 1e-14;
+    if (std::fabs(flat.first - direct.first) > tol
+        || std::fabs(flat.second - direct.second) > tol) {
+        BOOST_ERROR("flat transition tables do not reproduce rollback:"
+                    << std::setprecision(16)
+                    << "\n  with tables:    " << flat.first
+                    << ", " << flat.second
+                    << "\n  without tables: " << direct.first
+                    << ", " << direct.second);
+    }
+    return tree;
+}
+
+BOOST_AUTO_TEST_CASE(testTreeTransitionTables) {
+    BOOST_TEST_MESSAGE("Testing flat transition tables of short-rate trees...");
+
+    const Date today = Settings::instance().evaluationDate();
+    const Handle<YieldTermStructure> rTS(
+        flatRate(today, 0.04, Actual365Fixed()));
+
+    const HullWhite model(rTS, 0.05, 0.01);
+
+    const Time maturity = 5.0;
+    const ext::shared_ptr<OneFactorModel::ShortRateTree> tree =
+        checkTransitionTables<OneFactorModel::ShortRateTree>(
+            model, TimeGrid(maturity, 100));
+
+    const Real flat = rollbackDiscountBond(tree, maturity).first;
+    const Real expected = rTS->discount(maturity);
+    if (std::fabs(flat - expected) > 1e-6) {
+        BOOST_ERROR("failed to reproduce discount bond price on tree:"
+                    << "\n  calculated: " << flat
+                    << "\n  expected:   " << expected);
+    }
+
+    const Spread spread = 0.01;
+    tree->setSpread(spread);
+    const Real withSpread = rollbackDiscountBond(tree, maturity).first;
+    tree->setSpread(0.0);
+    const Real withoutSpread = rollbackDiscountBond(tree, maturity).first;
+
+    if (std::fabs(withSpread - expected*std::exp(-spread*maturity)) > 1e-6
+        || std::fabs(withoutSpread - flat) > 1e-14) {
+        BOOST_ERROR("transition tables not reset on spread change:"
+                    << "\n  with spread:    " << withSpread
+                    << "\n  expected:       "
+                    << expected*std::exp(-spread*maturity)
+                    << "\n  without spread: " << withoutSpread
+                    << "\n  expected:       " << flat);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testTwoFactorTreeTransitionTables) {
+    BOOST_TEST_MESSAGE("Testing flat transition tables of two-factor trees...");
+
+    const Date today = Settings::instance().evaluationDate();
+    const Handle<YieldTermStructure> rTS(
+        flatRate(today, 0.04, Actual365Fixed()));
+
+    const G2 model(rTS, 0.1, 0.01, 0.2, 0.008, -0.6);
+
+    const Time maturity = 5.0;
+    const ext::shared_ptr<TwoFactorModel::ShortRateTree> tree =
+        checkTransitionTables<TwoFactorModel::ShortRateTree>(
+            model, TimeGrid(maturity, 40));
+
+    const Real flat = rollbackDiscountBond(tree, maturity).first;
+    const Real expected = rTS->discount(maturity);
+    if (std::fabs(flat - expected) > 1e-4) {
+        BOOST_ERROR("failed to reproduce discount bond price on tree:"
+                    << "\n  calculated: " << flat
+                    << "\n  expected:   " << expected);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()